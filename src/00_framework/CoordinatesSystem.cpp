@@ -24,6 +24,7 @@
 
 #include "SchemaMacros.hpp"
 
+#include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/Point.h>
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp>
@@ -44,6 +45,178 @@ namespace synthese
 	const CoordinatesSystem* CoordinatesSystem::_instanceCoordinatesSystem(NULL);
 	const CoordinatesSystem* CoordinatesSystem::_storageCoordinatesSystem(NULL);
 	CoordinatesSystem::CoordinatesSystemsMap CoordinatesSystem::_CoordinatesSystems;
+	boost::thread_specific_ptr<CoordinatesSystem::_ThreadProjections> CoordinatesSystem::_threadProjections;
+	size_t CoordinatesSystem::_generation(0);
+
+
+
+	namespace
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Collects the coordinates of a geometry to convert them at once.
+		class CoordinatesCollector:
+			public CoordinateFilter
+		{
+			mutable vector<Coordinate*> _coordinates;
+
+		public:
+			virtual void filter_rw(Coordinate* c) const { _coordinates.push_back(c); }
+
+			const vector<Coordinate*>& getCoordinates() const { return _coordinates; }
+		};
+	}
+
+
+
+	CoordinatesSystem::_ThreadProjections::_ThreadProjections():
+		context(pj_ctx_alloc()),
+		generation(_generation)
+	{}
+
+
+
+	CoordinatesSystem::_ThreadProjections::~_ThreadProjections()
+	{
+		clear();
+		pj_ctx_free(context);
+	}
+
+
+
+	void CoordinatesSystem::_ThreadProjections::clear()
+	{
+		BOOST_FOREACH(const Projections::value_type& it, projections)
+		{
+			if(it.second)
+			{
+				pj_free(it.second);
+			}
+		}
+		projections.clear();
+	}
+
+
+
+	projPJ CoordinatesSystem::_getThreadProjObject() const
+	{
+		_ThreadProjections* threadProjections(_threadProjections.get());
+		if(!threadProjections)
+		{
+			threadProjections = new _ThreadProjections;
+			_threadProjections.reset(threadProjections);
+		}
+
+		// The systems may have been replaced since the last conversion
+		if(threadProjections->generation != _generation)
+		{
+			threadProjections->clear();
+			threadProjections->generation = _generation;
+		}
+
+		projPJ& result(threadProjections->projections[_srid]);
+		if(!result)
+		{
+			result = pj_init_plus_ctx(threadProjections->context, _projSequence.c_str());
+		}
+		return result;
+	}
+
+
+
+	void CoordinatesSystem::_convertCoordinates(
+		const CoordinatesSystem& source,
+		double* x,
+		double* y,
+		size_t number,
+		size_t offset
+	) const	{
+		if(!number)
+		{
+			return;
+		}
+
+		if(source._degrees)
+		{
+			for(size_t i(0); i < number; ++i)
+			{
+				x[i * offset] = Angle::toRadians(x[i * offset]);
+				y[i * offset] = Angle::toRadians(y[i * offset]);
+			}
+		}
+
+		pj_transform(
+			source._getThreadProjObject(),
+			_getThreadProjObject(),
+			static_cast<long>(number),
+			static_cast<int>(offset),
+			x, y, NULL
+		);
+
+		if(_degrees)
+		{
+			for(size_t i(0); i < number; ++i)
+			{
+				x[i * offset] = Angle::toDegrees(x[i * offset]);
+				y[i * offset] = Angle::toDegrees(y[i * offset]);
+			}
+		}
+	}
+
+
+
+	void CoordinatesSystem::convertCoordinates(
+		const CoordinatesSystem& source,
+		const vector<Coordinate*>& coordinates
+	) const	{
+		if(coordinates.empty())
+		{
+			return;
+		}
+
+		// Interleaved x and y to call PROJ once
+		vector<double> values(coordinates.size() * 2);
+		for(size_t i(0); i < coordinates.size(); ++i)
+		{
+			values[2 * i] = coordinates[i]->x;
+			values[2 * i + 1] = coordinates[i]->y;
+		}
+
+		_convertCoordinates(source, &values[0], &values[1], coordinates.size(), 2);
+
+		for(size_t i(0); i < coordinates.size(); ++i)
+		{
+			coordinates[i]->x = values[2 * i];
+			coordinates[i]->y = values[2 * i + 1];
+		}
+	}
+
+
+
+	void CoordinatesSystem::convertCoordinates(
+		const CoordinatesSystem& source,
+		CoordinateSequence& sequence
+	) const	{
+		size_t number(sequence.getSize());
+		if(!number)
+		{
+			return;
+		}
+
+		vector<double> values(number * 2);
+		for(size_t i(0); i < number; ++i)
+		{
+			values[2 * i] = sequence.getX(i);
+			values[2 * i + 1] = sequence.getY(i);
+		}
+
+		_convertCoordinates(source, &values[0], &values[1], number, 2);
+
+		for(size_t i(0); i < number; ++i)
+		{
+			sequence.setOrdinate(i, CoordinateSequence::X, values[2 * i]);
+			sequence.setOrdinate(i, CoordinateSequence::Y, values[2 * i + 1]);
+		}
+	}
 
 
 
@@ -57,16 +230,16 @@ namespace synthese
 
 	boost::shared_ptr<geos::geom::Geometry> CoordinatesSystem::convertGeometry( const geos::geom::Geometry& source ) const
 	{
-		mutex::scoped_lock lock (_proj4Mutex);
-
 		boost::shared_ptr<geos::geom::Geometry> result(_geometryFactory.createGeometry(&source));
 
-		CoordinatesSystem::ConversionFilter filter(
-			GetCoordinatesSystem(source.getSRID()),
-			*this
-		);
-
-		result->apply_rw(&filter);
+		const CoordinatesSystem& sourceSystem(GetCoordinatesSystem(source.getSRID()));
+		if(&sourceSystem != this)
+		{
+			CoordinatesCollector collector;
+			result->apply_rw(&collector);
+			convertCoordinates(sourceSystem, collector.getCoordinates());
+			result->geometryChanged();
+		}
 		result->setSRID(_srid);
 
 		return result;
@@ -104,6 +277,7 @@ namespace synthese
 	{
 		_instanceCoordinatesSystem = NULL;
 		_storageCoordinatesSystem = NULL;
+		++_generation;
 		if (_CoordinatesSystems.size() != 0)
 			_CoordinatesSystems.clear();
 	}
@@ -272,22 +446,5 @@ namespace synthese
 
 	void CoordinatesSystem::ConversionFilter::filter_rw( geos::geom::Coordinate* c ) const
 	{
-		if(_source._degrees)
-		{
-			c->x = Angle::toRadians(c->x);
-			c->y = Angle::toRadians(c->y);
-		}
-
-		pj_transform(
-			_source.getProjObject(),
-			_dest.getProjObject(),
-			1, 1,
-			&c->x, &c->y, NULL
-		);
-
-		if(_dest._degrees)
-		{
-			c->x = Angle::toDegrees(c->x);
-			c->y = Angle::toDegrees(c->y);
-		}
+		_dest._convertCoordinates(_source, &c->x, &c->y, 1, 1);
 }	}
@@ -29,13 +29,22 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <proj_api.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/optional.hpp>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/CoordinateFilter.h>
-#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace geos
+{
+	namespace geom
+	{
+		class CoordinateSequence;
+	}
+}
 
 namespace synthese
 {
@@ -65,6 +74,8 @@ namespace synthese
 		/// CoordinateFilter which converts coordinates from a spatial reference
 		/// system into another.
 		//////////////////////////////////////////////////////////////////////////
+		/// Each coordinate is converted by a call to PROJ : prefer convertGeometry
+		/// or convertCoordinates to convert several coordinates.
 		/// @see http://geos.refractions.net/ro/doxygen_docs/html/classgeos_1_1geom_1_1CoordinateFilter.html
 		/// @ingroup m00
 		/// @author Hugues Romain
@@ -96,11 +107,41 @@ namespace synthese
 		projPJ _projObject;
 		geos::geom::GeometryFactory _geometryFactory;
 		bool _degrees;
-		mutable boost::mutex _proj4Mutex;
+
+		//////////////////////////////////////////////////////////////////////////
+		/// PROJ context and projection objects of a thread.
+		/// The PROJ objects cannot be used by several threads at the same time :
+		/// each thread initializes its own objects at its first conversion.
+		struct _ThreadProjections
+		{
+			typedef std::map<SRID, projPJ> Projections;
+
+			projCtx context;
+			Projections projections;
+			std::size_t generation;
+
+			_ThreadProjections();
+			~_ThreadProjections();
+			void clear();
+		};
+		static boost::thread_specific_ptr<_ThreadProjections> _threadProjections;
+		static std::size_t _generation;	//!< changed when the coordinates systems are cleared
 
 		CoordinatesSystem(const CoordinatesSystem&);
 		void operator=(const CoordinatesSystem&);
 
+		//////////////////////////////////////////////////////////////////////////
+		/// @return the projection object of the system for the current thread
+		projPJ _getThreadProjObject() const;
+
+		void _convertCoordinates(
+			const CoordinatesSystem& source,
+			double* x,
+			double* y,
+			std::size_t number,
+			std::size_t offset
+		) const;
+
 	public:
 
 		CoordinatesSystem(
@@ -133,9 +174,39 @@ namespace synthese
 
 
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Conversion of the coordinate system of a geometry.
+			/// All the coordinates of the geometry are converted in a single call to
+			/// PROJ. The conversions run concurrently in several threads.
+			/// @param source geometry to convert
+			/// @return result of the conversion
 			boost::shared_ptr<geos::geom::Geometry> convertGeometry(const geos::geom::Geometry& source) const;
 
 
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Conversion of coordinates into the current system in a single call to
+			/// PROJ.
+			/// @param source coordinates system of the coordinates
+			/// @param coordinates the coordinates to convert (updated)
+			void convertCoordinates(
+				const CoordinatesSystem& source,
+				const std::vector<geos::geom::Coordinate*>& coordinates
+			) const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Conversion of a coordinate sequence into the current system in a
+			/// single call to PROJ.
+			/// @param source coordinates system of the sequence
+			/// @param sequence the sequence to convert (updated)
+			void convertCoordinates(
+				const CoordinatesSystem& source,
+				geos::geom::CoordinateSequence& sequence
+			) const;
+
+
 			//////////////////////////////////////////////////////////////////////////
 			/// Point creation using the registered geos factory.
 			//////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,7 @@
 #include "NumericField.hpp"
 #include "ParametersMap.h"
 #include "PointersVectorField.hpp"
+#include "RegistryBase.h"
 #include "UtilTypes.h"
 
 #include <string>
@@ -580,6 +581,13 @@ namespace synthese
 		boost::logic::tribool withFiles,
 		std::string prefix
 	) const {
+		// The object is displayed, whether it was read in its registry or reached
+		// by a link
+		if(getKey())
+		{
+			util::RegistryBase::RecordRead(getKey());
+		}
+
 		SaveOperator op(map, *this, withFiles, prefix);
 		boost::fusion::for_each(_schema, op);
 		if(withAdditionalParameters)
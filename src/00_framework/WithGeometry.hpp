@@ -25,6 +25,7 @@
 
 #include "CoordinatesSystem.hpp"
 
+#include <map>
 #include <boost/shared_ptr.hpp>
 
 namespace synthese
@@ -35,6 +36,11 @@ namespace synthese
 	///	@author Hugues Romain
 	///	@since 3.2.0
 	///	@date 2010
+	//////////////////////////////////////////////////////////////////////////
+	/// The conversions of the geometry into other spatial reference systems
+	/// are cached until the geometry is replaced by a setter (see
+	/// getProjectedGeometry). The cache is an immutable object replaced
+	/// atomically : the readers do not lock.
 	template<class G>
 	class WithGeometry
 	{
@@ -44,6 +50,20 @@ namespace synthese
 	private:
 		boost::shared_ptr<G> _geometry;
 
+		//////////////////////////////////////////////////////////////////////////
+		/// Conversions of a geometry, never modified once shared.
+		struct ProjectedGeometries
+		{
+			boost::shared_ptr<G> source;	//!< the converted geometry (keeps it alive)
+			std::map<CoordinatesSystem::SRID, boost::shared_ptr<G> > geometries;
+		};
+		mutable boost::shared_ptr<const ProjectedGeometries> _projectedGeometries;
+
+		void _clearProjectedGeometries()
+		{
+			// The readers which already got the previous cache keep it alive
+			boost::atomic_store(&_projectedGeometries, boost::shared_ptr<const ProjectedGeometries>());
+		}
 
 	public:
 		//////////////////////////////////////////////////////////////////////////
@@ -93,15 +113,15 @@ namespace synthese
 
 		//! @name Setters
 		//@{
-			void setGeometry(const boost::shared_ptr<G>& value){ _geometry = value; }
+			void setGeometry(const boost::shared_ptr<G>& value){ _geometry = value; _clearProjectedGeometries(); }
 		//@}
 
 
 
 		//! @name Modifiers
 		//@{
-			void resetGeometry(){ _geometry.reset(); }
-			void cloneGeometry(const G& value){_geometry.reset(value.clone()); }
+			void resetGeometry(){ _geometry.reset(); _clearProjectedGeometries(); }
+			void cloneGeometry(const G& value){_geometry.reset(value.clone()); _clearProjectedGeometries(); }
 		//@}
 
 
@@ -109,6 +129,67 @@ namespace synthese
 		//! @name Services
 		//@{
 			bool hasGeometry() const { return _geometry.get() && !_geometry->isEmpty(); }
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Geometry converted into a spatial reference system.
+			/// The conversion is cached : the geometry must not be modified in place
+			/// after the call (use the setters).
+			/// @param coordinatesSystem the spatial reference system
+			/// @return the converted geometry (the geometry itself if it already
+			/// uses the system, null if the object has no geometry)
+			boost::shared_ptr<G> getProjectedGeometry(
+				const CoordinatesSystem& coordinatesSystem
+			) const	{
+				boost::shared_ptr<G> geometry(_geometry);
+				if(	!geometry.get() ||
+					static_cast<CoordinatesSystem::SRID>(geometry->getSRID()) == coordinatesSystem.getSRID()
+				){
+					return geometry;
+				}
+
+				// Lock free search in the cache of the geometry : a cache left by a
+				// replaced geometry is never read
+				boost::shared_ptr<const ProjectedGeometries> cache(
+					boost::atomic_load(&_projectedGeometries)
+				);
+				if(cache.get() && cache->source == geometry)
+				{
+					typename std::map<CoordinatesSystem::SRID, boost::shared_ptr<G> >::const_iterator it(
+						cache->geometries.find(coordinatesSystem.getSRID())
+					);
+					if(it != cache->geometries.end())
+					{
+						return it->second;
+					}
+				}
+
+				boost::shared_ptr<G> result(
+					boost::static_pointer_cast<G, geos::geom::Geometry>(
+						coordinatesSystem.convertGeometry(static_cast<geos::geom::Geometry&>(*geometry))
+				)	);
+
+				// The new cache is stored only if the geometry was not replaced
+				// during the conversion (the source check above protects the
+				// readers anyway). A conversion stored concurrently into the same
+				// cache may be lost : it will be computed again.
+				boost::shared_ptr<ProjectedGeometries> newCache(new ProjectedGeometries);
+				if(cache.get() && cache->source == geometry)
+				{
+					*newCache = *cache;
+				}
+				newCache->source = geometry;
+				newCache->geometries[coordinatesSystem.getSRID()] = result;
+				if(_geometry == geometry)
+				{
+					boost::atomic_store(
+						&_projectedGeometries,
+						boost::shared_ptr<const ProjectedGeometries>(newCache)
+					);
+				}
+				return result;
+			}
 		//@}
 	};
 }
@@ -27,7 +27,10 @@
 #include "DBDirectTableSync.hpp"
 #include "Registrable.h"
 
+#include <boost/foreach.hpp>
+
 using namespace boost;
+using namespace std;
 
 namespace synthese
 {
@@ -54,5 +57,18 @@ namespace synthese
 			}
 			dynamic_cast<DBDirectTableSync&>(*tableSync).getEditableRegistry(*this).addRegistrable(object);
 		}
+
+
+
+		void Env::createAllRegistries()
+		{
+			BOOST_FOREACH(const RegistryCreatorMap::value_type& it, _registryCreators)
+			{
+				if(_map.find(it.first) == _map.end())
+				{
+					_map.insert(make_pair(it.first, it.second->create()));
+				}
+			}
+		}
 	}
 }
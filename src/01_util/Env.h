@@ -334,6 +334,15 @@ namespace synthese
 
 
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Creates all the integrated registries which are not created yet.
+			/// The registries are created on demand by getEditableRegistry : this
+			/// method must be called before the environment is filled by several
+			/// threads, as the creation of a registry is not thread safe.
+			void createAllRegistries();
+
+
+
 			//////////////////////////////////////////////////////////////////////////
 			/// Clears the environment : each registry is destroyed.
 			/// Thanks to the shared pointer, this method should destroy linked objects
@@ -261,6 +261,8 @@ namespace synthese
 		const boost::shared_ptr<T>& Registry<T>::getEditable(
 			RegistryKeyType key
 		) const {
+			RecordRead(key);
+
 			boost::recursive_mutex::scoped_lock lock(_mutex);
 			typename Map::const_iterator it(_registry.find(key));
 
@@ -278,6 +280,8 @@ namespace synthese
 		boost::shared_ptr<const T> Registry<T>::get(
 			RegistryKeyType key
 		) const	{
+			RecordRead(key);
+
 			boost::recursive_mutex::scoped_lock lock(_mutex);
 			typename Map::const_iterator it(_registry.find(key));
 
@@ -24,13 +24,86 @@
 // util
 #include "RegistryBase.h"
 
+#include <boost/thread/tss.hpp>
+
 namespace synthese
 {
 	namespace util
 	{
+		namespace
+		{
+			// The recorders are owned by the stacks of the threads
+			void _DoNotDelete(RegistryBase::ReadRecorder*)
+			{}
+
+			boost::thread_specific_ptr<RegistryBase::ReadRecorder> _currentRecorder(&_DoNotDelete);
+		}
+
+
+
 		RegistryBase::RegistryBase()
 		{
 
 		}
+
+
+
+		RegistryBase::ReadRecorder::ReadRecorder():
+			_anyTable(false),
+			_enclosingRecorder(_currentRecorder.get())
+		{
+			_currentRecorder.reset(this);
+		}
+
+
+
+		RegistryBase::ReadRecorder::~ReadRecorder()
+		{
+			_currentRecorder.reset(_enclosingRecorder);
+			if(_enclosingRecorder)
+			{
+				_enclosingRecorder->_keys.insert(_keys.begin(), _keys.end());
+				_enclosingRecorder->_tables.insert(_tables.begin(), _tables.end());
+				if(_anyTable)
+				{
+					_enclosingRecorder->_anyTable = true;
+				}
+			}
+		}
+
+
+
+		void RegistryBase::RecordRead(
+			RegistryKeyType key
+		){
+			ReadRecorder* recorder(_currentRecorder.get());
+			if(recorder)
+			{
+				recorder->record(key);
+			}
+		}
+
+
+
+		void RegistryBase::RecordTableRead(
+			RegistryTableType table
+		){
+			ReadRecorder* recorder(_currentRecorder.get());
+			if(recorder)
+			{
+				recorder->recordTable(table);
+			}
+		}
+
+
+
+		void RegistryBase::RecordAnyTableRead()
+		{
+			ReadRecorder* recorder(_currentRecorder.get());
+			if(recorder)
+			{
+				recorder->recordAnyTable();
+			}
+		}
 	}
 }
@@ -23,6 +23,7 @@
 #ifndef SYNTHESE_util_RegistryBase_h__
 #define SYNTHESE_util_RegistryBase_h__
 
+#include <set>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 
@@ -62,6 +63,68 @@ namespace synthese
 			virtual void addRegistrable(
 				const boost::shared_ptr<Registrable>& ptr
 			) = 0;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Records the data read by the current thread during the life of the
+			/// recorder :
+			/// <ul>
+			///		<li>the keys of the objects read in the registries, found or
+			///		not</li>
+			///		<li>the tables whose objects may have been read without the
+			///		registries (by a link between objects or by an iteration on a
+			///		registry)</li>
+			///		<li>or that any table may have been read that way</li>
+			/// </ul>
+			/// The recorders can be nested : the data recorded by a nested recorder
+			/// is recorded by the enclosing one too.
+			class ReadRecorder
+			{
+			public:
+				typedef std::set<RegistryKeyType> Keys;
+				typedef std::set<RegistryTableType> Tables;
+
+			private:
+				Keys _keys;
+				Tables _tables;
+				bool _anyTable;
+				ReadRecorder* const _enclosingRecorder;
+
+			public:
+				ReadRecorder();
+				~ReadRecorder();
+
+				const Keys& getKeys() const { return _keys; }
+				const Tables& getTables() const { return _tables; }
+				bool getAnyTable() const { return _anyTable; }
+
+				void record(RegistryKeyType key) { _keys.insert(key); }
+				void recordTable(RegistryTableType table) { _tables.insert(table); }
+				void recordAnyTable() { _anyTable = true; }
+			};
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Records a key in the current recorder of the thread, if any.
+			/// Called by the registries at each read of an object, by the objects
+			/// exported to a parameters map, and by the caches which return results
+			/// built from registry objects.
+			static void RecordRead(RegistryKeyType key);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Records a table in the current recorder of the thread, if any.
+			static void RecordTableRead(RegistryTableType table);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Records in the current recorder of the thread, if any, that any table
+			/// may have been read.
+			static void RecordAnyTableRead();
 		};
 	}
 }
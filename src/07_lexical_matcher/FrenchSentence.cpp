@@ -322,7 +322,7 @@ namespace synthese
 		size_t FrenchSentence::size() const
 		{
 			size_t size(0);
-			BOOST_FOREACH(_Words::value_type word, _words)
+			BOOST_FOREACH(Words::value_type word, _words)
 			{
 				size += word.getPhonetic().size();
 			}
@@ -44,11 +44,12 @@ namespace synthese
 				double phoneticScore;
 			};
 
+			typedef std::vector<FrenchPhoneticString> Words;
+
 		private:
-			typedef std::vector<FrenchPhoneticString> _Words;
 			std::string		_source;
 			std::string		_lowerSource;
-			_Words			_words;
+			Words			_words;
 
 			static std::string	_ConvertAlias(const std::string& source);
 
@@ -58,6 +59,7 @@ namespace synthese
 			FrenchSentence(const std::string& source);
 
 			const std::string& getSource() const;
+			const Words& getWords() const { return _words; }
 			std::string getPhoneticString() const;
 
 			ComparisonScore compare(const FrenchSentence& s) const;
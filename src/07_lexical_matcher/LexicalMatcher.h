@@ -5,10 +5,15 @@
 #include "FrenchSentence.h"
 
 #include <boost/foreach.hpp>
+#include <boost/optional.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <map>
+#include <queue>
+#include <set>
 #include <vector>
 
 namespace synthese
@@ -54,13 +59,110 @@ namespace synthese
 				}
 			};
 
+		private:
+			//////////////////////////////////////////////////////////////////////////
+			/// @name Candidates index
+			//////////////////////////////////////////////////////////////////////////
+			/// The words of the entries are indexed by their phonetic trigrams
+			/// (padded by two word boundaries at each side) and by their first
+			/// letters. The number of trigrams of a searched word missing in a word
+			/// of an entry gives a lower bound of the Levenshtein distance between
+			/// the two words (each edit destroys at most 3 trigrams), as does the
+			/// difference of their lengths. This gives an upper bound of the score
+			/// of the entry.
+			///
+			/// The bonus given to the entries beginning with the searched key is
+			/// possible only if the first word of the entry begins with the first
+			/// phoneme of the key.
+			///
+			/// bestMatches scores the entries by decreasing upper bound, and stops
+			/// as soon as the bound is lower than the score of the last kept entry :
+			/// the result is the same as scoring all the entries.
+			//@{
+				typedef const typename Map::value_type* Entry;
+				typedef std::pair<Entry, std::size_t> EntryWord;	//!< entry and rank of the word in the entry
+				typedef std::set<EntryWord> EntryWords;	//!< sorted to be removed by lookup
+				typedef std::size_t NGram;
+				typedef std::map<NGram, EntryWords> NGramsIndex;
+				typedef std::map<std::string, EntryWords> PrefixesIndex;
+
+				static const std::size_t PREFIX_SIZE = 3;
+				static const NGram WORD_BOUNDARY = 31;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Searched words found in the words of an entry.
+				/// Each vector is indexed by searched word rank * entry words number +
+				/// entry word rank.
+				struct Candidate
+				{
+					std::vector<std::size_t> nGrams;	//!< number of trigrams found
+					std::vector<char> firstNGram;	//!< the first trigram is found
+					std::vector<char> prefix;	//!< the first letters are found
+				};
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Searched word.
+				struct SearchedWord
+				{
+					std::set<NGram> nGrams;
+					NGram firstNGram;
+					std::size_t phoneticSize;
+					boost::optional<std::string> prefix;
+					double minScore;	//!< score given to the entries beginning with the word
+				};
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Maximal score of an entry.
+				struct MaxScore
+				{
+					double score;	//!< with the bonus or the malus of match of the beginning
+					double phoneticScore;
+					Entry entry;
+
+					bool operator<(const MaxScore& other) const { return score > other.score; }
+				};
+			//@}
+
 			Map _map;
+			NGramsIndex _nGrams;
+			PrefixesIndex _prefixes;
+
+			static std::set<NGram> _GetNGrams(const FrenchPhoneticString& word);
+			static double _GetMaxScore(
+				const std::vector<SearchedWord>& words,
+				Entry entry,
+				const Candidate* candidate
+			);
+			static Candidate& _GetCandidate(
+				std::map<Entry, Candidate>& candidates,
+				Entry entry,
+				std::size_t searchedWordsNumber
+			);
+
+			void _index(Entry entry);
+			void _unindex(Entry entry);
+
+			bool _score(
+				const typename Map::value_type& value,
+				const FrenchSentence& key,
+				double minScore,
+				MatchHit& hit
+			) const;
+
+			boost::optional<MatchResult> _indexedBestMatches(
+				const FrenchSentence& key,
+				size_t nbMatches,
+				double minScore
+			) const;
 
 		 public:
 
 			LexicalMatcher() {}
+			LexicalMatcher(const LexicalMatcher& other);
 			~LexicalMatcher() {}
 
+			LexicalMatcher& operator=(const LexicalMatcher& other);
+
 			//! @name Getters/Setters
 			//@{
 				const Map& entries () const;
@@ -75,12 +177,27 @@ namespace synthese
 					const std::string& fuzzyKey
 				) const;
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Best entries matching a key.
+				/// @param fuzzyKey the searched key
+				/// @param nbMatches maximal number of results (0 = unlimited)
+				/// @param minScore minimal phonetic score of the results
+				/// @return the entries sorted by descending score
+				/// If nbMatches is defined, only the entries which can reach the
+				/// best scores according to the index are scored.
 				MatchResult	bestMatches(
 					const std::string& fuzzyKey,
 					size_t nbMatches,
 					double minScore = 0
 				) const;
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Scores all the entries.
+				/// @param fuzzyKey the searched key
+				/// @param minScore minimal phonetic score of the results
+				/// @param maxNbValues stops after the maxNbValues first entries reaching
+				/// the minimal score, in the order of the keys (0 = unlimited)
+				/// @return the entries sorted by descending score
 				MatchResult	match(
 					const std::string& fuzzyKey,
 					double minScore,
@@ -103,6 +220,44 @@ namespace synthese
 	/** @} */
 
 
+		template<class T>
+		const std::size_t LexicalMatcher<T>::PREFIX_SIZE;
+
+		template<class T>
+		const typename LexicalMatcher<T>::NGram LexicalMatcher<T>::WORD_BOUNDARY;
+
+
+		template<class T>
+		LexicalMatcher<T>::LexicalMatcher(
+			const LexicalMatcher<T>& other
+		):	_map(other._map)
+		{
+			BOOST_FOREACH(const typename Map::value_type& value, _map)
+			{
+				_index(&value);
+			}
+		}
+
+
+
+		template<class T>
+		LexicalMatcher<T>& LexicalMatcher<T>::operator=(
+			const LexicalMatcher<T>& other
+		){
+			if(&other != this)
+			{
+				clear();
+				_map = other._map;
+				BOOST_FOREACH(const typename Map::value_type& value, _map)
+				{
+					_index(&value);
+				}
+			}
+			return *this;
+		}
+
+
+
 		template<class T>
 		size_t LexicalMatcher<T>::size () const
 		{
@@ -131,7 +286,20 @@ namespace synthese
 				return typename LexicalMatcher<T>::MatchResult();
 			}
 
-			MatchResult result = match(fuzzyKey, minScore, 0);
+			MatchResult result;
+			boost::optional<MatchResult> indexedResult;
+			if(nbMatches)
+			{
+				indexedResult = _indexedBestMatches(FrenchSentence(fuzzyKey), nbMatches, minScore);
+			}
+			if(indexedResult)
+			{
+				result.swap(*indexedResult);
+			}
+			else
+			{
+				result = match(fuzzyKey, minScore, 0);
+			}
 
 			if(nbMatches && result.size () > nbMatches)
 			{
@@ -158,39 +326,352 @@ namespace synthese
 			BOOST_FOREACH(const typename Map::value_type& value, _map)
 			{
 				MatchHit hit;
-				hit.score = value.first.compare(ppkey);
+				if(_score(value, ppkey, minScore, hit))
+				{
+					result.push_back(hit);
+				}
 
-				if (hit.score.phoneticScore >= minScore)
+				if (maxNbValues > 0 && result.size() == maxNbValues) break;
+			}
+
+			// Sort the result by descending score.
+			MatchHitSort hitSort;
+			std::sort (result.begin(), result.end(), hitSort);
+
+			return result;
+		}
+
+
+
+		template<class T>
+		bool LexicalMatcher<T>::_score(
+			const typename Map::value_type& value,
+			const FrenchSentence& key,
+			double minScore,
+			MatchHit& hit
+		) const {
+			hit.score = value.first.compare(key);
+
+			if (hit.score.phoneticScore < minScore)
+			{
+				return false;
+			}
+
+			if(value.first.startsWith(key))
+			{
+				hit.score.phoneticScore += ((1 - hit.score.phoneticScore) * hit.score.phoneticScore ) / 2;
+			}
+			else
+			{
+				hit.score.phoneticScore *= 0.9;
+			}
+			hit.key = value.first;
+			hit.value = value.second;
+			return true;
+		}
+
+
+
+		template<class T>
+		std::set<typename LexicalMatcher<T>::NGram> LexicalMatcher<T>::_GetNGrams(
+			const FrenchPhoneticString& word
+		){
+			std::vector<NGram> phonemes(2, WORD_BOUNDARY);
+			BOOST_FOREACH(FrenchPhoneticString::Phoneme phoneme, word.getPhonetic())
+			{
+				phonemes.push_back(static_cast<NGram>(phoneme));
+			}
+			phonemes.push_back(WORD_BOUNDARY);
+			phonemes.push_back(WORD_BOUNDARY);
+
+			std::set<NGram> result;
+			for(size_t i(0); i + 2 < phonemes.size(); ++i)
+			{
+				result.insert((phonemes[i] << 10) | (phonemes[i+1] << 5) | phonemes[i+2]);
+			}
+			return result;
+		}
+
+
+
+		template<class T>
+		double LexicalMatcher<T>::_GetMaxScore(
+			const std::vector<SearchedWord>& words,
+			Entry entry,
+			const Candidate* candidate
+		){
+			// Same formulas as FrenchSentence::compare, with the lowest possible
+			// distance between the words
+			double totalScores(0);
+			size_t entryWordsNumber(entry ? entry->first.getWords().size() : 0);
+			for(size_t j(0); j < words.size(); ++j)
+			{
+				const SearchedWord& word(words[j]);
+
+				// Entry without any trigram or prefix of the word
+				if(!candidate)
 				{
-					if(value.first.startsWith(ppkey))
+					size_t minDistance((word.nGrams.size() + 2) / 3);
+					double score(
+						minDistance >= word.phoneticSize ?
+						0 :
+						1 - static_cast<double>(minDistance) / static_cast<double>(word.phoneticSize)
+					);
+					if(!word.prefix && score < word.minScore)
 					{
-						hit.score.phoneticScore += ((1 - hit.score.phoneticScore) * hit.score.phoneticScore ) / 2;
+						score = word.minScore;
 					}
-					else
+					totalScores += score;
+					continue;
+				}
+
+				double bestScore(0);
+				for(size_t i(0); i < entryWordsNumber; ++i)
+				{
+					size_t rank(j * entryWordsNumber + i);
+					size_t entryWordSize(entry->first.getWords()[i].getPhonetic().size());
+					size_t minDistance((word.nGrams.size() - candidate->nGrams[rank] + 2) / 3);
+					size_t sizeDifference(
+						entryWordSize > word.phoneticSize ?
+						entryWordSize - word.phoneticSize :
+						word.phoneticSize - entryWordSize
+					);
+					if(sizeDifference > minDistance)
+					{
+						minDistance = sizeDifference;
+					}
+					double score(
+						minDistance >= word.phoneticSize ?
+						0 :
+						1 - static_cast<double>(minDistance) / static_cast<double>(word.phoneticSize)
+					);
+					if(score > 0 && candidate->firstNGram[rank])
 					{
-						hit.score.phoneticScore *= 0.9;
+						score += (1 - score) * score;
 					}
-					hit.key = value.first;
-					hit.value = value.second;
+					if(	(!word.prefix || candidate->prefix[rank]) &&
+						score < word.minScore
+					){
+						score = word.minScore;
+					}
+					if(score > bestScore)
+					{
+						bestScore = score;
+					}
+				}
+				totalScores += bestScore;
+			}
+			return totalScores / words.size();
+		}
+
+
+
+		template<class T>
+		typename LexicalMatcher<T>::Candidate& LexicalMatcher<T>::_GetCandidate(
+			std::map<Entry, Candidate>& candidates,
+			Entry entry,
+			std::size_t searchedWordsNumber
+		){
+			Candidate& candidate(candidates[entry]);
+			if(candidate.nGrams.empty())
+			{
+				size_t size(searchedWordsNumber * entry->first.getWords().size());
+				candidate.nGrams.resize(size, 0);
+				candidate.firstNGram.resize(size, false);
+				candidate.prefix.resize(size, false);
+			}
+			return candidate;
+		}
+
+
+
+		template<class T>
+		boost::optional<typename LexicalMatcher<T>::MatchResult> LexicalMatcher<T>::_indexedBestMatches(
+			const FrenchSentence& key,
+			size_t nbMatches,
+			double minScore
+		) const {
+			if(key.getWords().empty())
+			{
+				return boost::optional<MatchResult>();
+			}
+
+			// Searched words
+			std::vector<SearchedWord> words;
+			BOOST_FOREACH(const FrenchPhoneticString& phoneticWord, key.getWords())
+			{
+				SearchedWord word;
+				word.nGrams = _GetNGrams(phoneticWord);
+				word.firstNGram = (WORD_BOUNDARY << 10) | (WORD_BOUNDARY << 5) | static_cast<NGram>(phoneticWord.getPhonetic().front());
+				word.phoneticSize = phoneticWord.getPhonetic().size();
+				const std::string& source(phoneticWord.getPlainLowerSource());
+				if(source.size() >= PREFIX_SIZE)
+				{
+					word.prefix = source.substr(0, PREFIX_SIZE);
+				}
+				word.minScore = std::min(0.9, 0.1 * source.size());
+				words.push_back(word);
+			}
+
+			// Searched words found in the words of each entry
+			typedef std::map<Entry, Candidate> Candidates;
+			Candidates candidates;
+			for(size_t j(0); j < words.size(); ++j)
+			{
+				BOOST_FOREACH(NGram nGram, words[j].nGrams)
+				{
+					typename NGramsIndex::const_iterator it(_nGrams.find(nGram));
+					if(it == _nGrams.end())
+					{
+						continue;
+					}
+					bool firstNGram(nGram == words[j].firstNGram);
+					BOOST_FOREACH(const EntryWord& entryWord, it->second)
+					{
+						Candidate& candidate(_GetCandidate(candidates, entryWord.first, words.size()));
+						size_t rank(j * entryWord.first->first.getWords().size() + entryWord.second);
+						++candidate.nGrams[rank];
+						if(firstNGram)
+						{
+							candidate.firstNGram[rank] = true;
+						}
+				}	}
+				if(words[j].prefix)
+				{
+					typename PrefixesIndex::const_iterator it(_prefixes.find(*words[j].prefix));
+					if(it == _prefixes.end())
+					{
+						continue;
+					}
+					BOOST_FOREACH(const EntryWord& entryWord, it->second)
+					{
+						Candidate& candidate(_GetCandidate(candidates, entryWord.first, words.size()));
+						candidate.prefix[j * entryWord.first->first.getWords().size() + entryWord.second] = true;
+			}	}	}
+
+			// Scoring by descending maximal score
+			std::vector<MaxScore> maxScores;
+			BOOST_FOREACH(const typename Candidates::value_type& it, candidates)
+			{
+				MaxScore maxScore;
+				maxScore.entry = it.first;
+				maxScore.phoneticScore = _GetMaxScore(words, it.first, &it.second);
+				maxScore.score =
+					(!it.second.firstNGram.empty() && it.second.firstNGram[0]) ?
+					maxScore.phoneticScore + ((1 - maxScore.phoneticScore) * maxScore.phoneticScore) / 2 :
+					maxScore.phoneticScore * 0.9
+				;
+				maxScores.push_back(maxScore);
+			}
+			std::sort(maxScores.begin(), maxScores.end());
+
+			// (a small margin protects against the rounding errors)
+			MatchResult result;
+			std::priority_queue<double, std::vector<double>, std::greater<double> > bestScores;
+			BOOST_FOREACH(const MaxScore& maxScore, maxScores)
+			{
+				if(	bestScores.size() >= nbMatches &&
+					maxScore.score + 1e-9 < bestScores.top()
+				){
+					break;
+				}
+				if(maxScore.phoneticScore + 1e-9 < minScore)
+				{
+					continue;
+				}
+
+				MatchHit hit;
+				if(_score(*maxScore.entry, key, minScore, hit))
+				{
 					result.push_back(hit);
+					bestScores.push(hit.score.phoneticScore);
+					if(bestScores.size() > nbMatches)
+					{
+						bestScores.pop();
+					}
 				}
+			}
 
-				if (maxNbValues > 0 && result.size() == maxNbValues) break;
+			// The entries without any trigram in common may reach the best scores
+			double otherEntriesMaxScore(_GetMaxScore(words, NULL, NULL));
+			if(	otherEntriesMaxScore + 1e-9 >= minScore &&
+				(	bestScores.size() < nbMatches ||
+					otherEntriesMaxScore * 0.9 + 1e-9 >= bestScores.top()
+			)	){
+				return boost::optional<MatchResult>();
 			}
 
-			// Sort the result by descending score.
 			MatchHitSort hitSort;
-			std::sort (result.begin(), result.end(), hitSort);
-
+			std::sort(result.begin(), result.end(), hitSort);
 			return result;
 		}
 
 
 
+		template<class T>
+		void LexicalMatcher<T>::_index(
+			Entry entry
+		){
+			const FrenchSentence::Words& words(entry->first.getWords());
+			for(size_t i(0); i < words.size(); ++i)
+			{
+				BOOST_FOREACH(NGram nGram, _GetNGrams(words[i]))
+				{
+					_nGrams[nGram].insert(EntryWord(entry, i));
+				}
+				if(words[i].getPlainLowerSource().size() >= PREFIX_SIZE)
+				{
+					_prefixes[words[i].getPlainLowerSource().substr(0, PREFIX_SIZE)].insert(EntryWord(entry, i));
+				}
+			}
+		}
+
+
+
+		template<class T>
+		void LexicalMatcher<T>::_unindex(
+			Entry entry
+		){
+			const FrenchSentence::Words& words(entry->first.getWords());
+			for(size_t i(0); i < words.size(); ++i)
+			{
+				BOOST_FOREACH(NGram nGram, _GetNGrams(words[i]))
+				{
+					typename NGramsIndex::iterator it(_nGrams.find(nGram));
+					if(it == _nGrams.end())
+					{
+						continue;
+					}
+					it->second.erase(EntryWord(entry, i));
+					if(it->second.empty())
+					{
+						_nGrams.erase(it);
+					}
+				}
+				if(words[i].getPlainLowerSource().size() >= PREFIX_SIZE)
+				{
+					typename PrefixesIndex::iterator it(_prefixes.find(words[i].getPlainLowerSource().substr(0, PREFIX_SIZE)));
+					if(it == _prefixes.end())
+					{
+						continue;
+					}
+					it->second.erase(EntryWord(entry, i));
+					if(it->second.empty())
+					{
+						_prefixes.erase(it);
+					}
+				}
+			}
+		}
+
+
+
 		template<class T>
 		void LexicalMatcher<T>::clear ()
 		{
 			_map.clear ();
+			_nGrams.clear();
+			_prefixes.clear();
 		}
 
 
@@ -199,7 +680,13 @@ namespace synthese
 		void LexicalMatcher<T>::add (const std::string& key, T ptr)
 		{
 			if (key.empty()) return;
-			_map.insert(std::make_pair(FrenchSentence(key), ptr));
+			std::pair<typename Map::iterator, bool> result(
+				_map.insert(std::make_pair(FrenchSentence(key), ptr))
+			);
+			if(result.second)
+			{
+				_index(&*result.first);
+			}
 		}
 
 
@@ -207,7 +694,13 @@ namespace synthese
 		template<class T>
 		void LexicalMatcher<T>::remove (const std::string& key)
 		{
-			_map.erase(FrenchSentence(key));
+			typename Map::iterator it(_map.find(FrenchSentence(key)));
+			if(it == _map.end())
+			{
+				return;
+			}
+			_unindex(&*it);
+			_map.erase(it);
 		}
 
 
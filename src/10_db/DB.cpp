@@ -33,6 +33,7 @@
 #include "Factory.h"
 #include "InterSYNTHESEModule.hpp"
 #include "DBTableSync.hpp"
+#include "DBTablesLoader.hpp"
 #include "DBTransaction.hpp"
 #include "Log.h"
 #include "ObjectBase.hpp"
@@ -58,7 +59,7 @@ namespace synthese
 	namespace db
 	{
 		DB::ConnectionInfo::ConnectionInfo(const string& connectionString) :
-			port(0), debug(false), triggerCheck(true), noTrigger(false)
+			port(0), debug(false), triggerCheck(true), noTrigger(false), loadThreads(0)
 		{
 			string::const_iterator it = connectionString.begin(),
 				end = connectionString.end();
@@ -107,6 +108,7 @@ namespace synthese
 				else if (param == "debug") { this->debug = boost::lexical_cast<bool>(value); }
 				else if (param == "triggerCheck") { this->triggerCheck = boost::lexical_cast<bool>(value); }
 				else if (param == "noTrigger") { this->noTrigger = boost::lexical_cast<bool>(value); }
+				else if (param == "loadThreads") { this->loadThreads = boost::lexical_cast<size_t>(value); }
 				else
 				{
 					throw InvalidConnectionStringException("Unknown parameter " + param);
@@ -161,6 +163,7 @@ namespace synthese
 		// The default instance coordinates system is Lambert zone II.
 		// It can be changed using a parameter.
 		const CoordinatesSystem::SRID DB::_DEFAULT_INSTANCE_COORD_SYSTEM_SRID(27572);
+		DB::ModificationCallbacks DB::_modificationCallbacks;
 
 		DB::DB() :
 			_schemaUpdated(false),
@@ -260,22 +263,10 @@ namespace synthese
 				tableSync->initAutoIncrement();
 			}
 
-			// Call the first sync step on all synchronizers.
-			BOOST_FOREACH(const boost::shared_ptr<DBTableSync> tableSync, tableSyncs)
-			{
-			    Log::GetInstance().info("Loading table " + tableSync->getFactoryKey() +"...");
-			    try
-			    {
-					tableSync->firstSync(this);
-			    }
-			    catch (std::exception& e)
-			    {
-					Log::GetInstance().error("Unattended error during first sync of " + tableSync->getFactoryKey() +
-							  ". In-memory data might be inconsistent.", e);
-					if (_connInfo->debug)
-						throw;
-			    }
-			}
+			// Call the first sync step on all synchronizers, concurrently if allowed
+			// by their dependencies.
+			DBTablesLoader loader(*this, tableSyncs, _connInfo->loadThreads, _connInfo->debug);
+			loader.run();
 
 #ifdef DO_VERIFY_TRIGGER_EVENTS
 			_recordedEvents.clear();
@@ -407,7 +398,13 @@ namespace synthese
 
 			if (_schemaUpdated == false) return;
 
-			recursive_mutex::scoped_lock lock(_tableSynchronizersMutex);
+			// The loader threads act on behalf of the thread running DB::init,
+			// which already holds the lock
+			recursive_mutex::scoped_lock lock(_tableSynchronizersMutex, boost::defer_lock);
+			if(!DBTablesLoader::IsLoaderThread())
+			{
+				lock.lock();
+			}
 			const DBModule::TablesByNameMap& tm(DBModule::GetTablesByName());
 
 			Log::GetInstance().trace(
@@ -438,6 +435,19 @@ namespace synthese
 
 				tableSync->rowsRemoved(this, rowIds);
 			}
+
+			BOOST_FOREACH(ModificationCallback callback, _modificationCallbacks)
+			{
+				callback(modifEvent);
+			}
+		}
+
+
+
+		void DB::AddModificationCallback(
+			ModificationCallback callback
+		){
+			_modificationCallbacks.push_back(callback);
 		}
 
 
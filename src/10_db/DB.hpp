@@ -95,6 +95,7 @@ namespace synthese
 				bool debug;
 				bool triggerCheck;
 				bool noTrigger;
+				std::size_t loadThreads;	//!< number of tables loaded concurrently at startup (0 = number of processors)
 
 				ConnectionInfo(const std::string& connectionString);
 			};
@@ -132,6 +133,15 @@ namespace synthese
 
 			static const CoordinatesSystem::SRID _STORAGE_COORD_SYSTEM_SRID;
 			static const CoordinatesSystem::SRID _DEFAULT_INSTANCE_COORD_SYSTEM_SRID;
+
+		public:
+			/// Function called after the dispatch of a modification to the table syncs
+			typedef void (*ModificationCallback)(const DBModifEvent& modifEvent);
+
+		private:
+			typedef std::vector<ModificationCallback> ModificationCallbacks;
+			static ModificationCallbacks _modificationCallbacks;
+
 #ifdef DO_VERIFY_TRIGGER_EVENTS
 			boost::unordered_set<DBModifEvent> _recordedEvents;
 #endif
@@ -174,6 +184,16 @@ namespace synthese
 			);
 
 			void addDBModifEvent(const DBModifEvent& modifEvent, boost::optional<DBTransaction&> transaction);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Registers a function to call after each modification of a loaded
+			/// table, once the objects are updated.
+			/// Must be called at the modules initialization.
+			/// @param callback the function to call
+			static void AddModificationCallback(ModificationCallback callback);
+
 #ifdef DO_VERIFY_TRIGGER_EVENTS
 			void checkModificationEvents();
 #endif
@@ -303,6 +303,52 @@ namespace synthese
 
 
 
+		optional<RegistryKeyType> DBInterSYNTHESE::getReplacedObject(
+			const string& parameter
+		) const	{
+			// rstmt:table:id:0:size:value:...
+			const string prefix(TYPE_REPLACE_STATEMENT + FIELD_SEPARATOR);
+			if(parameter.compare(0, prefix.size(), prefix))
+			{
+				return optional<RegistryKeyType>();
+			}
+
+			// Table number
+			size_t i(parameter.find(FIELD_SEPARATOR[0], prefix.size()));
+			if(i == string::npos)
+			{
+				return optional<RegistryKeyType>();
+			}
+			++i;
+
+			// The first field must be the not null id
+			const string idPrefix(TABLE_COL_ID + FIELD_SEPARATOR + "0" + FIELD_SEPARATOR);
+			if(parameter.compare(i, idPrefix.size(), idPrefix))
+			{
+				return optional<RegistryKeyType>();
+			}
+			i += idPrefix.size();
+
+			// Size and value
+			size_t l(i);
+			i = parameter.find(FIELD_SEPARATOR[0], i);
+			if(i == string::npos)
+			{
+				return optional<RegistryKeyType>();
+			}
+			try
+			{
+				size_t dataSize(lexical_cast<size_t>(parameter.substr(l, i-l)));
+				return lexical_cast<RegistryKeyType>(parameter.substr(i+1, dataSize));
+			}
+			catch(bad_lexical_cast&)
+			{
+				return optional<RegistryKeyType>();
+			}
+		}
+
+
+
 		boost::shared_ptr<DBTableSync> DBInterSYNTHESE::_getTableSync( const std::string& perimeter )
 		{
 			// Detection of the table by id
@@ -97,6 +97,12 @@ namespace synthese
 				const std::string& perimeter
 			) const;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// A replace statement replaces the row identified by its first field.
+			virtual boost::optional<util::RegistryKeyType> getReplacedObject(
+				const std::string& parameter
+			) const;
+
 			class RequestEnqueue:
 				public boost::static_visitor<bool>
 			{
@@ -71,6 +71,25 @@ namespace synthese
 
 
 
+		boost::optional<DBTableSync::LoadDependencies> DBTableSync::getLoadDependencies() const
+		{
+			return boost::optional<LoadDependencies>();
+		}
+
+
+
+		DBTableSync::LoadDependencies DBTableSync::GetBaseLoadDependencies()
+		{
+			LoadDependencies result;
+			result.push_back("1");
+			result.push_back("20");
+			result.push_back("30");
+			result.push_back("31");
+			return result;
+		}
+
+
+
 
 		DBTableSync::Index::Index(
 			const char* first,
@@ -34,6 +34,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <boost/optional.hpp>
 
 namespace synthese
 {
@@ -248,6 +249,36 @@ namespace synthese
 
 
 
+				typedef std::vector<std::string> LoadDependencies;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Tables to load before the table at the server startup.
+				/// Each item is the beginning of the factory keys of the tables to wait
+				/// for : "35.40" designates the connection places and the DRT areas, "32"
+				/// designates all the tables of the geography module.
+				/// The default implementation returns nothing : the table is then loaded
+				/// after all the tables which precede it in the factory keys order.
+				/// A table declaring its dependencies can be loaded concurrently with the
+				/// other tables : its load must not read the objects of any table but its
+				/// dependencies, and its objects must not be read by the load of the
+				/// tables which precede it.
+				/// @return the dependencies of the table, undefined if the table must be
+				/// loaded after all the tables which precede it
+				virtual boost::optional<LoadDependencies> getLoadDependencies() const;
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Dependencies on all the tables of the base modules, whose keys begin
+				/// by 1 (security, logs, threads, imports, messages, inter-SYNTHESE), 20
+				/// (tree folders), 30 (fares) and 31 (reservations).
+				/// The tables of the business modules declaring their dependencies start
+				/// from this list, since the loads of the base tables can read any other
+				/// object, loading it from the database if it is not already in memory.
+				static LoadDependencies GetBaseLoadDependencies();
+
+
+
 				//////////////////////////////////////////////////////////////////////////
 				/// Tests if specified object can be deleted from the table, according to
 				/// the current user rights if a session is opened.
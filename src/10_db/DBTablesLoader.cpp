@@ -0,0 +1,317 @@
+/** DBTablesLoader class implementation.
+	@file DBTablesLoader.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "DBTablesLoader.hpp"
+
+#include "DB.hpp"
+#include "DBException.hpp"
+#include "Env.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	using namespace util;
+
+	namespace db
+	{
+		boost::thread_specific_ptr<bool> DBTablesLoader::_loaderThread;
+
+
+
+		DBTablesLoader::DBTablesLoader(
+			DB& db,
+			const TableSyncs& tableSyncs,
+			size_t threadsNumber,
+			bool stopOnError
+		):	_db(db),
+			_tableSyncs(tableSyncs),
+			_threadsNumber(
+				threadsNumber ?
+				threadsNumber :
+				max<size_t>(boost::thread::hardware_concurrency(), 1)
+			),
+			_stopOnError(stopOnError),
+			_remainingTables(0)
+		{}
+
+
+
+		DBTablesLoader::Dependencies DBTablesLoader::GetDependencies(
+			const vector<string>& keys,
+			const vector<optional<DBTableSync::LoadDependencies> >& declaredDependencies
+		){
+			Dependencies result(keys.size());
+			for(size_t rank(0); rank < keys.size(); ++rank)
+			{
+				// Default : all the preceding tables
+				if(!declaredDependencies[rank])
+				{
+					for(size_t i(0); i < rank; ++i)
+					{
+						result[rank].push_back(i);
+					}
+					continue;
+				}
+
+				// Declared dependencies
+				set<size_t> dependencies;
+				BOOST_FOREACH(const string& prefix, *declaredDependencies[rank])
+				{
+					for(size_t i(0); i < keys.size(); ++i)
+					{
+						if(	i != rank &&
+							keys[i].compare(0, prefix.size(), prefix) == 0
+						){
+							dependencies.insert(i);
+						}
+					}
+				}
+				result[rank].assign(dependencies.begin(), dependencies.end());
+			}
+			return result;
+		}
+
+
+
+		bool DBTablesLoader::IsLoaderThread()
+		{
+			return _loaderThread.get() && *_loaderThread;
+		}
+
+
+
+		void DBTablesLoader::run()
+		{
+			// Dependencies
+			vector<string> keys;
+			vector<optional<DBTableSync::LoadDependencies> > declaredDependencies;
+			BOOST_FOREACH(const TableSyncs::value_type& tableSync, _tableSyncs)
+			{
+				keys.push_back(tableSync->getFactoryKey());
+				declaredDependencies.push_back(tableSync->getLoadDependencies());
+			}
+			Dependencies dependencies(GetDependencies(keys, declaredDependencies));
+
+			// Load state initialization
+			_loads.clear();
+			_loads.resize(_tableSyncs.size());
+			_readyTables.clear();
+			_remainingTables = _tableSyncs.size();
+			_error = optional<string>();
+			for(size_t rank(0); rank < dependencies.size(); ++rank)
+			{
+				_loads[rank].waitedTables = dependencies[rank].size();
+				BOOST_FOREACH(size_t dependency, dependencies[rank])
+				{
+					_loads[dependency].followingTables.push_back(rank);
+				}
+				if(dependencies[rank].empty())
+				{
+					_readyTables.push_back(rank);
+				}
+			}
+
+			// Cycles check : each table must be reachable from the tables without dependencies
+			{
+				vector<size_t> waitedTables;
+				BOOST_FOREACH(const TableLoad& load, _loads)
+				{
+					waitedTables.push_back(load.waitedTables);
+				}
+				deque<size_t> tables(_readyTables);
+				size_t reachedTables(0);
+				while(!tables.empty())
+				{
+					size_t rank(tables.front());
+					tables.pop_front();
+					++reachedTables;
+					BOOST_FOREACH(size_t following, _loads[rank].followingTables)
+					{
+						if(--waitedTables[following] == 0)
+						{
+							tables.push_back(following);
+						}
+					}
+				}
+				if(reachedTables < _loads.size())
+				{
+					throw DBException("Cyclic load dependencies between tables");
+				}
+			}
+
+			ptime startTime(microsec_clock::local_time());
+			size_t threadsNumber(min(_threadsNumber, _tableSyncs.size()));
+			if(threadsNumber <= 1)
+			{
+				_runThread(0, false);
+			}
+			else
+			{
+				Log::GetInstance().info(
+					"Loading tables with "+ lexical_cast<string>(threadsNumber) +" threads..."
+				);
+
+				// The registries must not be created concurrently by the load of the tables
+				Env::GetOfficialEnv().createAllRegistries();
+
+				thread_group threads;
+				for(size_t i(0); i < threadsNumber; ++i)
+				{
+					threads.create_thread(
+						boost::bind(&DBTablesLoader::_runThread, this, i, true)
+					);
+				}
+				threads.join_all();
+			}
+			_logReport(microsec_clock::local_time() - startTime);
+
+			if(_error && _stopOnError)
+			{
+				throw DBException("Error during first sync of "+ *_error);
+			}
+		}
+
+
+
+		void DBTablesLoader::_runThread(
+			size_t threadRank,
+			bool ownThread
+		){
+			if(ownThread)
+			{
+				_loaderThread.reset(new bool(true));
+			}
+			string threadName("loader " + lexical_cast<string>(threadRank));
+
+			boost::mutex::scoped_lock lock(_mutex);
+			while(true)
+			{
+				while(	_readyTables.empty() &&
+						_remainingTables &&
+						!(_error && _stopOnError)
+				){
+					_condition.wait(lock);
+				}
+				if(!_remainingTables || (_error && _stopOnError))
+				{
+					break;
+				}
+
+				size_t rank(_readyTables.front());
+				_readyTables.pop_front();
+
+				lock.unlock();
+				_loadTable(rank, threadName);
+				lock.lock();
+
+				_tableLoaded(rank);
+			}
+		}
+
+
+
+		void DBTablesLoader::_loadTable(
+			size_t rank,
+			const string& threadName
+		){
+			DBTableSync& tableSync(*_tableSyncs[rank]);
+			Log::GetInstance().info("Loading table " + tableSync.getFactoryKey() +"...");
+
+			ptime startTime(microsec_clock::local_time());
+			try
+			{
+				tableSync.firstSync(&_db);
+			}
+			catch (std::exception& e)
+			{
+				Log::GetInstance().error("Unattended error during first sync of " + tableSync.getFactoryKey() +
+						  ". In-memory data might be inconsistent.", e);
+
+				boost::mutex::scoped_lock lock(_mutex);
+				if(!_error)
+				{
+					_error = tableSync.getFactoryKey() +" : "+ e.what();
+				}
+			}
+			_loads[rank].duration = microsec_clock::local_time() - startTime;
+			_loads[rank].threadName = threadName;
+		}
+
+
+
+		void DBTablesLoader::_tableLoaded(
+			size_t rank
+		){
+			--_remainingTables;
+			BOOST_FOREACH(size_t following, _loads[rank].followingTables)
+			{
+				if(--_loads[following].waitedTables == 0)
+				{
+					_readyTables.push_back(following);
+				}
+			}
+			_condition.notify_all();
+		}
+
+
+
+		void DBTablesLoader::_logReport(
+			const time_duration& duration
+		) const	{
+			// Slowest tables first
+			vector<pair<time_duration, size_t> > durations;
+			for(size_t rank(0); rank < _loads.size(); ++rank)
+			{
+				if(_loads[rank].threadName.empty())
+				{
+					continue; // Not loaded
+				}
+				durations.push_back(make_pair(_loads[rank].duration, rank));
+			}
+			sort(durations.begin(), durations.end());
+			reverse(durations.begin(), durations.end());
+
+			stringstream report;
+			report << "Tables loaded in " << duration.total_milliseconds() << " ms :";
+			for(vector<pair<time_duration, size_t> >::const_iterator it(durations.begin()); it != durations.end(); ++it)
+			{
+				report <<
+					endl << "  " << _tableSyncs[it->second]->getFactoryKey() <<
+					" : " << it->first.total_milliseconds() << " ms" <<
+					" (" << _loads[it->second].threadName << ")"
+				;
+			}
+			Log::GetInstance().info(report.str());
+		}
+}	}
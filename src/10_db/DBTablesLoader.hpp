@@ -0,0 +1,145 @@
+/** DBTablesLoader class header.
+	@file DBTablesLoader.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_db_DBTablesLoader_hpp__
+#define SYNTHESE_db_DBTablesLoader_hpp__
+
+#include "DBTableSync.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/date_time/posix_time/posix_time_duration.hpp>
+
+namespace synthese
+{
+	namespace db
+	{
+		class DB;
+
+		//////////////////////////////////////////////////////////////////////////
+		/// First synchronization of the tables at the server startup.
+		///	@ingroup m10
+		//////////////////////////////////////////////////////////////////////////
+		/// The tables are loaded by a pool of threads, each table being loaded
+		/// as soon as the tables it depends on are loaded (see
+		/// DBTableSync::getLoadDependencies). With a single thread, the tables are
+		/// loaded in the factory keys order by the calling thread.
+		///
+		/// The duration of the load of each table is logged at the end.
+		class DBTablesLoader
+		{
+		public:
+			typedef std::vector<boost::shared_ptr<DBTableSync> > TableSyncs;
+			typedef std::vector<std::vector<std::size_t> > Dependencies;
+
+		private:
+			//////////////////////////////////////////////////////////////////////////
+			/// Load of a table.
+			struct TableLoad
+			{
+				std::size_t waitedTables;	//!< number of dependencies not loaded yet
+				std::vector<std::size_t> followingTables;	//!< tables depending on the table
+				boost::posix_time::time_duration duration;
+				std::string threadName;
+			};
+
+			//! @name Parameters
+			//@{
+				DB& _db;
+				const TableSyncs& _tableSyncs;
+				const std::size_t _threadsNumber;
+				const bool _stopOnError;
+			//@}
+
+			static boost::thread_specific_ptr<bool> _loaderThread;
+
+			//! @name Load state
+			//@{
+				std::vector<TableLoad> _loads;
+				std::deque<std::size_t> _readyTables;
+				std::size_t _remainingTables;
+				boost::optional<std::string> _error;
+				boost::mutex _mutex;
+				boost::condition_variable _condition;
+			//@}
+
+			void _loadTable(std::size_t rank, const std::string& threadName);
+			void _tableLoaded(std::size_t rank);
+			void _runThread(std::size_t threadRank, bool ownThread);
+			void _logReport(const boost::posix_time::time_duration& duration) const;
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor.
+			/// @param db the database to load from
+			/// @param tableSyncs the tables to load, sorted by factory key
+			/// @param threadsNumber maximal number of tables to load concurrently
+			/// (0 = number of processors)
+			/// @param stopOnError throw an exception if the load of a table fails
+			/// (debug mode), instead of logging the error and continuing
+			DBTablesLoader(
+				DB& db,
+				const TableSyncs& tableSyncs,
+				std::size_t threadsNumber,
+				bool stopOnError
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Computes the dependencies between tables.
+			/// @param keys the factory keys of the tables, sorted
+			/// @param declaredDependencies the dependencies declared by each table
+			/// @return for each table, the ranks of the tables to load before it
+			/// Each declared dependency designates the tables whose factory key starts
+			/// with it, except the table itself. A table without declared dependencies
+			/// depends on all the preceding tables.
+			static Dependencies GetDependencies(
+				const std::vector<std::string>& keys,
+				const std::vector<boost::optional<DBTableSync::LoadDependencies> >& declaredDependencies
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Checks if the current thread is a thread of a loader pool.
+			/// The loader threads load the tables on behalf of the thread which runs
+			/// the loader, which already holds the table synchronizers lock of the
+			/// database.
+			static bool IsLoaderThread();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Loads the tables.
+			/// @throws DBException if a dependency cycle is found, or if a table
+			/// fails to load in stopOnError mode
+			void run();
+		};
+}	}
+
+#endif // SYNTHESE_db_DBTablesLoader_hpp__
@@ -71,15 +71,28 @@ namespace synthese
 
 
 
+		void DBTransaction::addCommitCallback(const CommitCallback& callback)
+		{
+			_commitCallbacks.push_back(callback);
+		}
+
+
+
 		void DBTransaction::run(
 		){
-			if(_queries.empty())
+			if(!_queries.empty())
 			{
-				return;
+				DBModule::GetDB()->execTransaction(*this);
+				_queries.clear();
+				_modifiedRows.clear();
+			}
+
+			CommitCallbacks commitCallbacks;
+			commitCallbacks.swap(_commitCallbacks);
+			BOOST_FOREACH(const CommitCallback& callback, commitCallbacks)
+			{
+				callback();
 			}
-			DBModule::GetDB()->execTransaction(*this);
-			_queries.clear();
-			_modifiedRows.clear();
 		}
 
 
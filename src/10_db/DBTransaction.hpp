@@ -26,6 +26,7 @@
 #include "DB.hpp"
 #include "DBRecord.hpp"
 
+#include <boost/function.hpp>
 #include <boost/variant.hpp>
 #include <vector>
 #include <string>
@@ -51,11 +52,14 @@ namespace synthese
 
 			typedef std::vector<DB::DBModifEvent> DBModifEvents;
 			typedef std::set<std::pair<std::string, util::RegistryKeyType> > ModifiedRows;
+			typedef boost::function<void ()> CommitCallback;
+			typedef std::vector<CommitCallback> CommitCallbacks;
 
 		private:
 			Queries _queries;
 			DBModifEvents _modifEvents;
 			ModifiedRows _modifiedRows;
+			CommitCallbacks _commitCallbacks;
 			const bool _withInterSYNTHESESync;
 
 		public:
@@ -66,6 +70,12 @@ namespace synthese
 			void addReplaceStmt(const DBRecord& record);
 			void addDeleteStmt(util::RegistryKeyType id);
 			void addDBModifEvent(const DB::DBModifEvent& modifEvent);
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Adds a function to call after the commit of the transaction.
+			/// The functions are not called if the transaction fails or is not run.
+			void addCommitCallback(const CommitCallback& callback);
+
 			const Queries& getQueries() const;
 			const DBModifEvents& getDBModifEvents() const;
 			const ModifiedRows& getUpdatedRows() const { return _modifiedRows; }
@@ -111,6 +111,12 @@ namespace synthese
 			/// @date 2011
 			virtual std::string getOutputMimeType() const;
 
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The result depends on the parameters only.
+			virtual void recordReadTables() const {}
+
 			virtual server::FunctionAPI getAPI() const;
 		};
 }	}
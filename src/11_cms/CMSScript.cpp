@@ -105,6 +105,7 @@ namespace synthese
 					boost::shared_ptr<WebpageContentNode>(
 						new ConstantExpression(_code)
 				)	);
+				_compile();
 			}
 			else
 			{
@@ -536,6 +537,195 @@ namespace synthese
 				)	);
 				currentText.clear();
 			}
+
+			_compile();
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Builds the program from the nodes.
+		void CMSScript::_compile()
+		{
+			_program.clear();
+			_labels.clear();
+
+			BOOST_FOREACH(const boost::shared_ptr<WebpageContentNode>& node, _nodes)
+			{
+				// Static text
+				if(dynamic_cast<ConstantExpression*>(node.get()))
+				{
+					const string& value(static_cast<ConstantExpression*>(node.get())->getValue());
+					if(value.empty())
+					{
+						continue;
+					}
+
+					// Concatenation to the previous text if no label is between them
+					if(	!_program.empty() &&
+						_program.back().type == Instruction::TEXT &&
+						(_labels.empty() || _labels.back().second < _program.size())
+					){
+						_program.back().text += value;
+					}
+					else
+					{
+						Instruction instruction;
+						instruction.type = Instruction::TEXT;
+						instruction.text = value;
+						instruction.node = NULL;
+						_program.push_back(instruction);
+					}
+					continue;
+				}
+
+				// Label
+				if(dynamic_cast<LabelNode*>(node.get()))
+				{
+					_labels.push_back(
+						make_pair(
+							static_cast<LabelNode*>(node.get())->getLabel(),
+							_program.size()
+					)	);
+					continue;
+				}
+
+				Instruction instruction;
+				instruction.type = dynamic_cast<GotoNode*>(node.get()) ? Instruction::GOTO : Instruction::NODE;
+				instruction.node = node.get();
+				_program.push_back(instruction);
+			}
+
+			// Resolution of the jumps to constant labels
+			for(size_t position(0); position < _program.size(); ++position)
+			{
+				Instruction& instruction(_program[position]);
+				if(instruction.type != Instruction::GOTO)
+				{
+					continue;
+				}
+				optional<string> label(
+					static_cast<const GotoNode*>(instruction.node)->getDirection().getConstantText()
+				);
+				if(!label)
+				{
+					continue;
+				}
+				optional<size_t> labelPosition;
+				if(!label->empty())
+				{
+					labelPosition = _getLabelPosition(*label, position);
+				}
+				instruction.target = labelPosition ? *labelPosition : position + 1;
+			}
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Searches a label as the tree interpreter does : first after the goto,
+		/// then from the beginning.
+		/// @param label the label to search
+		/// @param gotoPosition position of the goto in the program
+		/// @return the position of the instruction following the label, nothing
+		/// if the label does not exist
+		optional<size_t> CMSScript::_getLabelPosition(
+			const string& label,
+			size_t gotoPosition
+		) const	{
+			BOOST_FOREACH(const Labels::value_type& it, _labels)
+			{
+				if(it.second > gotoPosition && it.first == label)
+				{
+					return it.second;
+				}
+			}
+			BOOST_FOREACH(const Labels::value_type& it, _labels)
+			{
+				if(it.second <= gotoPosition && it.first == label)
+				{
+					return it.second;
+				}
+			}
+			return optional<size_t>();
+		}
+
+
+
+		optional<string> CMSScript::getConstantText() const
+		{
+			boost::shared_lock<shared_recursive_mutex> lock(*_sharedMutex);
+			if(!_labels.empty())
+			{
+				return optional<string>();
+			}
+			if(_program.empty())
+			{
+				return string();
+			}
+			if(	_program.size() == 1 &&
+				_program.front().type == Instruction::TEXT
+			){
+				return _program.front().text;
+			}
+			return optional<string>();
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Runs the program on a stream.
+		/// @param stream stream to write on
+		/// @param request current request
+		void CMSScript::display(
+			std::ostream& stream,
+			const server::Request& request,
+			const util::ParametersMap& additionalParametersMap,
+			const Webpage& page,
+			util::ParametersMap& variables
+		) const	{
+			boost::shared_lock<shared_recursive_mutex> lock(*_sharedMutex);
+
+			size_t position(0);
+			while(position < _program.size())
+			{
+				const Instruction& instruction(_program[position]);
+				switch(instruction.type)
+				{
+				case Instruction::TEXT:
+					stream << instruction.text;
+					++position;
+					break;
+
+				case Instruction::NODE:
+					instruction.node->display(stream, request, additionalParametersMap, page, variables);
+					++position;
+					break;
+
+				case Instruction::GOTO:
+					if(instruction.target)
+					{
+						position = *instruction.target;
+					}
+					else
+					{
+						string label(
+							instruction.node->eval(
+								request,
+								additionalParametersMap,
+								page,
+								variables
+						)	);
+						optional<size_t> labelPosition;
+						if(!label.empty())
+						{
+							labelPosition = _getLabelPosition(label, position);
+						}
+						position = labelPosition ? *labelPosition : position + 1;
+					}
+					break;
+				}
+			}
 		}
 
 
@@ -547,7 +737,7 @@ namespace synthese
 		/// @author Hugues Romain
 		/// @date 2010
 		/// @since 3.1.16
-		void CMSScript::display(
+		void CMSScript::interpret(
 			std::ostream& stream,
 			const server::Request& request,
 			const util::ParametersMap& additionalParametersMap,
@@ -28,6 +28,7 @@
 #include <set>
 #include <string>
 #include <vector>
+#include <boost/optional.hpp>
 
 namespace synthese
 {
@@ -51,6 +52,17 @@ namespace synthese
 
 		/** CMSScript class.
 			@ingroup m11
+
+			The code is parsed into a tree of nodes, which is then compiled into a
+			flat program :
+			<ul>
+				<li>the consecutive static texts (including the expressions folded
+				at the parsing) are concatenated into a single instruction</li>
+				<li>the labels are removed from the program and the jumps to a
+				constant label are resolved once</li>
+			</ul>
+			The program is run by display. The tree interpreter is kept as
+			interpret.
 		*/
 		class CMSScript
 		{
@@ -66,8 +78,39 @@ namespace synthese
 			mutable Nodes _nodes;
 			boost::shared_ptr<util::shared_recursive_mutex> _sharedMutex;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Instruction of the compiled program.
+			struct Instruction
+			{
+				enum Type
+				{
+					TEXT,	//!< static text
+					NODE,	//!< node to display
+					GOTO	//!< jump to a label
+				};
+
+				Type type;
+				std::string text;
+				const WebpageContentNode* node;	//!< owned by _nodes
+				boost::optional<std::size_t> target;	//!< resolved jump if the label is constant
+			};
+			typedef std::vector<Instruction> Program;
+
+			/// Labels and the position of the instruction which follows each of them
+			typedef std::vector<std::pair<std::string, std::size_t> > Labels;
+
+			Program _program;
+			Labels _labels;
+
 			void _updateNodes();
 
+			void _compile();
+
+			boost::optional<std::size_t> _getLabelPosition(
+				const std::string& label,
+				std::size_t gotoPosition
+			) const;
+
 			void _parse(
 				std::string::const_iterator& it,
 				std::string::const_iterator end,
@@ -109,6 +152,26 @@ namespace synthese
 
 
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Evaluates the nodes tree without the compiled program.
+				/// Produces the same output as display, slower.
+				void interpret(
+					std::ostream& stream,
+					const server::Request& request,
+					const util::ParametersMap& additionalParametersMap,
+					const Webpage& page,
+					util::ParametersMap& variables
+				) const;
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Text produced by the script if it does not depend on the context.
+				/// @return the text, nothing if the script must be evaluated
+				boost::optional<std::string> getConstantText() const;
+
+
+
 				void display(
 					std::ostream& stream,
 					const server::Request& request,
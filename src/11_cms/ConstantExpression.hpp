@@ -52,6 +52,10 @@ namespace synthese
 				util::ParametersMap& variables
 			) const;
 
+			virtual bool isConstant() const { return true; }
+
+			const std::string& getValue() const { return _value; }
+
 			virtual void display(
 				std::ostream& stream,
 				const server::Request& request,
@@ -125,6 +125,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2011
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The result depends on the parameters and on the clock only.
+			virtual void recordReadTables() const {}
 		};
 	}
 }
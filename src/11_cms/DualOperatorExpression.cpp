@@ -208,6 +208,16 @@ namespace synthese
 
 
 
+		bool DualOperatorExpression::isConstant() const
+		{
+			return
+				_left.get() && _left->isConstant() &&
+				_right.get() && _right->isConstant()
+			;
+		}
+
+
+
 		boost::optional<DualOperatorExpression::Operator> DualOperatorExpression::ParseOperator(
 			std::string::const_iterator& it,
 			const std::string::const_iterator end
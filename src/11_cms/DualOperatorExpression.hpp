@@ -79,6 +79,10 @@ namespace synthese
 			) const;
 
 
+
+			virtual bool isConstant() const;
+
+
 			static boost::optional<Operator> ParseOperator(
 				std::string::const_iterator& it,
 				const std::string::const_iterator end
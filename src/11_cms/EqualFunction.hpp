@@ -113,6 +113,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2010
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The result depends on the parameters only.
+			virtual void recordReadTables() const {}
 		};
 	}
 }
@@ -112,6 +112,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2011
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The services called by the evaluated code record their own tables.
+			virtual void recordReadTables() const {}
 		};
 	}
 }
@@ -31,14 +31,46 @@
 #include "TripleOperatorExpression.hpp"
 #include "VariableExpression.hpp"
 #include "VariablesDebugExpression.hpp"
+#include "ParametersMap.h"
+#include "StaticFunctionRequest.h"
+#include "Webpage.h"
+#include "WebPageDisplayFunction.h"
+#include "Website.hpp"
+
+#include <boost/thread/tss.hpp>
 
 using namespace boost;
 using namespace std;
 
 namespace synthese
 {
+	using namespace server;
+	using namespace util;
+
 	namespace cms
 	{
+		namespace
+		{
+			//////////////////////////////////////////////////////////////////////////
+			/// Context given to the evaluation of the constant expressions at the
+			/// parsing, which do not read it.
+			/// It is built once per thread, the pages being parsed concurrently by
+			/// the load of the tables.
+			struct FoldContext
+			{
+				StaticFunctionRequest<WebPageDisplayFunction> request;
+				ParametersMap additionalParametersMap;
+				Website site;
+				Webpage page;
+
+				FoldContext() { page.setRoot(&site); }
+			};
+
+			boost::thread_specific_ptr<FoldContext> foldContext;
+		}
+
+
+
 		boost::shared_ptr<Expression> Expression::Parse(
 			string::const_iterator& it,
 			string::const_iterator end,
@@ -323,33 +355,36 @@ namespace synthese
 					{
 						if(singleOperator)
 						{
-							expr1.reset(
-								new SingleOperatorExpression(
-									expr,
-									*singleOperator
-							)	);
+							expr1 = _Fold(
+								boost::shared_ptr<Expression>(
+									new SingleOperatorExpression(
+										expr,
+										*singleOperator
+							)	)	);
 							singleOperator.reset();
 						}
 						else if(dualOperator && expr1.get())
 						{
-							expr1.reset(
-								new DualOperatorExpression(
-								expr1,
-								*dualOperator,
-								expr
-							)	);
+							expr1 = _Fold(
+								boost::shared_ptr<Expression>(
+									new DualOperatorExpression(
+										expr1,
+										*dualOperator,
+										expr
+							)	)	);
 						}
 						else if(tripleOperator)
 						{
 							if(expr2.get())
 							{
-								expr1.reset(
-									new TripleOperatorExpression(
-										expr1,
-										expr2,
-										expr,
-										*tripleOperator
-								)	);
+								expr1 = _Fold(
+									boost::shared_ptr<Expression>(
+										new TripleOperatorExpression(
+											expr1,
+											expr2,
+											expr,
+											*tripleOperator
+								)	)	);
 							}
 							else
 							{
@@ -376,6 +411,31 @@ namespace synthese
 
 
 
+		boost::shared_ptr<Expression> Expression::_Fold(
+			boost::shared_ptr<Expression> expr
+		){
+			if(!expr->isConstant())
+			{
+				return expr;
+			}
+
+			if(!foldContext.get())
+			{
+				foldContext.reset(new FoldContext);
+			}
+			ParametersMap variables;
+			return boost::shared_ptr<Expression>(
+				new ConstantExpression(
+					expr->eval(
+						foldContext->request,
+						foldContext->additionalParametersMap,
+						foldContext->page,
+						variables
+			)	)	);
+		}
+
+
+
 		void Expression::display(
 			std::ostream& stream,
 			const server::Request& request,
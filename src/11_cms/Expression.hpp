@@ -39,6 +39,14 @@ namespace synthese
 				boost::shared_ptr<Expression> expr
 			) const;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Replaces a constant expression by its value.
+			/// @param expr the expression to fold
+			/// @return a ConstantExpression if expr is constant, expr otherwise
+			static boost::shared_ptr<Expression> _Fold(
+				boost::shared_ptr<Expression> expr
+			);
+
 		public:
 			virtual void display(
 				std::ostream& stream,
@@ -59,6 +67,14 @@ namespace synthese
 
 
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Checks if the result of the expression depends only on the code,
+			/// and not on the request, the page or the variables.
+			/// The constant expressions are evaluated once at the parsing.
+			virtual bool isConstant() const { return false; }
+
+
+
 			static boost::shared_ptr<Expression> Parse(
 				std::string::const_iterator& it,
 				std::string::const_iterator end,
@@ -50,6 +50,10 @@ namespace synthese
 
 
 
+			const CMSScript& getDirection() const { return _direction; }
+
+
+
 			virtual void display(
 				std::ostream& stream,
 				const server::Request& request,
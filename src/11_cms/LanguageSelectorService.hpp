@@ -120,6 +120,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2011
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The languages are not read in the database.
+			virtual void recordReadTables() const {}
 		};
 	}
 }
@@ -102,6 +102,12 @@ namespace synthese
 			/// @author hromain
 			/// @date 2013
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The service reads nothing.
+			virtual void recordReadTables() const {}
 		};
 }	}
 
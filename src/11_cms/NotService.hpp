@@ -109,6 +109,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2011
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The result depends on the parameters only.
+			virtual void recordReadTables() const {}
 		};
 }	}
 
@@ -111,6 +111,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2012
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The result depends on the parameters only.
+			virtual void recordReadTables() const {}
 		};
 }	}
 
@@ -165,6 +165,7 @@ namespace synthese
 				if (function->isAuthorized(request.getSession().get()))
 				{
 					// Run of the service
+					function->recordReadTables();
 					result = function->run(stream, request);
 				}
 				else // Output error message for forbidden service
@@ -201,6 +201,29 @@ namespace synthese
 
 
 
+		bool SingleOperatorExpression::isConstant() const
+		{
+			if(!_operand.get() || !_operand->isConstant())
+			{
+				return false;
+			}
+
+			// Operators reading the context
+			switch(_operator)
+			{
+			case GLOBAL:
+			case READ_CONFIG:
+			case LENGTH:
+			case VARIABLE:
+				return false;
+
+			default:
+				return true;
+			}
+		}
+
+
+
 		boost::optional<SingleOperatorExpression::Operator> SingleOperatorExpression::ParseOperator(
 			std::string::const_iterator& it,
 			const std::string::const_iterator end
@@ -71,6 +71,10 @@ namespace synthese
 
 
 
+			virtual bool isConstant() const;
+
+
+
 			static boost::optional<Operator> ParseOperator(
 				std::string::const_iterator& it,
 				const std::string::const_iterator end
@@ -102,6 +102,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2010
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// String operation on the parameters.
+			virtual void recordReadTables() const {}
 		};
 	}
 }
@@ -87,6 +87,12 @@ namespace synthese
 			/// Gets the Mime type of the content generated by the function.
 			/// @return the Mime type of the content generated by the function
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// String operation on the parameters.
+			virtual void recordReadTables() const {}
 		};
 	}
 }
@@ -116,6 +116,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2012
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The result depends on the parameters and on the clock only.
+			virtual void recordReadTables() const {}
 		};
 }	}
 
@@ -85,6 +85,17 @@ namespace synthese
 
 
 
+		bool TripleOperatorExpression::isConstant() const
+		{
+			return
+				_expr1.get() && _expr1->isConstant() &&
+				_expr2.get() && _expr2->isConstant() &&
+				_expr3.get() && _expr3->isConstant()
+			;
+		}
+
+
+
 		boost::optional<TripleOperatorExpression::Operator> TripleOperatorExpression::ParseOperator1(
 			std::string::const_iterator& it,
 			const std::string::const_iterator end
@@ -65,6 +65,10 @@ namespace synthese
 			) const;
 
 
+
+			virtual bool isConstant() const;
+
+
 			static boost::optional<Operator> ParseOperator1(
 				std::string::const_iterator& it,
 				const std::string::const_iterator end
@@ -323,6 +323,12 @@ namespace synthese
 									   ? boost::lexical_cast<string>(_page->get<MaxAge>().total_seconds() / 60)
 									   : "" );
 					stream << t.cell("Age maximum en cache (minutes)", t.getForm().GetTextInput(WebPageUpdateAction::PARAMETER_MAX_AGE, minutesStr));
+					string serverCacheMinutesStr(
+						!_page->get<ServerCacheDuration>().is_not_a_date_time() && _page->get<ServerCacheDuration>().total_seconds()
+						? boost::lexical_cast<string>(_page->get<ServerCacheDuration>().total_seconds() / 60)
+						: ""
+					);
+					stream << t.cell("Durée en cache serveur (minutes)", t.getForm().GetTextInput(WebPageUpdateAction::PARAMETER_SERVER_CACHE_DURATION, serverCacheMinutesStr));
 					stream << t.cell(
 						"Page supérieure",
 						t.getForm().getSelectInput(
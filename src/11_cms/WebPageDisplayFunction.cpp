@@ -30,6 +30,7 @@
 #include "Env.h"
 #include "Request.h"
 #include "RequestException.h"
+#include "ResponseCache.hpp"
 #include "ServerConstants.h"
 #include "URI.hpp"
 #include "Webpage.h"
@@ -280,50 +281,54 @@ namespace synthese
 				// Page data
 				_page->toParametersMap(pm);
 
-				if(_useTemplate && _page->getTemplate())
-				{
-					DelayedEvaluationParametersMap::Fields fields;
-					BOOST_FOREACH(const ParametersMap::Map::value_type& it, pm.getMap())
-					{
-						fields.insert(
-							make_pair(
-								it.first,
-								DelayedEvaluationParametersMap::Field(it.second)
-						)	);
-					}
+				// Server cache
+				time_duration cacheDuration(_page->getServerCacheDuration());
+				if(	cacheDuration.is_not_a_date_time() ||
+					cacheDuration.total_seconds() <= 0 ||
+					request.getSession() ||
+					request.getAction()
+				){
+					_display(stream, request, pm);
+					return util::ParametersMap();
+				}
 
-					// The page content will be evaluated when it will be displayed
-					// Variables initialized by the template are available at the page
-					// evaluation
-					stringstream content;
-					fields.insert(
-						make_pair(
-							DATA_CONTENT,
-							DelayedEvaluationParametersMap::Field(_page->get<WebpageContent>().getCMSScript())
-					)	);
-					
-					ParametersMap variables;
-					DelayedEvaluationParametersMap depm(
-						fields,
-						request,
-						pm,
-						*_page,
-						variables
-					);
-					
-					// Display the template
-					_page->getTemplate()->get<WebpageContent>().getCMSScript().display(
-						stream,
-						request,
-						depm,
-						*_page,
-						variables
-					);
+				// The equivalent URL contains the host name and the normalized parameters
+				ResponseCache::Key key(FACTORY_KEY, _page->getKey(), url.str());
+				if(ResponseCache::Read(key, stream))
+				{
+					return util::ParametersMap();
 				}
-				else
+
+				ResponseCache::Generation generation(ResponseCache::GetGeneration());
+				stringstream content;
+				RegistryBase::ReadRecorder::Keys dependencies;
+				ResponseCache::Tables tables;
+				bool anyTable(false);
 				{
-					_page->display(stream, request, pm);
+					// The services called by the page record the tables they read
+					// without the registries
+					RegistryBase::ReadRecorder recorder;
+					_display(content, request, pm);
+					dependencies = recorder.getKeys();
+					tables = recorder.getTables();
+					anyTable = recorder.getAnyTable();
 				}
+
+				// The pages included by the content are not read in the registries
+				tables.insert(Webpage::CLASS_NUMBER);
+				tables.insert(Website::CLASS_NUMBER);
+
+				ResponseCache::Write(
+					key,
+					generation,
+					_page->getFullName(),
+					content.str(),
+					dependencies,
+					tables,
+					anyTable,
+					cacheDuration
+				);
+				stream << content.str();
 			}
 
 			return util::ParametersMap();
@@ -331,6 +336,59 @@ namespace synthese
 
 
 
+		void WebPageDisplayFunction::_display(
+			std::ostream& stream,
+			const Request& request,
+			const ParametersMap& pm
+		) const	{
+			if(_useTemplate && _page->getTemplate())
+			{
+				DelayedEvaluationParametersMap::Fields fields;
+				BOOST_FOREACH(const ParametersMap::Map::value_type& it, pm.getMap())
+				{
+					fields.insert(
+						make_pair(
+							it.first,
+							DelayedEvaluationParametersMap::Field(it.second)
+					)	);
+				}
+
+				// The page content will be evaluated when it will be displayed
+				// Variables initialized by the template are available at the page
+				// evaluation
+				stringstream content;
+				fields.insert(
+					make_pair(
+						DATA_CONTENT,
+						DelayedEvaluationParametersMap::Field(_page->get<WebpageContent>().getCMSScript())
+				)	);
+				
+				ParametersMap variables;
+				DelayedEvaluationParametersMap depm(
+					fields,
+					request,
+					pm,
+					*_page,
+					variables
+				);
+				
+				// Display the template
+				_page->getTemplate()->get<WebpageContent>().getCMSScript().display(
+					stream,
+					request,
+					depm,
+					*_page,
+					variables
+				);
+			}
+			else
+			{
+				_page->display(stream, request, pm);
+			}
+		}
+
+
+
 		bool WebPageDisplayFunction::isAuthorized(
 			const Session* session
 		) const {
@@ -357,6 +415,13 @@ namespace synthese
 
 
 
+		void WebPageDisplayFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
+
+
+
 		WebPageDisplayFunction::WebPageDisplayFunction():
 			_page(NULL),
 			_rawData(false),
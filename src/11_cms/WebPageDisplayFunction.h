@@ -69,6 +69,17 @@ namespace synthese
 				std::string		_equivURI;
 			//@}
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Evaluates the page, with its template if any.
+			/// @param stream stream to write on
+			/// @param request the current request
+			/// @param pm the page parameters
+			void _display(
+				std::ostream& stream,
+				const server::Request& request,
+				const util::ParametersMap& pm
+			) const;
+
 
 		public:
 			//////////////////////////////////////////////////////////////////////////
@@ -138,6 +149,12 @@ namespace synthese
 			/// @date 2010
 			virtual std::string getOutputMimeType() const;
 
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The service browses the pages tree.
+			virtual void recordReadTables() const;
+
 		
 			//////////////////////////////////////////////////////////////////////////
 			/// Return the max-age of a page
@@ -205,5 +205,12 @@ namespace synthese
 		{
 			return _displayPage.get() ? _displayPage->getMimeType() : "application/rss+xml";
 		}
+
+
+
+		void WebPageLastNewsFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
 	}
 }
@@ -129,6 +129,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2010
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The service browses the pages tree.
+			virtual void recordReadTables() const;
 		};
 	}
 }
@@ -198,6 +198,13 @@ namespace synthese
 
 
 
+		void WebPageLinkFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
+
+
+
 		WebPageLinkFunction::WebPageLinkFunction():
 			_target(NULL),
 			_useSmartURL(true)
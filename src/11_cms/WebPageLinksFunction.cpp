@@ -127,4 +127,11 @@ namespace synthese
 		{
 			return _displayPage.get() ? _displayPage->getMimeType() : "text/plain";
 		}
+
+
+
+		void WebPageLinksFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
 }	}
@@ -315,6 +315,13 @@ namespace synthese
 
 
 
+		void WebPageMenuFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
+
+
+
 		bool WebPageMenuFunction::_getMenuContentRecursive(
 			std::ostream& stream,
 			const server::Request& request /*= NULL*/,
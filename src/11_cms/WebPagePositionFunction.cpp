@@ -195,6 +195,13 @@ namespace synthese
 
 
 
+		void WebPagePositionFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
+
+
+
 		WebPagePositionFunction::WebPagePositionFunction():
 			_minDepth(1),
 			_rawData(false)
@@ -28,6 +28,7 @@
 #include "SelectQuery.hpp"
 #include "SQLSingleOperatorExpression.hpp"
 #include "Website.hpp"
+#include "WebsiteTableSync.hpp"
 
 #include <boost/foreach.hpp>
 
@@ -236,4 +237,13 @@ namespace synthese
 			}
 			return result;
 		} ;
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> WebPageTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result;
+			result.push_back(WebsiteTableSync::FACTORY_KEY);
+			return result;
+		}
 }	}
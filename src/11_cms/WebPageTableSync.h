@@ -106,6 +106,12 @@ namespace synthese
 				const boost::optional<std::string> prefix,
 				const boost::optional<std::size_t> limit,
 				const boost::optional<std::string> optionalParameter) const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The pages depend on the sites only.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
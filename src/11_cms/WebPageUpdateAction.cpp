@@ -56,6 +56,7 @@ namespace synthese
 		const string WebPageUpdateAction::PARAMETER_START_DATE = Action_PARAMETER_PREFIX + "sd";
 		const string WebPageUpdateAction::PARAMETER_END_DATE = Action_PARAMETER_PREFIX + "ed";
 		const string WebPageUpdateAction::PARAMETER_MAX_AGE = Action_PARAMETER_PREFIX + "ma";
+		const string WebPageUpdateAction::PARAMETER_SERVER_CACHE_DURATION = Action_PARAMETER_PREFIX + "scd";
 		const string WebPageUpdateAction::PARAMETER_MIME_TYPE = Action_PARAMETER_PREFIX + "mt";
 		const string WebPageUpdateAction::PARAMETER_DO_NOT_USE_TEMPLATE = Action_PARAMETER_PREFIX + "du";
 		const string WebPageUpdateAction::PARAMETER_HAS_FORUM = Action_PARAMETER_PREFIX + "fo";
@@ -257,6 +258,19 @@ namespace synthese
 				}
 			}
 
+			// Server cache duration
+			if(map.isDefined(PARAMETER_SERVER_CACHE_DURATION))
+			{
+				if(map.getDefault<string>(PARAMETER_SERVER_CACHE_DURATION).empty())
+				{
+					_serverCacheDuration = time_duration(not_a_date_time);
+				}
+				else
+				{
+					_serverCacheDuration = minutes(atoi(map.get<string>(PARAMETER_SERVER_CACHE_DURATION).c_str()));
+				}
+			}
+
 			if(map.isDefined(PARAMETER_DO_NOT_USE_TEMPLATE))
 			{
 				_doNotUseTemplate = map.getDefault<bool>(PARAMETER_DO_NOT_USE_TEMPLATE, false);
@@ -497,6 +511,10 @@ namespace synthese
 									? *_maxAge 
 									: time_duration(0,0,0,0) );
 			}
+			if(_serverCacheDuration)
+			{
+				_page->set<ServerCacheDuration>(*_serverCacheDuration);
+			}
 			if(_template)
 			{
 				_page->set<SpecificTemplate>(*_template);
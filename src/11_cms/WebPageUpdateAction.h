@@ -68,6 +68,7 @@ namespace synthese
 			static const std::string PARAMETER_RAW_EDITOR;
 			static const std::string PARAMETER_DO_NOT_EVALUATE;
 			static const std::string PARAMETER_MAX_AGE;
+			static const std::string PARAMETER_SERVER_CACHE_DURATION;
 
 		private:
 			boost::shared_ptr<Webpage> _page;
@@ -82,6 +83,7 @@ namespace synthese
 			boost::optional<boost::posix_time::ptime> _startDate;
 			boost::optional<boost::posix_time::ptime> _endDate;
 			boost::optional<boost::posix_time::time_duration> _maxAge;
+			boost::optional<boost::posix_time::time_duration> _serverCacheDuration;
 			boost::optional<util::MimeType> _mimeType;
 			boost::optional<bool> _doNotUseTemplate;
 			boost::optional<bool> _hasForum;
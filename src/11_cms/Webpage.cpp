@@ -55,6 +55,7 @@ namespace synthese
 	FIELD_DEFINITION_OF_TYPE(SmartURLDefaultParameterName, "smart_url_default_parameter_name", SQL_TEXT)
 	FIELD_DEFINITION_OF_TYPE(RawEditor, "raw_editor", SQL_BOOLEAN)
 	FIELD_DEFINITION_OF_TYPE(MaxAge, "max_age", SQL_INTEGER)
+	FIELD_DEFINITION_OF_TYPE(ServerCacheDuration, "server_cache_duration", SQL_INTEGER)
 
 	template<> const Field ComplexObjectFieldDefinition<WebpageTreeNode>::FIELDS[] = {
 		Field("site_id", SQL_INTEGER),
@@ -89,13 +90,22 @@ namespace synthese
 					FIELD_DEFAULT_CONSTRUCTOR(SmartURLPath),
 					FIELD_DEFAULT_CONSTRUCTOR(SmartURLDefaultParameterName),
 					FIELD_VALUE_CONSTRUCTOR(RawEditor, false),
-					FIELD_DEFAULT_CONSTRUCTOR(SpecificTemplate)
+					FIELD_DEFAULT_CONSTRUCTOR(SpecificTemplate),
+					FIELD_VALUE_CONSTRUCTOR(ServerCacheDuration, posix_time::not_a_date_time)
 			)	)
 		{
 		}
 
 
 
+		void Webpage::RecordTreeRead()
+		{
+			RegistryBase::RecordTableRead(Webpage::CLASS_NUMBER);
+			RegistryBase::RecordTableRead(Website::CLASS_NUMBER);
+		}
+
+
+
 		bool Webpage::mustBeDisplayed( boost::posix_time::ptime now /*= boost::posix_time::second_clock::local_time()*/ ) const
 		{
 			return
@@ -202,6 +212,13 @@ namespace synthese
 			return get<MaxAge>();
 		}
 
+
+
+		boost::posix_time::time_duration Webpage::getServerCacheDuration() const
+		{
+			return get<ServerCacheDuration>();
+		}
+
 		void Webpage::addAdditionalParameters(
 			util::ParametersMap& pm,
 			std::string prefix
@@ -73,6 +73,7 @@ namespace synthese
 		FIELD_BOOL(RawEditor)
 		FIELD_POINTER(SpecificTemplate, Webpage)
 		FIELD_MINUTES(MaxAge)
+		FIELD_MINUTES(ServerCacheDuration)
 
 		typedef boost::fusion::map<
 			FIELD(Key),
@@ -90,7 +91,8 @@ namespace synthese
 			FIELD(SmartURLPath),
 			FIELD(SmartURLDefaultParameterName),
 			FIELD(RawEditor),
-			FIELD(SpecificTemplate)
+			FIELD(SpecificTemplate),
+			FIELD(ServerCacheDuration)
 		> WebpageRecord;
 
 
@@ -145,6 +147,22 @@ namespace synthese
 
 			If the page smart path does not begin with a / character, it is automatically added. The smart path can be /. It must be unique in a website.
 			Pages without smart path are accessible only by their id.
+
+			<h3>Server cache</h3>
+
+			If a server cache duration is defined, the responses of the page are
+			stored in the server::ResponseCache for each set of parameters, and
+			removed :
+			<ul>
+				<li>when an object read in the registries or displayed by the page is
+				modified</li>
+				<li>when any object of a table read by a service called by the page is
+				added, modified or removed (a service which does not declare its tables
+				makes the response depend on all the tables, see
+				server::Function::recordReadTables)</li>
+				<li>at the end of the cache duration, which bounds the staleness caused
+				by the data modified without database event (real time data)</li>
+			</ul>
 		*/
 		class Webpage:
 			public tree::TreeNode<
@@ -182,6 +200,14 @@ namespace synthese
 
 
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Records the tables of the pages and of the sites in the current read
+				/// recorder of the registries, for the services which browse the pages
+				/// tree.
+				static void RecordTreeRead();
+
+
+
 				//////////////////////////////////////////////////////////////////////////
 				/// Gets the template applicable to the current page.
 				/// @return in decreasing priority order :
@@ -270,6 +296,14 @@ namespace synthese
 
 
 				boost::posix_time::time_duration getMaxAge() const;
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Duration of the storage of the responses in the server cache.
+				/// @return the duration, not_a_date_time if the responses must not be
+				/// stored
+				boost::posix_time::time_duration getServerCacheDuration() const;
 				
 				//////////////////////////////////////////////////////////////////////////
 				/// CMS exporter.
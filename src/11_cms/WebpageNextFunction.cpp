@@ -93,4 +93,11 @@ namespace synthese
 		{
 			return "text/plain";
 		}
+
+
+
+		void WebpageNextFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
 }	}
@@ -93,5 +93,12 @@ namespace synthese
 		{
 			return "text/plain";
 		}
+
+
+
+		void WebpagePreviousFunction::recordReadTables() const
+		{
+			Webpage::RecordTreeRead();
+		}
 	}
 }
@@ -124,4 +124,11 @@ namespace synthese
 
 			return LoadFromQuery(query, env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> WebsiteTableSync::getLoadDependencies() const
+		{
+			return LoadDependencies();
+		}
 }	}
@@ -61,6 +61,12 @@ namespace synthese
 				, bool raisingOrder = true,
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The sites do not depend on any other table.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -131,6 +131,28 @@ namespace synthese
 
 
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Allows the server to send the output while it is written by the
+			/// function (chunked transfer encoding), instead of sending it with its
+			/// length at the end of the run.
+			/// Should be allowed by the functions producing large outputs (exports).
+			/// @return true if the output can be streamed
+			virtual bool isStreamable() const { return false; }
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Records the tables whose objects the function may read without the
+			/// registries (links between objects, iterations on the registries) in
+			/// the current read recorder (see util::RegistryBase::ReadRecorder).
+			/// Used by the responses cache to know which modifications invalidate a
+			/// response including the output of the function.
+			/// The default implementation records that any table may be read. It
+			/// should be overloaded by the functions which read few tables.
+			virtual void recordReadTables() const { util::RegistryBase::RecordAnyTableRead(); }
+
+
+
 			/** Copy of the function parameters.
 				@param function
 				@author Hugues Romain
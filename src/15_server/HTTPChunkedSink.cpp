@@ -0,0 +1,125 @@
+/** HTTPChunkedSink class implementation.
+	@file HTTPChunkedSink.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "HTTPChunkedSink.hpp"
+
+#include "HTTPReply.hpp"
+
+#include <sstream>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+namespace synthese
+{
+	namespace server
+	{
+		const size_t HTTPChunkedSink::DEFAULT_CHUNK_SIZE(64 * 1024);
+
+		namespace
+		{
+			const string CRLF("\r\n");
+			const string LAST_CHUNK("0\r\n\r\n");
+		}
+
+
+
+		HTTPChunkedSink::HTTPChunkedSink(
+			HTTPReply& reply,
+			const HeadersWriter& headersWriter,
+			size_t chunkSize
+		):	_state(new _State)
+		{
+			_state->reply = &reply;
+			_state->headersWriter = headersWriter;
+			_state->chunkSize = chunkSize;
+			_state->started = false;
+		}
+
+
+
+		streamsize HTTPChunkedSink::write(
+			const char* s,
+			streamsize n
+		){
+			_state->buffer.append(s, static_cast<size_t>(n));
+			if(_state->buffer.size() >= _state->chunkSize)
+			{
+				_send(false);
+			}
+			return n;
+		}
+
+
+
+		void HTTPChunkedSink::_send(
+			bool last
+		){
+			HTTPReply& reply(*_state->reply);
+			vector<asio::const_buffer> buffers;
+
+			// Status line and headers
+			if(!_state->started)
+			{
+				_state->headersWriter(reply);
+				reply.headers.erase("Content-Length");
+				reply.headers["Transfer-Encoding"] = "chunked";
+				reply.headers["Connection"] = "close";
+				buffers = reply.headers_to_buffers(true);
+				_state->started = true;
+			}
+
+			// Chunk (the size line must live until the end of the write)
+			string chunkSize;
+			if(!_state->buffer.empty())
+			{
+				stringstream chunkSizeStream;
+				chunkSizeStream << hex << _state->buffer.size() << CRLF;
+				chunkSize = chunkSizeStream.str();
+				buffers.push_back(asio::buffer(chunkSize));
+				buffers.push_back(asio::buffer(_state->buffer));
+				buffers.push_back(asio::buffer(CRLF));
+			}
+			if(last)
+			{
+				buffers.push_back(asio::buffer(LAST_CHUNK));
+			}
+
+			reply.sender(buffers);
+			_state->buffer.clear();
+		}
+
+
+
+		bool HTTPChunkedSink::finish()
+		{
+			if(!_state->started)
+			{
+				_state->reply->content.append(_state->buffer);
+				_state->buffer.clear();
+				return false;
+			}
+
+			_send(true);
+			return true;
+		}
+}	}
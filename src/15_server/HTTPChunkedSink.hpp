@@ -0,0 +1,98 @@
+/** HTTPChunkedSink class header.
+	@file HTTPChunkedSink.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_server_HTTPChunkedSink_hpp__
+#define SYNTHESE_server_HTTPChunkedSink_hpp__
+
+#include <iosfwd>
+#include <string>
+#include <boost/function.hpp>
+#include <boost/iostreams/categories.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace synthese
+{
+	namespace server
+	{
+		struct HTTPReply;
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Boost iostreams sink sending the content of a reply by chunks while
+		/// it is written (HTTP/1.1 chunked transfer encoding).
+		///	@ingroup m15
+		//////////////////////////////////////////////////////////////////////////
+		/// The content is buffered until the chunk size is reached. At the first
+		/// chunk, the headers are completed by the headers writer and sent with
+		/// the status line. The chunks are sent by the sender of the reply.
+		///
+		/// If the whole content is shorter than a chunk, nothing is sent : finish
+		/// puts the content in the reply, which is then sent as usual with its
+		/// length.
+		///
+		/// The copies of the sink share the same state, so the sink can be pushed
+		/// in a filtering stream and finished after the stream is closed.
+		class HTTPChunkedSink
+		{
+		public:
+			typedef char char_type;
+			typedef boost::iostreams::sink_tag category;
+
+			/// Completes the headers of the reply before the first chunk.
+			typedef boost::function<void (HTTPReply&)> HeadersWriter;
+
+			static const std::size_t DEFAULT_CHUNK_SIZE;
+
+		private:
+			struct _State
+			{
+				HTTPReply* reply;
+				HeadersWriter headersWriter;
+				std::size_t chunkSize;
+				std::string buffer;
+				bool started;
+			};
+
+			boost::shared_ptr<_State> _state;
+
+			void _send(bool last);
+
+		public:
+			HTTPChunkedSink(
+				HTTPReply& reply,
+				const HeadersWriter& headersWriter,
+				std::size_t chunkSize = DEFAULT_CHUNK_SIZE
+			);
+
+			std::streamsize write(const char* s, std::streamsize n);
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Ends the reply.
+			/// @return true if the reply has been sent by chunks, false if the
+			/// content has been put in the reply because it was too short
+			bool finish();
+
+			//////////////////////////////////////////////////////////////////////////
+			/// @return true if a part of the reply has already been sent
+			bool isStarted() const { return _state->started; }
+		};
+}	}
+
+#endif // SYNTHESE_server_HTTPChunkedSink_hpp__
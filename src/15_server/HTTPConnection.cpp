@@ -10,20 +10,36 @@
 
 #include "HTTPConnection.hpp"
 
+#include <sstream>
 #include <vector>
 #include <boost/bind.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 
 namespace synthese
 {
 	namespace server
 	{
+		boost::mutex HTTPConnection::_mutex;
+		boost::posix_time::time_duration HTTPConnection::_idleTimeout(boost::posix_time::seconds(15));
+		std::size_t HTTPConnection::_maxRequests(100);
+		HTTPConnection::Statistics HTTPConnection::_statistics = { 0, 0, 0 };
+
+
 
 		HTTPConnection::HTTPConnection(
 			boost::asio::io_service& io_service,
-			void (*handler)(const HTTPRequest& request, HTTPReply& reply)
+			void (*handler)(const HTTPRequest& request, HTTPReply& reply),
+			const Dispatcher& dispatcher
 		):	strand_(io_service),
 			socket_(io_service),
-			handler_(handler)
+			timer_(io_service),
+			pending_begin_(0),
+			pending_end_(0),
+			part_sent_(false),
+			requests_number_(0),
+			keep_alive_(false),
+			handler_(handler),
+			dispatcher_(dispatcher)
 		{
 		}
 
@@ -36,7 +52,37 @@ namespace synthese
 
 
 
+		void HTTPConnection::SetKeepAliveParameters(
+			const boost::posix_time::time_duration& idleTimeout,
+			std::size_t maxRequests
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			_idleTimeout = idleTimeout;
+			_maxRequests = maxRequests;
+		}
+
+
+
+		HTTPConnection::Statistics HTTPConnection::GetStatistics()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _statistics;
+		}
+
+
+
 		void HTTPConnection::start()
+		{
+			{
+				boost::mutex::scoped_lock lock(_mutex);
+				++_statistics.connectionsNumber;
+			}
+			read();
+		}
+
+
+
+		void HTTPConnection::read()
 		{
 			socket_.async_read_some(boost::asio::buffer(buffer_),
 				strand_.wrap(
@@ -53,41 +99,183 @@ namespace synthese
 		){
 			if (!e)
 			{
-				boost::tribool result;
-				boost::tie(result, boost::tuples::ignore) = request_parser_.parse(
-					request_, buffer_.data(), buffer_.data() + bytes_transferred);
+				// Stops the wait for the next request (the pending wait is
+				// cancelled and will not close the socket)
+				timer_.expires_at(boost::posix_time::pos_infin);
 
-				if (result)
+				handle_data(buffer_.data(), buffer_.data() + bytes_transferred);
+			}
+
+			// If an error occurs then no new asynchronous operations are started. This
+			// means that all shared_ptr references to the connection object will
+			// disappear and the object will be destroyed automatically after this
+			// handler returns. The connection class's destructor closes the socket.
+		}
+
+
+
+		void HTTPConnection::handle_data(
+			char* begin,
+			char* end
+		){
+			pending_begin_ = 0;
+			pending_end_ = 0;
+
+			boost::tribool result;
+			char* consumed;
+			boost::tie(result, consumed) = request_parser_.parse(
+				request_, begin, end);
+
+			if (result)
+			{
+				// The data following the request belongs to the next requests
+				// (pipelining) : it is kept until the reply is written
+				pending_begin_ = consumed - buffer_.data();
+				pending_end_ = end - buffer_.data();
+
+				++requests_number_;
+				if(requests_number_ > 1)
 				{
-					request_.ipaddr = socket_.remote_endpoint().address().to_string();
-					(*handler_)(request_, reply_);
-					boost::asio::async_write(socket_, reply_.to_buffers(),
-						strand_.wrap(
-							boost::bind(&HTTPConnection::handle_write, shared_from_this(),
-							boost::asio::placeholders::error)));
+					boost::mutex::scoped_lock lock(_mutex);
+					++_statistics.keepAliveRequestsNumber;
+					if(requests_number_ == 2)
+					{
+						++_statistics.reusedConnectionsNumber;
+					}
 				}
-				else if (!result)
+
+				request_.ipaddr = socket_.remote_endpoint().address().to_string();
+				reply_.sender = boost::bind(&HTTPConnection::send_part, this, _1);
+				if(!dispatcher_)
 				{
-					reply_ = HTTPReply::stock_reply(HTTPReply::bad_request);
+					run_handler();
+				}
+				else if(!dispatcher_(request_, boost::bind(&HTTPConnection::run_handler, shared_from_this())))
+				{
+					keep_alive_ = false;
+					reply_ = HTTPReply::stock_reply(HTTPReply::service_unavailable);
+					reply_.headers["Connection"] = "close";
 					boost::asio::async_write(socket_, reply_.to_buffers(),
 						strand_.wrap(
 							boost::bind(&HTTPConnection::handle_write, shared_from_this(),
 							boost::asio::placeholders::error)));
 				}
-				else
+			}
+			else if (!result)
+			{
+				keep_alive_ = false;
+				reply_ = HTTPReply::stock_reply(HTTPReply::bad_request);
+				reply_.headers["Connection"] = "close";
+				boost::asio::async_write(socket_, reply_.to_buffers(),
+					strand_.wrap(
+						boost::bind(&HTTPConnection::handle_write, shared_from_this(),
+						boost::asio::placeholders::error)));
+			}
+			else
+			{
+				read();
+			}
+		}
+
+
+
+		void HTTPConnection::run_handler()
+		{
+			// No operation uses the connection while the handler runs : the
+			// handler can be run outside of the strand
+			(*handler_)(request_, reply_);
+
+			// Back to the strand (immediately if the handler has been run by it)
+			strand_.dispatch(
+				boost::bind(&HTTPConnection::handle_reply, shared_from_this()));
+		}
+
+
+
+		void HTTPConnection::handle_reply()
+		{
+			keep_alive_ = can_keep_alive();
+			if(part_sent_)
+			{
+				// The reply has already been sent by the handler
+				handle_write(boost::system::error_code());
+				return;
+			}
+
+			bool http11(
+				request_.http_version_major > 1 ||
+				(request_.http_version_major == 1 && request_.http_version_minor >= 1)
+			);
+			if(keep_alive_)
+			{
+				boost::posix_time::time_duration idleTimeout;
+				std::size_t maxRequests;
 				{
-					socket_.async_read_some(boost::asio::buffer(buffer_),
-						strand_.wrap(
-							boost::bind(&HTTPConnection::handle_read, shared_from_this(),
-							boost::asio::placeholders::error,
-							boost::asio::placeholders::bytes_transferred)));
+					boost::mutex::scoped_lock lock(_mutex);
+					idleTimeout = _idleTimeout;
+					maxRequests = _maxRequests;
+				}
+				std::stringstream keepAlive;
+				keepAlive << "timeout=" << idleTimeout.total_seconds();
+				if(maxRequests)
+				{
+					keepAlive << ", max=" << (maxRequests - requests_number_);
 				}
+				reply_.headers["Connection"] = "keep-alive";
+				reply_.headers["Keep-Alive"] = keepAlive.str();
 			}
+			else
+			{
+				reply_.headers["Connection"] = "close";
+			}
+			boost::asio::async_write(socket_, reply_.to_buffers(http11),
+				strand_.wrap(
+					boost::bind(&HTTPConnection::handle_write, shared_from_this(),
+					boost::asio::placeholders::error)));
+		}
 
-			// If an error occurs then no new asynchronous operations are started. This
-			// means that all shared_ptr references to the connection object will
-			// disappear and the object will be destroyed automatically after this
-			// handler returns. The connection class's destructor closes the socket.
+
+
+		bool HTTPConnection::can_keep_alive() const
+		{
+			// A reply sent by parts is not delimited by its length
+			if(	part_sent_ ||
+				reply_.headers.find("Content-Length") == reply_.headers.end()
+			){
+				return false;
+			}
+
+			// Server parameters
+			{
+				boost::mutex::scoped_lock lock(_mutex);
+				if(	_idleTimeout <= boost::posix_time::seconds(0) ||
+					(_maxRequests && requests_number_ >= _maxRequests)
+				){
+					return false;
+				}
+			}
+
+			// Client wish : persistent connection by default in HTTP/1.1, on
+			// demand in HTTP/1.0
+			HTTPRequest::Headers::const_iterator it(request_.headers.find("Connection"));
+			std::string connection(it == request_.headers.end() ? std::string() : it->second);
+			if(	request_.http_version_major > 1 ||
+				(request_.http_version_major == 1 && request_.http_version_minor >= 1)
+			){
+				return !boost::algorithm::iequals(connection, "close");
+			}
+			return boost::algorithm::iequals(connection, "keep-alive");
+		}
+
+
+
+		void HTTPConnection::send_part(
+			const std::vector<boost::asio::const_buffer>& buffers
+		){
+			// No other operation uses the socket while the handler runs : the
+			// synchronous write is safe in any thread
+			part_sent_ = true;
+			boost::asio::write(socket_, buffers);
 		}
 
 
@@ -96,6 +284,40 @@ namespace synthese
 		{
 			if (!e)
 			{
+				if(keep_alive_)
+				{
+					// Ready for the next request
+					request_ = HTTPRequest();
+					reply_ = HTTPReply();
+					request_parser_.reset();
+					part_sent_ = false;
+					keep_alive_ = false;
+
+					// Next request already received
+					if(pending_begin_ < pending_end_)
+					{
+						handle_data(
+							buffer_.data() + pending_begin_,
+							buffer_.data() + pending_end_
+						);
+						return;
+					}
+
+					// Wait for the next request
+					boost::posix_time::time_duration idleTimeout;
+					{
+						boost::mutex::scoped_lock lock(_mutex);
+						idleTimeout = _idleTimeout;
+					}
+					timer_.expires_from_now(idleTimeout);
+					timer_.async_wait(
+						strand_.wrap(
+							boost::bind(&HTTPConnection::handle_timeout, shared_from_this(),
+							boost::asio::placeholders::error)));
+					read();
+					return;
+				}
+
 				// Initiate graceful connection closure.
 				boost::system::error_code ignored_ec;
 				socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_ec);
@@ -107,5 +329,20 @@ namespace synthese
 			// destructor closes the socket.
 		}
 
+
+
+		void HTTPConnection::handle_timeout(const boost::system::error_code& e)
+		{
+			// The timer may have been restarted by a read after the expiration
+			if(	e != boost::asio::error::operation_aborted &&
+				timer_.expires_at() <= boost::asio::deadline_timer::traits_type::now()
+			){
+				// Closing the socket cancels the pending read, which releases the
+				// connection
+				boost::system::error_code ignored_ec;
+				socket_.close(ignored_ec);
+			}
+		}
+
 	} // namespace server
 } // namespace http
@@ -16,8 +16,11 @@
 #include <boost/asio.hpp>
 #include <boost/array.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <boost/function.hpp>
 #include "HTTPReply.hpp"
 #include "HTTPRequest.hpp"
 #include "HTTPRequestParser.hpp"
@@ -30,15 +33,42 @@ namespace synthese
 		/// Represents a single connection from a client.
 		/// @ingroup m15
 		///
+		/// The connection is persistent if the client asks it (HTTP/1.1 by
+		/// default, HTTP/1.0 with Connection: keep-alive) and if keep-alive is
+		/// enabled : the next request is then read on the same socket, until the
+		/// idle timeout or the maximal requests number is reached. The requests
+		/// sent by the client without waiting for the replies (pipelining) are
+		/// handled one after the other.
+		///
+		/// If a dispatcher is provided, the handler is not run by the I/O thread
+		/// which has read the request but by the task given to the dispatcher,
+		/// which can run it in an other thread. The reply is then written by the
+		/// I/O threads.
 		class HTTPConnection:
 			public boost::enable_shared_from_this<HTTPConnection>,
 			private boost::noncopyable
 		{
 			public:
+			/// Counters of the connections since the server start.
+			struct Statistics
+			{
+				std::size_t connectionsNumber;	//!< accepted connections
+				std::size_t reusedConnectionsNumber;	//!< connections which handled more than one request
+				std::size_t keepAliveRequestsNumber;	//!< requests received on an already used connection
+			};
+
+			/// Task running the handler and sending the reply.
+			typedef boost::function<void ()> Task;
+
+			/// Schedules the task of a request, returns false if the request
+			/// is refused.
+			typedef boost::function<bool (const HTTPRequest& request, const Task& task)> Dispatcher;
+
 			/// Construct a connection with the given io_service.
 			explicit HTTPConnection(
 				boost::asio::io_service& io_service,
-				void (*handler)(const HTTPRequest& request, HTTPReply& reply)
+				void (*handler)(const HTTPRequest& request, HTTPReply& reply),
+				const Dispatcher& dispatcher = Dispatcher()
 			);
 
 			/// Get the socket associated with the connection.
@@ -47,23 +77,61 @@ namespace synthese
 			/// Start the first asynchronous operation for the connection.
 			void start();
 
+			/// Set the keep-alive parameters of the next requests.
+			/// @param idleTimeout maximal wait for the next request (0 disables the keep-alive)
+			/// @param maxRequests maximal requests number per connection (0 = unlimited)
+			static void SetKeepAliveParameters(
+				const boost::posix_time::time_duration& idleTimeout,
+				std::size_t maxRequests
+			);
+
+			static Statistics GetStatistics();
+
 			private:
+			/// Start an asynchronous read.
+			void read();
+
 			/// Handle completion of a read operation.
 			void handle_read(const boost::system::error_code& e,
 				std::size_t bytes_transferred);
 
+			/// Parse received data and handle the request when it is complete.
+			void handle_data(char* begin, char* end);
+
+			/// Run the handler on the complete request.
+			void run_handler();
+
+			/// Send the reply produced by the handler.
+			void handle_reply();
+
 			/// Handle completion of a write operation.
 			void handle_write(const boost::system::error_code& e);
 
+			/// Handle the end of the wait for the next request.
+			void handle_timeout(const boost::system::error_code& e);
+
+			/// Write synchronously a part of the reply (sender of the reply).
+			void send_part(const std::vector<boost::asio::const_buffer>& buffers);
+
+			/// Check if the connection can be kept after the current request.
+			bool can_keep_alive() const;
+
 			/// Strand to ensure the connection's handlers are not called concurrently.
 			boost::asio::io_service::strand strand_;
 
 			/// Socket for the connection.
 			boost::asio::ip::tcp::socket socket_;
 
+			/// Timer of the wait for the next request.
+			boost::asio::deadline_timer timer_;
+
 			/// Buffer for incoming data.
 			boost::array<char, 8192> buffer_;
 
+			/// Received data not parsed yet (beginning of the next request).
+			std::size_t pending_begin_;
+			std::size_t pending_end_;
+
 			/// The incoming request.
 			HTTPRequest request_;
 
@@ -73,7 +141,26 @@ namespace synthese
 			/// The reply to be sent back to the client.
 			HTTPReply reply_;
 
+			/// The handler has sent the reply by parts.
+			bool part_sent_;
+
+			/// Number of requests received on the connection.
+			std::size_t requests_number_;
+
+			/// The connection is kept after the current reply.
+			bool keep_alive_;
+
 			void (*handler_)(const HTTPRequest& request, HTTPReply& reply);
+
+			Dispatcher dispatcher_;
+
+			/// @name Keep-alive parameters and statistics
+			//@{
+				static boost::mutex _mutex;	//!< protects the following attributes
+				static boost::posix_time::time_duration _idleTimeout;
+				static std::size_t _maxRequests;
+				static Statistics _statistics;
+			//@}
 		};
 
 		typedef boost::shared_ptr<HTTPConnection> connection_ptr;
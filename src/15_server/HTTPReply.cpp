@@ -102,13 +102,30 @@ namespace synthese
 
 		const char name_value_separator[] = { ':', ' ' };
 		const char crlf[] = { '\r', '\n' };
+		const char http11[] = { 'H', 'T', 'T', 'P', '/', '1', '.', '1' };
 
 		} // namespace misc_strings
 
-		std::vector<boost::asio::const_buffer> HTTPReply::to_buffers()
+		std::vector<boost::asio::const_buffer> HTTPReply::to_buffers(bool http11)
+		{
+		  std::vector<boost::asio::const_buffer> buffers(headers_to_buffers(http11));
+		  buffers.push_back(boost::asio::buffer(content));
+		  return buffers;
+		}
+
+		std::vector<boost::asio::const_buffer> HTTPReply::headers_to_buffers(bool http11)
 		{
 		  std::vector<boost::asio::const_buffer> buffers;
-		  buffers.push_back(status_strings::to_buffer(status));
+		  if(http11)
+		  {
+			// Same status line with the version replaced
+			buffers.push_back(boost::asio::buffer(misc_strings::http11));
+			buffers.push_back(status_strings::to_buffer(status) + sizeof(misc_strings::http11));
+		  }
+		  else
+		  {
+			buffers.push_back(status_strings::to_buffer(status));
+		  }
 		  BOOST_FOREACH(const Header& h, headers)
 		  {
 			buffers.push_back(boost::asio::buffer(h.first));
@@ -117,7 +134,6 @@ namespace synthese
 			buffers.push_back(boost::asio::buffer(misc_strings::crlf));
 		  }
 		  buffers.push_back(boost::asio::buffer(misc_strings::crlf));
-		  buffers.push_back(boost::asio::buffer(content));
 		  return buffers;
 		}
 
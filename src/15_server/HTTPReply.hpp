@@ -12,8 +12,10 @@
 #define HTTP_SERVER3_REPLY_HPP
 
 #include <map>
+#include <string>
 #include <vector>
 #include <boost/asio.hpp>
+#include <boost/function.hpp>
 
 namespace synthese
 {
@@ -55,10 +57,24 @@ namespace synthese
 		  /// The content to be sent in the reply.
 		  std::string content;
 
+		  /// Synchronous writer of buffers on the connection socket.
+		  typedef boost::function<void (const std::vector<boost::asio::const_buffer>&)> Sender;
+
+		  /// Sender provided by the connection to the handler, to send the reply
+		  /// progressively. If the handler uses it, the reply object is ignored by
+		  /// the connection, which only closes the socket after the handler.
+		  Sender sender;
+
 		  /// Convert the reply into a vector of buffers. The buffers do not own the
 		  /// underlying memory blocks, therefore the reply object must remain valid and
 		  /// not be changed until the write operation has completed.
-		  std::vector<boost::asio::const_buffer> to_buffers();
+		  /// @param http11 the status line is an HTTP/1.1 one
+		  std::vector<boost::asio::const_buffer> to_buffers(bool http11 = false);
+
+		  /// Convert the status line and the headers into a vector of buffers.
+		  /// @param http11 the status line is an HTTP/1.1 one (required by the
+		  /// chunked transfer encoding and the persistent connections)
+		  std::vector<boost::asio::const_buffer> headers_to_buffers(bool http11 = false);
 
 		  /// Get a stock reply with optionnaly a description.
 		  static HTTPReply stock_reply(status_type status, const std::string &description = "");
@@ -21,7 +21,8 @@ namespace synthese
 	{
 
 		HTTPRequestParser::HTTPRequestParser()
-		  : state_(method_start)
+		  : _postToDownload(0),
+			state_(method_start)
 		{
 		}
 
@@ -30,6 +31,7 @@ namespace synthese
 			state_ = method_start;
 			_currentHeaderKey.clear();
 			_currentHeaderValue.clear();
+			_postToDownload = 0;
 		}
 
 		boost::tribool HTTPRequestParser::consume(HTTPRequest& req, char input)
@@ -308,6 +310,8 @@ namespace synthese
 					return false;
 
 				_postToDownload = lexical_cast<size_t>(it->second);
+				if(!_postToDownload)
+					return true;
 				state_ = postData;
 				return boost::indeterminate;
 			}
@@ -29,6 +29,7 @@
 #include "ResultHTMLTable.h"
 #include "User.h"
 #include "ParametersMap.h"
+#include "ResponseCache.hpp"
 #include "ServerModule.h"
 #include "ServerAdminRight.h"
 
@@ -58,6 +59,7 @@ namespace synthese
 	namespace server
 	{
 		const string MemoryStatisticsAdmin::TAB_REGISTRY = "tab_registry";
+		const string MemoryStatisticsAdmin::TAB_RESPONSE_CACHE = "tab_response_cache";
 
 
 
@@ -183,6 +185,56 @@ namespace synthese
 				// Table closing
 				stream << t.close();
 			}
+
+			////////////////////////////////////////////////////////////////////
+			// RESPONSE CACHE TAB
+			if (openTabContent(stream, TAB_RESPONSE_CACHE))
+			{
+				stream << "<h1>Cache des réponses</h1>";
+				{
+					HTMLTable::ColsVector c;
+					c.push_back("Réponses en cache");
+					c.push_back("Mémoire");
+					c.push_back("Mémoire maximale");
+					HTMLTable t(c, ResultHTMLTable::CSS_CLASS);
+					stream << t.open();
+					stream << t.row();
+					stream << t.col() << ResponseCache::GetEntriesNumber();
+					stream << t.col() << ResponseCache::GetSize();
+					stream << t.col() << ResponseCache::GetMaxSize();
+					stream << t.close();
+				}
+
+				stream << "<h1>Utilisation par objet</h1>";
+				{
+					HTMLTable::ColsVector c;
+					c.push_back("Fonction");
+					c.push_back("Objet");
+					c.push_back("Nom");
+					c.push_back("Lectures en cache");
+					c.push_back("Calculs");
+					c.push_back("Taux de succès");
+					c.push_back("Invalidations");
+					HTMLTable t(c, ResultHTMLTable::CSS_CLASS);
+					stream << t.open();
+					BOOST_FOREACH(const ResponseCache::StatisticsMap::value_type& item, ResponseCache::GetStatistics())
+					{
+						stream << t.row();
+						stream << t.col() << item.first.first;
+						stream << t.col() << item.first.second;
+						stream << t.col() << item.second.name;
+						stream << t.col() << item.second.hits;
+						stream << t.col() << item.second.misses;
+						stream << t.col();
+						if(item.second.hits + item.second.misses)
+						{
+							stream << fixed << setprecision(2) << (double(100 * item.second.hits) / double(item.second.hits + item.second.misses)) << "%";
+						}
+						stream << t.col() << item.second.invalidations;
+					}
+					stream << t.close();
+				}
+			}
 			
 			////////////////////////////////////////////////////////////////////
 			/// END TABS
@@ -218,6 +270,7 @@ namespace synthese
 			_tabs.clear();
 
 			_tabs.push_back(Tab("Registres", TAB_REGISTRY, profile.isAuthorized<ServerAdminRight>(WRITE, UNKNOWN_RIGHT_LEVEL)));
+			_tabs.push_back(Tab("Cache des réponses", TAB_RESPONSE_CACHE, profile.isAuthorized<ServerAdminRight>(WRITE, UNKNOWN_RIGHT_LEVEL)));
 
 			_tabBuilded = true;
 		}
@@ -45,6 +45,7 @@ namespace synthese
 			/// @name Parameter identifiers
 			//@{
 				static const std::string TAB_REGISTRY;
+				static const std::string TAB_RESPONSE_CACHE;
 			//@}
 
 		private:
@@ -0,0 +1,287 @@
+/** RequestScheduler class implementation.
+	@file RequestScheduler.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "RequestScheduler.hpp"
+
+#include "Exception.h"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	namespace server
+	{
+		const string RequestScheduler::DEFAULT_LANE("default");
+
+		boost::mutex RequestScheduler::_mutex;
+		RequestScheduler::Lanes RequestScheduler::_lanes;
+		RequestScheduler::LanesByKey RequestScheduler::_lanesByKey;
+
+
+
+		RequestScheduler::Statistics::Statistics():
+			threadsNumber(0),
+			maxQueueLength(0),
+			queueLength(0),
+			runningRequests(0),
+			executedRequests(0),
+			refusedRequests(0),
+			totalWaitingTime(seconds(0)),
+			maxWaitingTime(seconds(0))
+		{}
+
+
+
+		void RequestScheduler::SetLanes(
+			const string& definition,
+			size_t defaultThreadsNumber
+		){
+			// Parsing
+			map<string, pair<size_t, size_t> > lanesParameters;
+			LanesByKey lanesByKey;
+			lanesParameters[DEFAULT_LANE] = make_pair(defaultThreadsNumber, 0);
+			vector<string> lanesDefinitions;
+			split(lanesDefinitions, definition, is_any_of(";"));
+			BOOST_FOREACH(const string& laneDefinition, lanesDefinitions)
+			{
+				if(trim_copy(laneDefinition).empty())
+				{
+					continue;
+				}
+				try
+				{
+					size_t nameEnd(laneDefinition.find('='));
+					if(nameEnd == string::npos)
+					{
+						throw bad_lexical_cast();
+					}
+					string name(trim_copy(laneDefinition.substr(0, nameEnd)));
+					string parameters(laneDefinition.substr(nameEnd + 1));
+					string keys;
+					size_t keysBegin(parameters.find(':'));
+					if(keysBegin != string::npos)
+					{
+						keys = parameters.substr(keysBegin + 1);
+						parameters = parameters.substr(0, keysBegin);
+					}
+					size_t threadsNumber(0);
+					size_t maxQueueLength(0);
+					size_t maxQueueLengthBegin(parameters.find('/'));
+					if(maxQueueLengthBegin != string::npos)
+					{
+						maxQueueLength = lexical_cast<size_t>(trim_copy(parameters.substr(maxQueueLengthBegin + 1)));
+						parameters = parameters.substr(0, maxQueueLengthBegin);
+					}
+					threadsNumber = lexical_cast<size_t>(trim_copy(parameters));
+					if(name.empty() || !threadsNumber)
+					{
+						throw bad_lexical_cast();
+					}
+					lanesParameters[name] = make_pair(threadsNumber, maxQueueLength);
+
+					vector<string> keysVector;
+					split(keysVector, keys, is_any_of(","));
+					BOOST_FOREACH(const string& key, keysVector)
+					{
+						if(!trim_copy(key).empty())
+						{
+							lanesByKey[trim_copy(key)] = name;
+						}
+					}
+				}
+				catch(bad_lexical_cast&)
+				{
+					throw synthese::Exception("Malformed request lane definition : "+ laneDefinition);
+				}
+			}
+
+			// Update of the lanes
+			boost::mutex::scoped_lock lock(_mutex);
+			for(Lanes::iterator it(_lanes.begin()); it != _lanes.end(); )
+			{
+				if(	!lanesParameters.count(it->first) &&
+					it->second->queue.empty() &&
+					!it->second->statistics.runningRequests
+				){
+					// The workers of the lane stop
+					it->second->condition.notify_all();
+					_lanes.erase(it++);
+				}
+				else
+				{
+					++it;
+				}
+			}
+			typedef map<string, pair<size_t, size_t> > LanesParameters;
+			BOOST_FOREACH(const LanesParameters::value_type& laneParameters, lanesParameters)
+			{
+				boost::shared_ptr<Lane>& lane(_lanes[laneParameters.first]);
+				if(!lane.get())
+				{
+					lane.reset(new Lane);
+					lane->statistics.lane = laneParameters.first;
+				}
+				lane->statistics.threadsNumber = laneParameters.second.first;
+				lane->statistics.maxQueueLength = laneParameters.second.second;
+			}
+			_lanesByKey = lanesByKey;
+		}
+
+
+
+		string RequestScheduler::GetLane(
+			const string& key
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			LanesByKey::const_iterator it(_lanesByKey.find(key));
+			return it == _lanesByKey.end() ? DEFAULT_LANE : it->second;
+		}
+
+
+
+		map<string, size_t> RequestScheduler::GetThreadsNumbers()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			map<string, size_t> result;
+			BOOST_FOREACH(const Lanes::value_type& it, _lanes)
+			{
+				result[it.first] = it.second->statistics.threadsNumber;
+			}
+			return result;
+		}
+
+
+
+		bool RequestScheduler::Push(
+			const string& lane,
+			const Task& task
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			Lanes::iterator it(_lanes.find(lane));
+			if(it == _lanes.end())
+			{
+				it = _lanes.find(DEFAULT_LANE);
+				if(it == _lanes.end())
+				{
+					return false;
+				}
+			}
+			Lane& theLane(*it->second);
+			if(	theLane.statistics.maxQueueLength &&
+				theLane.queue.size() >= theLane.statistics.maxQueueLength
+			){
+				++theLane.statistics.refusedRequests;
+				return false;
+			}
+			theLane.queue.push_back(make_pair(task, microsec_clock::local_time()));
+			theLane.statistics.queueLength = theLane.queue.size();
+			theLane.condition.notify_one();
+			return true;
+		}
+
+
+
+		void RequestScheduler::RunWorker(
+			const string& laneName
+		){
+			while(true)
+			{
+				Task task;
+				boost::shared_ptr<Lane> lane;
+
+				// Waiting for a request
+				{
+					boost::mutex::scoped_lock lock(_mutex);
+					while(true)
+					{
+						Lanes::const_iterator it(_lanes.find(laneName));
+						if(it == _lanes.end())
+						{
+							return;
+						}
+						lane = it->second;
+						if(!lane->queue.empty())
+						{
+							break;
+						}
+						lane->condition.wait(lock);
+					}
+
+					task = lane->queue.front().first;
+					time_duration waitingTime(microsec_clock::local_time() - lane->queue.front().second);
+					lane->queue.pop_front();
+
+					Statistics& statistics(lane->statistics);
+					statistics.queueLength = lane->queue.size();
+					++statistics.runningRequests;
+					statistics.totalWaitingTime += waitingTime;
+					if(waitingTime > statistics.maxWaitingTime)
+					{
+						statistics.maxWaitingTime = waitingTime;
+					}
+				}
+
+				// Execution
+				try
+				{
+					task();
+				}
+				catch(...)
+				{
+					_endRequest(*lane);
+					throw;
+				}
+				_endRequest(*lane);
+			}
+		}
+
+
+
+		void RequestScheduler::_endRequest(
+			Lane& lane
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			--lane.statistics.runningRequests;
+			++lane.statistics.executedRequests;
+		}
+
+
+
+		RequestScheduler::StatisticsVector RequestScheduler::GetStatistics()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			StatisticsVector result;
+			BOOST_FOREACH(const Lanes::value_type& it, _lanes)
+			{
+				result.push_back(it.second->statistics);
+			}
+			return result;
+		}
+}	}
@@ -0,0 +1,154 @@
+/** RequestScheduler class header.
+	@file RequestScheduler.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_server_RequestScheduler_hpp__
+#define SYNTHESE_server_RequestScheduler_hpp__
+
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace server
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Queues of the requests waiting for a worker thread.
+		///	@ingroup m15
+		//////////////////////////////////////////////////////////////////////////
+		/// The requests are read and the replies are written by the I/O threads
+		/// of the server, which only push the execution of the requests in a
+		/// lane. Each lane has its own worker threads (see RunWorker) : the
+		/// number of threads of a lane is the maximal number of its requests
+		/// running at the same time, so slow services in a lane cannot delay the
+		/// services of the other lanes.
+		///
+		/// The lanes are defined by a string :
+		/// <pre>name=threads[/max queue length][:key,key...];name=...</pre>
+		/// The keys are the factory keys of the services and actions run by the
+		/// lane. The requests of the other services go to the default lane, which
+		/// can be defined in the string too. A request pushed in a lane whose queue
+		/// has reached its maximal length (0 = unlimited) is refused.
+		class RequestScheduler
+		{
+		public:
+			typedef boost::function<void ()> Task;
+
+			static const std::string DEFAULT_LANE;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// State and activity of a lane.
+			struct Statistics
+			{
+				std::string lane;
+				std::size_t threadsNumber;
+				std::size_t maxQueueLength;
+				std::size_t queueLength;
+				std::size_t runningRequests;
+				std::size_t executedRequests;
+				std::size_t refusedRequests;
+				boost::posix_time::time_duration totalWaitingTime;
+				boost::posix_time::time_duration maxWaitingTime;
+
+				Statistics();
+			};
+			typedef std::vector<Statistics> StatisticsVector;
+
+		private:
+			typedef std::deque<std::pair<Task, boost::posix_time::ptime> > Queue;
+
+			struct Lane
+			{
+				Queue queue;
+				boost::condition_variable condition;
+				Statistics statistics;
+			};
+			typedef std::map<std::string, boost::shared_ptr<Lane> > Lanes;
+			typedef std::map<std::string, std::string> LanesByKey;
+
+			static boost::mutex _mutex;	//!< protects all the following attributes
+			static Lanes _lanes;
+			static LanesByKey _lanesByKey;
+
+			static void _endRequest(Lane& lane);
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Defines the lanes.
+			/// The queues of the lanes which already exist are kept. The lanes which
+			/// are not defined anymore are removed if they are empty.
+			/// @param definition the lanes definition (see the class documentation)
+			/// @param defaultThreadsNumber number of threads of the default lane if
+			/// it is not defined in the string
+			/// @throws synthese::Exception if the definition is malformed
+			static void SetLanes(
+				const std::string& definition,
+				std::size_t defaultThreadsNumber
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// @param key the factory key of the service or the action of a request
+			/// @return the lane running the request
+			static std::string GetLane(const std::string& key);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// @return the number of worker threads of each lane
+			static std::map<std::string, std::size_t> GetThreadsNumbers();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Queues a request.
+			/// @param lane the lane (the default lane is used if the lane does not
+			/// exist)
+			/// @param task the execution of the request
+			/// @return false if the queue is full
+			static bool Push(
+				const std::string& lane,
+				const Task& task
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Body of a worker thread : runs the requests of a lane until the
+			/// thread is interrupted or the lane is removed.
+			/// @param lane the lane
+			static void RunWorker(const std::string& lane);
+
+
+
+			static StatisticsVector GetStatistics();
+		};
+}	}
+
+#endif // SYNTHESE_server_RequestScheduler_hpp__
@@ -0,0 +1,425 @@
+/** ResponseCache class implementation.
+	@file ResponseCache.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "ResponseCache.hpp"
+
+#include <boost/foreach.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	using namespace db;
+	using namespace util;
+
+	namespace server
+	{
+		boost::mutex ResponseCache::_mutex;
+		ResponseCache::Entries ResponseCache::_entries;
+		ResponseCache::LRUList ResponseCache::_lru;
+		ResponseCache::EntriesByObject ResponseCache::_entriesByObject;
+		ResponseCache::EntriesByTable ResponseCache::_entriesByReadTable;
+		ResponseCache::EntriesByTable ResponseCache::_entriesByTable;
+		set<ResponseCache::Key> ResponseCache::_entriesByAnyTable;
+		size_t ResponseCache::_size(0);
+		size_t ResponseCache::_maxSize(64 * 1024 * 1024);
+		ResponseCache::StatisticsMap ResponseCache::_statistics;
+		ResponseCache::Generation ResponseCache::_generation(0);
+		ResponseCache::Modifications ResponseCache::_modifications;
+		const size_t ResponseCache::_MODIFICATIONS_NUMBER(4096);
+
+
+
+		ResponseCache::Key::Key(
+			const string& function_,
+			RegistryKeyType objectId_,
+			const string& parameters_
+		):	function(function_),
+			objectId(objectId_),
+			parameters(parameters_)
+		{}
+
+
+
+		bool ResponseCache::Key::operator<(
+			const Key& other
+		) const	{
+			if(objectId != other.objectId)
+			{
+				return objectId < other.objectId;
+			}
+			if(function != other.function)
+			{
+				return function < other.function;
+			}
+			return parameters < other.parameters;
+		}
+
+
+
+		ResponseCache::Statistics::Statistics():
+			hits(0),
+			misses(0),
+			invalidations(0)
+		{}
+
+
+
+		void ResponseCache::_erase(
+			Entries::iterator it
+		){
+			const Key& key(it->first);
+			const Entry& entry(it->second);
+
+			BOOST_FOREACH(RegistryKeyType id, entry.dependencies)
+			{
+				EntriesByObject::iterator itObject(_entriesByObject.find(id));
+				itObject->second.erase(key);
+				if(itObject->second.empty())
+				{
+					_entriesByObject.erase(itObject);
+				}
+
+				EntriesByTable::iterator itTable(_entriesByReadTable.find(decodeTableId(id)));
+				if(itTable != _entriesByReadTable.end())
+				{
+					itTable->second.erase(key);
+					if(itTable->second.empty())
+					{
+						_entriesByReadTable.erase(itTable);
+					}
+				}
+			}
+			BOOST_FOREACH(RegistryTableType table, entry.tables)
+			{
+				EntriesByTable::iterator itTable(_entriesByTable.find(table));
+				itTable->second.erase(key);
+				if(itTable->second.empty())
+				{
+					_entriesByTable.erase(itTable);
+				}
+			}
+			if(entry.anyTable)
+			{
+				_entriesByAnyTable.erase(key);
+			}
+
+			_size -= entry.content->size() + key.parameters.size();
+			_lru.erase(entry.lruPosition);
+			_entries.erase(it);
+		}
+
+
+
+		void ResponseCache::_invalidate(
+			const set<Key>& keys
+		){
+			// Copy : the set belongs to an index updated by _erase
+			set<Key> keysToErase(keys);
+			BOOST_FOREACH(const Key& key, keysToErase)
+			{
+				Entries::iterator it(_entries.find(key));
+				if(it == _entries.end())
+				{
+					continue;
+				}
+				++_statistics[make_pair(key.function, key.objectId)].invalidations;
+				_erase(it);
+			}
+		}
+
+
+
+		bool ResponseCache::_isModifiedSince(
+			Generation generation,
+			const RegistryBase::ReadRecorder::Keys& dependencies,
+			const Tables& tables,
+			bool anyTable
+		){
+			if(generation == _generation)
+			{
+				return false;
+			}
+			if(anyTable)
+			{
+				return true;
+			}
+
+			// Some of the modifications since the generation are not known anymore
+			if(	_modifications.empty() ||
+				_modifications.front().generation > generation + 1
+			){
+				return true;
+			}
+
+			Tables readTables;
+			BOOST_FOREACH(RegistryKeyType id, dependencies)
+			{
+				readTables.insert(decodeTableId(id));
+			}
+			BOOST_REVERSE_FOREACH(const Modification& modification, _modifications)
+			{
+				if(modification.generation <= generation)
+				{
+					break;
+				}
+				RegistryTableType table(decodeTableId(modification.id));
+				if(	tables.find(table) != tables.end() ||
+					dependencies.find(modification.id) != dependencies.end() ||
+					(modification.insertion && readTables.find(table) != readTables.end())
+				){
+					return true;
+				}
+			}
+			return false;
+		}
+
+
+
+		bool ResponseCache::Read(
+			const Key& key,
+			ostream& stream
+		){
+			boost::shared_ptr<const string> content;
+			RegistryBase::ReadRecorder::Keys dependencies;
+			Tables tables;
+			bool anyTable(false);
+			{
+				boost::mutex::scoped_lock lock(_mutex);
+				Statistics& statistics(_statistics[make_pair(key.function, key.objectId)]);
+
+				Entries::iterator it(_entries.find(key));
+				if(	it != _entries.end() &&
+					it->second.expirationTime < second_clock::local_time()
+				){
+					_erase(it);
+					it = _entries.end();
+				}
+				if(it == _entries.end())
+				{
+					++statistics.misses;
+					return false;
+				}
+
+				++statistics.hits;
+				_lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+				content = it->second.content;
+				dependencies = it->second.dependencies;
+				tables = it->second.tables;
+				anyTable = it->second.anyTable;
+			}
+
+			// The response is read as if it was generated
+			stream << *content;
+			BOOST_FOREACH(RegistryKeyType id, dependencies)
+			{
+				RegistryBase::RecordRead(id);
+			}
+			BOOST_FOREACH(RegistryTableType table, tables)
+			{
+				RegistryBase::RecordTableRead(table);
+			}
+			if(anyTable)
+			{
+				RegistryBase::RecordAnyTableRead();
+			}
+			return true;
+		}
+
+
+
+		ResponseCache::Generation ResponseCache::GetGeneration()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _generation;
+		}
+
+
+
+		void ResponseCache::Write(
+			const Key& key,
+			Generation generation,
+			const string& name,
+			const string& content,
+			const RegistryBase::ReadRecorder::Keys& dependencies,
+			const Tables& tables,
+			bool anyTable,
+			const time_duration& duration
+		){
+			size_t size(content.size() + key.parameters.size());
+
+			boost::mutex::scoped_lock lock(_mutex);
+			_statistics[make_pair(key.function, key.objectId)].name = name;
+
+			Entries::iterator it(_entries.find(key));
+			if(it != _entries.end())
+			{
+				_erase(it);
+			}
+			if(	size > _maxSize ||
+				_isModifiedSince(generation, dependencies, tables, anyTable)
+			){
+				return;
+			}
+
+			// Room for the new entry
+			while(_size + size > _maxSize)
+			{
+				_erase(_entries.find(_lru.back()));
+			}
+
+			// Storage
+			Entry& entry(_entries[key]);
+			entry.content.reset(new string(content));
+			entry.dependencies = dependencies;
+			entry.tables = tables;
+			entry.anyTable = anyTable;
+			entry.expirationTime = second_clock::local_time() + duration;
+			_lru.push_front(key);
+			entry.lruPosition = _lru.begin();
+			_size += size;
+
+			// Indexes
+			BOOST_FOREACH(RegistryKeyType id, dependencies)
+			{
+				_entriesByObject[id].insert(key);
+				_entriesByReadTable[decodeTableId(id)].insert(key);
+			}
+			BOOST_FOREACH(RegistryTableType table, tables)
+			{
+				_entriesByTable[table].insert(key);
+			}
+			if(anyTable)
+			{
+				_entriesByAnyTable.insert(key);
+			}
+		}
+
+
+
+		void ResponseCache::Invalidate(
+			const DB::DBModifEvent& modifEvent
+		){
+			RegistryTableType table(decodeTableId(modifEvent.id));
+
+			boost::mutex::scoped_lock lock(_mutex);
+
+			// Responses being generated
+			Modification modification;
+			modification.generation = ++_generation;
+			modification.id = modifEvent.id;
+			modification.insertion = (modifEvent.type == DB::MODIF_INSERT);
+			_modifications.push_back(modification);
+			if(_modifications.size() > _MODIFICATIONS_NUMBER)
+			{
+				_modifications.pop_front();
+			}
+
+			// Responses depending on all the tables
+			_invalidate(_entriesByAnyTable);
+
+			// Responses depending on the whole table
+			EntriesByTable::const_iterator itTable(_entriesByTable.find(table));
+			if(itTable != _entriesByTable.end())
+			{
+				_invalidate(itTable->second);
+			}
+
+			// A new object can appear in the responses which have read objects of
+			// its table
+			if(modifEvent.type == DB::MODIF_INSERT)
+			{
+				EntriesByTable::const_iterator itReadTable(_entriesByReadTable.find(table));
+				if(itReadTable != _entriesByReadTable.end())
+				{
+					_invalidate(itReadTable->second);
+				}
+			}
+
+			// Responses which have read the object
+			EntriesByObject::const_iterator itObject(_entriesByObject.find(modifEvent.id));
+			if(itObject != _entriesByObject.end())
+			{
+				_invalidate(itObject->second);
+			}
+		}
+
+
+
+		void ResponseCache::Clear()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			_entries.clear();
+			_lru.clear();
+			_entriesByObject.clear();
+			_entriesByReadTable.clear();
+			_entriesByTable.clear();
+			_entriesByAnyTable.clear();
+			_size = 0;
+		}
+
+
+
+		void ResponseCache::SetMaxSize(
+			size_t value
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			_maxSize = value;
+			while(_size > _maxSize)
+			{
+				_erase(_entries.find(_lru.back()));
+			}
+		}
+
+
+
+		size_t ResponseCache::GetMaxSize()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _maxSize;
+		}
+
+
+
+		size_t ResponseCache::GetSize()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _size;
+		}
+
+
+
+		size_t ResponseCache::GetEntriesNumber()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _entries.size();
+		}
+
+
+
+		ResponseCache::StatisticsMap ResponseCache::GetStatistics()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _statistics;
+		}
+}	}
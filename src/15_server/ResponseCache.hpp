@@ -0,0 +1,234 @@
+/** ResponseCache class header.
+	@file ResponseCache.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_server_ResponseCache_hpp__
+#define SYNTHESE_server_ResponseCache_hpp__
+
+#include "DB.hpp"
+#include "RegistryBase.h"
+#include "UtilTypes.h"
+
+#include <deque>
+#include <list>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace server
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Cache of the responses of the functions.
+		///	@ingroup m15
+		//////////////////////////////////////////////////////////////////////////
+		/// A response is stored with the data read while it was generated (see
+		/// util::RegistryBase::ReadRecorder) and is removed :
+		/// <ul>
+		///		<li>when one of the objects read in the registries or displayed is
+		///		updated or removed</li>
+		///		<li>when an object is added in the table of one of these objects</li>
+		///		<li>when any object of a table read without the registries (links,
+		///		iterations) or declared as a whole dependency is added, updated or
+		///		removed</li>
+		///		<li>when any object is added, updated or removed, if any table may
+		///		have been read without the registries</li>
+		///		<li>at the end of its duration, which bounds the staleness caused by
+		///		the data modified without database event (real time data)</li>
+		///		<li>when the cache reaches its maximal size, in least recently used
+		///		order</li>
+		/// </ul>
+		/// The modifications are received through db::DB::AddModificationCallback.
+		/// A response generated while one of its objects was modified is not
+		/// stored : the generation of the cache is read before the generation of
+		/// the response, and the last modifications are kept to be compared with
+		/// its dependencies at the storage.
+		class ResponseCache
+		{
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Identifies a response.
+			struct Key
+			{
+				std::string function;	//!< factory key of the function
+				util::RegistryKeyType objectId;	//!< main object of the response (page...)
+				std::string parameters;	//!< normalized parameters
+
+				Key(
+					const std::string& function,
+					util::RegistryKeyType objectId,
+					const std::string& parameters
+				);
+
+				bool operator<(const Key& other) const;
+			};
+
+			typedef std::set<util::RegistryTableType> Tables;
+			typedef unsigned long long Generation;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Use of the cache by the responses of an object.
+			struct Statistics
+			{
+				std::string name;
+				std::size_t hits;
+				std::size_t misses;
+				std::size_t invalidations;
+
+				Statistics();
+			};
+			typedef std::map<std::pair<std::string, util::RegistryKeyType>, Statistics> StatisticsMap;
+
+		private:
+			typedef std::list<Key> LRUList;
+
+			struct Entry
+			{
+				boost::shared_ptr<const std::string> content;
+				util::RegistryBase::ReadRecorder::Keys dependencies;
+				Tables tables;
+				bool anyTable;
+				boost::posix_time::ptime expirationTime;
+				LRUList::iterator lruPosition;
+			};
+			typedef std::map<Key, Entry> Entries;
+			typedef std::map<util::RegistryKeyType, std::set<Key> > EntriesByObject;
+			typedef std::map<util::RegistryTableType, std::set<Key> > EntriesByTable;
+
+			struct Modification
+			{
+				Generation generation;
+				util::RegistryKeyType id;
+				bool insertion;
+			};
+			typedef std::deque<Modification> Modifications;
+
+			static const std::size_t _MODIFICATIONS_NUMBER;	//!< number of kept modifications
+
+			static boost::mutex _mutex;	//!< protects all the following attributes
+			static Entries _entries;
+			static LRUList _lru;	//!< most recently used first
+			static EntriesByObject _entriesByObject;
+			static EntriesByTable _entriesByReadTable;
+			static EntriesByTable _entriesByTable;
+			static std::set<Key> _entriesByAnyTable;
+			static std::size_t _size;
+			static std::size_t _maxSize;
+			static StatisticsMap _statistics;
+			static Generation _generation;	//!< number of modifications received
+			static Modifications _modifications;	//!< last modifications, oldest first
+
+			static void _erase(Entries::iterator it);
+
+			static bool _isModifiedSince(
+				Generation generation,
+				const util::RegistryBase::ReadRecorder::Keys& dependencies,
+				const Tables& tables,
+				bool anyTable
+			);
+
+			static void _invalidate(const std::set<Key>& keys);
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Writes a stored response on a stream.
+			/// The dependencies of the response are recorded by the current
+			/// registries read recorder, so a cached response can be part of an other
+			/// one.
+			/// @param key the response to read
+			/// @param stream stream to write on
+			/// @return true if the response was found
+			static bool Read(
+				const Key& key,
+				std::ostream& stream
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Current generation of the cache, to read before the generation of a
+			/// response to store.
+			/// @return the number of modifications received
+			static Generation GetGeneration();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Stores a response.
+			/// The response is not stored if one of its dependencies was modified
+			/// since the generation, or if the modifications since the generation
+			/// are not known anymore.
+			/// @param key the response to store
+			/// @param generation generation of the cache read before the generation
+			/// of the response
+			/// @param name name of the object of the response, for the statistics
+			/// @param content the response
+			/// @param dependencies keys of the objects read by the response
+			/// @param tables tables whose any modification invalidates the response
+			/// @param anyTable if true, any modification invalidates the response
+			/// @param duration maximal duration of the storage
+			static void Write(
+				const Key& key,
+				Generation generation,
+				const std::string& name,
+				const std::string& content,
+				const util::RegistryBase::ReadRecorder::Keys& dependencies,
+				const Tables& tables,
+				bool anyTable,
+				const boost::posix_time::time_duration& duration
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Removes the responses depending on a modified object.
+			/// Registered by db::DB::AddModificationCallback.
+			/// @param modifEvent the modification
+			static void Invalidate(const db::DB::DBModifEvent& modifEvent);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Removes all the stored responses.
+			static void Clear();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Changes the maximal size of the stored responses.
+			/// @param value the size in bytes
+			static void SetMaxSize(std::size_t value);
+
+			//! @name Statistics
+			//@{
+				static std::size_t GetMaxSize();
+				static std::size_t GetSize();
+				static std::size_t GetEntriesNumber();
+				static StatisticsMap GetStatistics();
+			//@}
+		};
+}	}
+
+#endif // SYNTHESE_server_ResponseCache_hpp__
@@ -24,6 +24,7 @@
 
 #include "SYNTHESEInformationService.hpp"
 
+#include "HTTPConnection.hpp"
 #include "RequestException.h"
 #include "Request.h"
 #include "ServerModule.h"
@@ -42,6 +43,9 @@ namespace synthese
 	namespace server
 	{
 		const string SYNTHESEInformationService::ATTR_START_TIME = "start_time";
+		const string SYNTHESEInformationService::ATTR_CONNECTIONS_NUMBER = "connections_number";
+		const string SYNTHESEInformationService::ATTR_REUSED_CONNECTIONS_NUMBER = "reused_connections_number";
+		const string SYNTHESEInformationService::ATTR_KEEP_ALIVE_REQUESTS_NUMBER = "keep_alive_requests_number";
 		
 
 
@@ -65,6 +69,12 @@ namespace synthese
 		) const {
 			ParametersMap map;
 			map.insert(ATTR_START_TIME, ServerModule::GetStartingTime());
+
+			// HTTP connections
+			HTTPConnection::Statistics statistics(HTTPConnection::GetStatistics());
+			map.insert(ATTR_CONNECTIONS_NUMBER, statistics.connectionsNumber);
+			map.insert(ATTR_REUSED_CONNECTIONS_NUMBER, statistics.reusedConnectionsNumber);
+			map.insert(ATTR_KEEP_ALIVE_REQUESTS_NUMBER, statistics.keepAliveRequestsNumber);
 			return map;
 		}
 		
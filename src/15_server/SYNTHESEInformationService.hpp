@@ -45,6 +45,9 @@ namespace synthese
 		{
 		public:
 			static const std::string ATTR_START_TIME;
+			static const std::string ATTR_CONNECTIONS_NUMBER;
+			static const std::string ATTR_REUSED_CONNECTIONS_NUMBER;
+			static const std::string ATTR_KEEP_ALIVE_REQUESTS_NUMBER;
 			
 		protected:
 			//! \name Page parameters
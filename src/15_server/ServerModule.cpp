@@ -31,6 +31,7 @@
 
 #include <iomanip>
 #include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/bind.hpp>
 #include <boost/iostreams/copy.hpp>
@@ -48,6 +49,7 @@
   #define DEFAULT_TEMP_DIR "c:/temp"
 #endif
 
+#include "HTTPChunkedSink.hpp"
 #include "HTTPReply.hpp"
 #include "HTTPRequest.hpp"
 #include "Log.h"
@@ -56,6 +58,8 @@
 #include "RequestException.h"
 #include "ActionException.h"
 #include "PermanentThread.hpp"
+#include "RequestScheduler.hpp"
+#include "ResponseCache.hpp"
 
 using namespace boost;
 using namespace std;
@@ -75,7 +79,7 @@ namespace synthese
 	{
 		boost::asio::io_service ServerModule::_io_service;
 		boost::asio::ip::tcp::acceptor ServerModule::_acceptor(ServerModule::_io_service);
-		connection_ptr ServerModule::_new_connection(new HTTPConnection(ServerModule::_io_service, &ServerModule::HandleRequest));
+		connection_ptr ServerModule::_new_connection(new HTTPConnection(ServerModule::_io_service, &ServerModule::HandleRequest, &ServerModule::DispatchRequest));
 		ServerModule::Threads ServerModule::_threads;
 		recursive_mutex ServerModule::_threadManagementMutex;
 		time_duration ServerModule::_sessionMaxDuration(minutes(30));
@@ -86,6 +90,8 @@ namespace synthese
 
 		const string ServerModule::MODULE_PARAM_PORT ("port");
 		const string ServerModule::MODULE_PARAM_NB_THREADS ("nb_threads");
+		const string ServerModule::MODULE_PARAM_NB_IO_THREADS ("nb_io_threads");
+		const string ServerModule::MODULE_PARAM_REQUEST_LANES ("request_lanes");
 		const string ServerModule::MODULE_PARAM_LOG_LEVEL ("log_level");
 		const string ServerModule::MODULE_PARAM_SMTP_SERVER ("smtp_server");
 		const string ServerModule::MODULE_PARAM_SMTP_PORT ("smtp_port");
@@ -93,6 +99,9 @@ namespace synthese
 		const string ServerModule::MODULE_PARAM_AUTO_LOGIN_USER("auto_login_user");
 		const string ServerModule::MODULE_PARAM_HTTP_TRACE_PATH = "http_trace_path";
 		const string ServerModule::MODULE_PARAM_HTTP_FORCE_GZIP = "http_force_gzip";
+		const string ServerModule::MODULE_PARAM_RESPONSE_CACHE_MAX_SIZE = "response_cache_max_size";
+		const string ServerModule::MODULE_PARAM_HTTP_KEEP_ALIVE_TIMEOUT = "http_keep_alive_timeout";
+		const string ServerModule::MODULE_PARAM_HTTP_KEEP_ALIVE_MAX_REQUESTS = "http_keep_alive_max_requests";
 
 		const std::string ServerModule::VERSION(SYNTHESE_VERSION);
 #ifdef WIN32 // CMake is not able to extract the current revision number and the build date in other OS than linux right now
@@ -113,6 +122,8 @@ namespace synthese
 		{
 			RegisterParameter(ServerModule::MODULE_PARAM_PORT, "8080", &ServerModule::ParameterCallback);
 			RegisterParameter(ServerModule::MODULE_PARAM_NB_THREADS, "5", &ServerModule::ParameterCallback);
+			RegisterParameter(ServerModule::MODULE_PARAM_NB_IO_THREADS, "2", &ServerModule::ParameterCallback);
+			RegisterParameter(ServerModule::MODULE_PARAM_REQUEST_LANES, "", &ServerModule::ParameterCallback);
 			RegisterParameter(ServerModule::MODULE_PARAM_LOG_LEVEL, "1", &ServerModule::ParameterCallback);
 			RegisterParameter(ServerModule::MODULE_PARAM_SMTP_SERVER, "smtp", &ServerModule::ParameterCallback);
 			RegisterParameter(ServerModule::MODULE_PARAM_SMTP_PORT, "mail", &ServerModule::ParameterCallback);
@@ -120,6 +131,12 @@ namespace synthese
 			RegisterParameter(ServerModule::MODULE_PARAM_AUTO_LOGIN_USER, "", &ServerModule::ParameterCallback);
 			RegisterParameter(ServerModule::MODULE_PARAM_HTTP_TRACE_PATH, "", &ServerModule::ParameterCallback);
 			RegisterParameter(ServerModule::MODULE_PARAM_HTTP_FORCE_GZIP, "", &ServerModule::ParameterCallback);
+			RegisterParameter(ServerModule::MODULE_PARAM_RESPONSE_CACHE_MAX_SIZE, "64", &ServerModule::ParameterCallback);
+			RegisterParameter(ServerModule::MODULE_PARAM_HTTP_KEEP_ALIVE_TIMEOUT, "15", &ServerModule::ParameterCallback);
+			RegisterParameter(ServerModule::MODULE_PARAM_HTTP_KEEP_ALIVE_MAX_REQUESTS, "100", &ServerModule::ParameterCallback);
+
+			// Invalidation of the cached responses
+			db::DB::AddModificationCallback(&ResponseCache::Invalidate);
 		}
 
 
@@ -172,7 +189,8 @@ namespace synthese
 
 			Log::GetInstance().info(
 				"HTTP Server is now listening on port " + GetParameter(ServerModule::MODULE_PARAM_PORT) +
-				" with at least "+ GetParameter(ServerModule::MODULE_PARAM_NB_THREADS) + " threads ..."
+				" with "+ GetParameter(ServerModule::MODULE_PARAM_NB_IO_THREADS) + " I/O threads and at least "+
+				GetParameter(ServerModule::MODULE_PARAM_NB_THREADS) + " request threads ..."
 			);
 		}
 
@@ -181,11 +199,16 @@ namespace synthese
 		{
 			UnregisterParameter(ServerModule::MODULE_PARAM_PORT);
 			UnregisterParameter(ServerModule::MODULE_PARAM_NB_THREADS);
+			UnregisterParameter(ServerModule::MODULE_PARAM_NB_IO_THREADS);
+			UnregisterParameter(ServerModule::MODULE_PARAM_REQUEST_LANES);
 			UnregisterParameter(ServerModule::MODULE_PARAM_LOG_LEVEL);
 			UnregisterParameter(ServerModule::MODULE_PARAM_SMTP_SERVER);
 			UnregisterParameter(ServerModule::MODULE_PARAM_SMTP_PORT);
 			UnregisterParameter(ServerModule::MODULE_PARAM_SESSION_MAX_DURATION);
 			UnregisterParameter(ServerModule::MODULE_PARAM_HTTP_TRACE_PATH);
+			UnregisterParameter(ServerModule::MODULE_PARAM_RESPONSE_CACHE_MAX_SIZE);
+			UnregisterParameter(ServerModule::MODULE_PARAM_HTTP_KEEP_ALIVE_TIMEOUT);
+			UnregisterParameter(ServerModule::MODULE_PARAM_HTTP_KEEP_ALIVE_MAX_REQUESTS);
 
 			ServerModule::_io_service.stop();
 		}
@@ -218,9 +241,10 @@ namespace synthese
 			{
 				Log::GetInstance ().setLevel (static_cast<Log::Level>(lexical_cast<int>(value)));
 			}
-			if(name == MODULE_PARAM_NB_THREADS)
-			{
-
+			if(	name == MODULE_PARAM_NB_THREADS ||
+				name == MODULE_PARAM_REQUEST_LANES
+			){
+				_SetRequestLanes();
 			}
 			if(name == MODULE_PARAM_SESSION_MAX_DURATION)
 			{
@@ -245,6 +269,22 @@ namespace synthese
 			{
 				_forceGZip = (value == "1");
 			}
+			if(name == MODULE_PARAM_RESPONSE_CACHE_MAX_SIZE)
+			{
+				// In megabytes
+				ResponseCache::SetMaxSize(lexical_cast<size_t>(value) * 1024 * 1024);
+			}
+			if(	name == MODULE_PARAM_HTTP_KEEP_ALIVE_TIMEOUT ||
+				name == MODULE_PARAM_HTTP_KEEP_ALIVE_MAX_REQUESTS
+			){
+				// In seconds, 0 disables the persistent connections
+				string timeout(GetParameter(MODULE_PARAM_HTTP_KEEP_ALIVE_TIMEOUT));
+				string maxRequests(GetParameter(MODULE_PARAM_HTTP_KEEP_ALIVE_MAX_REQUESTS));
+				HTTPConnection::SetKeepAliveParameters(
+					seconds(timeout.empty() ? 0 : lexical_cast<long>(timeout)),
+					maxRequests.empty() ? 0 : lexical_cast<size_t>(maxRequests)
+				);
+			}
 		}
 
 
@@ -254,7 +294,7 @@ namespace synthese
 			if (!e)
 			{
 				_new_connection->start();
-				_new_connection.reset(new HTTPConnection(_io_service, &ServerModule::HandleRequest));
+				_new_connection.reset(new HTTPConnection(_io_service, &ServerModule::HandleRequest, &ServerModule::DispatchRequest));
 				_acceptor.async_accept(
 					_new_connection->socket(),
 					boost::bind(
@@ -266,6 +306,128 @@ namespace synthese
 		}
 
 
+		bool ServerModule::DispatchRequest(
+			const HTTPRequest& req,
+			const HTTPConnection::Task& task
+		){
+			// Service or action of the request, read in the query string or in the
+			// posted form
+			string key;
+			try
+			{
+				ParametersMap map;
+				size_t separator(req.uri.find('?'));
+				if(separator != string::npos)
+				{
+					map = ParametersMap(req.uri.substr(separator + 1));
+				}
+				HTTPRequest::Headers::const_iterator it(req.headers.find("Content-Type"));
+				if(	it != req.headers.end() &&
+					starts_with(it->second, "application/x-www-form-urlencoded")
+				){
+					ParametersMap postMap(req.postData);
+					map.merge(postMap);
+				}
+				key = map.getDefault<string>(Request::PARAMETER_SERVICE);
+				if(key.empty())
+				{
+					key = map.getDefault<string>(Request::PARAMETER_FUNCTION);
+				}
+				if(key.empty())
+				{
+					key = map.getDefault<string>(Request::PARAMETER_ACTION);
+				}
+			}
+			catch(...)
+			{
+				// The malformed requests are reported by the handler
+			}
+
+			return RequestScheduler::Push(RequestScheduler::GetLane(key), task);
+		}
+
+
+
+		void ServerModule::_SetRequestLanes()
+		{
+			try
+			{
+				string threadsNumber(GetParameter(MODULE_PARAM_NB_THREADS));
+				RequestScheduler::SetLanes(
+					GetParameter(MODULE_PARAM_REQUEST_LANES),
+					threadsNumber.empty() ? 1 : lexical_cast<size_t>(threadsNumber)
+				);
+			}
+			catch(std::exception& e)
+			{
+				Log::GetInstance().error("Invalid request lanes definition", e);
+				return;
+			}
+			_AdjustRequestWorkers();
+		}
+
+
+
+		void ServerModule::_AdjustRequestWorkers()
+		{
+			recursive_mutex::scoped_lock lock(_threadManagementMutex);
+
+			// The workers are started with the I/O threads (see KillAllHTTPThreads)
+			typedef map<string, vector<string> > WorkersByLane;
+			WorkersByLane workers;
+			bool serverRunning(false);
+			BOOST_FOREACH(const Threads::value_type& it, _threads)
+			{
+				if(!it.second.isHTTPThread)
+				{
+					continue;
+				}
+				if(it.second.lane.empty())
+				{
+					serverRunning = true;
+				}
+				else if(it.second.status == ThreadInfo::THREAD_WAITING)
+				{
+					// The waiting workers are stopped first
+					workers[it.second.lane].insert(workers[it.second.lane].begin(), it.first);
+				}
+				else
+				{
+					workers[it.second.lane].push_back(it.first);
+				}
+			}
+			if(!serverRunning)
+			{
+				return;
+			}
+
+			typedef map<string, size_t> LanesThreadsNumbers;
+			LanesThreadsNumbers lanesThreadsNumbers(RequestScheduler::GetThreadsNumbers());
+
+			// Workers of the removed lanes and workers in excess
+			BOOST_FOREACH(const WorkersByLane::value_type& it, workers)
+			{
+				LanesThreadsNumbers::const_iterator itLane(lanesThreadsNumbers.find(it.first));
+				size_t threadsNumber(itLane == lanesThreadsNumbers.end() ? 0 : itLane->second);
+				for(size_t i(0); i + threadsNumber < it.second.size(); ++i)
+				{
+					KillThread(it.second[i], false);
+				}
+			}
+
+			// Missing workers, including the ones of the new lanes
+			BOOST_FOREACH(const LanesThreadsNumbers::value_type& it, lanesThreadsNumbers)
+			{
+				WorkersByLane::const_iterator itWorkers(workers.find(it.first));
+				for(size_t i(itWorkers == workers.end() ? 0 : itWorkers->second.size()); i < it.second; ++i)
+				{
+					AddRequestWorker(it.first);
+				}
+			}
+		}
+
+
+
 		void ServerModule::HandleRequest(
 			const HTTPRequest& req,
 			HTTPReply& rep
@@ -324,15 +486,62 @@ namespace synthese
 					gzipCompression = (formats.find("gzip") != formats.end());
 				}
 
+				bool compression(
+					_forceGZip ||
+					(	gzipCompression &&
+						req.ipaddr != "127.0.0.1" // Never compress for localhost use
+				)	);
+
+				// Streamed output : the output is sent by chunks while it is written,
+				// if the function allows it and if the client understands HTTP/1.1
+				if(	!_httpTracePath &&
+					!rep.sender.empty() &&
+					(	req.http_version_major > 1 ||
+						(req.http_version_major == 1 && req.http_version_minor >= 1)
+					) &&
+					request.getFunction().get() &&
+					request.getFunction()->isStreamable()
+				){
+					if(compression)
+					{
+						rep.headers.insert(make_pair("Content-Encoding", "gzip"));
+					}
+
+					// If the run fails after the first chunk, the reply stays
+					// incomplete : the connection is closed without the last chunk
+					HTTPChunkedSink sink(
+						rep,
+						boost::bind(&ServerModule::_SetContentHeaders, _1, boost::ref(request))
+					);
+					{
+						filtering_stream<output> fs;
+						if(compression)
+						{
+							fs.push(gzip_compressor());
+						}
+						fs.push(sink);
+						request.run(fs);
+						fs.reset();
+					}
+
+					if(!sink.finish())
+					{
+						// The output was shorter than a chunk
+						_SetContentHeaders(rep, request);
+						rep.headers.insert(make_pair("Content-Length", lexical_cast<string>(rep.content.size())));
+					}
+
+					SetCurrentThreadWaiting();
+					return;
+				}
+
 				// Request run
 				stringstream ros;
 				request.run(ros);
 				
 				// Output
-				if(	_forceGZip ||
-					(	gzipCompression &&
-						req.ipaddr != "127.0.0.1" // Never compress for localhost use
-				)	){
+				if(compression)
+				{
 					stringstream os;
 					filtering_stream<output> fs;
 					fs.push(gzip_compressor());
@@ -346,22 +555,8 @@ namespace synthese
 				{
 					rep.content.append(ros.str());
 				}
-				rep.status = HTTPReply::ok;
 				rep.headers.insert(make_pair("Content-Length", lexical_cast<string>(rep.content.size())));
-				rep.headers.insert(make_pair("Content-Type", request.getOutputMimeType() + "; charset=utf-8"));
-				if(request.getFunction().get() && !request.getFunction()->getFileName().empty())
-				{
-					rep.headers.insert(make_pair("Content-Disposition", "attachement; filename="+ request.getFunction()->getFileName()));
-				}
-				if(request.getFunction().get() && !request.getFunction()->getMaxAge().is_not_a_date_time())
-				{
-					rep.headers.insert(make_pair("Cache-Control", "public, max-age="+
-												 lexical_cast<string>(request.getFunction()->getMaxAge().total_seconds())));
-				}
-				else
-				{
-					_SetCookieHeaders(rep, request.getCookiesMap());
-				}
+				_SetContentHeaders(rep, request);
 
 				if(_httpTracePath)
 				{
@@ -425,6 +620,29 @@ namespace synthese
 
 
 
+		void ServerModule::_SetContentHeaders(
+			HTTPReply& rep,
+			DynamicRequest& request
+		){
+			rep.status = HTTPReply::ok;
+			rep.headers.insert(make_pair("Content-Type", request.getOutputMimeType() + "; charset=utf-8"));
+			if(request.getFunction().get() && !request.getFunction()->getFileName().empty())
+			{
+				rep.headers.insert(make_pair("Content-Disposition", "attachement; filename="+ request.getFunction()->getFileName()));
+			}
+			if(request.getFunction().get() && !request.getFunction()->getMaxAge().is_not_a_date_time())
+			{
+				rep.headers.insert(make_pair("Cache-Control", "public, max-age="+
+											 lexical_cast<string>(request.getFunction()->getMaxAge().total_seconds())));
+			}
+			else
+			{
+				_SetCookieHeaders(rep, request.getCookiesMap());
+			}
+		}
+
+
+
 		const ServerModule::Threads& ServerModule::GetThreads()
 		{
 			return _threads;
@@ -437,18 +655,45 @@ namespace synthese
 			recursive_mutex::scoped_lock lock(_threadManagementMutex);
 			Threads::iterator it(_threads.find(key));
 			if(it == _threads.end()) return;
-			boost::shared_ptr<thread> theThread(it->second.theThread);
+			ThreadInfo info(it->second);
 
 			_threads.erase(it);
 
-			theThread->interrupt();
+			info.theThread->interrupt();
 			Log::GetInstance ().info ("Attempted to kill the thread "+ key);
 			if(	autoRestart &&
-				GetThreadInfo(key).isHTTPThread &&
-				_threads.size() < lexical_cast<size_t>(GetParameter(ServerModule::MODULE_PARAM_NB_THREADS))
+				info.isHTTPThread
 			){
-				thread::id newId(AddHTTPThread());
-				Log::GetInstance ().info ("Create the thread "+ lexical_cast<string>(newId) +" because the minimum threads number was reached");
+				// Remaining threads of the same kind
+				size_t threadsNumber(0);
+				BOOST_FOREACH(const Threads::value_type& itThread, _threads)
+				{
+					if(itThread.second.isHTTPThread && itThread.second.lane == info.lane)
+					{
+						++threadsNumber;
+					}
+				}
+
+				size_t minThreadsNumber(0);
+				if(info.lane.empty())
+				{
+					minThreadsNumber = lexical_cast<size_t>(GetParameter(ServerModule::MODULE_PARAM_NB_IO_THREADS));
+				}
+				else
+				{
+					map<string, size_t> lanesThreadsNumbers(RequestScheduler::GetThreadsNumbers());
+					map<string, size_t>::const_iterator itLane(lanesThreadsNumbers.find(info.lane));
+					if(itLane != lanesThreadsNumbers.end())
+					{
+						minThreadsNumber = itLane->second;
+					}
+				}
+
+				if(threadsNumber < minThreadsNumber)
+				{
+					thread::id newId(info.lane.empty() ? AddHTTPThread() : AddRequestWorker(info.lane));
+					Log::GetInstance ().info ("Create the thread "+ lexical_cast<string>(newId) +" because the minimum threads number was reached");
+				}
 			}
 		}
 
@@ -487,11 +732,22 @@ namespace synthese
 
 			if(autoRestart)
 			{
-				size_t threadsNumber(lexical_cast<size_t>(GetParameter(ServerModule::MODULE_PARAM_NB_THREADS)));
+				// I/O threads
+				size_t threadsNumber(lexical_cast<size_t>(GetParameter(ServerModule::MODULE_PARAM_NB_IO_THREADS)));
 				for (std::size_t i = 0; i < threadsNumber; ++i)
 				{
 					ServerModule::AddHTTPThread();
 				}
+
+				// Request workers
+				typedef map<string, size_t> LanesThreadsNumbers;
+				BOOST_FOREACH(const LanesThreadsNumbers::value_type& it, RequestScheduler::GetThreadsNumbers())
+				{
+					for (std::size_t i = 0; i < it.second; ++i)
+					{
+						ServerModule::AddRequestWorker(it.first);
+					}
+				}
 			}
 			else
 			{
@@ -531,6 +787,23 @@ namespace synthese
 
 
 
+		boost::thread::id ServerModule::AddRequestWorker(
+			const std::string& lane
+		){
+			recursive_mutex::scoped_lock lock(_threadManagementMutex);
+
+			boost::shared_ptr<thread> theThread(
+				AddThread(
+					boost::bind(&RequestScheduler::RunWorker, lane),
+					"HTTP "+ lane +" requests",
+					true
+			)	);
+			_threads[lexical_cast<string>(theThread->get_id())].lane = lane;
+			return theThread->get_id();
+		}
+
+
+
 		void ServerModule::SetCurrentThreadAnalysing( const std::string& queryString )
 		{
 			try
@@ -83,6 +83,7 @@ namespace synthese
 	*/
 	namespace server
 	{
+		class DynamicRequest;
 		class Session;
 		struct HTTPRequest;
 		struct HTTPReply;
@@ -116,6 +117,7 @@ namespace synthese
 				std::string queryString;
 				std::string description;
 				bool isHTTPThread;
+				std::string lane;	//!< lane of a request worker, empty for an I/O thread
 				boost::posix_time::ptime lastChangeTime;
 			};
 
@@ -124,6 +126,8 @@ namespace synthese
 			//! DbModule parameters
 			static const std::string MODULE_PARAM_PORT;
 			static const std::string MODULE_PARAM_NB_THREADS;
+			static const std::string MODULE_PARAM_NB_IO_THREADS;
+			static const std::string MODULE_PARAM_REQUEST_LANES;
 			static const std::string MODULE_PARAM_LOG_LEVEL;
 			static const std::string MODULE_PARAM_SMTP_SERVER;
 			static const std::string MODULE_PARAM_SMTP_PORT;
@@ -131,6 +135,9 @@ namespace synthese
 			static const std::string MODULE_PARAM_AUTO_LOGIN_USER;
 			static const std::string MODULE_PARAM_HTTP_TRACE_PATH;
 			static const std::string MODULE_PARAM_HTTP_FORCE_GZIP;
+			static const std::string MODULE_PARAM_RESPONSE_CACHE_MAX_SIZE;
+			static const std::string MODULE_PARAM_HTTP_KEEP_ALIVE_TIMEOUT;
+			static const std::string MODULE_PARAM_HTTP_KEEP_ALIVE_MAX_REQUESTS;
 
 			static const std::string VERSION;
 			static const std::string REVISION;
@@ -165,6 +172,7 @@ namespace synthese
 
 		public:
 			static boost::thread::id AddHTTPThread();
+			static boost::thread::id AddRequestWorker(const std::string& lane);
 			
 			template<class Callable>
 			static boost::shared_ptr<boost::thread> AddThread(
@@ -205,6 +213,15 @@ namespace synthese
 				const boost::system::error_code& e
 			);
 
+			/// Queue the execution of a request in its lane.
+			/// @param req HTTP request to run
+			/// @param task the execution of the request
+			/// @return false if the queue of the lane is full
+			static bool DispatchRequest(
+				const HTTPRequest& req,
+				const HTTPConnection::Task& task
+			);
+
 			/// Handle a request and produce a reply.
 			/// @param req HTTP request to handle
 			/// @param rep HTTP Reply to write the result on
@@ -220,6 +237,21 @@ namespace synthese
 				const CookiesMap& cookiesMap
 			);
 
+			/// Sets the status and the headers describing the content of a reply
+			/// (except the length), once the request has been run or has started
+			/// to write its output.
+			static void _SetContentHeaders(
+				HTTPReply& httpReply,
+				DynamicRequest& request
+			);
+
+			/// Applies the lanes parameters to the request scheduler.
+			static void _SetRequestLanes();
+
+			/// Starts and stops the request workers according to the threads numbers
+			/// of the lanes, if the HTTP server runs.
+			static void _AdjustRequestWorkers();
+
 			// Launch the permanent threads
 			static void _LaunchPermanentThreads();
 		};
@@ -34,6 +34,7 @@
 #include "ThreadKillAction.h"
 #include "Profile.h"
 #include "QuitAction.hpp"
+#include "RequestScheduler.hpp"
 #include "StaticActionRequest.h"
 
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -136,6 +137,47 @@ namespace synthese
 
 			stream << t.close();
 
+			// Queues of the requests
+			stream << "<h1>Files d'attente des requêtes</h1>";
+			HTMLTable::ColsVector cl;
+			cl.push_back("File");
+			cl.push_back("Threads");
+			cl.push_back("En cours");
+			cl.push_back("En attente");
+			cl.push_back("Attente max");
+			cl.push_back("Exécutées");
+			cl.push_back("Refusées");
+			cl.push_back("Durée d'attente moyenne");
+			cl.push_back("Durée d'attente max");
+			HTMLTable tl(cl, ResultHTMLTable::CSS_CLASS);
+			stream << tl.open();
+			BOOST_FOREACH(const RequestScheduler::Statistics& lane, RequestScheduler::GetStatistics())
+			{
+				stream << tl.row();
+				stream << tl.col() << lane.lane;
+				stream << tl.col() << lane.threadsNumber;
+				stream << tl.col() << lane.runningRequests;
+				stream << tl.col() << lane.queueLength;
+				stream << tl.col();
+				if(lane.maxQueueLength)
+				{
+					stream << lane.maxQueueLength;
+				}
+				else
+				{
+					stream << "illimitée";
+				}
+				stream << tl.col() << lane.executedRequests;
+				stream << tl.col() << lane.refusedRequests;
+				stream << tl.col();
+				if(lane.executedRequests + lane.runningRequests)
+				{
+					stream << (lane.totalWaitingTime.total_milliseconds() / static_cast<long>(lane.executedRequests + lane.runningRequests)) << " ms";
+				}
+				stream << tl.col() << lane.maxWaitingTime.total_milliseconds() << " ms";
+			}
+			stream << tl.close();
+
 			stream << "<h1>Arrêt du serveur</h1>";
 
 			StaticActionRequest<QuitAction> quitAction(request);
@@ -0,0 +1,515 @@
+/** CSVReader class implementation.
+	@file CSVReader.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "CSVReader.hpp"
+
+#include "Exception.h"
+#include "IConv.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <boost/filesystem/operations.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	using namespace util;
+
+	namespace impex
+	{
+		const size_t CSVReader::NO_COLUMN(static_cast<size_t>(-1));
+		const size_t CSVReader::NO_BUFFER(static_cast<size_t>(-1));
+
+		namespace
+		{
+			// Powers of 10 exactly represented by a double
+			const double EXACT_POWERS_OF_10[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+				1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+				1e21, 1e22
+			};
+			const int MAX_EXACT_POWER_OF_10(22);
+			const unsigned long long MAX_EXACT_MANTISSA(1ULL << 53);
+			const int MAX_MANTISSA_DIGITS(19);
+
+			bool isSpace(char c)
+			{
+				return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+			}
+
+			bool isDigit(char c)
+			{
+				return c >= '0' && c <= '9';
+			}
+
+			// Reads the digits at the beginning of the range
+			// @return false if there is no digit
+			bool readUnsigned(const char*& position, const char* end, long& value)
+			{
+				const char* begin(position);
+				long result(0);
+				for(; position < end && isDigit(*position); ++position)
+				{
+					result = result * 10 + (*position - '0');
+				}
+				value = result;
+				return position != begin;
+			}
+		}
+
+
+
+		CSVReader::CSVReader(
+			const filesystem::path& path,
+			char separator,
+			char quote,
+			char escape,
+			const string& charset
+		):	_path(path),
+			_separator(separator),
+			_quote(quote),
+			_escape(escape),
+			_begin(NULL),
+			_position(NULL),
+			_end(NULL),
+			_rowNumber(0),
+			_usedBuffers(0)
+		{
+			if(!charset.empty())
+			{
+				_iconv.reset(new IConv(charset, "UTF-8"));
+			}
+
+			try
+			{
+				if(!filesystem::exists(path))
+				{
+					throw Exception("Could no open the file " + path.file_string());
+				}
+
+				// An empty file cannot be mapped
+				if(filesystem::file_size(path))
+				{
+					_file.open(path.file_string());
+					_position = _file.data();
+					_end = _position + _file.size();
+				}
+			}
+			catch(std::exception&)
+			{
+				throw Exception("Could no open the file " + path.file_string());
+			}
+
+			// UTF-8 byte order mark
+			if(_end - _position >= 3 && !memcmp(_position, "\xEF\xBB\xBF", 3))
+			{
+				_position += 3;
+			}
+			_begin = _position;
+		}
+
+
+
+		void CSVReader::rewind()
+		{
+			_position = _begin;
+			_rowNumber = 0;
+			_fields.clear();
+			_usedBuffers = 0;
+		}
+
+
+
+		bool CSVReader::next()
+		{
+			_fields.clear();
+			_usedBuffers = 0;
+
+			// Blank lines are ignored
+			while(_position < _end && (*_position == '\n' || *_position == '\r'))
+			{
+				++_position;
+			}
+			if(_position >= _end)
+			{
+				return false;
+			}
+
+			const char* position(_position);
+			while(true)
+			{
+				Field field;
+				field.begin = position;
+				field.buffer = NO_BUFFER;
+				for(; position < _end; ++position)
+				{
+					char c(*position);
+					if(c == _separator || c == '\n')
+					{
+						break;
+					}
+					if(	(_quote && c == _quote) ||
+						(_escape && c == _escape)
+					){
+						_readEscapedField(field, position);
+						break;
+					}
+				}
+				field.end = position;
+				_fields.push_back(field);
+
+				if(position >= _end)
+				{
+					break;
+				}
+				if(*position++ == '\n')
+				{
+					break;
+				}
+			}
+
+			_position = position;
+			++_rowNumber;
+			return true;
+		}
+
+
+
+		void CSVReader::_readEscapedField(
+			Field& field,
+			const char*& position
+		){
+			if(_usedBuffers == _buffers.size())
+			{
+				_buffers.push_back(string());
+			}
+			field.buffer = _usedBuffers++;
+			string& buffer(_buffers[field.buffer]);
+			buffer.assign(field.begin, position);
+
+			bool quoted(false);
+			for(; position < _end; ++position)
+			{
+				char c(*position);
+				if(_escape && c == _escape && position + 1 < _end)
+				{
+					++position;
+					buffer.push_back(*position == 'n' ? '\n' : *position);
+				}
+				else if(_quote && c == _quote)
+				{
+					if(quoted && position + 1 < _end && position[1] == _quote)
+					{
+						buffer.push_back(_quote);
+						++position;
+					}
+					else
+					{
+						quoted = !quoted;
+					}
+				}
+				else if(!quoted && (c == _separator || c == '\n'))
+				{
+					break;
+				}
+				else
+				{
+					buffer.push_back(c);
+				}
+			}
+		}
+
+
+
+		bool CSVReader::readHeader()
+		{
+			_columns.clear();
+			if(!next())
+			{
+				return false;
+			}
+			for(size_t column(0); column < _fields.size(); ++column)
+			{
+				_columns.insert(make_pair(getString(column), column));
+			}
+			return true;
+		}
+
+
+
+		size_t CSVReader::getColumn(
+			const string& name
+		) const {
+			Columns::const_iterator it(_columns.find(name));
+			return it == _columns.end() ? NO_COLUMN : it->second;
+		}
+
+
+
+		void CSVReader::_getField(
+			size_t column,
+			const char*& begin,
+			const char*& end
+		) const {
+			if(column >= _fields.size())
+			{
+				begin = end = NULL;
+				return;
+			}
+
+			const Field& field(_fields[column]);
+			if(field.buffer == NO_BUFFER)
+			{
+				begin = field.begin;
+				end = field.end;
+			}
+			else
+			{
+				const string& buffer(_buffers[field.buffer]);
+				begin = buffer.data();
+				end = begin + buffer.size();
+			}
+
+			while(begin < end && isSpace(*begin))
+			{
+				++begin;
+			}
+			while(end > begin && isSpace(*(end - 1)))
+			{
+				--end;
+			}
+		}
+
+
+
+		string CSVReader::getString(
+			size_t column
+		) const {
+			const char* begin;
+			const char* end;
+			_getField(column, begin, end);
+			if(begin == end)
+			{
+				return string();
+			}
+			string value(begin, end);
+			return _iconv.get() ? _iconv->convert(value) : value;
+		}
+
+
+
+		bool CSVReader::isEmpty(
+			size_t column
+		) const {
+			const char* begin;
+			const char* end;
+			_getField(column, begin, end);
+			return begin == end;
+		}
+
+
+
+		bool CSVReader::equals(
+			size_t column,
+			const char* value
+		) const {
+			const char* begin;
+			const char* end;
+			_getField(column, begin, end);
+			size_t size(strlen(value));
+			return static_cast<size_t>(end - begin) == size && (!size || !memcmp(begin, value, size));
+		}
+
+
+
+		bool CSVReader::getInt(
+			size_t column,
+			long& value
+		) const {
+			const char* begin;
+			const char* end;
+			_getField(column, begin, end);
+			return ParseInt(begin, end, value);
+		}
+
+
+
+		bool CSVReader::getDouble(
+			size_t column,
+			double& value
+		) const {
+			const char* begin;
+			const char* end;
+			_getField(column, begin, end);
+			return ParseDouble(begin, end, value);
+		}
+
+
+
+		bool CSVReader::getTime(
+			size_t column,
+			time_duration& value
+		) const {
+			const char* begin;
+			const char* end;
+			_getField(column, begin, end);
+			return ParseTime(begin, end, value);
+		}
+
+
+
+		bool CSVReader::ParseInt(
+			const char* begin,
+			const char* end,
+			long& value
+		){
+			bool negative(false);
+			if(begin < end && (*begin == '-' || *begin == '+'))
+			{
+				negative = (*begin == '-');
+				++begin;
+			}
+			long result;
+			if(!readUnsigned(begin, end, result) || begin != end)
+			{
+				return false;
+			}
+			value = negative ? -result : result;
+			return true;
+		}
+
+
+
+		bool CSVReader::ParseDouble(
+			const char* begin,
+			const char* end,
+			double& value
+		){
+			// Fast path : decimal number whose mantissa and power of 10 are exact
+			const char* position(begin);
+			bool negative(false);
+			if(position < end && (*position == '-' || *position == '+'))
+			{
+				negative = (*position == '-');
+				++position;
+			}
+			unsigned long long mantissa(0);
+			int digits(0);
+			int exponent(0);
+			bool withDigits(false);
+			bool inFraction(false);
+			for(; position < end; ++position)
+			{
+				char c(*position);
+				if(c == '.' && !inFraction)
+				{
+					inFraction = true;
+					continue;
+				}
+				if(!isDigit(c))
+				{
+					break;
+				}
+				withDigits = true;
+				if(digits < MAX_MANTISSA_DIGITS)
+				{
+					mantissa = mantissa * 10 + (c - '0');
+					if(mantissa)
+					{
+						++digits;
+					}
+					if(inFraction)
+					{
+						--exponent;
+					}
+				}
+				else if(!inFraction)
+				{
+					++exponent;
+				}
+			}
+			if(	position == end &&
+				withDigits &&
+				mantissa <= MAX_EXACT_MANTISSA &&
+				exponent >= -MAX_EXACT_POWER_OF_10 &&
+				exponent <= MAX_EXACT_POWER_OF_10
+			){
+				double result(static_cast<double>(mantissa));
+				if(exponent < 0)
+				{
+					result /= EXACT_POWERS_OF_10[-exponent];
+				}
+				else
+				{
+					result *= EXACT_POWERS_OF_10[exponent];
+				}
+				value = negative ? -result : result;
+				return true;
+			}
+
+			// Other numbers (exponent, long mantissa...)
+			if(begin == end || (position != end && !withDigits))
+			{
+				return false;
+			}
+			string text(begin, end);
+			char* textEnd(NULL);
+			double result(strtod(text.c_str(), &textEnd));
+			if(textEnd != text.c_str() + text.size())
+			{
+				return false;
+			}
+			value = result;
+			return true;
+		}
+
+
+
+		bool CSVReader::ParseTime(
+			const char* begin,
+			const char* end,
+			time_duration& value
+		){
+			long hoursNumber;
+			long minutesNumber;
+			long secondsNumber(0);
+			if(	!readUnsigned(begin, end, hoursNumber) ||
+				begin == end || *begin++ != ':' ||
+				!readUnsigned(begin, end, minutesNumber)
+			){
+				return false;
+			}
+			if(begin != end)
+			{
+				if(	*begin++ != ':' ||
+					!readUnsigned(begin, end, secondsNumber) ||
+					begin != end
+				){
+					return false;
+				}
+			}
+			value = time_duration(hoursNumber, minutesNumber, secondsNumber);
+			return true;
+		}
+}	}
@@ -0,0 +1,203 @@
+/** CSVReader class header.
+	@file CSVReader.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_impex_CSVReader_hpp__
+#define SYNTHESE_impex_CSVReader_hpp__
+
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace util
+	{
+		class IConv;
+	}
+
+	namespace impex
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Streaming reader of a CSV file.
+		///	@ingroup m16
+		//////////////////////////////////////////////////////////////////////////
+		/// The file is mapped in memory and read row by row : the fields of the
+		/// current row point directly in the file, except the fields containing
+		/// quotes or escape characters, which are copied once in buffers reused
+		/// by all the rows. The strings are built only when the value is read
+		/// by getString, and the numbers and the times are parsed in place.
+		///
+		/// The columns are found by their rank, or by their name in the header
+		/// if readHeader has been called : the rank of a column should be read
+		/// once after the header, and used for every row.
+		///
+		/// Format :
+		/// <ul>
+		///		<li>rows end by LF or CR LF</li>
+		///		<li>the values are trimmed</li>
+		///		<li>if a quote character is defined, the separators and the line
+		///		breaks between quotes belong to the value, and a doubled quote
+		///		between quotes is a quote</li>
+		///		<li>if an escape character is defined, it makes the following
+		///		character literal (n is a line break)</li>
+		///		<li>an UTF-8 byte order mark at the beginning of the file is
+		///		ignored</li>
+		/// </ul>
+		class CSVReader
+		{
+		public:
+			static const std::size_t NO_COLUMN;
+
+		private:
+			static const std::size_t NO_BUFFER;
+
+			struct Field
+			{
+				const char* begin;
+				const char* end;
+				std::size_t buffer;	//!< rank of the buffer containing the value, NO_BUFFER if the value is in the file
+			};
+			typedef std::vector<Field> Fields;
+			typedef std::map<std::string, std::size_t> Columns;
+
+			const boost::filesystem::path _path;
+			const char _separator;
+			const char _quote;
+			const char _escape;
+			boost::shared_ptr<util::IConv> _iconv;
+
+			boost::iostreams::mapped_file_source _file;
+			const char* _begin;
+			const char* _position;
+			const char* _end;
+			std::size_t _rowNumber;
+
+			Columns _columns;
+			Fields _fields;
+			std::vector<std::string> _buffers;
+			std::size_t _usedBuffers;
+
+			void _readEscapedField(
+				Field& field,
+				const char*& position
+			);
+
+			void _getField(
+				std::size_t column,
+				const char*& begin,
+				const char*& end
+			) const;
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Opens a file.
+			/// @param path the file to read
+			/// @param separator the separator of the values
+			/// @param quote the quote character (0 = no quotes)
+			/// @param escape the escape character (0 = no escape)
+			/// @param charset the charset of the file (empty = UTF-8)
+			/// @throws synthese::Exception if the file cannot be opened
+			CSVReader(
+				const boost::filesystem::path& path,
+				char separator,
+				char quote = 0,
+				char escape = 0,
+				const std::string& charset = std::string()
+			);
+
+			//! @name Getters
+			//@{
+				std::size_t getRowNumber() const { return _rowNumber; }
+				std::size_t getFieldsNumber() const { return _fields.size(); }
+			//@}
+
+			//! @name Reading
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// Reads the next row.
+				/// @return false if the end of the file is reached
+				bool next();
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Reads the next row as the names of the columns.
+				/// @return false if the end of the file is reached
+				bool readHeader();
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Goes back to the beginning of the file. The columns read in the
+				/// header are kept.
+				void rewind();
+
+				//////////////////////////////////////////////////////////////////////////
+				/// @param name the name of the column in the header
+				/// @return the rank of the column, NO_COLUMN if the column is not in
+				/// the header
+				std::size_t getColumn(const std::string& name) const;
+
+				bool hasColumn(const std::string& name) const { return getColumn(name) != NO_COLUMN; }
+			//@}
+
+			//! @name Values of the current row
+			/// A column which is not in the header or after the last field of the
+			/// row has an empty value.
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// @return the value converted in UTF-8
+				std::string getString(std::size_t column) const;
+
+				bool isEmpty(std::size_t column) const;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Compares the value without building a string.
+				bool equals(std::size_t column, const char* value) const;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// @return false if the value is not an integer (value is then unchanged)
+				bool getInt(std::size_t column, long& value) const;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// @return false if the value is not a number (value is then unchanged)
+				bool getDouble(std::size_t column, double& value) const;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// @return false if the value is not a time (value is then unchanged)
+				bool getTime(std::size_t column, boost::posix_time::time_duration& value) const;
+			//@}
+
+			//! @name Parsers
+			/// The parsers read the whole range : a value followed by other
+			/// characters is invalid.
+			//@{
+				static bool ParseInt(const char* begin, const char* end, long& value);
+				static bool ParseDouble(const char* begin, const char* end, double& value);
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Parses a time H:MM or H:MM:SS. The hours can be greater than 23.
+				static bool ParseTime(const char* begin, const char* end, boost::posix_time::time_duration& value);
+			//@}
+		};
+}	}
+
+#endif // SYNTHESE_impex_CSVReader_hpp__
@@ -43,6 +43,10 @@ namespace synthese
 
 	namespace impex
 	{
+		boost::mutex DataSource::_linksMutex;
+
+
+
 		DataSource::DataSource(
 			RegistryKeyType id
 		):	Registrable(id),
@@ -39,6 +39,7 @@
 #include <string>
 #include <boost/date_time/time_duration.hpp>
 #include <boost/foreach.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace synthese
 {
@@ -103,6 +104,7 @@ namespace synthese
 		private:
 			mutable Links _links;
 			mutable LinksWithoutCode _linksWithoutCode;
+			static boost::mutex _linksMutex;	//!< protects the links of all the sources against the tables loaded concurrently at startup
 
 		public:
 			/////////////////////////////////////////////////////////////////////
@@ -125,6 +127,7 @@ namespace synthese
 				template<class T>
 				void addLink(T& object, const std::string& code) const
 				{
+					boost::mutex::scoped_lock lock(_linksMutex);
 					if(code.empty())
 					{
 						_linksWithoutCode[T::Registry::KEY].insert(static_cast<Importable*>(&object));
@@ -150,6 +153,7 @@ namespace synthese
 				template<class T>
 				void removeLink(T& object, const std::string& code) const
 				{
+					boost::mutex::scoped_lock lock(_linksMutex);
 					if(code.empty())
 					{
 						LinksWithoutCode::iterator it(_linksWithoutCode.find(T::Registry::KEY));
@@ -113,6 +113,12 @@ namespace synthese
 			/// @author Hugues Romain
 			/// @date 2010
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The export is sent while it is written.
+			virtual bool isStreamable() const { return true; }
 		};
 	}
 }
@@ -159,9 +159,11 @@ namespace synthese
 			}
 
 			_autoImporterEnv->clear();
+			_autoImporter->resetSession();
 			bool result(_autoImporter->parseFiles());
 			if(result)
 			{
+				Importer::Phase phase(*_autoImporter, "save");
 				DBTransaction transaction(_autoImporter->save());
 				transaction.run();
 			}
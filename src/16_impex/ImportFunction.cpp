@@ -165,7 +165,10 @@ namespace synthese
 
 			if(_doImport && _importDone)
 			{
-				_importer->save().run();
+				{
+					Importer::Phase phase(*_importer, "save");
+					_importer->save().run();
+				}
 
 				// Result
 				_result.insert(ATTR_DONE, true);
@@ -188,6 +191,10 @@ namespace synthese
 				setw(2) << setfill('0') << now.time_of_day().minutes() << ":" <<
 				setw(2) << setfill('0') << now.time_of_day().seconds();
 			_result.insert(ATTR_IMPORT_END_TIME, dateStr.str());
+
+			// Durations of the phases
+			_importer->logPhasesReport();
+
 			_result.insert(ATTR_LOGS, _output.str());
 
 			return _result;
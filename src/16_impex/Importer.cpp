@@ -27,6 +27,8 @@
 
 #include <boost/filesystem/convenience.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 
 using namespace boost::filesystem;
 using namespace boost::posix_time;
@@ -46,6 +48,25 @@ namespace synthese
 
 
 
+		Importer::Phase::Phase(
+			const Importer& importer,
+			const std::string& name
+		):	_importer(importer),
+			_name(name),
+			_startTime(microsec_clock::local_time())
+		{}
+
+
+
+		Importer::Phase::~Phase()
+		{
+			_importer._phasesDurations.push_back(
+				make_pair(_name, microsec_clock::local_time() - _startTime)
+			);
+		}
+
+
+
 		//////////////////////////////////////////////////////////////////////////
 		void Importer::_log(
 			ImportLogLevel level,
@@ -232,6 +253,8 @@ namespace synthese
 			const boost::posix_time::ptime& startTime
 		) const	{
 
+			logPhasesReport();
+
 			{
 				stringstream dateStr;
 				ptime now(second_clock::local_time());
@@ -268,4 +291,31 @@ namespace synthese
 				_fileStream.reset();
 			}
 		}
+
+
+
+		void Importer::logPhasesReport() const
+		{
+			time_duration total(seconds(0));
+			BOOST_FOREACH(const PhasesDurations::value_type& phase, _phasesDurations)
+			{
+				_logInfo(
+					"Phase "+ phase.first +" was done in "+ boost::lexical_cast<string>(phase.second.total_milliseconds()) +" ms."
+				);
+				total += phase.second;
+			}
+			if(!_phasesDurations.empty())
+			{
+				_logInfo(
+					"Phases were done in "+ boost::lexical_cast<string>(total.total_milliseconds()) +" ms."
+				);
+			}
+		}
+
+
+
+		void Importer::resetSession() const
+		{
+			_phasesDurations.clear();
+		}
 }	}
@@ -28,8 +28,12 @@
 
 #include <ostream>
 #include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
 #include <boost/optional.hpp>
 #include <boost/date_time/gregorian/greg_date.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 namespace synthese
 {
@@ -65,6 +69,25 @@ namespace synthese
 			static const std::string ATTR_LEVEL;
 			static const std::string ATTR_TEXT;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Measures the duration of a phase of the import.
+			/// The duration is recorded at the destruction of the object and is
+			/// reported by logPhasesReport.
+			class Phase
+			{
+			private:
+				const Importer& _importer;
+				const std::string _name;
+				const boost::posix_time::ptime _startTime;
+
+			public:
+				Phase(
+					const Importer& importer,
+					const std::string& name
+				);
+				~Phase();
+			};
+
 			Importer(
 				util::Env& env,
 				const Import& import,
@@ -83,6 +106,9 @@ namespace synthese
 			mutable boost::optional<std::ostream&> _outputStream;		//!< An output stream where the content must be sent
 			util::ParametersMap& _pm;	//!< Parameters map where entries must be stored
 
+			typedef std::vector<std::pair<std::string, boost::posix_time::time_duration> > PhasesDurations;
+			mutable PhasesDurations _phasesDurations;	//!< Durations of the ended phases, in chronological order
+
 
 			virtual db::DBTransaction _save() const = 0;
 
@@ -135,6 +161,21 @@ namespace synthese
 			) const;
 
 
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Writes the duration of each phase of the import in the log.
+			void logPhasesReport() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Forgets the data of the previous parsing (phases durations, indexes
+			/// on the objects of the environment).
+			/// Must be called before each new parsing done by the same importer,
+			/// after the clearing of the environment.
+			virtual void resetSession() const;
+
+
 			//////////////////////////////////////////////////////////////////////////
 			/// Purge the obsolete data imported by the source
 			/// @param firstDayToKeep the first day to keep
@@ -161,6 +161,7 @@ namespace synthese
 					}
 					const FilePathsMap::mapped_type& path(it->second);
 
+					Phase phase(*this, key);
 					if(!_parse(path, key))
 					{
 						return false;
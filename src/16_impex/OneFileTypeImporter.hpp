@@ -138,6 +138,7 @@ namespace synthese
 				bool result(true);
 				BOOST_FOREACH(const FilePathsSet::value_type& path, _pathsSet)
 				{
+					Phase phase(*this, path.file_string());
 					result &= _parse(path);
 				}
 				return result;
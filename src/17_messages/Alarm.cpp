@@ -154,7 +154,7 @@ namespace synthese
 				boost::shared_ptr<ParametersMap> recipientsPM(new ParametersMap);
 
 				// Locks the linked objects
-				mutex::scoped_lock(_linkedObjectsMutex);
+				boost::mutex::scoped_lock lock(_linkedObjectsMutex);
 
 				// Loop on linked objects
 				LinkedObjectsToParametersMap(
@@ -179,11 +179,16 @@ namespace synthese
 			const ParametersMap& parameters
 		) const	{
 
-			// Locks the linked objects
-			mutex::scoped_lock(_linkedObjectsMutex);
+			// Copies the linked objects (the broadcast point may run a CMS rule
+			// reading the recipients of the message)
+			LinkedObjects linkedObjects;
+			{
+				boost::mutex::scoped_lock lock(_linkedObjectsMutex);
+				linkedObjects = _linkedObjects;
+			}
 
 			// Asks the broadcast point
-			return point.displaysMessage(_linkedObjects, parameters);
+			return point.displaysMessage(linkedObjects, parameters);
 		}
 
 
@@ -203,7 +208,7 @@ namespace synthese
 			const AlarmObjectLink& link
 		) const	{
 			// Locks the cache
-			mutex::scoped_lock(_linkedObjectsMutex);
+			boost::mutex::scoped_lock lock(_linkedObjectsMutex);
 
 			// Adds the object in the cache
 			LinkedObjects::iterator it(
@@ -227,7 +232,7 @@ namespace synthese
 		void Alarm::removeLinkedObject( const AlarmObjectLink& link ) const
 		{
 			// Locks the cache
-			mutex::scoped_lock(_linkedObjectsMutex);
+			boost::mutex::scoped_lock lock(_linkedObjectsMutex);
 
 			// Removes the object of the cache
 			LinkedObjects::iterator it(
@@ -273,7 +278,7 @@ namespace synthese
 		) const	{
 
 			// Locks the cache
-			mutex::scoped_lock(_linkedObjectsMutex);
+			boost::mutex::scoped_lock lock(_linkedObjectsMutex);
 
 			// Search the recipient key in the cache
 			LinkedObjects::iterator it(
@@ -40,6 +40,7 @@
 #include "MessagesRight.h"
 #include "MessagesLibraryLog.h"
 #include "MessagesLog.h"
+#include "MessagesModule.h"
 #include "AlarmTemplate.h"
 
 #include <boost/lexical_cast.hpp>
@@ -137,6 +138,7 @@ namespace synthese
 				if(sentAlarm)
 				{
 					sentAlarm->clearBroadcastPointsCache();
+					MessagesModule::UpdateActivatedMessageRecipients(*sentAlarm);
 				}
 			}
 			catch(ObjectNotFoundException<Alarm> e)
@@ -162,6 +164,7 @@ namespace synthese
 				if(sentAlarm)
 				{
 					sentAlarm->clearBroadcastPointsCache();
+					MessagesModule::UpdateActivatedMessageRecipients(*sentAlarm);
 				}
 			}
 		}
@@ -27,6 +27,7 @@
 
 #include "SentAlarm.h"
 
+#include <set>
 #include <vector>
 
 namespace synthese
@@ -65,6 +66,21 @@ namespace synthese
 				const util::ParametersMap& parameters
 			) const = 0;
 
+			typedef std::set<util::RegistryKeyType> RecipientKeys;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Lists the broadcast point recipients which select the broadcast point.
+			/// If the broadcast point displays only the messages linked to one of
+			/// these recipients, the other activated messages are not checked.
+			/// Default implementation returns false : all the activated messages
+			/// are checked.
+			/// @param result the object ids of the recipients (output)
+			/// @return true if a message must be linked to one of the recipients to be
+			/// displayed
+			virtual bool getRecipientKeys(
+				RecipientKeys& result
+			) const { return false; }
+
 			typedef std::vector<BroadcastPoint*> BroadcastPoints;
 			
 			virtual void getBrodcastPoints(BroadcastPoints& result) const = 0;
@@ -131,6 +131,20 @@ namespace synthese
 
 
 
+		//////////////////////////////////////////////////////////////////////////
+		/// The broadcast point or one of its parents must be linked to the message.
+		bool CustomBroadcastPoint::getRecipientKeys(
+			RecipientKeys& result
+		) const	{
+			for(const CustomBroadcastPoint* cbp(this); cbp != NULL; cbp = cbp->getParent())
+			{
+				result.insert(cbp->getKey());
+			}
+			return true;
+		}
+
+
+
 		void CustomBroadcastPoint::getBrodcastPoints( BroadcastPoints& result ) const
 		{
 			BOOST_FOREACH(
@@ -80,6 +80,8 @@ namespace synthese
 				const util::ParametersMap& parameters
 			) const;
 
+			virtual bool getRecipientKeys(RecipientKeys& result) const;
+
 			virtual void getBrodcastPoints(BroadcastPoints& result) const;
 		};
 	}
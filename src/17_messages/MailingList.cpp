@@ -163,6 +163,17 @@ namespace synthese
 
 
 
+		//////////////////////////////////////////////////////////////////////////
+		/// A mailing list can only be sent if it is explicitly linked to the message.
+		bool MailingList::getRecipientKeys(
+			RecipientKeys& result
+		) const	{
+			result.insert(getKey());
+			return true;
+		}
+
+
+
 		//////////////////////////////////////////////////////////////////////////
 		/// Check of a message should be sent to the mailing list according to its recipients.
 		/// A mailing list can only be sent if it is explicitly linked to the message.
@@ -23,6 +23,7 @@
 #include "MessagesModule.h"
 
 #include "BroadcastPoint.hpp"
+#include "BroadcastPointAlarmRecipient.hpp"
 #include "Env.h"
 #include "SentScenario.h"
 #include "ServerModule.h"
@@ -90,7 +91,9 @@ namespace synthese
 	namespace messages
 	{
 		MessagesModule::ActivatedMessages MessagesModule::_activatedMessages;
-		boost::mutex MessagesModule::_activatedMessagesMutex;
+		MessagesModule::ActivatedMessagesIndex MessagesModule::_activatedMessagesIndex;
+		MessagesModule::IndexedMessages MessagesModule::_indexedMessages;
+		boost::shared_mutex MessagesModule::_activatedMessagesMutex;
 		long MessagesModule::_lastMinute(60);
 
 		MessagesModule::Labels MessagesModule::GetScenarioTemplatesLabels(
@@ -259,63 +262,137 @@ namespace synthese
 			// Now
 			ptime now(second_clock::local_time());
 
-			// Wait for the availability of the cache
-			mutex::scoped_lock(_activatedMessagesMutex);
+			ActivatedMessages activatedMessages;
+			ActivatedMessages decativatedMessages;
+			{
+				// Wait for the availability of the cache
+				boost::unique_lock<boost::shared_mutex> lock(_activatedMessagesMutex);
 
-			// Duplicate the cache to run deactivation triggers
-			ActivatedMessages decativatedMessages(_activatedMessages);
+				// Duplicate the cache to find the deactivated messages
+				decativatedMessages = _activatedMessages;
 
-			// Loop on all messages
+				// Loop on all messages
+				BOOST_FOREACH(
+					const Registry<Alarm>::value_type& message,
+					Env::GetOfficialEnv().getRegistry<Alarm>()
+				){
+					// Avoid library messages
+					boost::shared_ptr<SentAlarm> sentMessage(
+						dynamic_pointer_cast<SentAlarm, Alarm>(message.second)
+					);
+					if(!sentMessage)
+					{
+						continue;
+					}
+
+					// Record active message
+					if(sentMessage->isApplicable(now))
+					{
+						// Remove the message as deactivated one
+						decativatedMessages.erase(sentMessage);
+
+						// Check if the message was already activated
+						if(_activatedMessages.find(sentMessage) == _activatedMessages.end())
+						{
+							// Record the message as activated
+							_activatedMessages.insert(sentMessage);
+							_indexMessage(sentMessage);
+							activatedMessages.insert(sentMessage);
+						}
+					}
+				}
+
+				// Erase deactivated messages
+				BOOST_FOREACH(const ActivatedMessages::value_type& sentMessage, decativatedMessages)
+				{
+					_activatedMessages.erase(sentMessage);
+					_unindexMessage(*sentMessage);
+				}
+			}
+
+			// The triggers are run after the release of the cache as they may read it
 			BOOST_FOREACH(
-				const Registry<Alarm>::value_type& message,
-				Env::GetOfficialEnv().getRegistry<Alarm>()
+				const BroadcastPoint::BroadcastPoints::value_type& bp,
+				BroadcastPoint::GetBroadcastPoints()
 			){
-				// Avoid library messages
-				boost::shared_ptr<SentAlarm> sentMessage(
-					dynamic_pointer_cast<SentAlarm, Alarm>(message.second)
-				);
-				if(!sentMessage)
+				// Run the display start trigger
+				BOOST_FOREACH(const ActivatedMessages::value_type& sentMessage, activatedMessages)
 				{
-					continue;
+					bp->onDisplayStart(*sentMessage);
 				}
 
-				// Record active message
-				if(sentMessage->isApplicable(now))
+				// Run the display end trigger
+				BOOST_FOREACH(const ActivatedMessages::value_type& sentMessage, decativatedMessages)
 				{
-					// Remove the message as deactivated one
-					decativatedMessages.erase(sentMessage);
-
-					// Check if the message was already activated
-					if(_activatedMessages.find(sentMessage) == _activatedMessages.end())
-					{
-						// Record the message as activated
-						_activatedMessages.insert(sentMessage);
-
-						// Run the display start trigger on each broadcast point
-						BOOST_FOREACH(
-							const BroadcastPoint::BroadcastPoints::value_type& bp,
-							BroadcastPoint::GetBroadcastPoints()
-						){
-							bp->onDisplayStart(*sentMessage);
-						}
-					}
+					bp->onDisplayEnd(*sentMessage);
 				}
 			}
+		}
 
-			// Erase deactivated messages
-			BOOST_FOREACH(const ActivatedMessages::value_type& sentMessage, decativatedMessages)
+
+
+		void MessagesModule::UpdateActivatedMessageRecipients(
+			const SentAlarm& message
+		){
+			boost::unique_lock<boost::shared_mutex> lock(_activatedMessagesMutex);
+
+			IndexedMessages::const_iterator it(_indexedMessages.find(&message));
+			if(it == _indexedMessages.end())
 			{
-				// Remove from cache
-				_activatedMessages.erase(sentMessage);
+				return;
+			}
+			boost::shared_ptr<SentAlarm> sentMessage(it->second.first);
+			_unindexMessage(message);
+			_indexMessage(sentMessage);
+		}
 
-				// Run the display end trigger
-				BOOST_FOREACH(
-					const BroadcastPoint::BroadcastPoints::value_type& bp,
-					BroadcastPoint::GetBroadcastPoints()
-				){
-					bp->onDisplayEnd(*sentMessage);
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Adds an activated message to the index, under each broadcast point
+		/// recipient of the message.
+		/// The activated messages mutex must be locked.
+		void MessagesModule::_indexMessage(
+			const boost::shared_ptr<SentAlarm>& message
+		){
+			IndexedMessages::mapped_type& indexedMessage(_indexedMessages[message.get()]);
+			indexedMessage.first = message;
+			BOOST_FOREACH(
+				const Alarm::LinkedObjects::mapped_type::value_type& link,
+				message->getLinkedObjects(BroadcastPointAlarmRecipient::FACTORY_KEY)
+			){
+				indexedMessage.second.insert(link->getObjectId());
+				_activatedMessagesIndex[link->getObjectId()].insert(message);
+			}
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Removes a message from the index.
+		/// The activated messages mutex must be locked.
+		void MessagesModule::_unindexMessage(
+			const SentAlarm& message
+		){
+			IndexedMessages::iterator it(_indexedMessages.find(&message));
+			if(it == _indexedMessages.end())
+			{
+				return;
+			}
+			BOOST_FOREACH(RegistryKeyType key, it->second.second)
+			{
+				ActivatedMessagesIndex::iterator itIndex(_activatedMessagesIndex.find(key));
+				if(itIndex == _activatedMessagesIndex.end())
+				{
+					continue;
+				}
+				itIndex->second.erase(it->second.first);
+				if(itIndex->second.empty())
+				{
+					_activatedMessagesIndex.erase(itIndex);
 				}
 			}
+			_indexedMessages.erase(it);
 		}
 
 
@@ -323,6 +400,8 @@ namespace synthese
 		//////////////////////////////////////////////////////////////////////////
 		/// Lists the message to display on a broadcast point according to the
 		/// specified parameters.
+		/// If the broadcast point provides its recipient keys, only the messages
+		/// linked to them are checked.
 		/// @param broadcastPoint the broadcast point to check
 		/// @param parameters the broadcast parameters
 		/// @return the list of the messages to display
@@ -330,14 +409,41 @@ namespace synthese
 			const BroadcastPoint& broadcastPoint,
 			const util::ParametersMap& parameters
 		){
+			BroadcastPoint::RecipientKeys recipientKeys;
+			bool indexed(broadcastPoint.getRecipientKeys(recipientKeys));
+
 			// Wait for the availability of the cache
-			mutex::scoped_lock(_activatedMessagesMutex);
+			boost::shared_lock<boost::shared_mutex> lock(_activatedMessagesMutex);
 
 			// Initialisation of the result
 			ActivatedMessages result;
 
+			// Check the messages linked to the broadcast point
+			if(indexed)
+			{
+				BOOST_FOREACH(RegistryKeyType key, recipientKeys)
+				{
+					ActivatedMessagesIndex::const_iterator it(_activatedMessagesIndex.find(key));
+					if(it == _activatedMessagesIndex.end())
+					{
+						continue;
+					}
+					BOOST_FOREACH(const boost::shared_ptr<SentAlarm>& message, it->second)
+					{
+						if(	!result.count(message) &&
+							message->isOnBroadcastPoint(
+								broadcastPoint,
+								parameters
+						)	){
+							result.insert(message);
+						}
+					}
+				}
+				return result;
+			}
+
 			// Check each message
-			BOOST_FOREACH(boost::shared_ptr<SentAlarm> message, _activatedMessages)
+			BOOST_FOREACH(const boost::shared_ptr<SentAlarm>& message, _activatedMessages)
 			{
 				// Check the message
 				if(message->isOnBroadcastPoint(
@@ -28,10 +28,13 @@
 #include "Registry.h"
 #include "MessagesTypes.h"
 
+#include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <boost/optional.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 namespace synthese
 {
@@ -79,13 +82,36 @@ namespace synthese
 			typedef std::set<boost::shared_ptr<SentAlarm> > ActivatedMessages;
 
 		private:
+			/// Activated messages by object id of their broadcast point recipients
+			typedef std::map<util::RegistryKeyType, ActivatedMessages> ActivatedMessagesIndex;
+
+			/// Broadcast point recipients under which each activated message is indexed
+			typedef std::map<
+				const SentAlarm*,
+				std::pair<
+					boost::shared_ptr<SentAlarm>,
+					std::set<util::RegistryKeyType>
+			>	> IndexedMessages;
+
 			static ActivatedMessages _activatedMessages;
-			static boost::mutex _activatedMessagesMutex;
+			static ActivatedMessagesIndex _activatedMessagesIndex;
+			static IndexedMessages _indexedMessages;
+			static boost::shared_mutex _activatedMessagesMutex;	//!< protects the activated messages and their index
 			static long _lastMinute;
 
+			static void _indexMessage(const boost::shared_ptr<SentAlarm>& message);
+			static void _unindexMessage(const SentAlarm& message);
+
 		public:
 			static void UpdateActivatedMessages();
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Updates the index of the activated messages after a change of the
+			/// recipients of a message.
+			/// Does nothing if the message is not activated.
+			/// @param message the message whose recipients have changed
+			static void UpdateActivatedMessageRecipients(const SentAlarm& message);
+
 			static ActivatedMessages GetActivatedMessages(
 				const BroadcastPoint& broadcastPoint,
 				const util::ParametersMap& parameters
@@ -162,6 +162,7 @@ namespace synthese
 
 		void SentAlarm::clearBroadcastPointsCache() const
 		{
+			boost::mutex::scoped_lock lock(_broadcastPointsCacheMutex);
 			_broadcastPointsCache.clear();
 		}
 
@@ -175,17 +176,24 @@ namespace synthese
 			BroadcastPointsCache::key_type pp(
 				make_pair(&point, parameters)
 			);
-			BroadcastPointsCache::const_iterator it(
-				_broadcastPointsCache.find(pp)
-			);
-			if(it == _broadcastPointsCache.end())
+
+			// Search in the cache
 			{
-				it = _broadcastPointsCache.insert(
-					make_pair(
-						pp,
-						_isOnBroadcastPoint(point, parameters)
-				)	).first;
+				boost::mutex::scoped_lock lock(_broadcastPointsCacheMutex);
+				BroadcastPointsCache::const_iterator it(
+					_broadcastPointsCache.find(pp)
+				);
+				if(it != _broadcastPointsCache.end())
+				{
+					return it->second;
+				}
 			}
-			return it->second;
+
+			// The check is done without locking the cache as it may be long
+			bool result(_isOnBroadcastPoint(point, parameters));
+
+			boost::mutex::scoped_lock lock(_broadcastPointsCacheMutex);
+			_broadcastPointsCache.insert(make_pair(pp, result));
+			return result;
 		}
 }	}
@@ -29,6 +29,8 @@
 #include "MessagesTypes.h"
 #include "Registry.h"
 
+#include <boost/thread/mutex.hpp>
+
 namespace synthese
 {
 	namespace messages
@@ -55,6 +57,7 @@ namespace synthese
 			> BroadcastPointsCache;
 
 			mutable BroadcastPointsCache _broadcastPointsCache;
+			mutable boost::mutex _broadcastPointsCacheMutex;
 
 		public:
 			/** Copy constructor.
@@ -47,8 +47,6 @@ namespace synthese
 
 	namespace graph
 	{
-		const size_t Edge::INDICES_NUMBER(24);
-
 		Edge::Edge(
 			Path* parentPath,
 			size_t rankInPath,
@@ -65,8 +63,6 @@ namespace synthese
 			_followingConnectionArrival(NULL),
 			_followingArrivalForFineSteppingOnly(NULL),
 			_next(NULL),
-			_departureIndex(INDICES_NUMBER),
-			_arrivalIndex(INDICES_NUMBER),
 			_serviceIndexUpdateNeeded (true),
 			_RTserviceIndexUpdateNeeded(true)
 		{
@@ -166,7 +162,8 @@ namespace synthese
 			bool ignoreReservation,
 			bool allowCanceled,
 			bool enableTheoretical,
-			bool enableRealTime
+			bool enableRealTime,
+			const SearchTimeContext& timeContext
 		) const	{
 			boost::shared_lock<util::shared_recursive_mutex> sharedServicesLock(
 						*getParentPath()->sharedServicesMutex
@@ -178,14 +175,14 @@ namespace synthese
 				return ServicePointer();
 			}
 
-			bool RTData(enableRealTime && departureMoment < posix_time::second_clock().local_time() + posix_time::hours(23));
+			bool RTData(enableRealTime && timeContext.isRealTimeUsable(departureMoment));
 
 			// Search schedule
-			DepartureServiceIndex::Value next(getDepartureFromIndex(RTData, departureMoment.time_of_day().hours()));
+			boost::shared_ptr<const DepartureServiceIndex> index(getDepartureIndex(RTData));
+			DepartureServiceIndex::Value next(index->getFirst(departureMoment.time_of_day()));
 
-			if(	minNextServiceIndex &&
-				(*minNextServiceIndex == services.end() || services.value_comp()(*next, **minNextServiceIndex))
-			){
+			if(minNextServiceIndex && *minNextServiceIndex > next)
+			{
 				next = *minNextServiceIndex;
 			}
 
@@ -194,11 +191,17 @@ namespace synthese
 				// Look in schedule for when the line is in service
 				if(	getParentPath()->isActive(departureMoment.date()))
 				{
-					for (; next != services.end(); ++next)  // boucle sur les services
+					for (; next < index->end(); ++next)  // boucle sur les services
 					{
+						// Services which can not depart at the presence time are ignored
+						if(!index->isCandidate(next, departureMoment.time_of_day()))
+						{
+							continue;
+						}
+
 						// Saving of the used service
 						ServicePointer servicePointer(
-							(*next)->getFromPresenceTime(
+							index->get(next).service->getFromPresenceTime(
 								accessParameters,
 								enableTheoretical,
 								RTData,
@@ -208,7 +211,8 @@ namespace synthese
 								checkIfTheServiceIsReachable,
 								inverted,
 								ignoreReservation,
-								allowCanceled
+								allowCanceled,
+								timeContext
 							)
 						);
 
@@ -239,7 +243,7 @@ namespace synthese
 				else
 					departureMoment = ptime(departureMoment.date(), hours(27));
 
-				next = _departureIndex[0].get(RTData);
+				next = index->getFirst(departureMoment.time_of_day());
 			}
 
 			return ServicePointer();
@@ -256,7 +260,8 @@ namespace synthese
 			bool ignoreReservation,
 			bool allowCanceled,
 			bool enableTheoretical,
-			bool enableRealTime
+			bool enableRealTime,
+			const SearchTimeContext& timeContext
 		) const {
 			boost::shared_lock<util::shared_recursive_mutex> sharedServicesLock(
 						*getParentPath()->sharedServicesMutex
@@ -268,13 +273,13 @@ namespace synthese
 				return ServicePointer();
 			}
 
-			bool RTData(enableRealTime && arrivalMoment < posix_time::second_clock().local_time() + posix_time::hours(23));
+			bool RTData(enableRealTime && timeContext.isRealTimeUsable(arrivalMoment));
 
-			ArrivalServiceIndex::Value previous(getArrivalFromIndex(RTData, arrivalMoment.time_of_day().hours()));
+			boost::shared_ptr<const ArrivalServiceIndex> index(getArrivalIndex(RTData));
+			ArrivalServiceIndex::Value previous(index->getFirst(arrivalMoment.time_of_day()));
 
-			if(	maxPreviousServiceIndex &&
-				(*maxPreviousServiceIndex == services.rend() || services.value_comp()(**maxPreviousServiceIndex, *previous))
-			){
+			if(maxPreviousServiceIndex && *maxPreviousServiceIndex > previous)
+			{
 				previous = *maxPreviousServiceIndex;
 			}
 
@@ -282,11 +287,17 @@ namespace synthese
 			{
 				if(	getParentPath()->isActive(arrivalMoment.date()))
 				{
-					for (; previous != services.rend(); ++previous)  // Loop over services
+					for (; previous < index->end(); ++previous)  // Loop over services
 					{
+						// Services which can not arrive at the presence time are ignored
+						if(!index->isCandidate(previous, arrivalMoment.time_of_day()))
+						{
+							continue;
+						}
+
 						// Saving of the used service
 						ServicePointer servicePointer(
-							(*previous)->getFromPresenceTime(
+							index->get(previous).service->getFromPresenceTime(
 								accessParameters,
 								enableTheoretical,
 								RTData,
@@ -296,7 +307,8 @@ namespace synthese
 								checkIfTheServiceIsReachable,
 								inverted,
 								ignoreReservation,
-								allowCanceled
+								allowCanceled,
+								timeContext
 							)
 						);
 
@@ -325,7 +337,7 @@ namespace synthese
 				}	}
 
 				arrivalMoment = ptime(arrivalMoment.date(), -seconds(1));
-				previous = _arrivalIndex[INDICES_NUMBER - 1].get(RTData);
+				previous = index->getFirst(arrivalMoment.time_of_day());
 			}
 
 			return ServicePointer();
@@ -343,83 +355,28 @@ namespace synthese
 			);
 
 			const ServiceSet& services(getParentPath()->getServices());
-			size_t numHour;
 
-			// Reset
-			for ( numHour = 0; numHour < INDICES_NUMBER; ++numHour)
-			{
-				_departureIndex[numHour].set(RTData, services.end());
-				_arrivalIndex[numHour].set(RTData, services.rend());
-			}
+			// The indices are replaced as a whole : the searches running on the
+			// previous ones keep them until they end
+			boost::shared_ptr<const DepartureServiceIndex> departureIndex(
+				new DepartureServiceIndex(services, getRankInPath(), true, RTData)
+			);
+			boost::shared_ptr<const ArrivalServiceIndex> arrivalIndex(
+				new ArrivalServiceIndex(services, getRankInPath(), false, RTData)
+			);
+
 			if(RTData)
 			{
+				_RTDepartureIndex = departureIndex;
+				_RTArrivalIndex = arrivalIndex;
 				_RTserviceIndexUpdateNeeded = false;
 			}
 			else
 			{
+				_departureIndex = departureIndex;
+				_arrivalIndex = arrivalIndex;
 				_serviceIndexUpdateNeeded = false;
 			}
-
-			if(services.empty()) return;
-
-			// Departures
-			for(ServiceSet::const_iterator it(services.begin()); it!=services.end(); ++it)
-			{
-				const Service* service = *it;
-				time_duration endHour(service->getDepartureEndScheduleToIndex(RTData, getRankInPath()));
-				size_t endHours(std::min((size_t)endHour.hours(), (size_t)23));
-				time_duration beginHour(service->getDepartureBeginScheduleToIndex(RTData, getRankInPath()));
-
-				for (numHour = 0; numHour <= endHours; ++numHour)
-				{
-					if(	_departureIndex[numHour].get(RTData) == services.end() ||
-						(*_departureIndex[numHour].get(RTData)) \
-							->getDepartureBeginScheduleToIndex(RTData, getRankInPath()) > endHour
-					){
-						_departureIndex[numHour].set(RTData, it);
-					}
-				}
-				if (endHour < beginHour)
-				{
-					for (numHour = endHours; numHour < 24; ++numHour)
-					{
-						if(	_departureIndex[numHour].get(RTData) == services.end())
-						{
-							_departureIndex[numHour].set(RTData, it);
-						}
-					}
-				}
-			}
-
-			// Arrivals
-			for(ServiceSet::const_reverse_iterator it(services.rbegin()); it != services.rend(); ++it)
-			{
-				const Service* service = *it;
-				time_duration endHour(service->getArrivalEndScheduleToIndex(RTData, getRankInPath()));
-				time_duration beginHour(service->getArrivalBeginScheduleToIndex(RTData, getRankInPath()));
-				size_t beginHours(std::min((size_t)beginHour.hours(), (size_t)23));
-
-				for (numHour = 23; numHour >= beginHours; --numHour)
-				{
-					if(	_arrivalIndex[numHour].get(RTData) == services.rend()	||
-						(*_arrivalIndex[numHour].get(RTData))->getArrivalBeginScheduleToIndex(RTData, getRankInPath()) < beginHour
-					){
-						_arrivalIndex[numHour].set(RTData, it);						
-					}
-					if(numHour == 0) break;
-				}
-				if (endHour < beginHour)
-				{
-					for (numHour = endHour.hours(); true; --numHour)
-					{
-						if(	_arrivalIndex[numHour].get(RTData) == services.rend())
-						{
-							_arrivalIndex[numHour].set(RTData, it);
-						}
-						if(numHour == 0) break;
-					}
-				}
-			}
 		}
 
 
@@ -443,22 +400,22 @@ namespace synthese
 
 
 
-		Edge::DepartureServiceIndex::Value Edge::getDepartureFromIndex(
-			bool RTData,
-			size_t hour
+		boost::shared_ptr<const Edge::DepartureServiceIndex> Edge::getDepartureIndex(
+			bool RTData
 		) const {
+			boost::recursive_mutex::scoped_lock lock(_indexMutex);
 			if (_getServiceIndexUpdateNeeded(RTData)) _updateServiceIndex(RTData);
-			return  _departureIndex[hour].get(RTData);
+			return RTData ? _RTDepartureIndex : _departureIndex;
 		}
 
 
 
-		Edge::ArrivalServiceIndex::Value Edge::getArrivalFromIndex(
-			bool RTData,
-			size_t hour
+		boost::shared_ptr<const Edge::ArrivalServiceIndex> Edge::getArrivalIndex(
+			bool RTData
 		) const {
+			boost::recursive_mutex::scoped_lock lock(_indexMutex);
 			if (_getServiceIndexUpdateNeeded(RTData)) _updateServiceIndex(RTData);
-			return _arrivalIndex[hour].get(RTData);
+			return RTData ? _RTArrivalIndex : _arrivalIndex;
 		}
 
 
@@ -30,9 +30,12 @@
 #include "Registrable.h"
 #include "GraphTypes.h"
 #include "Path.h"
+#include "SearchTimeContext.hpp"
+#include "ServiceIndex.hpp"
 #include "WithGeometry.hpp"
 
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/date_time/posix_time/ptime.hpp>
 #include <boost/date_time/posix_time/posix_time_duration.hpp>
 #include <boost/thread/recursive_mutex.hpp>
@@ -84,32 +87,8 @@ namespace synthese
 			public RuleUser
 		{
 		public:
-			template<class Iterator>
-			class ServiceIndex
-			{
-			public:
-				typedef Iterator Value;
-
-			private:
-				Value _value;
-				Value _RTValue;
-
-			public:
-				Value get(bool RTData) const{ return RTData ? _RTValue : _value; }
-
-				void set(
-					bool RTData,
-					Value value
-				){
-					if(RTData) _RTValue = value; else _value = value;
-				}
-			};
-
-			typedef ServiceIndex<ServiceSet::const_iterator> DepartureServiceIndex;
-			typedef ServiceIndex<ServiceSet::const_reverse_iterator> ArrivalServiceIndex;
-
-			typedef std::vector<DepartureServiceIndex> DepartureServiceIndices;
-			typedef std::vector<ArrivalServiceIndex> ArrivalServiceIndices;
+			typedef ServiceIndex DepartureServiceIndex;
+			typedef ServiceIndex ArrivalServiceIndex;
 
 		protected:
 			Vertex*	_fromVertex;
@@ -117,8 +96,6 @@ namespace synthese
 			MetricOffset _metricOffset;		//!< Metric offset
 
 		private:
-			static const std::size_t INDICES_NUMBER;
-
 			std::size_t _rankInPath;		//!< Rank in path.
 
 			Edge* _previous;
@@ -128,8 +105,10 @@ namespace synthese
 			Edge* _followingArrivalForFineSteppingOnly;	//!< Next arrival edge with or without connection
 			Edge* _next;
 
-			mutable DepartureServiceIndices _departureIndex;	//!< First service index by departure hour of day
-			mutable ArrivalServiceIndices _arrivalIndex;		//!< First service index by arrival hour of day
+			mutable boost::shared_ptr<const DepartureServiceIndex> _departureIndex;	//!< Services sorted by theoretical departure time
+			mutable boost::shared_ptr<const DepartureServiceIndex> _RTDepartureIndex;	//!< Services sorted by real time departure time
+			mutable boost::shared_ptr<const ArrivalServiceIndex> _arrivalIndex;		//!< Services sorted by theoretical arrival time
+			mutable boost::shared_ptr<const ArrivalServiceIndex> _RTArrivalIndex;		//!< Services sorted by real time arrival time
 
 			mutable bool _serviceIndexUpdateNeeded;
 			mutable bool _RTserviceIndexUpdateNeeded;
@@ -195,9 +174,6 @@ namespace synthese
 				Edge* getFollowingArrivalForFineSteppingOnly () const { return _followingArrivalForFineSteppingOnly; }
 				Edge* getNext() const { return _next; }
 
-				const DepartureServiceIndices& getDepartureIndices() const { return _departureIndex; }
-				const ArrivalServiceIndices& getArrivalIndices() const { return _arrivalIndex; }
-
 				std::size_t getRankInPath () const { return _rankInPath; }
 			//@}
 
@@ -219,14 +195,23 @@ namespace synthese
 
 				const Hub* getHub() const;
 
-				DepartureServiceIndex::Value getDepartureFromIndex(
-					bool RTData,
-					size_t hour
+				//////////////////////////////////////////////////////////////////////////
+				/// Gets the services of the path sorted by departure time at the edge.
+				/// The index is rebuilt if the services have changed since the last
+				/// call.
+				/// @param RTData true for the real time index
+				/// @return the index, which remains valid after the next update
+				boost::shared_ptr<const DepartureServiceIndex> getDepartureIndex(
+					bool RTData
 				) const;
 
-				ArrivalServiceIndex::Value getArrivalFromIndex(
-					bool RTData,
-					size_t hour
+				//////////////////////////////////////////////////////////////////////////
+				/// Gets the services of the path sorted by arrival time at the edge,
+				/// latest first.
+				/// @param RTData true for the real time index
+				/// @return the index, which remains valid after the next update
+				boost::shared_ptr<const ArrivalServiceIndex> getArrivalIndex(
+					bool RTData
 				) const;
 
 				bool isArrival() const;
@@ -289,6 +274,7 @@ namespace synthese
 					@retval departureMoment Accurate departure moment. Meaningless if -1 returned.
 					@retval minNextServiceIndex Index corresponding to the returned service
 					@param allowCanceledService returns real time canceled services too. The _canceled attribute of the service pointer would be set to true.
+					@param timeContext current time of the search : a search scanning many edges should build it once
 				*/
 				ServicePointer getNextService(
 					const AccessParameters& accessParameters,
@@ -300,7 +286,8 @@ namespace synthese
 					bool ignoreReservation = false,
 					bool allowCanceledService = false,
 					bool enableTheoretical = true,
-					bool enableRealTime = true
+					bool enableRealTime = true,
+					const SearchTimeContext& timeContext = SearchTimeContext()
 				) const;
 
 
@@ -316,6 +303,7 @@ namespace synthese
 					@return Found service instance index or -1 if none was found.
 					@retval arrivalMoment Accurate departure moment. Meaningless if -1 returned.
 					@retval maxPreviousServiceIndex Index corresponding to the returned service
+					@param timeContext current time of the search : a search scanning many edges should build it once
 				*/
 				ServicePointer getPreviousService(
 					const AccessParameters& accessParameters,
@@ -327,7 +315,8 @@ namespace synthese
 					bool ignoreReservation = false,
 					bool allowCanceledService = false,
 					bool enableTheoretical = true,
-					bool enableRealTime = true
+					bool enableRealTime = true,
+					const SearchTimeContext& timeContext = SearchTimeContext()
 				) const;
 			//@}
 
@@ -59,6 +59,7 @@ namespace synthese
 			_pathGroup(NULL),
 			_pathClass(NULL),
 			_pathNetwork(NULL),
+			_servicesVersion(new boost::detail::atomic_count(0)),
 			sharedServicesMutex(new synthese::util::shared_recursive_mutex)
 		{}
 
@@ -265,6 +266,8 @@ namespace synthese
 		void Path::addEdge(
 			Edge& edge
 		){
+			markServicesUpdated();
+
 			// Empty path : just put the edge in the vector
 			if (_edges.empty())
 			{
@@ -357,6 +360,7 @@ namespace synthese
 
 		void Path::markScheduleIndexesUpdateNeeded(bool RTDataOnly)
 		{
+			markServicesUpdated();
 			BOOST_FOREACH(const Edges::value_type& edge, _edges)
 			{
 				Edge::SubEdges subEdges(edge->getSubEdges());
@@ -369,6 +373,13 @@ namespace synthese
 
 
 
+		void Path::markServicesUpdated()
+		{
+			++*_servicesVersion;
+		}
+
+
+
 		void Path::merge(Path& other )
 		{
 			if(	other._pathGroup != _pathGroup ||
@@ -548,6 +559,8 @@ namespace synthese
 
 		void Path::removeEdge( Edge& edge )
 		{
+			markServicesUpdated();
+
 			// Empty path : just clear the path
 			if (_edges.size() == 1)
 			{
@@ -29,7 +29,9 @@
 #include "shared_recursive_mutex.hpp"
 
 #include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/detail/atomic_count.hpp>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
 #include <set>
 
@@ -93,6 +95,7 @@ namespace synthese
 			Edges			_edges; 	//!< Down link 1 : edges
 			ServiceSet		_services;	//!< Down link 2 : services
 			RankMap			_rankMap;	//!< Saves the first edge at each metric offset
+			boost::shared_ptr<boost::detail::atomic_count>	_servicesVersion;	//!< Incremented at each change of the services
 
 			/** Constructor.
 			*/
@@ -115,6 +118,7 @@ namespace synthese
 				PathClass*			getPathClass()	const { return _pathClass; }
 				PathClass*                      getPathNetwork()  const { return _pathNetwork; }
 				PathGroup*			getPathGroup()	const { return _pathGroup; }
+				long				getServicesVersion() const { return *_servicesVersion; }
 			//@}
 
 			//! @name Setters
@@ -380,6 +384,15 @@ namespace synthese
 				/// @param RTDataOnly if true only the real time indexes are reseted
 				/// @author Hugues Romain
 				void markScheduleIndexesUpdateNeeded(bool RTDataOnly);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Increments the services version, to notify the caches built on the
+				/// services of the path that they must be refreshed.
+				/// Called by markScheduleIndexesUpdateNeeded. Use this method directly
+				/// when a change of the services does not affect the schedules.
+				void markServicesUpdated();
 			//@}
 		};
 }	}
@@ -49,7 +49,8 @@ namespace synthese
 			bool controlIfTheServiceIsReachable,
 			bool inverted,
 			bool ignoreReservation,
-			bool canceled
+			bool canceled,
+			const SearchTimeContext& timeContext
 		) const	{
 
 			// Access parameters check
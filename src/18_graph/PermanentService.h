@@ -91,7 +91,8 @@ namespace synthese
 				bool controlIfTheServiceIsReachable,
 				bool inverted,
 				bool ingoreReservation,
-				bool allowCanceled
+				bool allowCanceled,
+				const graph::SearchTimeContext& timeContext = graph::SearchTimeContext()
 			) const;
 
 			virtual void completeServicePointer(
@@ -0,0 +1,56 @@
+/** SearchTimeContext class implementation.
+	@file SearchTimeContext.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "SearchTimeContext.hpp"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+using namespace boost::gregorian;
+using namespace boost::posix_time;
+
+namespace synthese
+{
+	namespace graph
+	{
+		SearchTimeContext::SearchTimeContext():
+			_now(second_clock::local_time())
+		{
+			_init();
+		}
+
+
+
+		SearchTimeContext::SearchTimeContext(
+			const ptime& now
+		):	_now(now)
+		{
+			_init();
+		}
+
+
+
+		void SearchTimeContext::_init()
+		{
+			_today = _now.date();
+			_tomorrow = _today + days(1);
+			_realTimeEnd = _now + hours(23);
+		}
+}	}
@@ -0,0 +1,98 @@
+/** SearchTimeContext class header.
+	@file SearchTimeContext.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_graph_SearchTimeContext_hpp__
+#define SYNTHESE_graph_SearchTimeContext_hpp__
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace graph
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Current time as seen by a search in the services.
+		///	@ingroup m18
+		//////////////////////////////////////////////////////////////////////////
+		/// The clock is read once when the context is built, and the dates
+		/// deciding between the real time and the theoretical schedules are
+		/// computed at the same time. A search builds one context and passes it
+		/// to each service lookup (Edge::getNextService,
+		/// Service::getFromPresenceTime...) : the lookups do not read the clock
+		/// anymore and all the services of a search are selected at the same
+		/// current time.
+		class SearchTimeContext
+		{
+		private:
+			boost::posix_time::ptime _now;
+			boost::gregorian::date _today;
+			boost::gregorian::date _tomorrow;
+			boost::posix_time::ptime _realTimeEnd;
+
+			void _init();
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Builds a context at the current time.
+			SearchTimeContext();
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Builds a context at a given time.
+			/// @param now the time to use as current time
+			explicit SearchTimeContext(const boost::posix_time::ptime& now);
+
+			//! @name Getters
+			//@{
+				const boost::posix_time::ptime& getNow() const { return _now; }
+				const boost::gregorian::date& getToday() const { return _today; }
+			//@}
+
+			//! @name Services
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// Real time data are loaded for the 23 next hours only.
+				/// @param moment the presence time
+				/// @return true if the real time schedules can be used at the moment
+				bool isRealTimeUsable(const boost::posix_time::ptime& moment) const
+				{
+					return moment < _realTimeEnd;
+				}
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Real time data are available for the current day only, and the day
+				/// finishes at 03:00 the day after.
+				/// @param presenceDateTime the presence time
+				/// @return true if the theoretical schedules must be used at the
+				/// presence time even if real time is requested
+				bool isTheoreticalForced(const boost::posix_time::ptime& presenceDateTime) const
+				{
+					return
+						(presenceDateTime.date() > _today && presenceDateTime.time_of_day().hours() > 3) ||
+						presenceDateTime.date() > _tomorrow
+					;
+				}
+			//@}
+		};
+}	}
+
+#endif // SYNTHESE_graph_SearchTimeContext_hpp__
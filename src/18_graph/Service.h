@@ -27,6 +27,7 @@
 #include "Registrable.h"
 #include "Registry.h"
 #include "RuleUser.h"
+#include "SearchTimeContext.hpp"
 
 #include <string>
 #include <boost/date_time/posix_time/ptime.hpp>
@@ -180,6 +181,7 @@ namespace synthese
 					@param inverted : indicates if the range computing must follow the same rules as method says (false) or the inverted ones (true)
 					@param allowCanceled returns the service even if it is canceled at the specified edge. In this case, the _canceled attribute of the returned pointer is set to true.
 					@param accessParameters access parameters to check for compatibility
+					@param timeContext current time of the search (decides if the real time schedules can be used at the presence time)
 					@return A full ServicePointer to the service. If the service cannot be used at the specified date/time, then the ServicePointer points to a NULL service.
 					@author Hugues Romain
 					@date 2007
@@ -195,7 +197,8 @@ namespace synthese
 					bool checkIfTheServiceIsReachable,
 					bool inverted,
 					bool ignoreReservation,
-					bool allowCanceled
+					bool allowCanceled,
+					const SearchTimeContext& timeContext = SearchTimeContext()
 				) const = 0;
 
 
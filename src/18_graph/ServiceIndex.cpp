@@ -0,0 +1,200 @@
+
+/** ServiceIndex class implementation.
+	@file ServiceIndex.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "ServiceIndex.hpp"
+
+#include "Service.h"
+
+#include <algorithm>
+#include <functional>
+#include <boost/foreach.hpp>
+
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	namespace graph
+	{
+		const int ServiceIndex::UNBOUNDED(10 * 86400);
+
+		namespace
+		{
+			// Services can be used at presence times before 03:00 by the rule of the
+			// previous day if their schedule is after 04:00 (see Service::getFromPresenceTime)
+			const int NIGHT_END(3 * 3600);
+			const int PREVIOUS_DAY_SCHEDULE_BEGIN(4 * 3600);
+			const int DAY(86400);
+
+			struct cmpEntryTime
+			{
+				bool _ascending;
+
+				cmpEntryTime(bool ascending): _ascending(ascending) {}
+
+				bool operator()(const ServiceIndex::Entry& e1, const ServiceIndex::Entry& e2) const
+				{
+					return _ascending ? e1.time < e2.time : e2.time < e1.time;
+				}
+			};
+		}
+
+
+
+		int ServiceIndex::_ToSeconds( const time_duration& value )
+		{
+			return static_cast<int>(value.total_seconds());
+		}
+
+
+
+		ServiceIndex::ServiceIndex(
+			const ServiceSet& services,
+			size_t rankInPath,
+			bool departure,
+			bool RTData
+		):	_departure(departure)
+		{
+			_entries.reserve(services.size());
+			BOOST_FOREACH(const Service* service, services)
+			{
+				Entry entry;
+				entry.service = service;
+
+				if(_departure)
+				{
+					entry.time = _ToSeconds(service->getDepartureBeginScheduleToIndex(RTData, rankInPath));
+					entry.minTime = entry.time;
+					entry.maxTime = _ToSeconds(service->getDepartureEndScheduleToIndex(RTData, rankInPath));
+					if(RTData)
+					{
+						entry.minTime = min(entry.minTime, _ToSeconds(service->getDepartureBeginScheduleToIndex(false, rankInPath)));
+						entry.maxTime = max(entry.maxTime, _ToSeconds(service->getDepartureEndScheduleToIndex(false, rankInPath)));
+					}
+				}
+				else
+				{
+					entry.time = _ToSeconds(service->getArrivalEndScheduleToIndex(RTData, rankInPath));
+					entry.minTime = _ToSeconds(service->getArrivalBeginScheduleToIndex(RTData, rankInPath));
+					entry.maxTime = entry.time;
+					if(RTData)
+					{
+						entry.minTime = min(entry.minTime, _ToSeconds(service->getArrivalBeginScheduleToIndex(false, rankInPath)));
+						entry.maxTime = max(entry.maxTime, _ToSeconds(service->getArrivalEndScheduleToIndex(false, rankInPath)));
+					}
+				}
+
+				// The schedules of continuous services are read modulo 24 hours
+				if(service->isContinuous())
+				{
+					entry.minTime = -UNBOUNDED;
+					entry.maxTime = UNBOUNDED;
+				}
+
+				_entries.push_back(entry);
+			}
+
+			// The stable sort keeps the order of the services set between services
+			// with the same schedule
+			stable_sort(_entries.begin(), _entries.end(), cmpEntryTime(_departure));
+
+			_bounds.reserve(_entries.size());
+			BOOST_FOREACH(const Entry& entry, _entries)
+			{
+				if(_bounds.empty())
+				{
+					_bounds.push_back(_departure ? entry.maxTime : entry.minTime);
+				}
+				else
+				{
+					_bounds.push_back(
+						_departure ?
+						max(_bounds.back(), entry.maxTime) :
+						min(_bounds.back(), entry.minTime)
+					);
+				}
+			}
+		}
+
+
+
+		ServiceIndex::Value ServiceIndex::getFirst(
+			const time_duration& presenceTime
+		) const	{
+			int time(_ToSeconds(presenceTime));
+			if(_departure)
+			{
+				// First position where a service ends after the presence time
+				return lower_bound(_bounds.begin(), _bounds.end(), time) - _bounds.begin();
+			}
+			else
+			{
+				// First position where a service begins before the presence time,
+				// the services of the previous day included
+				if(time < NIGHT_END)
+				{
+					time += DAY;
+				}
+				return lower_bound(_bounds.begin(), _bounds.end(), time, greater<int>()) - _bounds.begin();
+			}
+		}
+
+
+
+		bool ServiceIndex::isCandidate(
+			Value value,
+			const time_duration& presenceTime
+		) const	{
+			const Entry& entry(_entries[value]);
+			int time(_ToSeconds(presenceTime));
+			bool night(time < NIGHT_END);
+
+			if(_departure)
+			{
+				if(entry.maxTime < time)
+				{
+					return false;
+				}
+				if(	night &&
+					entry.minTime >= PREVIOUS_DAY_SCHEDULE_BEGIN &&
+					entry.maxTime < time + DAY
+				){
+					return false;
+				}
+			}
+			else
+			{
+				if(entry.minTime > (night ? time + DAY : time))
+				{
+					return false;
+				}
+				if(	night &&
+					entry.maxTime < PREVIOUS_DAY_SCHEDULE_BEGIN &&
+					entry.minTime > time
+				){
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+}
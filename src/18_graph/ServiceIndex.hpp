@@ -0,0 +1,159 @@
+
+/** ServiceIndex class header.
+	@file ServiceIndex.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_graph_ServiceIndex_hpp__
+#define SYNTHESE_graph_ServiceIndex_hpp__
+
+#include "Path.h"
+
+#include <vector>
+#include <boost/date_time/posix_time/posix_time_duration.hpp>
+
+namespace synthese
+{
+	namespace graph
+	{
+		class Service;
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Schedules of the services of a path at an edge, sorted by time.
+		///	@ingroup m18
+		//////////////////////////////////////////////////////////////////////////
+		/// The index is a contiguous array of the schedules of the services at
+		/// the edge, stored as numbers of seconds since midnight of the day of
+		/// the service :
+		/// <ul>
+		///		<li>a departure index is sorted by departure time, in ascending
+		///		order</li>
+		///		<li>an arrival index is sorted by arrival time, in descending
+		///		order</li>
+		/// </ul>
+		/// A position in the index is then the rank of a service in the scan
+		/// order of Edge::getNextService or Edge::getPreviousService : the next
+		/// candidate is always at the following position.
+		///
+		/// Each position stores the range of the schedules of the service at the
+		/// edge (the range of a continuous service is unbounded : its schedules
+		/// are read by Service::getFromPresenceTime only), and a running bound
+		/// allowing to find by binary search the first position which can be
+		/// used at a given time.
+		///
+		/// A real time index includes the theoretical schedules in the range of
+		/// each service, because the theoretical schedules are used by
+		/// Service::getFromPresenceTime after the current day.
+		///
+		/// The index is read only once built : it is replaced as a whole when the
+		/// services of the path are updated.
+		class ServiceIndex
+		{
+		public:
+			typedef std::size_t Value;
+
+			static const int UNBOUNDED;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Service of the index.
+			struct Entry
+			{
+				int time;	//!< sort key : departure (or arrival) schedule in seconds
+				int minTime;	//!< earliest schedule of the service at the edge
+				int maxTime;	//!< latest schedule of the service at the edge
+				const Service* service;
+			};
+			typedef std::vector<Entry> Entries;
+
+		private:
+			bool _departure;
+			Entries _entries;
+			std::vector<int> _bounds;	//!< latest maxTime (departure) or earliest minTime (arrival) of the entries until each position
+
+			static int _ToSeconds(const boost::posix_time::time_duration& value);
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Builds the index of the services of a path at an edge.
+			/// @param services the services of the path
+			/// @param rankInPath rank of the edge in the path
+			/// @param departure true for a departure index, false for an arrival index
+			/// @param RTData true for the real time index
+			/// @warning the services set must be protected by the services mutex of
+			/// the path during the construction
+			ServiceIndex(
+				const ServiceSet& services,
+				std::size_t rankInPath,
+				bool departure,
+				bool RTData
+			);
+
+			//! @name Getters
+			//@{
+				bool isDeparture() const { return _departure; }
+				const Entries& getEntries() const { return _entries; }
+			//@}
+
+			//! @name Services
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// Position after the last entry.
+				Value end() const { return _entries.size(); }
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Entry at a position.
+				/// @pre value < end()
+				const Entry& get(Value value) const { return _entries[value]; }
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Finds by binary search the first position which can be used at a
+				/// given presence time.
+				/// All the entries before the returned position are rejected by
+				/// isCandidate at this time.
+				/// @param presenceTime presence time of day at the edge
+				/// @return the first position to scan, end() if none
+				Value getFirst(const boost::posix_time::time_duration& presenceTime) const;
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Checks if the service at a position can be used at a presence time
+				/// without reading the service.
+				/// The check is conservative : a true result must be confirmed by
+				/// Service::getFromPresenceTime.
+				/// Presence times before 03:00 can be served by the services of the
+				/// previous day, according to the rule of
+				/// Service::getFromPresenceTime.
+				/// @param value the position to check
+				/// @param presenceTime presence time of day at the edge
+				/// @return false if the service can not be used at this time
+				bool isCandidate(
+					Value value,
+					const boost::posix_time::time_duration& presenceTime
+				) const;
+			//@}
+		};
+	}
+}
+
+#endif // SYNTHESE_graph_ServiceIndex_hpp__
@@ -30,6 +30,9 @@
 #include "InterSYNTHESEUpdateAckService.hpp"
 #include "StaticFunctionRequest.h"
 
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+
 using namespace boost;
 using namespace std;
 
@@ -51,6 +54,18 @@ namespace synthese
 
 
 
+		InterSYNTHESEFileFormat::Importer_::PendingAcks InterSYNTHESEFileFormat::Importer_::_pendingAcks;
+		boost::mutex InterSYNTHESEFileFormat::Importer_::_pendingAcksMutex;
+
+
+
+		string InterSYNTHESEFileFormat::Importer_::_getPendingAckKey() const
+		{
+			return _address +":"+ _port +":"+ lexical_cast<string>(_slaveId);
+		}
+
+
+
 		bool InterSYNTHESEFileFormat::Importer_::_read(
 		) const	{
 			try
@@ -59,8 +74,18 @@ namespace synthese
 					"Inter-SYNTHESE : Attempt to sync with "+ _address +":"+ _port + " as slave id #"+ lexical_cast<string>(_slaveId)
 				);
 				
+				// The request acknowledges the last applied batch
 				StaticFunctionRequest<InterSYNTHESESlaveUpdateService> r;
 				r.getFunction()->setSlaveId(_slaveId);
+				r.getFunction()->setBatch(true);
+				{
+					boost::mutex::scoped_lock lock(_pendingAcksMutex);
+					PendingAcks::const_iterator it(_pendingAcks.find(_getPendingAckKey()));
+					if(it != _pendingAcks.end())
+					{
+						r.getFunction()->setAckRange(it->second.first, it->second.second);
+					}
+				}
 				BasicClient c(
 					_address,
 					_port
@@ -69,6 +94,12 @@ namespace synthese
 					c.get(r.getURL())
 				);
 
+				// The master has received the acknowledgement
+				{
+					boost::mutex::scoped_lock lock(_pendingAcksMutex);
+					_pendingAcks.erase(_getPendingAckKey());
+				}
+
 				if(contentStr == InterSYNTHESESlaveUpdateService::NO_CONTENT_TO_SYNC)
 				{
 					_logDebug(
@@ -77,70 +108,52 @@ namespace synthese
 					return true;
 				}
 
-				bool ok(true);
-				typedef std::map<
-					util::RegistryKeyType,	// id of the update
-					std::pair<
-						std::string,		// synchronizer
-						std::string			// message
-				>	> ContentMap;
-				ContentMap content;
-	
-				size_t i(0);
-				while(i < contentStr.size())
+				// Batch mode : the range is acknowledged by the next request, once
+				// the content is applied
+				const string batchHeader(
+					InterSYNTHESESlaveUpdateService::BATCH_HEADER +
+					InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR
+				);
+				if(!contentStr.compare(0, batchHeader.size(), batchHeader))
 				{
-					ContentMap::mapped_type item;
-
-					// ID + Search for next :
-					size_t l=i;
-					for(; i < contentStr.size() && contentStr[i] != InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR[0]; ++i) ;
-					if(i == contentStr.size())
+					// Header : batch:range begin:range end:items number
+					size_t headerEnd(contentStr.find(InterSYNTHESESlaveUpdateService::SYNCS_SEPARATOR));
+					if(headerEnd == string::npos)
 					{
-						ok = false;
-						break;
+						return false;
 					}
-					RegistryKeyType id(lexical_cast<RegistryKeyType>(contentStr.substr(l, i-l)));
-					++i;
-
-					// Synchronizer + Search for next :
-					l=i;
-					for(; i < contentStr.size() && contentStr[i] != InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR[0]; ++i) ;
-					if(i == contentStr.size())
+					vector<string> fields;
+					string header(contentStr.substr(batchHeader.size(), headerEnd - batchHeader.size()));
+					split(fields, header, is_any_of(InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR));
+					if(fields.size() < 2)
 					{
-						ok = false;
-						break;
+						return false;
 					}
-					item.first = contentStr.substr(l, i-l);
-					++i;
-
-					// Size + Search for next :
-					l=i;
-					for(; i < contentStr.size() && contentStr[i] != InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR[0]; ++i) ;
-					if(i == contentStr.size())
-					{
-						ok = false;
-						break;
+					RegistryKeyType rangeBegin(lexical_cast<RegistryKeyType>(fields[0]));
+					RegistryKeyType rangeEnd(lexical_cast<RegistryKeyType>(fields[1]));
+
+					ContentMap content;
+					if(!_parseContent(
+						contentStr,
+						headerEnd + InterSYNTHESESlaveUpdateService::SYNCS_SEPARATOR.size(),
+						content
+					)){
+						return false;
 					}
-					size_t contentSize = lexical_cast<size_t>(contentStr.substr(l, i-l));
-					++i;
+					_logDebug(
+						"Inter-SYNTHESE : "+ _address +":"+ _port + " has sent "+ lexical_cast<string>(content.size()) +" elements to sync in "+ lexical_cast<string>(contentStr.size()) +" bytes for slave id #"+ lexical_cast<string>(_slaveId)
+					);
 
-					// Content
-					if(i+contentSize > contentStr.size())
-					{
-						ok = false;
-						break;
-					}
-					item.second = contentStr.substr(i, contentSize);
-					i += contentSize + InterSYNTHESESlaveUpdateService::SYNCS_SEPARATOR.size();
-
-					content.insert(
-						make_pair(
-							id,
-							item
-					)	);
+					_applyContent(content);
+
+					boost::mutex::scoped_lock lock(_pendingAcksMutex);
+					_pendingAcks[_getPendingAckKey()] = make_pair(rangeBegin, rangeEnd);
+					return true;
 				}
 
-				if(!ok)
+				// Master without batch mode : acknowledgement before the update
+				ContentMap content;
+				if(!_parseContent(contentStr, 0, content))
 				{
 					return false;
 				}
@@ -168,56 +181,122 @@ namespace synthese
 				);
 				if(result2 == InterSYNTHESEUpdateAckService::VALUE_OK)
 				{
-					// Local variables
-					auto_ptr<InterSYNTHESESyncTypeFactory> interSYNTHESE;
-					string lastFactoryKey;
+					_applyContent(content);
+				}
+			}
+			catch(std::exception& e)
+			{
+				_logError(
+					"Inter-SYNTHESE : Synchronization with "+ _address +":"+ _port + " as slave id #"+ lexical_cast<string>(_slaveId) +" has failed "+ string(e.what())
+				);
+				return false;
+			}
+			return true;
+		}
+
+
+
+		bool InterSYNTHESEFileFormat::Importer_::_parseContent(
+			const string& contentStr,
+			size_t i,
+			ContentMap& content
+		) const	{
+			while(i < contentStr.size())
+			{
+				ContentMap::mapped_type item;
+
+				// ID + Search for next :
+				size_t l=i;
+				for(; i < contentStr.size() && contentStr[i] != InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR[0]; ++i) ;
+				if(i == contentStr.size())
+				{
+					return false;
+				}
+				RegistryKeyType id(lexical_cast<RegistryKeyType>(contentStr.substr(l, i-l)));
+				++i;
+
+				// Synchronizer + Search for next :
+				l=i;
+				for(; i < contentStr.size() && contentStr[i] != InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR[0]; ++i) ;
+				if(i == contentStr.size())
+				{
+					return false;
+				}
+				item.first = contentStr.substr(l, i-l);
+				++i;
+
+				// Size + Search for next :
+				l=i;
+				for(; i < contentStr.size() && contentStr[i] != InterSYNTHESESlaveUpdateService::FIELDS_SEPARATOR[0]; ++i) ;
+				if(i == contentStr.size())
+				{
+					return false;
+				}
+				size_t contentSize = lexical_cast<size_t>(contentStr.substr(l, i-l));
+				++i;
+
+				// Content
+				if(i+contentSize > contentStr.size())
+				{
+					return false;
+				}
+				item.second = contentStr.substr(i, contentSize);
+				i += contentSize + InterSYNTHESESlaveUpdateService::SYNCS_SEPARATOR.size();
+
+				content.insert(
+					make_pair(
+						id,
+						item
+				)	);
+			}
+			return true;
+		}
+
+
 
-					// Reading the content
-					BOOST_FOREACH(const ContentMap::value_type& item, content)
+		void InterSYNTHESEFileFormat::Importer_::_applyContent(
+			const ContentMap& content
+		) const	{
+			// Local variables
+			auto_ptr<InterSYNTHESESyncTypeFactory> interSYNTHESE;
+			string lastFactoryKey;
+
+			// Reading the content
+			BOOST_FOREACH(const ContentMap::value_type& item, content)
+			{
+				try
+				{
+					const string& factoryKey(item.second.first);
+					if(factoryKey != lastFactoryKey)
 					{
-						try
-						{
-							const string& factoryKey(item.second.first);
-							if(factoryKey != lastFactoryKey)
-							{
-								if(interSYNTHESE.get())
-								{
-									interSYNTHESE->closeSync();
-								}
-								interSYNTHESE.reset(
-									Factory<InterSYNTHESESyncTypeFactory>::create(factoryKey)
-								);
-								lastFactoryKey = factoryKey;
-								interSYNTHESE->initSync();
-							}
-
-							interSYNTHESE->sync(
-								item.second.second,
-								_idFilter.get()
-							);
-						}
-						catch(...)
+						if(interSYNTHESE.get())
 						{
-							// Log
+							interSYNTHESE->closeSync();
 						}
-					}
-					if(interSYNTHESE.get())
-					{
-						interSYNTHESE->closeSync();
-						_logDebug(
-							"Inter-SYNTHESE : "+ _address +":"+ _port + " has been synchronized with current instance as slave id #"+ lexical_cast<string>(_slaveId)
+						interSYNTHESE.reset(
+							Factory<InterSYNTHESESyncTypeFactory>::create(factoryKey)
 						);
+						lastFactoryKey = factoryKey;
+						interSYNTHESE->initSync();
 					}
+
+					interSYNTHESE->sync(
+						item.second.second,
+						_idFilter.get()
+					);
+				}
+				catch(...)
+				{
+					// Log
 				}
 			}
-			catch(std::exception& e)
+			if(interSYNTHESE.get())
 			{
-				_logError(
-					"Inter-SYNTHESE : Synchronization with "+ _address +":"+ _port + " as slave id #"+ lexical_cast<string>(_slaveId) +" has failed "+ string(e.what())
+				interSYNTHESE->closeSync();
+				_logDebug(
+					"Inter-SYNTHESE : "+ _address +":"+ _port + " has been synchronized with current instance as slave id #"+ lexical_cast<string>(_slaveId)
 				);
-				return false;
 			}
-			return true;
 		}
 
 
@@ -31,6 +31,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <boost/thread/mutex.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
@@ -63,6 +64,38 @@ namespace synthese
 				util::RegistryKeyType _slaveId;
 				boost::shared_ptr<InterSYNTHESEIdFilter> _idFilter;
 
+				typedef std::map<
+					util::RegistryKeyType,	// id of the update
+					std::pair<
+						std::string,		// synchronizer
+						std::string			// message
+				>	> ContentMap;
+
+				/// Ranges applied but not acknowledged yet, by master and slave id.
+				/// The acknowledgement is sent with the next request.
+				typedef std::map<
+					std::string,
+					std::pair<util::RegistryKeyType, util::RegistryKeyType>
+				> PendingAcks;
+				static PendingAcks _pendingAcks;
+				static boost::mutex _pendingAcksMutex;
+
+				std::string _getPendingAckKey() const;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Reads the updates sent by the master.
+				/// @param contentStr the content sent by the master
+				/// @param i position of the first update in the content
+				/// @param content the updates (output)
+				/// @return false if the content is malformed
+				bool _parseContent(
+					const std::string& contentStr,
+					std::size_t i,
+					ContentMap& content
+				) const;
+
+				void _applyContent(const ContentMap& content) const;
+
 			protected:
 
 
@@ -25,7 +25,6 @@
 #include "Import.hpp"
 #include "InterSYNTHESEFileFormat.hpp"
 #include "InterSYNTHESEPackage.hpp"
-#include "InterSYNTHESEQueueTableSync.hpp"
 #include "InterSYNTHESESlave.hpp"
 #include "InterSYNTHESESlaveUpdateService.hpp"
 #include "ServerModule.h"
@@ -57,6 +56,7 @@ namespace synthese
 		const string InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_WAITING_TIME = "inter_synthese_waiting_time";
 		const string InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_SLAVE_ACTIVE = "inter_synthese_slave_active";
 		const string InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_SLAVE_ID = "inter_synthese_slave_id";
+		const string InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_QUEUE_LOGS_PATH = "inter_synthese_queue_logs_path";
 		const RegistryKeyType InterSYNTHESEModule::FAKE_IMPORT_ID = 1;
 
 		string InterSYNTHESEModule::_masterHost;
@@ -64,6 +64,7 @@ namespace synthese
 		bool InterSYNTHESEModule::_slaveActive(true);
 		time_duration InterSYNTHESEModule::_syncWaitingTime(seconds(5));
 		RegistryKeyType InterSYNTHESEModule::_slaveId(0);
+		string InterSYNTHESEModule::_queueLogsPath("inter_synthese_queue");
 		InterSYNTHESEModule::PackagesBySmartURL InterSYNTHESEModule::_packagesBySmartURL;
 	}
 
@@ -78,6 +79,7 @@ namespace synthese
 			RegisterParameter(InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_SLAVE_ACTIVE, "0", &InterSYNTHESEModule::ParameterCallback);
 			RegisterParameter(InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_SLAVE_ID, "0", &InterSYNTHESEModule::ParameterCallback);
 			RegisterParameter(InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_WAITING_TIME, "5", &InterSYNTHESEModule::ParameterCallback);
+			RegisterParameter(InterSYNTHESEModule::MODULE_PARAM_INTER_SYNTHESE_QUEUE_LOGS_PATH, "inter_synthese_queue", &InterSYNTHESEModule::ParameterCallback);
 		}
 
 
@@ -166,6 +168,13 @@ namespace synthese
 					_slaveActive = false;
 				}
 			}
+			else if(name == MODULE_PARAM_INTER_SYNTHESE_QUEUE_LOGS_PATH)
+			{
+				if(!value.empty())
+				{
+					_queueLogsPath = value;
+				}
+			}
 			else if(name == MODULE_PARAM_INTER_SYNTHESE_SLAVE_ID)
 			{
 				try
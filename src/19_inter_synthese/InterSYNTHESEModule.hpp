@@ -86,6 +86,7 @@ namespace synthese
 			static const std::string MODULE_PARAM_INTER_SYNTHESE_WAITING_TIME;
 			static const std::string MODULE_PARAM_INTER_SYNTHESE_SLAVE_ACTIVE;
 			static const std::string MODULE_PARAM_INTER_SYNTHESE_SLAVE_ID;
+			static const std::string MODULE_PARAM_INTER_SYNTHESE_QUEUE_LOGS_PATH;
 			static const util::RegistryKeyType FAKE_IMPORT_ID;
 
 			typedef std::map<std::string, InterSYNTHESEPackage*> PackagesBySmartURL;
@@ -96,6 +97,7 @@ namespace synthese
 			static std::string _masterPort;
 			static bool _slaveActive;
 			static util::RegistryKeyType _slaveId;
+			static std::string _queueLogsPath;
 			static void _generateFakeImport();
 			static PackagesBySmartURL _packagesBySmartURL;
 
@@ -110,6 +112,10 @@ namespace synthese
 				const std::string& value
 			);
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Directory of the queue logs of the slaves (see InterSYNTHESEQueueLog).
+			static const std::string& GetQueueLogsPath() { return _queueLogsPath; }
+
 			static InterSYNTHESEPackage* GetPackageBySmartURL(
 				const std::string& smartURL
 			);
@@ -24,7 +24,6 @@
 #include "InterSYNTHESEConfigTableSync.hpp"
 #include "InterSYNTHESEConfigItemTableSync.hpp"
 #include "InterSYNTHESEPackageTableSync.hpp"
-#include "InterSYNTHESEQueueTableSync.hpp"
 #include "InterSYNTHESESlaveTableSync.hpp"
 
 #include "InterSYNTHESEModule.inc.cpp"
@@ -37,7 +36,6 @@ void synthese::inter_synthese::moduleRegister()
 	synthese::inter_synthese::InterSYNTHESEConfigItemTableSync::integrate();
 	synthese::inter_synthese::InterSYNTHESEPackageTableSync::integrate();
 	synthese::inter_synthese::InterSYNTHESESlaveTableSync::integrate();
-	synthese::inter_synthese::InterSYNTHESEQueueTableSync::integrate();
 
 	synthese::inter_synthese::InterSYNTHESEFileFormat::integrate();
 	synthese::inter_synthese::InterSYNTHESEPackageFileFormat::integrate();
@@ -53,24 +53,4 @@ namespace synthese
 			)	)
 		{
 		}
-
-
-
-		void InterSYNTHESEQueue::link( util::Env& env, bool withAlgorithmOptimizations /*= false*/ )
-		{
-			if(get<InterSYNTHESESlave>())
-			{
-				get<InterSYNTHESESlave>()->queue(*this);
-			}
-		}
-
-
-
-		void InterSYNTHESEQueue::unlink()
-		{
-			if(get<InterSYNTHESESlave>())
-			{
-				get<InterSYNTHESESlave>()->removeFromQueue(get<Key>());
-			}
-		}
 }	}
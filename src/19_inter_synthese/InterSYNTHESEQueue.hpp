@@ -57,6 +57,10 @@ namespace synthese
 		///	@ingroup m19
 		/// @author Hugues Romain
 		/// @since 3.5.0
+		//////////////////////////////////////////////////////////////////////////
+		/// Update waiting for a slave. The items are read from the queue log of
+		/// the slave (see InterSYNTHESEQueueLog) and are identified by their
+		/// offset in the log.
 		class InterSYNTHESEQueue:
 			public Object<InterSYNTHESEQueue, InterSYNTHESEQueueRecord>
 		{
@@ -73,12 +77,6 @@ namespace synthese
 			//! @name Services
 			//@{
 			//@}
-
-			//! @name Modifiers
-			//@{
-				virtual void link(util::Env& env, bool withAlgorithmOptimizations = false);
-				virtual void unlink();
-			//@}
 		};
 }	}
 
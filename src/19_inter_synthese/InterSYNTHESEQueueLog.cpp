@@ -0,0 +1,358 @@
+
+/** InterSYNTHESEQueueLog class implementation.
+	@file InterSYNTHESEQueueLog.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "InterSYNTHESEQueueLog.hpp"
+
+#include "Exception.h"
+
+#include <cstdio>
+#include <cstring>
+#include <boost/filesystem/operations.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	namespace inter_synthese
+	{
+		const string InterSYNTHESEQueueLog::MAGIC("SYNTHESE INTER-SYNTHESE QUEUE LOG 1");
+		const uint64_t InterSYNTHESEQueueLog::COMPACTION_MIN_SIZE(16 * 1024 * 1024);
+
+		namespace
+		{
+			const ptime EPOCH(gregorian::date(1970, 1, 1));
+			const uint64_t HEADER_SIZE(InterSYNTHESEQueueLog::MAGIC.size() + sizeof(uint64_t));
+
+			// Writing helpers
+			template<class T>
+			void _WriteNumber(string& buffer, T value)
+			{
+				buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+			}
+
+
+
+			// Reading helper : returns false if the stream ends before the value
+			template<class T>
+			bool _ReadNumber(istream& stream, T& value)
+			{
+				char buffer[sizeof(T)];
+				if(!stream.read(buffer, sizeof(T)))
+				{
+					return false;
+				}
+				memcpy(&value, buffer, sizeof(T));
+				return true;
+			}
+
+
+
+			// Replaces a file by an other one, atomically where the system allows it
+			void _ReplaceFile(const string& from, const string& to)
+			{
+#ifdef WIN32
+				remove(to.c_str());
+#endif
+				if(rename(from.c_str(), to.c_str()))
+				{
+					remove(from.c_str());
+					throw synthese::Exception("Inter-SYNTHESE queue log "+ to +" can not be written");
+				}
+			}
+		}
+
+
+
+		InterSYNTHESEQueueLog::InterSYNTHESEQueueLog(
+			const string& path
+		):	_path(path),
+			_firstOffset(1),
+			_endOffset(1),
+			_acknowledgedOffset(1)
+		{}
+
+
+
+		void InterSYNTHESEQueueLog::_writeHeader(
+			ostream& stream,
+			Offset firstOffset
+		) const	{
+			string header(MAGIC);
+			_WriteNumber(header, static_cast<uint64_t>(firstOffset));
+			stream.write(header.data(), header.size());
+		}
+
+
+
+		void InterSYNTHESEQueueLog::_writeAcknowledgedOffset() const
+		{
+			string temporaryPath(_getAcknowledgementPath() + ".tmp");
+			{
+				ofstream file(temporaryPath.c_str(), ios::out | ios::trunc);
+				file << _acknowledgedOffset;
+				file.close();
+				if(file.fail())
+				{
+					remove(temporaryPath.c_str());
+					throw synthese::Exception("Inter-SYNTHESE queue log "+ _getAcknowledgementPath() +" can not be written");
+				}
+			}
+			_ReplaceFile(temporaryPath, _getAcknowledgementPath());
+		}
+
+
+
+		void InterSYNTHESEQueueLog::_openForAppend()
+		{
+			_file.close();
+			_file.clear();
+			_file.open(_path.c_str(), ios::out | ios::binary | ios::app);
+			if(!_file.is_open())
+			{
+				throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" can not be written");
+			}
+		}
+
+
+
+		bool InterSYNTHESEQueueLog::open(
+			Records& pendingRecords
+		){
+			_file.close();
+			pendingRecords.clear();
+
+			// Creation of the log
+			if(!filesystem::exists(_path))
+			{
+				_firstOffset = _endOffset;
+				_acknowledgedOffset = _endOffset;
+				{
+					ofstream file(_path.c_str(), ios::out | ios::binary | ios::trunc);
+					_writeHeader(file, _firstOffset);
+					file.close();
+					if(file.fail())
+					{
+						throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" can not be written");
+					}
+				}
+				_writeAcknowledgedOffset();
+				_openForAppend();
+				return false;
+			}
+
+			ifstream file(_path.c_str(), ios::in | ios::binary);
+			if(!file.is_open())
+			{
+				throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" can not be read");
+			}
+
+			// Header
+			string magic(MAGIC.size(), 0);
+			uint64_t firstOffset(0);
+			if(	!file.read(&magic[0], magic.size()) ||
+				magic != MAGIC ||
+				!_ReadNumber(file, firstOffset)
+			){
+				throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" has not the current format");
+			}
+			_firstOffset = firstOffset;
+
+			// Acknowledged offset : if its file was lost, the records are sent again
+			_acknowledgedOffset = _firstOffset;
+			{
+				ifstream ackFile(_getAcknowledgementPath().c_str());
+				Offset acknowledgedOffset(0);
+				if(ackFile >> acknowledgedOffset && acknowledgedOffset > _firstOffset)
+				{
+					_acknowledgedOffset = acknowledgedOffset;
+				}
+			}
+
+			// Records : the acknowledged ones are skipped
+			uint64_t position(HEADER_SIZE + _acknowledgedOffset - _firstOffset);
+			if(position > filesystem::file_size(_path))
+			{
+				_acknowledgedOffset = _firstOffset;
+				position = HEADER_SIZE;
+			}
+			file.seekg(position);
+			while(true)
+			{
+				uint32_t size(0);
+				if(!_ReadNumber(file, size))
+				{
+					break;
+				}
+				string body(size, 0);
+				if(size && !file.read(&body[0], size))
+				{
+					break;
+				}
+
+				Offset offset(_firstOffset + position - HEADER_SIZE);
+				position += sizeof(uint32_t) + size;
+
+				const size_t fixedSize(sizeof(int64_t) + sizeof(uint32_t));
+				int64_t requestTime(0);
+				uint32_t syncTypeSize(0);
+				if(size >= fixedSize)
+				{
+					memcpy(&requestTime, body.data(), sizeof(int64_t));
+					memcpy(&syncTypeSize, body.data() + sizeof(int64_t), sizeof(uint32_t));
+				}
+				if(size < fixedSize || syncTypeSize > size - fixedSize)
+				{
+					throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" is corrupted");
+				}
+
+				Record record;
+				record.offset = offset;
+				record.requestTime = requestTime ? EPOCH + microseconds(requestTime) : ptime(not_a_date_time);
+				record.syncType = body.substr(fixedSize, syncTypeSize);
+				record.content = body.substr(fixedSize + syncTypeSize);
+				pendingRecords.push_back(record);
+			}
+			file.close();
+			_endOffset = _firstOffset + position - HEADER_SIZE;
+
+			// A record truncated by a crash during its writing is dropped
+			if(filesystem::file_size(_path) > position)
+			{
+				filesystem::resize_file(_path, position);
+			}
+
+			_openForAppend();
+			return true;
+		}
+
+
+
+		InterSYNTHESEQueueLog::Offset InterSYNTHESEQueueLog::append(
+			const ptime& requestTime,
+			const string& syncType,
+			const string& content
+		){
+			string record;
+			_WriteNumber(record, static_cast<uint32_t>(sizeof(int64_t) + sizeof(uint32_t) + syncType.size() + content.size()));
+			_WriteNumber(record, static_cast<int64_t>(requestTime.is_not_a_date_time() ? 0 : (requestTime - EPOCH).total_microseconds()));
+			_WriteNumber(record, static_cast<uint32_t>(syncType.size()));
+			record.append(syncType);
+			record.append(content);
+
+			_file.write(record.data(), record.size());
+			_file.flush();
+			if(_file.fail())
+			{
+				// Drops the part of the record which may have been written
+				_file.close();
+				try
+				{
+					filesystem::resize_file(_path, HEADER_SIZE + _endOffset - _firstOffset);
+				}
+				catch(filesystem::filesystem_error&)
+				{
+				}
+				_openForAppend();
+				throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" can not be written");
+			}
+
+			Offset offset(_endOffset);
+			_endOffset += record.size();
+			return offset;
+		}
+
+
+
+		void InterSYNTHESEQueueLog::acknowledge(
+			Offset nextOffset
+		){
+			if(	nextOffset <= _acknowledgedOffset ||
+				nextOffset > _endOffset
+			){
+				return;
+			}
+			_acknowledgedOffset = nextOffset;
+			_writeAcknowledgedOffset();
+
+			// The acknowledged records are dropped when they take more room than the
+			// pending ones, so the copy of the pending records is amortized
+			uint64_t acknowledgedSize(_acknowledgedOffset - _firstOffset);
+			if(	acknowledgedSize >= COMPACTION_MIN_SIZE &&
+				acknowledgedSize >= _endOffset - _acknowledgedOffset
+			){
+				_compact();
+			}
+		}
+
+
+
+		void InterSYNTHESEQueueLog::clear()
+		{
+			_acknowledgedOffset = _endOffset;
+			_writeAcknowledgedOffset();
+			_compact();
+		}
+
+
+
+		void InterSYNTHESEQueueLog::_compact()
+		{
+			_file.close();
+
+			string temporaryPath(_path + ".tmp");
+			{
+				ifstream source(_path.c_str(), ios::in | ios::binary);
+				ofstream file(temporaryPath.c_str(), ios::out | ios::binary | ios::trunc);
+				_writeHeader(file, _acknowledgedOffset);
+
+				// Copy of the pending records
+				source.seekg(HEADER_SIZE + _acknowledgedOffset - _firstOffset);
+				char buffer[65536];
+				while(source.read(buffer, sizeof(buffer)) || source.gcount())
+				{
+					file.write(buffer, source.gcount());
+				}
+
+				file.close();
+				if(file.fail())
+				{
+					remove(temporaryPath.c_str());
+					_openForAppend();
+					throw synthese::Exception("Inter-SYNTHESE queue log "+ _path +" can not be written");
+				}
+			}
+			try
+			{
+				_ReplaceFile(temporaryPath, _path);
+			}
+			catch(...)
+			{
+				_openForAppend();
+				throw;
+			}
+			_firstOffset = _acknowledgedOffset;
+
+			_openForAppend();
+		}
+}	}
@@ -0,0 +1,143 @@
+
+/** InterSYNTHESEQueueLog class header.
+	@file InterSYNTHESEQueueLog.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_inter_synthese_InterSYNTHESEQueueLog_hpp__
+#define SYNTHESE_inter_synthese_InterSYNTHESEQueueLog_hpp__
+
+#include "UtilTypes.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace inter_synthese
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Append-only log of the updates waiting for an Inter-SYNTHESE slave.
+		///	@ingroup m19
+		//////////////////////////////////////////////////////////////////////////
+		/// Each update is appended to the log file of the slave as a record and is
+		/// identified by its offset, which never changes and is never reused : the
+		/// slave acknowledges the updates it has applied by the offset of the next
+		/// update to send, which is persisted in a separate file. At the opening
+		/// of the log, the replication resumes from the acknowledged offset.
+		///
+		/// The acknowledged records are not removed one by one : when they take
+		/// more room than the pending ones, the pending records are copied into a
+		/// new log file which replaces the previous one.
+		///
+		/// Log file format (native byte order) : magic, offset of the first
+		/// record, then for each record its size, its request time (microseconds
+		/// since 1970, 0 if unknown), its sync type and its content. A record
+		/// truncated by a crash is dropped at the opening of the log.
+		///
+		/// The log is not thread safe : the slave locks its queue around each
+		/// call.
+		class InterSYNTHESEQueueLog
+		{
+		public:
+			static const std::string MAGIC;
+			static const boost::uint64_t COMPACTION_MIN_SIZE;
+
+			typedef util::RegistryKeyType Offset;
+
+			struct Record
+			{
+				Offset offset;
+				boost::posix_time::ptime requestTime;
+				std::string syncType;
+				std::string content;
+			};
+			typedef std::vector<Record> Records;
+
+		private:
+			const std::string _path;
+			std::ofstream _file;
+			Offset _firstOffset;	//!< offset of the first record of the file
+			Offset _endOffset;	//!< offset of the next record to append
+			Offset _acknowledgedOffset;	//!< offset of the first record not applied by the slave
+
+			std::string _getAcknowledgementPath() const { return _path + ".ack"; }
+			void _writeHeader(std::ostream& stream, Offset firstOffset) const;
+			void _writeAcknowledgedOffset() const;
+			void _openForAppend();
+			void _compact();
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor.
+			/// @param path path of the log file
+			InterSYNTHESEQueueLog(const std::string& path);
+
+			//! @name Getters
+			//@{
+				Offset getEndOffset() const { return _endOffset; }
+				Offset getAcknowledgedOffset() const { return _acknowledgedOffset; }
+			//@}
+
+			//! @name Services
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// Opens the log file, or creates it if it does not exist.
+				/// @param pendingRecords the records not acknowledged by the slave,
+				/// in the order of the log
+				/// @return false if the log file was created
+				/// @throws synthese::Exception if the log can not be read or written
+				bool open(Records& pendingRecords);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Appends a record at the end of the log.
+				/// @return the offset of the record
+				/// @throws synthese::Exception if the log can not be written
+				Offset append(
+					const boost::posix_time::ptime& requestTime,
+					const std::string& syncType,
+					const std::string& content
+				);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Records the application of the records by the slave.
+				/// @param nextOffset offset of the first record not applied by the
+				/// slave (the end offset if all the records were applied)
+				/// @throws synthese::Exception if the log can not be written
+				void acknowledge(Offset nextOffset);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Drops all the records, before a full update of the slave.
+				/// The offsets of the next records follow the dropped ones.
+				/// @throws synthese::Exception if the log can not be written
+				void clear();
+			//@}
+		};
+}	}
+
+#endif // SYNTHESE_inter_synthese_InterSYNTHESEQueueLog_hpp__
@@ -24,14 +24,21 @@
 
 #include "ActionException.h"
 #include "BasicClient.h"
+#include "DBTransaction.hpp"
 #include "InterSYNTHESEConfigItem.hpp"
+#include "InterSYNTHESEModule.hpp"
 #include "InterSYNTHESEQueue.hpp"
-#include "InterSYNTHESEQueueTableSync.hpp"
+#include "InterSYNTHESEQueueLog.hpp"
 #include "InterSYNTHESESlaveTableSync.hpp"
 #include "InterSYNTHESESlaveUpdateService.hpp"
 #include "InterSYNTHESESyncTypeFactory.hpp"
+#include "Log.h"
 #include "ServerModule.h"
 
+#include <boost/bind.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
 using namespace boost;
 using namespace std;
 using namespace boost::posix_time;
@@ -54,6 +61,43 @@ namespace synthese
 	{
 		const string InterSYNTHESESlave::TAG_QUEUE_ITEM = "queue_item";
 		const string InterSYNTHESESlave::TAG_QUEUE_SIZE = "queue_size";
+		const string InterSYNTHESESlave::ATTR_OLDEST_ITEM_TIME = "oldest_item_time";
+		const string InterSYNTHESESlave::ATTR_LAG = "lag";
+		const string InterSYNTHESESlave::ATTR_LAST_SEND_TIME = "last_send_time";
+		const string InterSYNTHESESlave::ATTR_LAST_ACK_TIME = "last_ack_time";
+		const string InterSYNTHESESlave::ATTR_LAST_SENT_ITEMS_NUMBER = "last_sent_items_number";
+		const string InterSYNTHESESlave::ATTR_LAST_MERGED_ITEMS_NUMBER = "last_merged_items_number";
+		const string InterSYNTHESESlave::ATTR_LAST_SENT_SIZE = "last_sent_size";
+		const string InterSYNTHESESlave::ATTR_SENT_ITEMS_NUMBER = "sent_items_number";
+		const string InterSYNTHESESlave::ATTR_MERGED_ITEMS_NUMBER = "merged_items_number";
+		const string InterSYNTHESESlave::ATTR_ACKNOWLEDGED_OFFSET = "acknowledged_offset";
+
+
+
+		namespace
+		{
+			boost::shared_ptr<InterSYNTHESEQueue> _CreateQueueItem(
+				const InterSYNTHESESlave& slave,
+				const InterSYNTHESEQueueLog::Record& record
+			){
+				boost::shared_ptr<InterSYNTHESEQueue> item(new InterSYNTHESEQueue(record.offset));
+				item->set<InterSYNTHESESlave>(const_cast<InterSYNTHESESlave&>(slave));
+				item->set<RequestTime>(record.requestTime);
+				item->set<SyncType>(record.syncType);
+				item->set<SyncContent>(record.content);
+				return item;
+			}
+		}
+
+
+
+		InterSYNTHESESlave::ReplicationStatistics::ReplicationStatistics():
+			lastSentItemsNumber(0),
+			lastMergedItemsNumber(0),
+			lastSentSize(0),
+			sentItemsNumber(0),
+			mergedItemsNumber(0)
+		{}
 
 
 
@@ -70,6 +114,7 @@ namespace synthese
 					FIELD_DEFAULT_CONSTRUCTOR(InterSYNTHESEConfig),
 					FIELD_VALUE_CONSTRUCTOR(Active, false)
 			)	),
+			_queueLost(false),
 			_lastSentRange(make_pair(_queue.end(), _queue.end())),
 			_previousConfig(NULL)
 		{
@@ -122,28 +167,101 @@ namespace synthese
 				return;
 			}
 
-			InterSYNTHESEQueue q;
-			q.set<InterSYNTHESESlave>(*const_cast<InterSYNTHESESlave*>(this));
-			q.set<RequestTime>(now);
-			q.set<SyncType>(interSYNTHESEType);
-			q.set<SyncContent>(parameter);
-			InterSYNTHESEQueueTableSync::Save(&q, transaction);
+			// A change made in a transaction is sent only if the transaction is
+			// committed
+			if(transaction)
+			{
+				transaction->addCommitCallback(
+					boost::bind(&InterSYNTHESESlave::_appendToQueue, this, now, interSYNTHESEType, parameter)
+				);
+			}
+			else
+			{
+				_appendToQueue(now, interSYNTHESEType, parameter);
+			}
 		}
 
 
 
-		void InterSYNTHESESlave::queue( InterSYNTHESEQueue& obj ) const
-		{
+		void InterSYNTHESESlave::_appendToQueue(
+			const ptime& requestTime,
+			const string& interSYNTHESEType,
+			const string& parameter
+		) const	{
 			recursive_mutex::scoped_lock lock(_queueMutex);
-			_queue.insert(make_pair(obj.get<Key>(), &obj));
+
+			// The change may be already committed : if it can not be logged, the
+			// slave will be fully updated
+			InterSYNTHESEQueueLog::Record record;
+			try
+			{
+				_openQueueLog();
+				record.offset = _queueLog->append(requestTime, interSYNTHESEType, parameter);
+			}
+			catch(synthese::Exception& e)
+			{
+				Log::GetInstance().error("Inter-SYNTHESE update of slave "+ lexical_cast<string>(getKey()) +" lost", e);
+				_queueLost = true;
+				return;
+			}
+			record.requestTime = requestTime;
+			record.syncType = interSYNTHESEType;
+			record.content = parameter;
+			_queue.insert(make_pair(record.offset, _CreateQueueItem(*this, record)));
 		}
 
 
 
-		void InterSYNTHESESlave::removeFromQueue( util::RegistryKeyType id ) const
+		void InterSYNTHESESlave::_openQueueLog() const
 		{
-			recursive_mutex::scoped_lock lock(_queueMutex);
-			_queue.erase(id);
+			if(_queueLog.get())
+			{
+				return;
+			}
+
+			try
+			{
+				filesystem::path directory(InterSYNTHESEModule::GetQueueLogsPath());
+				filesystem::create_directories(directory);
+				_queueLog.reset(
+					new InterSYNTHESEQueueLog(
+						(directory / (lexical_cast<string>(getKey()) + ".log")).string()
+				)	);
+			}
+			catch(filesystem::filesystem_error& e)
+			{
+				throw Exception("Inter-SYNTHESE queue log of slave "+ lexical_cast<string>(getKey()) +" can not be created : "+ e.what());
+			}
+
+			InterSYNTHESEQueueLog::Records records;
+			try
+			{
+				// Without log, the updates not sent to the slave are unknown
+				if(!_queueLog->open(records))
+				{
+					_queueLost = true;
+				}
+			}
+			catch(...)
+			{
+				_queueLog.reset();
+				throw;
+			}
+
+			_queue.clear();
+			BOOST_FOREACH(const InterSYNTHESEQueueLog::Record& record, records)
+			{
+				_queue.insert(make_pair(record.offset, _CreateQueueItem(*this, record)));
+			}
+			_lastSentRange = make_pair(_queue.end(), _queue.end());
+		}
+
+
+
+		InterSYNTHESESlave::Queue& InterSYNTHESESlave::getQueue() const
+		{
+			_openQueueLog();
+			return _queue;
 		}
 
 
@@ -155,8 +273,43 @@ namespace synthese
 
 			// Lock the queue
 			recursive_mutex::scoped_lock lock(_queueMutex);
+			_openQueueLog();
 
 			map.insert(prefix + TAG_QUEUE_SIZE, _queue.size());
+			map.insert(prefix + ATTR_ACKNOWLEDGED_OFFSET, _queueLog->getAcknowledgedOffset());
+
+			// Replication lag : age of the oldest update waiting for the slave
+			if(!_queue.empty())
+			{
+				const ptime& oldestItemTime(_queue.begin()->second->get<RequestTime>());
+				if(!oldestItemTime.is_not_a_date_time())
+				{
+					map.insert(prefix + ATTR_OLDEST_ITEM_TIME, oldestItemTime);
+					map.insert(
+						prefix + ATTR_LAG,
+						static_cast<int>((second_clock::local_time() - oldestItemTime).total_seconds())
+					);
+				}
+			}
+			else
+			{
+				map.insert(prefix + ATTR_LAG, 0);
+			}
+
+			// Replication statistics
+			if(!_statistics.lastSendTime.is_not_a_date_time())
+			{
+				map.insert(prefix + ATTR_LAST_SEND_TIME, _statistics.lastSendTime);
+			}
+			if(!_statistics.lastAckTime.is_not_a_date_time())
+			{
+				map.insert(prefix + ATTR_LAST_ACK_TIME, _statistics.lastAckTime);
+			}
+			map.insert(prefix + ATTR_LAST_SENT_ITEMS_NUMBER, _statistics.lastSentItemsNumber);
+			map.insert(prefix + ATTR_LAST_MERGED_ITEMS_NUMBER, _statistics.lastMergedItemsNumber);
+			map.insert(prefix + ATTR_LAST_SENT_SIZE, _statistics.lastSentSize);
+			map.insert(prefix + ATTR_SENT_ITEMS_NUMBER, _statistics.sentItemsNumber);
+			map.insert(prefix + ATTR_MERGED_ITEMS_NUMBER, _statistics.mergedItemsNumber);
 
 			size_t count(30);
 			BOOST_FOREACH(const Queue::value_type& it, _queue)
@@ -184,6 +337,15 @@ namespace synthese
 				throw Exception("Invalid slave configuration");
 			}
 
+			{
+				recursive_mutex::scoped_lock lock(_queueMutex);
+				_openQueueLog();
+				if(_queueLost)
+				{
+					return true;
+				}
+			}
+
 			return(isObsolete() || get<InterSYNTHESEConfig>()->get<ForceDump>());
 		}
 
@@ -194,20 +356,16 @@ namespace synthese
 				throw Exception("Invalid slave configuration");
 			}
 
-			if(isObsolete() || get<InterSYNTHESEConfig>()->get<ForceDump>())
+			if(fullUpdateNeeded())
 			{
 				// Clean the obsolete queue items
-				DBTransaction deleteTransaction;
 				{
-					// Do no run transation with the lock or we will deadlock if
-					// a transaction triggers a real time update
 					recursive_mutex::scoped_lock lock(_queueMutex);
-					BOOST_FOREACH(const Queue::value_type& it, _queue)
-					{
-						DBModule::GetDB()->deleteStmt(it.first, deleteTransaction);
-					}
+					_queueLog->clear();
+					_queue.clear();
+					_lastSentRange = make_pair(_queue.end(), _queue.end());
+					_queueLost = false;
 				}
-				deleteTransaction.run();
 
 				boost::unique_lock<shared_mutex> lock(ServerModule::baseWriterMutex, boost::try_to_lock);
 				if(!lock.owns_lock())
@@ -258,6 +416,7 @@ namespace synthese
 				throw Exception("Invalid slave configuration");
 			}
 
+			_openQueueLog();
 			if(_queue.empty())
 			{
 				return make_pair(_queue.end(), _queue.end());
@@ -319,27 +478,49 @@ namespace synthese
 
 		void InterSYNTHESESlave::clearLastSentRange() const
 		{
-			DBTransaction transaction;
+			recursive_mutex::scoped_lock lock(_queueMutex);
+			_openQueueLog();
+			if(_lastSentRange.first == _queue.end())
 			{
-				// Do no run transation with the lock or we will deadlock if
-				// a transaction triggers a real time update
-				recursive_mutex::scoped_lock lock(_queueMutex);
+				return;
+			}
 
-				for(Queue::iterator it(_lastSentRange.first);
-					it != _queue.end();
-					++it
-					){
-					DBModule::GetDB()->deleteStmt(it->first, transaction);
-					// Exit on last item
-					if(it == _lastSentRange.second)
-					{
-						break;
-					}
-				}
+			// The range begins at the first item of the queue : all the items before
+			// the next one are applied by the slave
+			Queue::iterator itNext(_lastSentRange.second);
+			++itNext;
+			InterSYNTHESEQueueLog::Offset nextOffset(
+				itNext == _queue.end() ? _queueLog->getEndOffset() : itNext->first
+			);
+			_queue.erase(_lastSentRange.first, itNext);
 
-				_lastSentRange = make_pair(_queue.end(), _queue.end());
-			}
-			transaction.run();
+			_lastSentRange = make_pair(_queue.end(), _queue.end());
+			_statistics.lastAckTime = microsec_clock::local_time();
+			_queueLog->acknowledge(nextOffset);
+		}
+
+
+
+		void InterSYNTHESESlave::recordSentBatch(
+			size_t itemsNumber,
+			size_t mergedItemsNumber,
+			size_t size
+		) const	{
+			recursive_mutex::scoped_lock lock(_queueMutex);
+			_statistics.lastSendTime = microsec_clock::local_time();
+			_statistics.lastSentItemsNumber = itemsNumber;
+			_statistics.lastMergedItemsNumber = mergedItemsNumber;
+			_statistics.lastSentSize = size;
+			_statistics.sentItemsNumber += itemsNumber;
+			_statistics.mergedItemsNumber += mergedItemsNumber;
+		}
+
+
+
+		InterSYNTHESESlave::ReplicationStatistics InterSYNTHESESlave::getReplicationStatistics() const
+		{
+			recursive_mutex::scoped_lock lock(_queueMutex);
+			return _statistics;
 		}
 }	}
 
@@ -31,6 +31,7 @@
 #include "StringField.hpp"
 
 #include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/shared_ptr.hpp>
 #include "boost/thread/recursive_mutex.hpp"
 
 namespace synthese
@@ -43,6 +44,7 @@ namespace synthese
 	namespace inter_synthese
 	{
 		class InterSYNTHESEQueue;
+		class InterSYNTHESEQueueLog;
 
 		FIELD_STRING(ServerAddress)
 		FIELD_STRING(ServerPort)
@@ -65,11 +67,25 @@ namespace synthese
 		///	@ingroup m19
 		/// @author Hugues Romain
 		/// @since 3.5.0
+		//////////////////////////////////////////////////////////////////////////
+		/// The updates waiting for the slave are persisted in its append-only
+		/// queue log (see InterSYNTHESEQueueLog) and kept in memory as queue items
+		/// identified by their offset in the log.
 		class InterSYNTHESESlave:
 			public Object<InterSYNTHESESlave, InterSYNTHESESlaveRecord>
 		{
 			static const std::string TAG_QUEUE_ITEM;
 			static const std::string TAG_QUEUE_SIZE;
+			static const std::string ATTR_OLDEST_ITEM_TIME;
+			static const std::string ATTR_LAG;
+			static const std::string ATTR_LAST_SEND_TIME;
+			static const std::string ATTR_LAST_ACK_TIME;
+			static const std::string ATTR_LAST_SENT_ITEMS_NUMBER;
+			static const std::string ATTR_LAST_MERGED_ITEMS_NUMBER;
+			static const std::string ATTR_LAST_SENT_SIZE;
+			static const std::string ATTR_SENT_ITEMS_NUMBER;
+			static const std::string ATTR_MERGED_ITEMS_NUMBER;
+			static const std::string ATTR_ACKNOWLEDGED_OFFSET;
 		public:
 		
 			/// Chosen registry class.
@@ -77,7 +93,7 @@ namespace synthese
 
 			typedef std::map<
 				util::RegistryKeyType,
-				InterSYNTHESEQueue*
+				boost::shared_ptr<InterSYNTHESEQueue>
 			> Queue;
 
 			typedef std::pair<
@@ -85,9 +101,27 @@ namespace synthese
 				Queue::iterator
 			> QueueRange;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Activity of the replication to the slave.
+			struct ReplicationStatistics
+			{
+				boost::posix_time::ptime lastSendTime;
+				boost::posix_time::ptime lastAckTime;
+				std::size_t lastSentItemsNumber;	//!< queue items of the last batch
+				std::size_t lastMergedItemsNumber;	//!< queue items of the last batch merged with an other one
+				std::size_t lastSentSize;	//!< size of the last batch in bytes
+				std::size_t sentItemsNumber;	//!< total since the server start
+				std::size_t mergedItemsNumber;	//!< total since the server start
+
+				ReplicationStatistics();
+			};
+
 		private:
 			mutable Queue _queue;
+			mutable boost::shared_ptr<InterSYNTHESEQueueLog> _queueLog;
+			mutable bool _queueLost;	//!< some updates of the slave are unknown : it must be fully updated
 			mutable QueueRange _lastSentRange;
+			mutable ReplicationStatistics _statistics;
 			mutable boost::recursive_mutex _queueMutex;
 			mutable boost::recursive_mutex _slaveChangeMutex;
 
@@ -96,6 +130,17 @@ namespace synthese
 			// our destructor
 			InterSYNTHESEConfig *_previousConfig;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Opens the queue log at the first use and loads the pending updates.
+			/// @pre the queue must be locked
+			void _openQueueLog() const;
+
+			void _appendToQueue(
+				const boost::posix_time::ptime& requestTime,
+				const std::string& interSYNTHESEType,
+				const std::string& parameter
+			) const;
+
 		public:
 			InterSYNTHESESlave(util::RegistryKeyType id = 0);
 			~InterSYNTHESESlave();
@@ -111,22 +156,20 @@ namespace synthese
 
 				boost::recursive_mutex& getQueueMutex() const { return _queueMutex; }
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Appends an update to the queue of the slave.
+				/// If a transaction is specified, the update is appended when the
+				/// transaction is committed.
 				void enqueue(
 					const std::string& interSYNTHESEType,
 					const std::string& parameter,
 					boost::optional<db::DBTransaction&> transaction,
 					bool force = false
 				) const;
-				void queue(
-					InterSYNTHESEQueue& obj
-				) const;
-				void removeFromQueue(
-					util::RegistryKeyType id
-				) const;
 
 				/// @pre The queue must be locked by the caller of the function until the returned
 				/// QueueRange is destroyed. Use getQueueMutex to lock the queue.
-				Queue& getQueue() const { return _queue; }
+				Queue& getQueue() const;
 
 				//////////////////////////////////////////////////////////////////////////
 				/// Adds parameters that are not intended to be saved (i.e. generated content).
@@ -141,12 +184,29 @@ namespace synthese
 				/// @pre The queue must be locked by the caller of the function until the returned
 				/// QueueRange is destroyed. Use getQueueMutex to lock the queue.
 				const QueueRange& getLastSentRange() const { return _lastSentRange; }
+
+				ReplicationStatistics getReplicationStatistics() const;
 			//@}
 
 			//! @name Modifiers
 			//@{
 				void setLastSentRange(const QueueRange& value) const { _lastSentRange = value; }
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Records the sending of a batch in the statistics.
+				/// @param itemsNumber number of queue items of the batch
+				/// @param mergedItemsNumber number of queue items merged with an other
+				/// one
+				/// @param size size of the batch in bytes
+				void recordSentBatch(
+					std::size_t itemsNumber,
+					std::size_t mergedItemsNumber,
+					std::size_t size
+				) const;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Removes the items of the last sent range, applied by the slave, from
+				/// the queue and records their acknowledgement in the queue log.
 				void clearLastSentRange() const;
 
 				virtual void link(util::Env& env, bool withAlgorithmOptimizations = false);
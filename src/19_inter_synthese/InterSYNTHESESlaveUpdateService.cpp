@@ -24,6 +24,7 @@
 
 #include "InterSYNTHESESlaveUpdateService.hpp"
 
+#include "Factory.h"
 #include "InterSYNTHESEQueue.hpp"
 #include "InterSYNTHESESlave.hpp"
 #include "InterSYNTHESESyncTypeFactory.hpp"
@@ -32,6 +33,10 @@
 #include "ServerConstants.h"
 #include "ServerModule.h"
 
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 
 using namespace boost;
@@ -53,11 +58,21 @@ namespace synthese
 		const string InterSYNTHESESlaveUpdateService::SYNCS_SEPARATOR = "\r\n";
 		const string InterSYNTHESESlaveUpdateService::NO_CONTENT_TO_SYNC = "no_content_to_sync!";
 		const string InterSYNTHESESlaveUpdateService::PARAMETER_SLAVE_ID = "slave_id";
+		const string InterSYNTHESESlaveUpdateService::PARAMETER_BATCH = "batch";
+		const string InterSYNTHESESlaveUpdateService::PARAMETER_ACK_RANGE_BEGIN = "ack_range_begin";
+		const string InterSYNTHESESlaveUpdateService::PARAMETER_ACK_RANGE_END = "ack_range_end";
+		const string InterSYNTHESESlaveUpdateService::BATCH_HEADER = "batch";
 		
 		bool InterSYNTHESESlaveUpdateService::bgUpdaterDone(false);
 		boost::mutex InterSYNTHESESlaveUpdateService::bgMutex;
 		boost::shared_ptr<InterSYNTHESESlave> InterSYNTHESESlaveUpdateService::bgNextSlave;
 
+
+
+		InterSYNTHESESlaveUpdateService::InterSYNTHESESlaveUpdateService():
+			_batch(false)
+		{}
+
 		ParametersMap InterSYNTHESESlaveUpdateService::_getParametersMap() const
 		{
 			ParametersMap map;
@@ -65,6 +80,15 @@ namespace synthese
 			{
 				map.insert(PARAMETER_SLAVE_ID, *_slaveId);
 			}
+			if(_batch)
+			{
+				map.insert(PARAMETER_BATCH, _batch);
+			}
+			if(_ackRangeBegin && _ackRangeEnd)
+			{
+				map.insert(PARAMETER_ACK_RANGE_BEGIN, *_ackRangeBegin);
+				map.insert(PARAMETER_ACK_RANGE_END, *_ackRangeEnd);
+			}
 			return map;
 		}
 
@@ -80,6 +104,11 @@ namespace synthese
 			{
 				throw RequestException("No such slave");
 			}
+
+			// Batch mode
+			_batch = map.getDefault<bool>(PARAMETER_BATCH, false);
+			_ackRangeBegin = map.getOptional<RegistryKeyType>(PARAMETER_ACK_RANGE_BEGIN);
+			_ackRangeEnd = map.getOptional<RegistryKeyType>(PARAMETER_ACK_RANGE_END);
 		}
 
 
@@ -102,6 +131,30 @@ namespace synthese
 				return ParametersMap();
 			}
 
+			// Acknowledgement of the previous batch, once applied by the slave.
+			// The offsets of the queue items are kept by the queue log : a batch sent
+			// before a restart of the master is acknowledged too if it begins at the
+			// first item of the queue.
+			if(_ackRangeBegin && _ackRangeEnd)
+			{
+				recursive_mutex::scoped_lock queueLock(_slave->getQueueMutex());
+				InterSYNTHESESlave::Queue& queue(_slave->getQueue());
+				InterSYNTHESESlave::QueueRange ackRange(
+					queue.find(*_ackRangeBegin),
+					queue.find(*_ackRangeEnd)
+				);
+				if(	ackRange.first != queue.end() &&
+					ackRange.second != queue.end() &&
+					ackRange.first->first <= ackRange.second->first &&
+					(	ackRange == _slave->getLastSentRange() ||
+						(	_slave->getLastSentRange().first == queue.end() &&
+							ackRange.first == queue.begin()
+				)	)	){
+					_slave->setLastSentRange(ackRange);
+					_slave->clearLastSentRange();
+				}
+			}
+
 			recursive_mutex::scoped_lock queueLock(_slave->getQueueMutex());
 			InterSYNTHESESlave::QueueRange range(_slave->getQueueRange());
 			if(range.first == _slave->getQueue().end())
@@ -109,8 +162,16 @@ namespace synthese
 				// Send to the slave that there is nothing to sync
 				stream << NO_CONTENT_TO_SYNC;
 			}
+			else if(_batch)
+			{
+				pair<size_t, size_t> mergedItemsAndSize(_writeBatch(stream, range));
+				size_t itemsNumber(std::distance(range.first, range.second) + 1);
+				_slave->recordSentBatch(itemsNumber, mergedItemsAndSize.first, mergedItemsAndSize.second);
+			}
 			else
 			{
+				size_t itemsNumber(0);
+				size_t size(0);
 				for(InterSYNTHESESlave::Queue::iterator it(range.first); it != _slave->getQueue().end(); ++it)
 				{
 					stream <<
@@ -120,6 +181,8 @@ namespace synthese
 						it->second->get<SyncContent>() <<
 						InterSYNTHESESlaveUpdateService::SYNCS_SEPARATOR;
 					;
+					++itemsNumber;
+					size += it->second->get<SyncContent>().size();
 
 					// Exit on last item
 					if(it == range.second)
@@ -127,6 +190,7 @@ namespace synthese
 						break;
 					}
 				}
+				_slave->recordSentBatch(itemsNumber, 0, size);
 			}
 			_slave->setLastSentRange(range);
 
@@ -140,6 +204,102 @@ namespace synthese
 		
 		
 		
+		pair<size_t, size_t> InterSYNTHESESlaveUpdateService::_writeBatch(
+			ostream& stream,
+			const InterSYNTHESESlave::QueueRange& range
+		) const	{
+
+			// Items to send with their content
+			typedef vector<pair<const InterSYNTHESEQueue*, const string*> > Items;
+			Items items;
+			size_t mergedItemsNumber(0);
+
+			// Rank in the items of the last replacement of each object since the last
+			// message which is not a replacement (such a message may modify the
+			// objects : it can not be crossed by a merge)
+			typedef map<pair<string, RegistryKeyType>, size_t> ReplacedObjects;
+			ReplacedObjects replacedObjects;
+
+			typedef map<string, boost::shared_ptr<InterSYNTHESESyncTypeFactory> > SyncTypes;
+			SyncTypes syncTypes;
+
+			for(InterSYNTHESESlave::Queue::const_iterator it(range.first); it != _slave->getQueue().end(); ++it)
+			{
+				const InterSYNTHESEQueue& item(*it->second);
+				const string& syncType(item.get<SyncType>());
+
+				// Object replaced by the item
+				boost::shared_ptr<InterSYNTHESESyncTypeFactory>& factory(syncTypes[syncType]);
+				if(	!factory.get() &&
+					Factory<InterSYNTHESESyncTypeFactory>::contains(syncType)
+				){
+					factory.reset(Factory<InterSYNTHESESyncTypeFactory>::create(syncType));
+				}
+				optional<RegistryKeyType> object;
+				if(factory.get())
+				{
+					object = factory->getReplacedObject(item.get<SyncContent>());
+				}
+
+				if(object)
+				{
+					ReplacedObjects::iterator itObject(
+						replacedObjects.find(make_pair(syncType, *object))
+					);
+					if(itObject != replacedObjects.end())
+					{
+						// Merge with the previous replacement
+						items[itObject->second].second = &item.get<SyncContent>();
+						++mergedItemsNumber;
+					}
+					else
+					{
+						replacedObjects.insert(make_pair(make_pair(syncType, *object), items.size()));
+						items.push_back(make_pair(&item, &item.get<SyncContent>()));
+					}
+				}
+				else
+				{
+					replacedObjects.clear();
+					items.push_back(make_pair(&item, &item.get<SyncContent>()));
+				}
+
+				// Exit on last item
+				if(it == range.second)
+				{
+					break;
+				}
+			}
+
+			// Header
+			stringstream header;
+			header <<
+				BATCH_HEADER << FIELDS_SEPARATOR <<
+				range.first->first << FIELDS_SEPARATOR <<
+				range.second->first << FIELDS_SEPARATOR <<
+				items.size() << SYNCS_SEPARATOR
+			;
+			stream << header.str();
+			size_t size(header.str().size());
+
+			// Items
+			BOOST_FOREACH(const Items::value_type& item, items)
+			{
+				stream <<
+					item.first->get<Key>() << FIELDS_SEPARATOR <<
+					item.first->get<SyncType>() << FIELDS_SEPARATOR <<
+					item.second->size() << FIELDS_SEPARATOR <<
+					*item.second <<
+					SYNCS_SEPARATOR
+				;
+				size += item.second->size();
+			}
+
+			return make_pair(mergedItemsNumber, size);
+		}
+
+
+
 		bool InterSYNTHESESlaveUpdateService::isAuthorized(
 			const Session* session
 		) const {
@@ -45,6 +45,16 @@ namespace synthese
 		///	@author Hugues Romain
 		///	@date 2012
 		/// @since 3.5.0
+		///
+		/// In batch mode (parameter batch=1), the content begins with a header
+		/// describing the sent range of the queue :
+		/// <pre>batch:range begin:range end:items number</pre>
+		/// and the successive replacements of an object are merged : the first
+		/// item receives the content of the last one (see
+		/// InterSYNTHESESyncTypeFactory::getReplacedObject). The slave
+		/// acknowledges the range in its next request, after it has applied it
+		/// (parameters ack_range_begin and ack_range_end) : an unacknowledged range
+		/// is sent again.
 		class InterSYNTHESESlaveUpdateService:
 			public util::FactorableTemplate<server::Function,InterSYNTHESESlaveUpdateService>
 		{
@@ -54,12 +64,19 @@ namespace synthese
 			static const std::string NO_CONTENT_TO_SYNC;
 			
 			static const std::string PARAMETER_SLAVE_ID;
+			static const std::string PARAMETER_BATCH;
+			static const std::string PARAMETER_ACK_RANGE_BEGIN;
+			static const std::string PARAMETER_ACK_RANGE_END;
+			static const std::string BATCH_HEADER;
 
 		protected:
 			//! \name Page parameters
 			//@{
 				boost::optional<util::RegistryKeyType> _slaveId;
 				boost::shared_ptr<InterSYNTHESESlave> _slave;
+				bool _batch;
+				boost::optional<util::RegistryKeyType> _ackRangeBegin;
+				boost::optional<util::RegistryKeyType> _ackRangeEnd;
 			//@}
 			
 			
@@ -91,10 +108,23 @@ namespace synthese
 			static boost::mutex bgMutex;
 			static boost::shared_ptr<InterSYNTHESESlave> bgNextSlave;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Writes a range of the queue in batch mode.
+			/// @pre the queue is locked and the range is not empty
+			/// @return the number of merged items and the size of the batch
+			std::pair<std::size_t, std::size_t> _writeBatch(
+				std::ostream& stream,
+				const InterSYNTHESESlave::QueueRange& range
+			) const;
+
 		public:
+			InterSYNTHESESlaveUpdateService();
+
 			//! @name Setters
 			//@{
 				void setSlaveId(util::RegistryKeyType value){ _slaveId = value; }
+				void setBatch(bool value){ _batch = value; }
+				void setAckRange(util::RegistryKeyType begin, util::RegistryKeyType end){ _ackRangeBegin = begin; _ackRangeEnd = end; }
 			//@}
 
 
@@ -29,5 +29,13 @@ namespace synthese
 		InterSYNTHESESyncTypeFactory::InterSYNTHESESyncTypeFactory():
 			util::FactoryBase<InterSYNTHESESyncTypeFactory>()
 		{}
+
+
+
+		boost::optional<util::RegistryKeyType> InterSYNTHESESyncTypeFactory::getReplacedObject(
+			const std::string& parameter
+		) const	{
+			return boost::optional<util::RegistryKeyType>();
+		}
 }	}
 
@@ -24,8 +24,11 @@
 #define SYNTHESE_inter_synthese_InterSYNTHESESyncTypeFactory_hpp__
 
 #include "FactoryBase.h"
+#include "UtilTypes.h"
 
+#include <string>
 #include <vector>
+#include <boost/optional.hpp>
 
 namespace synthese
 {
@@ -67,6 +70,17 @@ namespace synthese
 				const std::string& messagePerimeter
 			) const = 0;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Object entirely replaced by a message.
+			/// The successive replacements of the same object can be merged in a
+			/// batch : only the last content is sent.
+			/// @param parameter the message
+			/// @return the key of the replaced object, nothing if the message can
+			/// not be merged (default implementation)
+			virtual boost::optional<util::RegistryKeyType> getReplacedObject(
+				const std::string& parameter
+			) const;
+
 			typedef std::vector<const InterSYNTHESEConfigItem*> SortedItems;
 			typedef std::vector<const InterSYNTHESEConfigItem*> RandomItems;
 			virtual SortedItems sort(const RandomItems& randItems) const = 0;
@@ -24,7 +24,9 @@
 
 #include "CalendarLink.hpp"
 
+#include <algorithm>
 #include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
 using namespace std;
@@ -35,6 +37,13 @@ namespace synthese
 {
 	namespace calendar
 	{
+		const size_t Calendar::BitSets::WORD_BITS(64);
+		boost::mutex Calendar::DatesPool::_mutex;
+		Calendar::DatesPool::Entries Calendar::DatesPool::_entries;
+		size_t Calendar::DatesPool::_sweepSize(1024);
+
+
+
 		Calendar::Calendar(
 			util::RegistryKeyType id
 		):
@@ -48,9 +57,7 @@ namespace synthese
 			const date& lastDate,
 			date_duration step
 		):	Registrable(0),
-			_markedDates(firstDate, lastDate, step),
-			_firstActiveDate(firstDate)
-			// last active date cannot be constructed at this time
+			_markedDates(firstDate, lastDate, step)
 		{
 		}
 
@@ -60,9 +67,10 @@ namespace synthese
 			const Calendar& other
 		):	Registrable(0),
 			_markedDates(other._markedDates),
+			_datesToForce(other._datesToForce),
+			_datesToBypass(other._datesToBypass),
 			_calendarLinks(other._calendarLinks),
-			_firstActiveDate(other._firstActiveDate),
-			_lastActiveDate(other._lastActiveDate)
+			_datesCache(boost::atomic_load(&other._datesCache))
 		{}
 
 
@@ -75,23 +83,78 @@ namespace synthese
 		}
 
 
-		
+
+		long Calendar::BitSets::_WordRank( const boost::gregorian::date& d )
+		{
+			return long(d.day_number() / WORD_BITS);
+		}
+
+
+
+		size_t Calendar::BitSets::_BitRank( const boost::gregorian::date& d )
+		{
+			return d.day_number() % WORD_BITS;
+		}
+
+
+
+		date Calendar::BitSets::_Date( long wordRank, size_t bitRank )
+		{
+			return date(gregorian_calendar::from_day_number(wordRank * WORD_BITS + bitRank));
+		}
+
+
+
+		void Calendar::BitSets::_extend( long firstWord, long lastWord )
+		{
+			if(_words.empty())
+			{
+				_firstWord = firstWord;
+				_words.assign(lastWord - firstWord + 1, Word(0));
+				return;
+			}
+			if(firstWord < _firstWord)
+			{
+				_words.insert(_words.begin(), _firstWord - firstWord, Word(0));
+				_firstWord = firstWord;
+			}
+			if(lastWord >= _firstWord + long(_words.size()))
+			{
+				_words.resize(lastWord - _firstWord + 1, Word(0));
+			}
+		}
+
+
+
+		void Calendar::BitSets::_trim()
+		{
+			while(!_words.empty() && !_words.back())
+			{
+				_words.pop_back();
+			}
+			size_t emptyWords(0);
+			while(emptyWords < _words.size() && !_words[emptyWords])
+			{
+				++emptyWords;
+			}
+			_words.erase(_words.begin(), _words.begin() + emptyWords);
+			_firstWord = _words.empty() ? 0 : _firstWord + long(emptyWords);
+		}
+
+
+
 		boost::gregorian::date Calendar::BitSets::getFirstActiveDate() const
 		{
-			if(_value.empty())
+			if(_words.empty())
 			{
 				return gregorian::date();
 			}
-			else
-			{
-				_BitSets::const_iterator it(_value.begin());
 
-				for(size_t p(0); p != 366; ++p)
+			for(size_t p(0); p != WORD_BITS; ++p)
+			{
+				if((_words.front() >> p) & 1)
 				{
-					if(it->second.test(p))
-					{
-						return date(it->first, Jan, 1) + days(long(p));
-					}
+					return _Date(_firstWord, p);
 				}
 			}
 
@@ -102,32 +165,23 @@ namespace synthese
 
 		date Calendar::getFirstActiveDate(
 		) const {
-			if(!_firstActiveDate)
-			{
-				recursive_mutex::scoped_lock lock(_mutex);
-				_firstActiveDate = _getDatesCache().getFirstActiveDate();
-			}
-			return *_firstActiveDate;
+			return _getDatesCache()->getFirstActiveDate();
 		}
 
 
 
 		boost::gregorian::date Calendar::BitSets::getLastActiveDate() const
 		{
-			if(_value.empty())
+			if(_words.empty())
 			{
 				return gregorian::date();
 			}
-			else
-			{
-				_BitSets::const_reverse_iterator it(_value.rbegin());
 
-				for(size_t p(366); p != 0; --p)
+			for(size_t p(WORD_BITS); p != 0; --p)
+			{
+				if((_words.back() >> (p-1)) & 1)
 				{
-					if(it->second.test(p-1))
-					{
-						return date(it->first, Jan, 1) + days(long(p-1));
-					}
+					return _Date(_firstWord + long(_words.size()) - 1, p-1);
 				}
 			}
 
@@ -139,27 +193,21 @@ namespace synthese
 
 		date Calendar::getLastActiveDate(
 		) const {
-			if(!_lastActiveDate)
-			{
-				_lastActiveDate = _getDatesCache().getLastActiveDate();
-			}
-			return *_lastActiveDate;
+			return _getDatesCache()->getLastActiveDate();
 		}
 
 
 
-		
 		Calendar::DatesVector Calendar::BitSets::getActiveDates() const
 		{
 			DatesVector result;
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
+			for(size_t w(0); w != _words.size(); ++w)
 			{
-				date d(it.first, Jan, 1);
-				for(size_t p(0); p != (gregorian_calendar::is_leap_year(it.first) ? 366 : 365); ++p)
+				for(size_t p(0); p != WORD_BITS; ++p)
 				{
-					if(it.second.test(p))
+					if((_words[w] >> p) & 1)
 					{
-						result.push_back(d + date_duration(long(p)));
+						result.push_back(_Date(_firstWord + long(w), p));
 					}
 				}
 			}
@@ -170,39 +218,37 @@ namespace synthese
 
 		Calendar::DatesVector Calendar::getActiveDates(
 		) const {
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache().getActiveDates();
+			return _getDatesCache()->getActiveDates();
 		}
 
 
-		
+
 		bool Calendar::BitSets::isActive( const boost::gregorian::date& d ) const
 		{
-			_BitSets::const_iterator it(_value.find(d.year()));
-			if(it == _value.end()) return false;
-			return it->second.test(_BitPos(d));
+			if(d.is_special())
+			{
+				return false;
+			}
+			long rank(_WordRank(d) - _firstWord);
+			if(rank < 0 || rank >= long(_words.size()))
+			{
+				return false;
+			}
+			return (_words[rank] >> _BitRank(d)) & 1;
 		}
 
 
 		bool Calendar::isActive(const date& d) const
 		{
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache().isActive(d);
+			return _getDatesCache()->isActive(d);
 		}
 
 
 
 		void Calendar::BitSets::setActive( const boost::gregorian::date& d )
 		{
-			_BitSets::iterator it(_value.find(d.year()));
-			if(it == _value.end())
-			{
-				it = _value.insert(
-					make_pair(d.year(), _BitSets::mapped_type())
-				).first;
-			}
-
-			it->second.set(_BitPos(d));
+			_extend(_WordRank(d), _WordRank(d));
+			_words[_WordRank(d) - _firstWord] |= (Word(1) << _BitRank(d));
 		}
 
 
@@ -213,7 +259,7 @@ namespace synthese
 
 			recursive_mutex::scoped_lock lock(_mutex);
 			_markedDates.setActive(d);
-		
+
 			_resetDatesCache();
 		}
 
@@ -233,17 +279,17 @@ namespace synthese
 
 		void Calendar::BitSets::setInactive( const boost::gregorian::date& d )
 		{
-			_BitSets::iterator it(_value.find(d.year()));
-			if(it == _value.end())
+			long rank(_WordRank(d) - _firstWord);
+			if(rank < 0 || rank >= long(_words.size()))
 			{
 				return;
 			}
 
-			it->second.set(_BitPos(d), false);
+			_words[rank] &= ~(Word(1) << _BitRank(d));
 
-			if(!it->second.any())
+			if(!_words[rank])
 			{
-				_value.erase(it);
+				_trim();
 			}
 		}
 
@@ -263,22 +309,25 @@ namespace synthese
 
 		Calendar::BitSets& Calendar::BitSets::operator&=( const BitSets& op )
 		{
-			_BitSets markedDates;
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
+			long firstWord(max(_firstWord, op._firstWord));
+			long lastWord(min(
+				_firstWord + long(_words.size()),
+				op._firstWord + long(op._words.size())
+			) - 1);
+			if(_words.empty() || op._words.empty() || firstWord > lastWord)
 			{
-				_BitSets::const_iterator it2(op._value.find(it.first));
-				if(it2 == op._value.end())
-				{
-					continue;
-				}
+				clear();
+				return *this;
+			}
 
-				_BitSets::mapped_type mask(it.second & it2->second);
-				if(!mask.none())
-				{
-					markedDates[it.first] = mask;
-				}
+			Words markedDates(lastWord - firstWord + 1);
+			for(long w(firstWord); w <= lastWord; ++w)
+			{
+				markedDates[w - firstWord] = _words[w - _firstWord] & op._words[w - op._firstWord];
 			}
-			_value = markedDates;
+			_words.swap(markedDates);
+			_firstWord = firstWord;
+			_trim();
 
 			return *this;
 		}
@@ -287,9 +336,10 @@ namespace synthese
 
 		Calendar& Calendar::operator&= (const Calendar& op)
 		{
+			boost::shared_ptr<const BitSets> opDates(op._getDatesCache());
 			recursive_mutex::scoped_lock lock(_mutex);
 
-			_markedDates &= op._getDatesCache();
+			_markedDates &= *opDates;
 
 			_resetDatesCache();
 			return *this;
@@ -300,9 +350,10 @@ namespace synthese
 		Calendar& Calendar::operator|=(
 			const Calendar& op
 		){
+			boost::shared_ptr<const BitSets> opDates(op._getDatesCache());
 			recursive_mutex::scoped_lock lock(_mutex);
 
-			_markedDates.operator |=(op._getDatesCache());
+			_markedDates.operator |=(*opDates);
 
 			_resetDatesCache();
 			return *this;
@@ -329,15 +380,19 @@ namespace synthese
 
 
 
-		
 		bool Calendar::BitSets::hasAtLeastOneCommonDateWith( const BitSets& op ) const
 		{
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
+			long firstWord(max(_firstWord, op._firstWord));
+			long lastWord(min(
+				_firstWord + long(_words.size()),
+				op._firstWord + long(op._words.size())
+			) - 1);
+			for(long w(firstWord); w <= lastWord; ++w)
 			{
-				_BitSets::const_iterator it2(op._value.find(it.first));
-				if(it2 == op._value.end()) continue;
-
-				if((it.second & it2->second).any()) return true;
+				if(_words[w - _firstWord] & op._words[w - op._firstWord])
+				{
+					return true;
+				}
 			}
 			return false;
 		}
@@ -345,44 +400,40 @@ namespace synthese
 
 		bool Calendar::hasAtLeastOneCommonDateWith( const Calendar& op ) const
 		{
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache().hasAtLeastOneCommonDateWith(op._getDatesCache());
+			return _getDatesCache()->hasAtLeastOneCommonDateWith(*op._getDatesCache());
 		}
 
 
 
 		bool Calendar::operator==( const Calendar& op ) const
 		{
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache() == op._getDatesCache();
+			boost::shared_ptr<const BitSets> dates(_getDatesCache());
+			boost::shared_ptr<const BitSets> opDates(op._getDatesCache());
+
+			// Interned dates are equal if and only if they are the same object
+			return dates == opDates || *dates == *opDates;
 		}
 
-	
+
 
 
 		Calendar::BitSets& Calendar::BitSets::operator-=( const BitSets& op )
 		{
-			set<_BitSets::key_type> toBeRemoved;
-
-			_BitSets markedDates;
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
+			long firstWord(max(_firstWord, op._firstWord));
+			long lastWord(min(
+				_firstWord + long(_words.size()),
+				op._firstWord + long(op._words.size())
+			) - 1);
+			if(_words.empty() || op._words.empty() || firstWord > lastWord)
 			{
-				_BitSets::const_iterator it2(op._value.find(it.first));
-				if(it2 == op._value.end())
-				{
-					markedDates[it.first] = it.second;
-					continue;
-				}
+				return *this;
+			}
 
-				_BitSets::mapped_type opMask(it2->second);
-				opMask.flip();
-				opMask = opMask & it.second;
-				if(!opMask.none())
-				{
-					markedDates[it.first] = opMask;
-				}
+			for(long w(firstWord); w <= lastWord; ++w)
+			{
+				_words[w - _firstWord] &= ~op._words[w - op._firstWord];
 			}
-			_value= markedDates;
+			_trim();
 
 			return *this;
 		}
@@ -391,9 +442,10 @@ namespace synthese
 
 		Calendar& Calendar::operator-=( const Calendar& op )
 		{
+			boost::shared_ptr<const BitSets> opDates(op._getDatesCache());
 			recursive_mutex::scoped_lock lock(_mutex);
 
-			_markedDates -= op._getDatesCache();
+			_markedDates -= *opDates;
 			_resetDatesCache();
 
 			return *this;
@@ -401,40 +453,32 @@ namespace synthese
 
 
 
-		size_t Calendar::BitSets::_BitPos( const boost::gregorian::date& d )
-		{
-			return d.day_of_year() - 1;
-		}
-
-
-
 		//////////////////////////////////////////////////////////////////////////
 		/// Tests if the calendar has no activated date.
 		/// @return true if the calendar has no activated date.
 		bool Calendar::BitSets::empty() const
 		{
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
-			{
-				if(!it.second.none()) return false;
-			}
-			return true;
+			// The bitmap is trimmed : a non empty bitmap contains at least one date
+			return _words.empty();
 		}
 
 
-		
+
 		bool Calendar::empty() const
 		{
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache().empty();
+			return _getDatesCache()->empty();
 		}
 
 
 		size_t Calendar::BitSets::size() const
 		{
 			size_t result(0);
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
+			BOOST_FOREACH(Word word, _words)
 			{
-				result += it.second.count();
+				for(; word; word &= word - 1)
+				{
+					++result;
+				}
 			}
 			return result;
 		}
@@ -443,32 +487,44 @@ namespace synthese
 
 		size_t Calendar::size() const
 		{
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache().size();
+			return _getDatesCache()->size();
+		}
+
+
+
+		size_t Calendar::BitSets::hash() const
+		{
+			size_t result(0);
+			boost::hash_combine(result, _firstWord);
+			BOOST_FOREACH(Word word, _words)
+			{
+				boost::hash_combine(result, word);
+			}
+			return result;
 		}
 
 
 
 		bool Calendar::operator!=( const Calendar& op ) const
 		{
-			recursive_mutex::scoped_lock lock(_mutex);
-			return _getDatesCache() != op._getDatesCache();
+			return !(*this == op);
 		}
 
 
 
-		
 		void Calendar::BitSets::copyDates( const BitSets& calendar )
 		{
-			_value = calendar._value;
+			_firstWord = calendar._firstWord;
+			_words = calendar._words;
 		}
 
 
 
 		void Calendar::copyDates( const Calendar& op )
 		{
+			boost::shared_ptr<const BitSets> opDates(op._getDatesCache());
 			recursive_mutex::scoped_lock lock(_mutex);
-			_markedDates = op._getDatesCache();
+			_markedDates = *opDates;
 			_resetDatesCache();
 		}
 
@@ -476,10 +532,17 @@ namespace synthese
 
 		void Calendar::BitSets::serialize( std::ostream& stream ) const
 		{
-			BOOST_FOREACH(const _BitSets::value_type& yearDates, _value)
+			DatesVector dates(getActiveDates());
+			for(DatesVector::const_iterator it(dates.begin()); it != dates.end(); )
 			{
-				stream << yearDates.first;
-				stream << yearDates.second;
+				greg_year year(it->year());
+				bitset<366> yearDates;
+				for(; it != dates.end() && it->year() == year; ++it)
+				{
+					yearDates.set(it->day_of_year() - 1);
+				}
+				stream << year;
+				stream << yearDates;
 			}
 		}
 
@@ -493,10 +556,9 @@ namespace synthese
 
 
 
-		
 		void Calendar::BitSets::setFromSerializedString( const std::string& value )
 		{
-			_value.clear();
+			clear();
 			for(size_t p(0); p+369<value.size(); p += 370)
 			{
 				bitset<366> bits(value.substr(p+4, 366));
@@ -504,11 +566,18 @@ namespace synthese
 				{
 					continue;
 				}
-				_value.insert(
-					make_pair(
-						greg_year(lexical_cast<unsigned short>(value.substr(p, 4))),
-						bits
-				)	);
+				date firstDate(
+					greg_year(lexical_cast<unsigned short>(value.substr(p, 4))),
+					Jan,
+					1
+				);
+				for(size_t d(0); d != (gregorian_calendar::is_leap_year(firstDate.year()) ? 366 : 365); ++d)
+				{
+					if(bits.test(d))
+					{
+						setActive(firstDate + days(long(d)));
+					}
+				}
 			}
 		}
 
@@ -525,9 +594,25 @@ namespace synthese
 
 		Calendar::BitSets& Calendar::BitSets::operator<<=( size_t i )
 		{
-			BOOST_FOREACH(_BitSets::value_type& yearDates, _value)
+			if(_words.empty())
 			{
-				yearDates.second <<= i;
+				return *this;
+			}
+
+			// Shift of whole words
+			_firstWord += long(i / WORD_BITS);
+
+			// Shift of the remaining bits, with carry to the next word
+			size_t bits(i % WORD_BITS);
+			if(bits)
+			{
+				_words.push_back(Word(0));
+				for(size_t w(_words.size() - 1); w != 0; --w)
+				{
+					_words[w] = (_words[w] << bits) | (_words[w-1] >> (WORD_BITS - bits));
+				}
+				_words.front() <<= bits;
+				_trim();
 			}
 			return *this;
 		}
@@ -556,10 +641,8 @@ namespace synthese
 			_datesToBypass = rhs._datesToBypass;
 			_calendarLinks = rhs._calendarLinks;
 
-			// Cache copy
-			_firstActiveDate = rhs._firstActiveDate;
-			_lastActiveDate = rhs._lastActiveDate;
-			_datesCache = rhs._datesCache;
+			// Cache copy (the bitmap is immutable : it can be shared)
+			boost::atomic_store(&_datesCache, boost::atomic_load(&rhs._datesCache));
 
 			return *this;
 		}
@@ -614,46 +697,60 @@ namespace synthese
 
 		void Calendar::_resetDatesCache() const
 		{
-			_firstActiveDate.reset();
-			_lastActiveDate.reset();
-			_datesCache.reset();
+			// The readers which already got the previous bitmap keep it alive
+			boost::atomic_store(&_datesCache, boost::shared_ptr<const BitSets>());
 		}
 
 
 
-		const Calendar::BitSets& Calendar::_getDatesCache() const
+		boost::shared_ptr<const Calendar::BitSets> Calendar::_getDatesCache() const
 		{
+			// Lock free access if the cache is already computed
+			boost::shared_ptr<const BitSets> result(boost::atomic_load(&_datesCache));
+			if(result)
+			{
+				return result;
+			}
+
 			recursive_mutex::scoped_lock lock(_mutex);
-			if(!_datesCache)
+			if(_datesCache)
+			{
+				return _datesCache;
+			}
+
+			BitSets cache;
+			if(_calendarLinks.empty())
+			{
+				cache = _markedDates;
+			}
+			else
 			{
-				if(_calendarLinks.empty())
+				BOOST_FOREACH(const CalendarLinks::value_type& link, _calendarLinks)
 				{
-					_datesCache = _markedDates;
+					link->addDatesToBitSets(cache);
 				}
-				else
-				{
-					BitSets cache;
-					BOOST_FOREACH(const CalendarLinks::value_type& link, _calendarLinks)
-					{
-						link->addDatesToBitSets(cache);
-					}
-
-					// Dates to force
-					BOOST_FOREACH(const DatesSet::value_type& d, _datesToForce)
-					{
-						cache.setActive(d);
-					}
 
-					// Dates to bypass
-					BOOST_FOREACH(const DatesSet::value_type& d, _datesToBypass)
-					{
-						cache.setInactive(d);
-					}
+				// Dates to force
+				BOOST_FOREACH(const DatesSet::value_type& d, _datesToForce)
+				{
+					cache.setActive(d);
+				}
 
-					_datesCache = cache;
+				// Dates to bypass
+				BOOST_FOREACH(const DatesSet::value_type& d, _datesToBypass)
+				{
+					cache.setInactive(d);
 				}
 			}
-			return *_datesCache;
+
+			// Only the dates of the registered calendars are interned : the
+			// temporary calendars would fill the pool with short lived entries
+			result = getKey() ?
+				DatesPool::Get(cache) :
+				boost::shared_ptr<const BitSets>(new BitSets(cache))
+			;
+			boost::atomic_store(&_datesCache, result);
+			return result;
 		}
 
 
@@ -687,30 +784,15 @@ namespace synthese
 
 		Calendar::BitSets& Calendar::BitSets::operator|=( const Calendar::BitSets& op )
 		{
-			set<greg_year> years;
-			BOOST_FOREACH(const _BitSets::value_type& it, _value)
-			{
-				years.insert(it.first);
-			}
-			BOOST_FOREACH(const _BitSets::value_type& it, op._value)
+			if(op._words.empty())
 			{
-				years.insert(it.first);
+				return *this;
 			}
-			BOOST_FOREACH(greg_year y, years)
+
+			_extend(op._firstWord, op._firstWord + long(op._words.size()) - 1);
+			for(size_t w(0); w != op._words.size(); ++w)
 			{
-				_BitSets::const_iterator it1(_value.find(y));
-				_BitSets::const_iterator it2(op._value.find(y));
-				if(it1 == _value.end())
-				{
-					_value[y] = it2->second;
-				}
-				else
-				{
-					if(it2 != op._value.end())
-					{
-						_value[y] = it1->second | it2->second;
-					}
-				}
+				_words[op._firstWord - _firstWord + w] |= op._words[w];
 			}
 			return *this;
 		}
@@ -721,80 +803,55 @@ namespace synthese
 			const boost::gregorian::date& firstDate,
 			const boost::gregorian::date& lastDate,
 			boost::gregorian::date_duration step /*= boost::gregorian::days(1) */
-		){
+		):	_firstWord(0)
+		{
 			// Check pre-conditions in debug mode
 			assert(!firstDate.is_not_a_date());
 			assert(!lastDate.is_not_a_date());
 			assert(firstDate <= lastDate);
 			assert(step.days() > 0);
 
+			_extend(_WordRank(firstDate), _WordRank(lastDate));
+
 			// Optimized version for all days of the range calendars
 			if(step.days() == 1)
 			{
-				// Loop on years
-				for(unsigned short y(firstDate.year()); y<=(lastDate.year()); ++y)
-				{
-					// Loop on days
-					_BitSets::mapped_type bits;
-					for(size_t i(y == firstDate.year() ? _BitPos(firstDate) : 0);
-						i <= (y == lastDate.year() ? _BitPos(lastDate) : (gregorian_calendar::is_leap_year(y) ? 365 : 364));
-						++i
-					){
-						bits.set(i);
-					}
-
-					// Storage
-					_BitSets::iterator it(
-						_value.insert(
-							make_pair(y, bits)
-						).first
-					);
-				}
+				fill(_words.begin(), _words.end(), ~Word(0));
+				_words.front() &= (~Word(0) << _BitRank(firstDate));
+				_words.back() &= (~Word(0) >> (WORD_BITS - 1 - _BitRank(lastDate)));
 			}
 			else
 			{
-				// Locales
-				_BitSets::iterator it(_value.end());
-				greg_year y(firstDate.year());
-				date d;
-
 				// Loop on days
-				for(d = firstDate;
+				for(date d(firstDate);
 					d <= lastDate;
 					d += step
 				){
-					// Allocate the bitset if necessary
-					if(it == _value.end() || d.year() != y)
-					{
-						it = _value.insert(
-							make_pair(d.year(), _BitSets::mapped_type())
-						).first;
-						y = d.year();
-					}
-
-					// Sets the date
-					it->second.set(_BitPos(d));
+					_words[_WordRank(d) - _firstWord] |= (Word(1) << _BitRank(d));
 				}
+				_trim();
 			}
 		}
 
 
 
-		Calendar::BitSets::BitSets()
+		Calendar::BitSets::BitSets():
+			_firstWord(0)
 		{
 
 		}
 
 		void Calendar::BitSets::clear()
 		{
-			_value.clear();
+			_firstWord = 0;
+			_words.clear();
 		}
 
 
 
 		bool Calendar::BitSets::operator==( const BitSets& op ) const
 		{
-			return _value == op._value;
+			return _firstWord == op._firstWord && _words == op._words;
 		}
 
 
@@ -802,6 +859,55 @@ namespace synthese
 
 		bool Calendar::BitSets::operator!=( const BitSets& op ) const
 		{
-			return _value != op._value;
+			return !(*this == op);
+		}
+
+
+
+		boost::shared_ptr<const Calendar::BitSets> Calendar::DatesPool::Get(
+			const BitSets& value
+		){
+			size_t hash(value.hash());
+
+			boost::mutex::scoped_lock lock(_mutex);
+
+			// Search of an existing bitmap
+			pair<Entries::iterator, Entries::iterator> range(_entries.equal_range(hash));
+			for(Entries::iterator it(range.first); it != range.second; )
+			{
+				boost::shared_ptr<const BitSets> entry(it->second.lock());
+				if(!entry)
+				{
+					_entries.erase(it++);
+					continue;
+				}
+				if(*entry == value)
+				{
+					return entry;
+				}
+				++it;
+			}
+
+			// Removal of the expired entries when the pool has grown enough
+			if(_entries.size() >= _sweepSize)
+			{
+				for(Entries::iterator it(_entries.begin()); it != _entries.end(); )
+				{
+					if(it->second.expired())
+					{
+						_entries.erase(it++);
+					}
+					else
+					{
+						++it;
+					}
+				}
+				_sweepSize = max(size_t(1024), 2 * _entries.size());
+			}
+
+			// Creation of the bitmap
+			boost::shared_ptr<const BitSets> result(new BitSets(value));
+			_entries.insert(make_pair(hash, boost::weak_ptr<const BitSets>(result)));
+			return result;
 		}
 }	}
@@ -31,8 +31,12 @@
 #include <bitset>
 #include <map>
 #include <vector>
+#include <boost/cstdint.hpp>
 #include <boost/optional/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <set>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 
 namespace synthese
@@ -45,12 +49,14 @@ namespace synthese
 			@ingroup m31
 
 			The Calendar class implements the service calendar, holding a
-			bitset representing year days. Each year day can be activated or not.
+			bitmap representing days. Each day can be activated or not.
 
-			The active dates of the calendar are marked as activated bits on a bitset per year.
-			Each year containing at least one activated date has a full bitset.
-			In a year bitset, a date is represented by the bit at the rank corresponding to its day number in the year.
-			Example : 2008-02-03 => bit 34 of the 2008 bitset.
+			The active dates of the calendar are marked as activated bits on a
+			contiguous bitmap covering the period between the first and the last
+			active dates.
+
+			The dates of the registered calendars (non zero key) are interned in a
+			pool : the calendars having the same dates share the same bitmap.
 		*/
 		class Calendar:
 			public virtual util::Registrable
@@ -61,18 +67,30 @@ namespace synthese
 			typedef std::set<CalendarLink*> CalendarLinks;
 
 		private:
+			//////////////////////////////////////////////////////////////////////////
+			/// Contiguous bitmap of dates.
+			/// A date is represented by the bit of rank day_number % 64 in the word
+			/// of rank day_number / 64 : the words of two bitmaps are always
+			/// aligned, so the set operations are done word per word.
+			/// The bitmap covers the words between the first and the last active
+			/// dates only (the first and the last words are never empty).
 			class BitSets
 			{
 			public:
-				typedef std::map<
-					boost::gregorian::greg_year,
-					std::bitset<366>
-				> _BitSets;
+				typedef boost::uint64_t Word;
+				typedef std::vector<Word> Words;
+				static const std::size_t WORD_BITS;
 
 			private:
-				_BitSets _value;
+				long _firstWord;	//!< rank of the first word of the bitmap
+				Words _words;
+
+				static long _WordRank(const boost::gregorian::date& d);
+				static std::size_t _BitRank(const boost::gregorian::date& d);
+				static boost::gregorian::date _Date(long wordRank, std::size_t bitRank);
 
-				static size_t _BitPos(const boost::gregorian::date& d);
+				void _extend(long firstWord, long lastWord);
+				void _trim();
 
 			public:
 
@@ -87,7 +105,6 @@ namespace synthese
 				bool operator==(const BitSets& op) const;
 				bool operator!=(const BitSets& op) const;
 				BitSets& operator-= (const BitSets& op);
-				const _BitSets getValue() const { return _value; }
 				boost::gregorian::date getFirstActiveDate() const;
 				boost::gregorian::date getLastActiveDate() const;
 				bool empty() const;
@@ -100,12 +117,31 @@ namespace synthese
 				void clear();
 				bool hasAtLeastOneCommonDateWith(const BitSets& op) const;
 				size_t size() const;
+				std::size_t hash() const;
 				void copyDates(const BitSets& calendar);
 				void serialize(std::ostream& stream) const;
 				void setFromSerializedString(const std::string& value);
 				BitSets& operator<<= (std::size_t i);
 			};
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Pool of the dates of the registered calendars.
+			/// The calendars having the same dates share the same immutable bitmap.
+			/// The pool does not own the bitmaps : an entry expires when the last
+			/// calendar using it is modified or deleted.
+			class DatesPool
+			{
+			private:
+				typedef std::multimap<std::size_t, boost::weak_ptr<const BitSets> > Entries;
+
+				static boost::mutex _mutex;
+				static Entries _entries;
+				static std::size_t _sweepSize;
+
+			public:
+				static boost::shared_ptr<const BitSets> Get(const BitSets& value);
+			};
+
 			/// @name Base data
 			//@{
 				BitSets _markedDates;
@@ -113,15 +149,20 @@ namespace synthese
 				DatesSet _datesToBypass;
 				CalendarLinks _calendarLinks;
 			//@}
-		
-			mutable boost::recursive_mutex _mutex;
-			mutable boost::optional<boost::gregorian::date> _firstActiveDate;
-			mutable boost::optional<boost::gregorian::date> _lastActiveDate;
-			mutable boost::optional<BitSets> _datesCache; ///< Dates coming from the links or the marked dates
-		
+
+			mutable boost::recursive_mutex _mutex;	//!< protects the base data and the computation of the dates cache
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Dates coming from the links or the marked dates.
+			/// The bitmap is immutable : it is replaced (never modified) when the
+			/// calendar changes, and it is always read and written by the atomic
+			/// access functions of shared_ptr, so the date tests do not need to
+			/// lock the calendar.
+			mutable boost::shared_ptr<const BitSets> _datesCache;
+
 			void _resetDatesCache() const;
 
-			const BitSets& _getDatesCache() const;
+			boost::shared_ptr<const BitSets> _getDatesCache() const;
 
 
 		public:
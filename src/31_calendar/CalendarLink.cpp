@@ -87,16 +87,16 @@ namespace synthese
 				Calendar result(_calendarTemplate->getResult(mask));
 				if(_calendarTemplate2)
 				{
-					bitsets |= _calendarTemplate2->getResult(result)._getDatesCache();
+					bitsets |= *_calendarTemplate2->getResult(result)._getDatesCache();
 				}
 				else
 				{
-					bitsets |= result._getDatesCache();
+					bitsets |= *result._getDatesCache();
 				}
 			}
 			else
 			{
-				bitsets |= _calendarTemplate2->getResult(mask)._getDatesCache();
+				bitsets |= *_calendarTemplate2->getResult(mask)._getDatesCache();
 			}
 		}
 
@@ -271,5 +271,13 @@ namespace synthese
 			}
 			return r;
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> CalendarTemplateTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			return result;
+		}
 	}
 }
@@ -90,6 +90,12 @@ namespace synthese
 				boost::optional<CalendarTemplatesList::value_type::first_type> idToAvoid = boost::optional<CalendarTemplatesList::value_type::first_type>(),
 				boost::optional<util::RegistryKeyType> parentId = boost::optional<util::RegistryKeyType>()
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The calendar templates depend on the base tables only.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
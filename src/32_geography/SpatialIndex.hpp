@@ -0,0 +1,371 @@
+/** SpatialIndex class header.
+	@file SpatialIndex.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_geography_SpatialIndex_hpp__
+#define SYNTHESE_geography_SpatialIndex_hpp__
+
+#include "Env.h"
+#include "Registry.h"
+#include "UtilTypes.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Point.h>
+#include <geos/index/quadtree/Quadtree.h>
+
+namespace synthese
+{
+	namespace geography
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// In memory spatial index of the objects of a class of the official
+		/// environment.
+		///	@ingroup m32
+		//////////////////////////////////////////////////////////////////////////
+		/// The objects are registered by the load of their table (Update) and
+		/// unregistered by its unlink (Remove), in the instance coordinates
+		/// system. The queries return the objects of the official environment
+		/// ordered by key, as an iteration on the registry would do.
+		/// @warning only the objects of the official environment must be
+		/// registered
+		template<class T>
+		class SpatialIndex
+		{
+		public:
+			typedef std::vector<boost::shared_ptr<T> > Objects;
+
+		private:
+			struct Item
+			{
+				util::RegistryKeyType key;
+				geos::geom::Envelope envelope;
+				boost::shared_ptr<const geos::geom::Geometry> geometry;
+			};
+			typedef std::map<const T*, Item> Items;
+
+			static boost::mutex _mutex;	//!< protects all the following attributes
+			static geos::index::quadtree::Quadtree _tree;
+			static Items _items;
+			static geos::geom::Envelope _bounds;	//!< contains all the registered objects (never reduced)
+
+			static void _remove(const T& object);
+
+			static std::vector<const Item*> _getItems(const geos::geom::Envelope& envelope);
+
+			static bool _CompareKeys(const boost::shared_ptr<T>& o1, const boost::shared_ptr<T>& o2);
+
+			static Objects _getObjects(const std::vector<const Item*>& items);
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Registers an object or updates its position.
+			/// @param object the object
+			/// @param geometry the geometry of the object (an empty geometry
+			/// unregisters the object)
+			static void Update(
+				const T& object,
+				const boost::shared_ptr<const geos::geom::Geometry>& geometry
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Unregisters an object.
+			static void Remove(const T& object);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Objects whose envelope intersects an envelope.
+			static Objects GetByEnvelope(const geos::geom::Envelope& envelope);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Objects at a maximal distance from a point.
+			/// @param point the point (instance coordinates system)
+			/// @param distance the maximal distance in meters
+			static Objects GetByMaxDistance(
+				const geos::geom::Point& point,
+				double distance
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Nearest object from a point.
+			/// The search is done in squares of increasing size around the point.
+			/// @param point the point (instance coordinates system)
+			/// @param maxDistance the maximal distance in meters
+			/// @return the nearest object, null if none is at less than maxDistance
+			static boost::shared_ptr<T> GetNearest(
+				const geos::geom::Point& point,
+				double maxDistance
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Envelope containing all the registered objects.
+			static geos::geom::Envelope GetBounds();
+
+
+
+			static std::size_t GetSize();
+		};
+
+
+
+		template<class T>
+		boost::mutex SpatialIndex<T>::_mutex;
+
+		template<class T>
+		geos::index::quadtree::Quadtree SpatialIndex<T>::_tree;
+
+		template<class T>
+		typename SpatialIndex<T>::Items SpatialIndex<T>::_items;
+
+		template<class T>
+		geos::geom::Envelope SpatialIndex<T>::_bounds;
+
+
+
+		template<class T>
+		void SpatialIndex<T>::_remove(
+			const T& object
+		){
+			typename Items::iterator it(_items.find(&object));
+			if(it == _items.end())
+			{
+				return;
+			}
+			_tree.remove(&it->second.envelope, const_cast<T*>(&object));
+			_items.erase(it);
+		}
+
+
+
+		template<class T>
+		std::vector<const typename SpatialIndex<T>::Item*> SpatialIndex<T>::_getItems(
+			const geos::geom::Envelope& envelope
+		){
+			// The quadtree returns the objects of the nodes crossed by the
+			// envelope : the envelopes of the objects must be checked
+			std::vector<void*> candidates;
+			_tree.query(&envelope, candidates);
+
+			std::vector<const Item*> result;
+			BOOST_FOREACH(void* candidate, candidates)
+			{
+				typename Items::const_iterator it(_items.find(static_cast<const T*>(candidate)));
+				if(	it != _items.end() &&
+					it->second.envelope.intersects(&envelope)
+				){
+					result.push_back(&it->second);
+				}
+			}
+			return result;
+		}
+
+
+
+		template<class T>
+		bool SpatialIndex<T>::_CompareKeys(
+			const boost::shared_ptr<T>& o1,
+			const boost::shared_ptr<T>& o2
+		){
+			return o1->getKey() < o2->getKey();
+		}
+
+
+
+		template<class T>
+		typename SpatialIndex<T>::Objects SpatialIndex<T>::_getObjects(
+			const std::vector<const Item*>& items
+		){
+			// Reading through the registry : the objects are returned with their
+			// ownership, and the objects which left the registry are ignored
+			const util::Registry<T>& registry(util::Env::GetOfficialEnv().getRegistry<T>());
+			Objects result;
+			BOOST_FOREACH(const Item* item, items)
+			{
+				if(registry.contains(item->key))
+				{
+					result.push_back(util::Env::GetOfficialEnv().getEditable<T>(item->key));
+				}
+			}
+			std::sort(result.begin(), result.end(), &SpatialIndex<T>::_CompareKeys);
+			return result;
+		}
+
+
+
+		template<class T>
+		void SpatialIndex<T>::Update(
+			const T& object,
+			const boost::shared_ptr<const geos::geom::Geometry>& geometry
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+
+			_remove(object);
+			if(!geometry.get() || geometry->isEmpty())
+			{
+				return;
+			}
+
+			Item& item(_items[&object]);
+			item.key = object.getKey();
+			item.envelope = *geometry->getEnvelopeInternal();
+			item.geometry = geometry;
+			_tree.insert(&item.envelope, const_cast<T*>(&object));
+			_bounds.expandToInclude(&item.envelope);
+		}
+
+
+
+		template<class T>
+		void SpatialIndex<T>::Remove(
+			const T& object
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			_remove(object);
+		}
+
+
+
+		template<class T>
+		typename SpatialIndex<T>::Objects SpatialIndex<T>::GetByEnvelope(
+			const geos::geom::Envelope& envelope
+		){
+			boost::mutex::scoped_lock lock(_mutex);
+			return _getObjects(_getItems(envelope));
+		}
+
+
+
+		template<class T>
+		typename SpatialIndex<T>::Objects SpatialIndex<T>::GetByMaxDistance(
+			const geos::geom::Point& point,
+			double distance
+		){
+			if(point.isEmpty())
+			{
+				return Objects();
+			}
+
+			geos::geom::Envelope envelope(
+				point.getX() - distance,
+				point.getX() + distance,
+				point.getY() - distance,
+				point.getY() + distance
+			);
+
+			boost::mutex::scoped_lock lock(_mutex);
+			std::vector<const Item*> items;
+			BOOST_FOREACH(const Item* item, _getItems(envelope))
+			{
+				if(item->geometry->distance(&point) <= distance)
+				{
+					items.push_back(item);
+				}
+			}
+			return _getObjects(items);
+		}
+
+
+
+		template<class T>
+		boost::shared_ptr<T> SpatialIndex<T>::GetNearest(
+			const geos::geom::Point& point,
+			double maxDistance
+		){
+			if(point.isEmpty())
+			{
+				return boost::shared_ptr<T>();
+			}
+
+			boost::mutex::scoped_lock lock(_mutex);
+			if(_items.empty())
+			{
+				return boost::shared_ptr<T>();
+			}
+			for(double distance(std::min(100.0, maxDistance)); true; distance = std::min(2 * distance, maxDistance))
+			{
+				geos::geom::Envelope envelope(
+					point.getX() - distance,
+					point.getX() + distance,
+					point.getY() - distance,
+					point.getY() + distance
+				);
+
+				// Every object nearer than the distance intersects the square
+				const Item* bestItem(NULL);
+				double bestDistance(distance);
+				BOOST_FOREACH(const Item* item, _getItems(envelope))
+				{
+					double itemDistance(item->geometry->distance(&point));
+					if(	itemDistance < bestDistance ||
+						(itemDistance == bestDistance && (!bestItem || item->key < bestItem->key))
+					){
+						bestItem = item;
+						bestDistance = itemDistance;
+					}
+				}
+				if(bestItem)
+				{
+					std::vector<const Item*> items(1, bestItem);
+					Objects result(_getObjects(items));
+					return result.empty() ? boost::shared_ptr<T>() : result.front();
+				}
+
+				if(distance >= maxDistance || envelope.contains(_bounds))
+				{
+					return boost::shared_ptr<T>();
+				}
+			}
+		}
+
+
+
+		template<class T>
+		geos::geom::Envelope SpatialIndex<T>::GetBounds()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _bounds;
+		}
+
+
+
+		template<class T>
+		std::size_t SpatialIndex<T>::GetSize()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			return _items.size();
+		}
+}	}
+
+#endif // SYNTHESE_geography_SpatialIndex_hpp__
@@ -252,8 +252,10 @@ namespace synthese
 
 
 
-		void AlgorithmLogger::closeIntegralSearchLog() const
-		{
+		void AlgorithmLogger::closeIntegralSearchLog(
+			size_t allocationsNumber,
+			size_t peakMemory
+		) const	{
 			if(!_active)
 			{
 				return;
@@ -274,6 +276,8 @@ namespace synthese
 				" IntegralSearch. Start "
 				<< " at " << _integralSearchDesiredTime
 				<< "</th></tr>"
+				<< "<tr><td colspan=\"7\">" << allocationsNumber << " journeys allocated, peak memory "
+				<< peakMemory << " bytes</td></tr>"
 				<< "</table></body></html>"
 			;
 
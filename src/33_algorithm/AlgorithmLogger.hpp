@@ -107,6 +107,7 @@ namespace synthese
 			/// @name Getters
 			//@{
 				const boost::filesystem::path& getDirectory() const { return _directory; }
+				bool getActive() const { return _active; }
 			//@}
 
 			/// @name Integral search
@@ -120,7 +121,13 @@ namespace synthese
 					const RoutePlanningIntermediateJourney& journey
 				) const;
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Closes the log of an integral search.
+				/// @param allocationsNumber number of journeys allocated by the search
+				/// @param peakMemory peak of memory used by the journeys (bytes)
 				void closeIntegralSearchLog(
+					std::size_t allocationsNumber,
+					std::size_t peakMemory
 				) const;
 			//@}
 
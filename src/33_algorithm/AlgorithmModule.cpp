@@ -43,6 +43,7 @@ namespace synthese
 		template<> void ModuleClassTemplate<AlgorithmModule>::PreInit()
 		{
 			RegisterParameter(AlgorithmModule::MODULE_PARAM_USE_ASTAR_FOR_PHYSICAL_STOPS_EXTENDER, "0", &AlgorithmModule::ParameterCallback);
+			RegisterParameter(AlgorithmModule::MODULE_PARAM_ROUTE_PLANNER_THREADS, "2", &AlgorithmModule::ParameterCallback);
 		}
 
 
@@ -62,6 +63,7 @@ namespace synthese
 		template<> void ModuleClassTemplate<AlgorithmModule>::End()
 		{
 			UnregisterParameter(AlgorithmModule::MODULE_PARAM_USE_ASTAR_FOR_PHYSICAL_STOPS_EXTENDER);
+			UnregisterParameter(AlgorithmModule::MODULE_PARAM_ROUTE_PLANNER_THREADS);
 		}
 
 
@@ -83,8 +85,10 @@ namespace synthese
 	namespace algorithm
 	{
 		const string AlgorithmModule::MODULE_PARAM_USE_ASTAR_FOR_PHYSICAL_STOPS_EXTENDER = "astar_for_walk";
+		const string AlgorithmModule::MODULE_PARAM_ROUTE_PLANNER_THREADS = "route_planner_threads";
 
 		bool AlgorithmModule::_useAStarForPhysicalStopsExtender = false;
+		size_t AlgorithmModule::_routePlannerThreads(2);
 		void AlgorithmModule::ParameterCallback(
 			const string& name,
 			const string& value
@@ -93,6 +97,10 @@ namespace synthese
 			{
 				_useAStarForPhysicalStopsExtender = !value.empty() && boost::lexical_cast<bool>(value);
 			}
+			if(name == MODULE_PARAM_ROUTE_PLANNER_THREADS)
+			{
+				_routePlannerThreads = value.empty() ? 1 : boost::lexical_cast<size_t>(value);
+			}
 		}
 	}
 }
@@ -68,13 +68,20 @@ namespace synthese
 		{
 		public:
 			static const std::string MODULE_PARAM_USE_ASTAR_FOR_PHYSICAL_STOPS_EXTENDER;
+			static const std::string MODULE_PARAM_ROUTE_PLANNER_THREADS;
 
 		private:
 			static bool _useAStarForPhysicalStopsExtender;
+			static std::size_t _routePlannerThreads;
 
 		public:
 			static bool GetUseAStarForPhysicalStopsExtender(){ return _useAStarForPhysicalStopsExtender; }
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Maximal number of threads used by a route planning request to run its
+			/// independent searches (1 = no parallelism).
+			static std::size_t GetRoutePlannerThreads(){ return _routePlannerThreads; }
+
 
 
 			static void ParameterCallback(
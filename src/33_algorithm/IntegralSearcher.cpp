@@ -426,7 +426,8 @@ namespace synthese
 									_ignoreReservation,
 									false, // allowCanceledService
 									_enableTheoretical,
-									_enableRealTime
+									_enableRealTime,
+									_timeContext
 								):
 								edge.getPreviousService(
 									_accessParameters,
@@ -438,7 +439,8 @@ namespace synthese
 									_ignoreReservation,
 									false, // allowCanceledService
 									_enableTheoretical,
-									_enableRealTime
+									_enableRealTime,
+									_timeContext
 							)	);
 
 							// If no service, advance to the next edge
@@ -557,7 +559,7 @@ sqrt(
 								);
 
 								boost::shared_ptr<RoutePlanningIntermediateJourney> resultJourney(
-									new RoutePlanningIntermediateJourney(
+									_journeysPool.create(
 										fullApproachJourney,
 										serviceUse,
 										isGoalReached,
@@ -601,7 +603,7 @@ sqrt(
 								if(	isARecursionNode
 								){
 									boost::shared_ptr<RoutePlanningIntermediateJourney> todoJourney(
-										new RoutePlanningIntermediateJourney(
+										_journeysPool.create(
 											*journey,
 											serviceUse,
 											false,
@@ -657,7 +659,10 @@ sqrt(
 			}
 */
 
-			_logger.closeIntegralSearchLog();
+			_logger.closeIntegralSearchLog(
+				_journeysPool.getAllocationsNumber(),
+				_journeysPool.getPeakMemory()
+			);
 		}
 
 // ------------------------------------------------------------------------- Utilities
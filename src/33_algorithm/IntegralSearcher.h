@@ -26,7 +26,9 @@
 #include "GraphTypes.h"
 #include "AccessParameters.h"
 #include "GraphModuleTemplate.h"
+#include "IntermediateJourneysPool.hpp"
 #include "RoutePlanningIntermediateJourney.hpp"
+#include "SearchTimeContext.hpp"
 
 #include <boost/optional.hpp>
 
@@ -90,6 +92,7 @@ namespace synthese
 				bool										_ignoreReservation;
 				bool										_enableTheoretical;
 				bool										_enableRealTime;
+				const graph::SearchTimeContext				_timeContext;	//!< Current time of the whole search
 			//@}
 
 			//! @name Route planning data
@@ -97,6 +100,7 @@ namespace synthese
 				const graph::VertexAccessMap&				_destinationVam;	//!< Can be a departure or an arrival, according to _accesDirection
 				const int									_totalDistance;
 				boost::optional<const JourneyTemplates&>	_journeyTemplates;	//!< For similarity test
+				IntermediateJourneysPool					_journeysPool;
 			//@}
 
 
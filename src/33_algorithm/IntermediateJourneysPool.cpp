@@ -0,0 +1,120 @@
+/** IntermediateJourneysPool class implementation.
+	@file IntermediateJourneysPool.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "IntermediateJourneysPool.hpp"
+
+#include <new>
+#include <boost/make_shared.hpp>
+
+using namespace boost;
+using namespace std;
+
+namespace synthese
+{
+	using namespace graph;
+
+	namespace algorithm
+	{
+		IntermediateJourneysPool::_Storage::_Storage():
+			_blockSize(0),
+			_allocationsNumber(0),
+			_usedMemory(0),
+			_peakMemory(0)
+		{}
+
+
+
+		void* IntermediateJourneysPool::_Storage::allocate(
+			size_t size
+		){
+			// The pool is sized at the first allocation : allocate_shared always
+			// requests blocks of the same size
+			if(!_pool.get())
+			{
+				_blockSize = size;
+				_pool.reset(new boost::pool<>(size));
+			}
+
+			void* result(
+				size == _blockSize ?
+				_pool->malloc() :
+				::operator new(size)
+			);
+			if(!result)
+			{
+				throw bad_alloc();
+			}
+
+			++_allocationsNumber;
+			_usedMemory += size;
+			if(_usedMemory > _peakMemory)
+			{
+				_peakMemory = _usedMemory;
+			}
+			return result;
+		}
+
+
+
+		void IntermediateJourneysPool::_Storage::deallocate(
+			void* p,
+			size_t size
+		){
+			if(size == _blockSize)
+			{
+				_pool->free(p);
+			}
+			else
+			{
+				::operator delete(p);
+			}
+			_usedMemory -= size;
+		}
+
+
+
+		IntermediateJourneysPool::IntermediateJourneysPool():
+			_storage(new _Storage)
+		{}
+
+
+
+		boost::shared_ptr<RoutePlanningIntermediateJourney> IntermediateJourneysPool::create(
+			const RoutePlanningIntermediateJourney& journey,
+			const ServicePointer& serviceUse,
+			bool endIsReached,
+			const VertexAccessMap& destinationVam,
+			Journey::Distance distanceToEnd,
+			bool similarity,
+			RoutePlanningIntermediateJourney::Score score
+		){
+			return allocate_shared<RoutePlanningIntermediateJourney>(
+				_Allocator<RoutePlanningIntermediateJourney>(_storage),
+				journey,
+				serviceUse,
+				endIsReached,
+				destinationVam,
+				distanceToEnd,
+				similarity,
+				score
+			);
+		}
+}	}
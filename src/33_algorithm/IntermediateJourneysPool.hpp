@@ -0,0 +1,159 @@
+/** IntermediateJourneysPool class header.
+	@file IntermediateJourneysPool.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_algorithm_IntermediateJourneysPool_hpp__
+#define SYNTHESE_algorithm_IntermediateJourneysPool_hpp__
+
+#include "RoutePlanningIntermediateJourney.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <boost/pool/pool.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace synthese
+{
+	namespace graph
+	{
+		class ServicePointer;
+		class VertexAccessMap;
+	}
+
+	namespace algorithm
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Pool of the intermediate journeys created by a search.
+		///	@ingroup m33
+		//////////////////////////////////////////////////////////////////////////
+		/// Each journey is allocated together with its shared_ptr counter in a
+		/// fixed size block of a boost::pool owned by the pool. The block goes
+		/// back to the pool when the last shared_ptr to the journey is released,
+		/// and is reused by the next journeys of the search. The memory is given
+		/// back to the system when the pool and all its journeys are destroyed.
+		///
+		/// The pool counts the allocations and the peak of used memory, for the
+		/// algorithm logs.
+		///
+		/// IntermediateJourneysPool is not thread safe ! It is intended to be
+		/// used only internally by a computing thread.
+		class IntermediateJourneysPool
+		{
+		private:
+			class _Storage
+			{
+			private:
+				std::size_t _blockSize;
+				std::auto_ptr<boost::pool<> > _pool;
+				std::size_t _allocationsNumber;
+				std::size_t _usedMemory;
+				std::size_t _peakMemory;
+
+			public:
+				_Storage();
+
+				void* allocate(std::size_t size);
+				void deallocate(void* p, std::size_t size);
+
+				std::size_t getAllocationsNumber() const { return _allocationsNumber; }
+				std::size_t getPeakMemory() const { return _peakMemory; }
+			};
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Allocator given to boost::allocate_shared.
+			/// The copies of the allocator kept by the shared_ptr counters keep the
+			/// storage alive as long as a journey of the pool exists.
+			template<class T>
+			class _Allocator
+			{
+			public:
+				typedef T value_type;
+				typedef T* pointer;
+				typedef const T* const_pointer;
+				typedef T& reference;
+				typedef const T& const_reference;
+				typedef std::size_t size_type;
+				typedef std::ptrdiff_t difference_type;
+
+				template<class U>
+				struct rebind
+				{
+					typedef _Allocator<U> other;
+				};
+
+				boost::shared_ptr<_Storage> storage;
+
+				explicit _Allocator(const boost::shared_ptr<_Storage>& value): storage(value) {}
+				template<class U>
+				_Allocator(const _Allocator<U>& other): storage(other.storage) {}
+
+				pointer address(reference value) const { return &value; }
+				const_pointer address(const_reference value) const { return &value; }
+				size_type max_size() const { return std::size_t(-1) / sizeof(T); }
+
+				pointer allocate(size_type n, const void* = 0)
+				{
+					return static_cast<pointer>(storage->allocate(n * sizeof(T)));
+				}
+
+				void deallocate(pointer p, size_type n)
+				{
+					storage->deallocate(p, n * sizeof(T));
+				}
+
+				void construct(pointer p, const T& value) { new(p) T(value); }
+				void destroy(pointer p) { p->~T(); }
+
+				template<class U>
+				bool operator==(const _Allocator<U>& other) const { return storage == other.storage; }
+				template<class U>
+				bool operator!=(const _Allocator<U>& other) const { return storage != other.storage; }
+			};
+
+			boost::shared_ptr<_Storage> _storage;
+
+		public:
+			IntermediateJourneysPool();
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Builds a journey in the pool by adding a service use after an
+			/// existing journey.
+			/// @see RoutePlanningIntermediateJourney::RoutePlanningIntermediateJourney
+			boost::shared_ptr<RoutePlanningIntermediateJourney> create(
+				const RoutePlanningIntermediateJourney& journey,
+				const graph::ServicePointer& serviceUse,
+				bool endIsReached,
+				const graph::VertexAccessMap& destinationVam,
+				graph::Journey::Distance distanceToEnd,
+				bool similarity,
+				RoutePlanningIntermediateJourney::Score score
+			);
+
+			//! @name Statistics
+			//@{
+				std::size_t getAllocationsNumber() const { return _storage->getAllocationsNumber(); }
+				std::size_t getPeakMemory() const { return _storage->getPeakMemory(); }
+			//@}
+		};
+}	}
+
+#endif // SYNTHESE_algorithm_IntermediateJourneysPool_hpp__
@@ -0,0 +1,134 @@
+/** ParallelSearches class implementation.
+	@file ParallelSearches.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "ParallelSearches.hpp"
+
+#include "Exception.h"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/thread/thread.hpp>
+
+using namespace boost;
+using namespace std;
+
+namespace synthese
+{
+	namespace algorithm
+	{
+		ParallelSearches::ParallelSearches(
+			size_t threadsNumber
+		):	_threadsNumber(threadsNumber),
+			_nextSearch(0)
+		{}
+
+
+
+		void ParallelSearches::add(
+			const Search& search
+		){
+			_searches.push_back(search);
+		}
+
+
+
+		void ParallelSearches::_runSearches()
+		{
+			while(true)
+			{
+				size_t rank;
+				{
+					boost::mutex::scoped_lock lock(_mutex);
+					if(_nextSearch >= _searches.size())
+					{
+						return;
+					}
+					rank = _nextSearch++;
+				}
+
+				try
+				{
+					_searches[rank]();
+				}
+				catch(thread_interrupted&)
+				{
+					throw;
+				}
+				catch(std::exception& e)
+				{
+					boost::mutex::scoped_lock lock(_mutex);
+					_errors[rank] = string(e.what());
+				}
+				catch(...)
+				{
+					boost::mutex::scoped_lock lock(_mutex);
+					_errors[rank] = string("unknown error");
+				}
+			}
+		}
+
+
+
+		void ParallelSearches::run()
+		{
+			_nextSearch = 0;
+			_errors.assign(_searches.size(), optional<string>());
+
+			thread_group threads;
+			try
+			{
+				// The calling thread is one of the threads running the searches
+				for(size_t i(1); i < min(_threadsNumber, _searches.size()); ++i)
+				{
+					try
+					{
+						threads.create_thread(boost::bind(&ParallelSearches::_runSearches, this));
+					}
+					catch(thread_resource_error&)
+					{
+						// The searches are run by the already created threads
+						break;
+					}
+				}
+
+				_runSearches();
+				threads.join_all();
+			}
+			catch(thread_interrupted&)
+			{
+				// The other threads use this object : they must be stopped before
+				// the interruption goes on
+				this_thread::disable_interruption di;
+				threads.interrupt_all();
+				threads.join_all();
+				throw;
+			}
+
+			BOOST_FOREACH(const optional<string>& error, _errors)
+			{
+				if(error)
+				{
+					throw synthese::Exception("Search failed : "+ *error);
+				}
+			}
+		}
+}	}
@@ -0,0 +1,86 @@
+/** ParallelSearches class header.
+	@file ParallelSearches.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_algorithm_ParallelSearches_hpp__
+#define SYNTHESE_algorithm_ParallelSearches_hpp__
+
+#include <string>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace synthese
+{
+	namespace algorithm
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Runner of independent searches of a request.
+		///	@ingroup m33
+		//////////////////////////////////////////////////////////////////////////
+		/// The searches are run by at most threadsNumber threads, including the
+		/// calling thread. Each search must write its own result : the caller
+		/// merges the results after run, in the order of the searches, so the
+		/// merge does not depend on the scheduling of the threads.
+		///
+		/// If the calling thread is interrupted, the other threads are
+		/// interrupted too and joined before the interruption goes on : their
+		/// searches stop at their next interruption point.
+		///
+		/// If a search throws an exception, the first error (in the order of the
+		/// searches) is thrown again by run as a synthese::Exception.
+		class ParallelSearches
+		{
+		public:
+			typedef boost::function<void ()> Search;
+
+		private:
+			const std::size_t _threadsNumber;
+			std::vector<Search> _searches;
+
+			/// @name Run state
+			//@{
+				boost::mutex _mutex;	//!< protects the run state
+				std::size_t _nextSearch;
+				std::vector<boost::optional<std::string> > _errors;
+			//@}
+
+			void _runSearches();
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor.
+			/// @param threadsNumber maximal number of threads running the searches
+			/// (0 or 1 runs all the searches in the calling thread)
+			ParallelSearches(
+				std::size_t threadsNumber
+			);
+
+			void add(const Search& search);
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Runs all the searches and waits for their end.
+			/// @throws synthese::Exception if a search has failed
+			void run();
+		};
+}	}
+
+#endif // SYNTHESE_algorithm_ParallelSearches_hpp__
@@ -26,6 +26,8 @@
 #include "Journey.h"
 #include "AlgorithmTypes.h"
 
+#include <boost/shared_ptr.hpp>
+
 namespace synthese
 {
 	namespace algorithm
@@ -170,26 +170,7 @@ namespace synthese
 			){
 				_logger.logTimeSlotJourneyPlannerStep(originDateTime);
 
-				RoutePlanner r(
-					_originVam,
-					_destinationVam,
-					_planningOrder,
-					_accessParameters,
-					_maxDuration,
-					originDateTime,
-					_planningOrder == DEPARTURE_FIRST ? _highestDepartureTime : _lowestArrivalTime,
-					_planningOrder == DEPARTURE_FIRST ? _highestArrivalTime : _lowestDepartureTime,
-					_whatToSearch,
-					_graphToUse,
-					_vmax,
-					_ignoreReservation,
-					_logger,
-					_journeyTemplates,
-					_maxTransferDuration,
-					_enableTheoretical,
-					_enableRealTime							
-				);
-				Journey journey(r.run());
+				Journey journey(_findJourney(originDateTime));
 
 				if(journey.empty()) break;
 
@@ -329,6 +310,33 @@ namespace synthese
 
 
 
+		Journey TimeSlotRoutePlanner::_findJourney(
+			const ptime& originDateTime
+		){
+			RoutePlanner r(
+				_originVam,
+				_destinationVam,
+				_planningOrder,
+				_accessParameters,
+				_maxDuration,
+				originDateTime,
+				_planningOrder == DEPARTURE_FIRST ? _highestDepartureTime : _lowestArrivalTime,
+				_planningOrder == DEPARTURE_FIRST ? _highestArrivalTime : _lowestDepartureTime,
+				_whatToSearch,
+				_graphToUse,
+				_vmax,
+				_ignoreReservation,
+				_logger,
+				_journeyTemplates,
+				_maxTransferDuration,
+				_enableTheoretical,
+				_enableRealTime
+			);
+			return r.run();
+		}
+
+
+
 		TimeSlotRoutePlanner::Result TimeSlotRoutePlanner::_MergeSubResultAndParentContinuousService(
 			const TimeSlotRoutePlanner::Result::value_type& parentContinuousService,
 			const TimeSlotRoutePlanner::Result& subResult
@@ -89,6 +89,21 @@ namespace synthese
 				const Result::value_type& parentContinuousService,
 				const Result& subResult
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Computes the best journey for an origin date time of the time slot.
+			/// The default implementation runs a RoutePlanner. Subclasses can
+			/// override it to use another search engine inside the time slot loop.
+			/// The optimization of the continuous services always uses the default
+			/// implementation.
+			/// @param originDateTime the departure (or arrival) time to start from
+			/// @return the best journey, empty if no solution was found
+			virtual graph::Journey _findJourney(
+				const boost::posix_time::ptime& originDateTime
+			);
+
 		public:
 			/** Constructor for specified time slot route planning.
 			*/
@@ -144,6 +159,8 @@ namespace synthese
 				bool enableRealTime = true
 			);
 
+			virtual ~TimeSlotRoutePlanner() {}
+
 			//! @name Getters
 			//@{
 				const boost::posix_time::ptime&		getLowestDepartureTime() const;
@@ -258,5 +258,15 @@ namespace synthese
 				return nonReachableRoads;
 			}
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> CrossingTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.10");
+			return result;
+		}
 	}
 }
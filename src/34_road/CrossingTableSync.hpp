@@ -102,6 +102,12 @@ namespace synthese
 				const std::string& value,
 				util::Env& env
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The crossings depend on the roads (non reachable roads).
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -162,7 +162,7 @@ namespace synthese
 			if(getGeometry().get())
 			{
 				boost::shared_ptr<Geometry> center(
-					coordinatesSystem->convertPoint(*getGeometry())
+					getProjectedGeometry(*coordinatesSystem)
 				);
 				pm.insert(DATA_X, center->getX());
 				pm.insert(DATA_Y, center->getY());
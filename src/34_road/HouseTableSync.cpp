@@ -29,6 +29,7 @@
 #include "DataSourceLinksField.hpp"
 #include "DataSourceTableSync.h"
 #include "SelectQuery.hpp"
+#include "SpatialIndex.hpp"
 #include "ReplaceQuery.h"
 #include "ImportableTableSync.hpp"
 #include "Road.h"
@@ -114,6 +115,13 @@ namespace synthese
 			// Road Place
 			boost::shared_ptr<RoadPlace> roadPlace(RoadPlaceTableSync::GetEditable(rows->getLongLong(HouseTableSync::COL_ROAD_PLACE_ID),env));
 			object->setRoadChunkFromRoadPlace(roadPlace);
+
+			// Spatial index
+			if(	&env == &Env::GetOfficialEnv() &&
+				linkLevel == ALGORITHMS_OPTIMIZATION_LOAD_LEVEL
+			){
+				geography::SpatialIndex<House>::Update(*object, object->getGeometry());
+			}
 		}
 
 
@@ -121,6 +129,8 @@ namespace synthese
 		template<> void OldLoadSavePolicy<HouseTableSync, House>::Unlink(
 			House* obj
 		){
+			// Spatial index
+			geography::SpatialIndex<House>::Remove(*obj);
 		}
 
 
@@ -175,4 +185,19 @@ namespace synthese
 			//TODO Log the removal
 		}
 	}
+
+
+
+	namespace road
+	{
+		boost::optional<DBTableSync::LoadDependencies> HouseTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.01");
+			result.push_back("34.10");
+			result.push_back("34.30");
+			return result;
+		}
+	}
 }
@@ -64,6 +64,11 @@ namespace synthese
 			HouseTableSync() {}
 			~HouseTableSync() {}
 
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The houses are projected on the road chunks of their road place.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -28,6 +28,7 @@
 #include "PublicPlaceEntrance.hpp"
 #include "ReverseRoadChunk.hpp"
 #include "RoadModule.h"
+#include "SpatialIndex.hpp"
 #include "VertexAccessMap.h"
 
 #include <geos/geom/Point.h>
@@ -244,6 +245,13 @@ namespace synthese
 					env.getEditableSPtr(this)
 				);
 			}
+
+			// Spatial index
+			if(	&env == &Env::GetOfficialEnv() &&
+				withAlgorithmOptimizations
+			){
+				SpatialIndex<PublicPlace>::Update(*this, getPoint());
+			}
 		}
 
 
@@ -272,5 +280,8 @@ namespace synthese
 					getFullName()
 				);
 			}
+
+			// Spatial index
+			SpatialIndex<PublicPlace>::Remove(*this);
 		}
 }	}
@@ -138,4 +138,15 @@ namespace synthese
 
 			return LoadFromQuery(query, env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> PublicPlaceEntranceTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.30");
+			result.push_back("34.40.03");
+			return result;
+		}
 }	}
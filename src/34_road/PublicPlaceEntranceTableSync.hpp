@@ -70,6 +70,12 @@ namespace synthese
 					util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 				);
 			//@}
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The entrances depend on the public places and on the road chunks.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
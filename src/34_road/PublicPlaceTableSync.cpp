@@ -136,4 +136,14 @@ namespace synthese
 
 			return LoadFromQuery(query, env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> PublicPlaceTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.01");
+			return result;
+		}
 }	}
@@ -70,6 +70,12 @@ namespace synthese
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
 
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The public places are registered in the places matchers of the cities
+			/// after the road places.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -30,6 +30,7 @@
 #include "PublicPlaceTableSync.h"
 #include "RequestException.h"
 #include "Request.h"
+#include "SpatialIndex.hpp"
 #include "Webpage.h"
 
 #include <sstream>
@@ -42,6 +43,7 @@ using namespace boost;
 namespace synthese
 {
 	using namespace util;
+	using namespace geography;
 	using namespace server;
 	using namespace security;
 	using namespace cms;
@@ -159,10 +161,24 @@ namespace synthese
 		) const {
 			ParametersMap pm;
 			
-			BOOST_FOREACH(const Registry<PublicPlace>::value_type& publicPlace, Env::GetOfficialEnv().getRegistry<PublicPlace>())
+			// The places of the bbox are found by the spatial index
+			SpatialIndex<PublicPlace>::Objects publicPlaces;
+			if(_bbox)
+			{
+				publicPlaces = SpatialIndex<PublicPlace>::GetByEnvelope(*_bbox);
+			}
+			else
+			{
+				BOOST_FOREACH(const Registry<PublicPlace>::value_type& publicPlace, Env::GetOfficialEnv().getRegistry<PublicPlace>())
+				{
+					publicPlaces.push_back(publicPlace.second);
+				}
+			}
+
+			BOOST_FOREACH(const boost::shared_ptr<PublicPlace>& publicPlace, publicPlaces)
 			{
 				boost::shared_ptr<ParametersMap> publicPlacePm(new ParametersMap);
-				publicPlace.second->toParametersMap(*publicPlacePm, _coordinatesSystem);
+				publicPlace->toParametersMap(*publicPlacePm, _coordinatesSystem);
 
 				pm.insert(TAG_PLACE, publicPlacePm);
 			}
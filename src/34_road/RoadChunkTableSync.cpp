@@ -28,6 +28,7 @@
 #include "RoadTableSync.h"
 #include "ReplaceQuery.h"
 #include "SelectQuery.hpp"
+#include "SpatialIndex.hpp"
 #include "LinkException.h"
 #include "CoordinatesSystem.hpp"
 #include "RuleUser.h"
@@ -278,6 +279,13 @@ namespace synthese
 					// Useful transfer calculation
 					object->getHub()->clearAndPropagateUsefulTransfer(RoadModule::GRAPH_ID);
 				}
+
+				// Spatial index
+				if(	&env == &Env::GetOfficialEnv() &&
+					linkLevel == ALGORITHMS_OPTIMIZATION_LOAD_LEVEL
+				){
+					geography::SpatialIndex<MainRoadChunk>::Update(*object, object->getGeometry());
+				}
 			}
 		}
 
@@ -291,6 +299,9 @@ namespace synthese
 			{
 				obj->getHub()->clearAndPropagateUsefulTransfer(RoadModule::GRAPH_ID);
 			}
+
+			// Spatial index
+			geography::SpatialIndex<MainRoadChunk>::Remove(*obj);
 		}
 
 
@@ -399,11 +410,9 @@ namespace synthese
 			EdgeProjector<boost::shared_ptr<MainRoadChunk> >::CompatibleUserClassesRequired requiredUserClasses
 		){
 			EdgeProjector<boost::shared_ptr<MainRoadChunk> >::From paths(
-				SearchByMaxDistance(
+				geography::SpatialIndex<MainRoadChunk>::GetByMaxDistance(
 					point,
-					maxDistance,
-					Env::GetOfficialEnv(),
-					UP_LINKS_LOAD_LEVEL
+					maxDistance
 			)	);
 
 			if(!paths.empty())
@@ -430,4 +439,15 @@ namespace synthese
 				}
 			}
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> RoadChunkTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.10");
+			result.push_back("34.20");
+			return result;
+		}
 }	}
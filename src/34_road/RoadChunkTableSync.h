@@ -143,6 +143,12 @@ namespace synthese
 				Address& address,
 				algorithm::EdgeProjector<boost::shared_ptr<road::MainRoadChunk> >::CompatibleUserClassesRequired requiredUserClasses = algorithm::EdgeProjector<boost::shared_ptr<road::MainRoadChunk> >::CompatibleUserClassesRequired()
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The road chunks link the roads and the crossings.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
@@ -298,4 +298,13 @@ namespace synthese
 			}
 			return roadPlaces.front();
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> RoadPlaceTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			return result;
+		}
 }	}
@@ -91,6 +91,12 @@ namespace synthese
 				util::Env& environment,
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The road places are registered in the places matchers of the cities.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
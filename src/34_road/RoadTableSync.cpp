@@ -204,5 +204,15 @@ namespace synthese
 
 			return LoadFromQuery(query.str(), env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> RoadTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.01");
+			return result;
+		}
 	}
 }
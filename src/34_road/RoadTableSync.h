@@ -87,6 +87,12 @@ namespace synthese
 				boost::optional<std::size_t> number = boost::optional<std::size_t>(),
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The roads depend on the road places.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
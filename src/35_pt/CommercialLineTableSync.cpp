@@ -522,5 +522,17 @@ namespace synthese
 
 			return query.str();
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> CommercialLineTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("55.10 Calendar templates");
+			result.push_back("35.10.06");
+			result.push_back("35.20.02");
+			result.push_back("35.40.01");
+			return result;
+		}
 	}
 }
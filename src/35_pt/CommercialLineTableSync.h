@@ -177,6 +177,14 @@ neededLevel = READ
 				, bool mustBeBookable
 				, std::string selectedColumns = db::TABLE_COL_ID
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The lines depend on the calendar templates, the use rules, the
+			/// reservation contacts, the networks and the stop areas (optional
+			/// reservation places).
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
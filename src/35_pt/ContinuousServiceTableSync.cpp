@@ -264,5 +264,19 @@ namespace synthese
 
 			return LoadFromQuery(query.str(), env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> ContinuousServiceTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("35.10.06");
+			result.push_back("35.25.02");
+			result.push_back("35.30.01");
+			result.push_back("35.55.01");
+			result.push_back("35.57.01");
+			result.push_back("35.60 Junctions");
+			return result;
+		}
 	}
 }
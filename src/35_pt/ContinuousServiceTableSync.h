@@ -84,6 +84,13 @@ namespace synthese
 				bool raisingOrder = true,
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The services are added to the journey patterns and their edges once all
+			/// the edges of the stops are loaded.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
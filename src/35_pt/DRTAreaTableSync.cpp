@@ -174,5 +174,14 @@ namespace synthese
 				}
 				return result;
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> DRTAreaTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("35.40.01");
+			return result;
+		}
 	}
 }
@@ -82,6 +82,12 @@ namespace synthese
 					const boost::optional<std::size_t> limit,
 					const boost::optional<std::string> optionalParameter) const;
 			//@}
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The DRT areas depend on the stop areas.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
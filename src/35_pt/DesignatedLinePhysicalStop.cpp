@@ -149,12 +149,9 @@ namespace synthese
 
 			if(hasGeometry())
 			{
-				boost::shared_ptr<geos::geom::Geometry> projected(getGeometry());
-				if(	CoordinatesSystem::GetStorageCoordinatesSystem().getSRID() !=
-					static_cast<CoordinatesSystem::SRID>(getGeometry()->getSRID())
-				){
-					projected = CoordinatesSystem::GetStorageCoordinatesSystem().convertGeometry(*getGeometry());
-				}
+				boost::shared_ptr<geos::geom::Geometry> projected(
+					getProjectedGeometry(CoordinatesSystem::GetStorageCoordinatesSystem())
+				);
 
 				geos::io::WKTWriter writer;
 				pm.insert(
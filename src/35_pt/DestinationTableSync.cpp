@@ -217,4 +217,12 @@ namespace synthese
 			}
 			return result;
 		} ;
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> DestinationTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			return result;
+		}
 }	}
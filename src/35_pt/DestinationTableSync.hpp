@@ -97,6 +97,12 @@ namespace synthese
 					const boost::optional<std::size_t> limit,
 					const boost::optional<std::string> optionalParameter) const;
 				//@}
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The destinations depend on the base tables only.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
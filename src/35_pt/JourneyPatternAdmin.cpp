@@ -874,8 +874,8 @@ namespace synthese
 					const LineStop& lineStop(dynamic_cast<const LineStop&>(*edge));
 					const DesignatedLinePhysicalStop* linePhysicalStop(dynamic_cast<const DesignatedLinePhysicalStop*>(edge));
 					const LineArea* lineArea(dynamic_cast<const LineArea*>(edge));
-					lineStop.getDepartureFromIndex(false,0);
-					lineStop.getDepartureFromIndex(true,0);
+					boost::shared_ptr<const Edge::DepartureServiceIndex> departureIndex(lineStop.getDepartureIndex(false));
+					boost::shared_ptr<const Edge::ArrivalServiceIndex> arrivalIndex(lineStop.getArrivalIndex(false));
 
 					if(lineStop.isArrival())
 					{
@@ -891,17 +891,18 @@ namespace synthese
 						}
 						stream << t.col(1, string(), true) << "A";
 
-						BOOST_FOREACH(const Edge::ArrivalServiceIndices::value_type& index, lineStop.getArrivalIndices())
+						for(int i(0); i<=23; ++i)
 						{
 							stream << t.col();
 
-							if(index.get(false) == lineStop.getParentPath()->getServices().rend())
+							Edge::ArrivalServiceIndex::Value index(arrivalIndex->getFirst(hours(i) + minutes(59) + seconds(59)));
+							if(index == arrivalIndex->end())
 							{
 								stream << "-";
 							}
 							else
 							{
-								const Service* service(*index.get(false));
+								const Service* service(arrivalIndex->get(index).service);
 								stream << services[service];
 								stream << "<br /><span class=\"mini\">" << service->getArrivalBeginScheduleToIndex(false, lineStop.getRankInPath()) << "</span>";
 							}
@@ -922,17 +923,18 @@ namespace synthese
 						}
 						stream << t.col(1, string(), true) << "D";
 
-						BOOST_FOREACH(const Edge::DepartureServiceIndices::value_type& index, lineStop.getDepartureIndices())
+						for(int i(0); i<=23; ++i)
 						{
 							stream << t.col();
 
-							if(index.get(false) == lineStop.getParentPath()->getServices().end())
+							Edge::DepartureServiceIndex::Value index(departureIndex->getFirst(hours(i)));
+							if(index == departureIndex->end())
 							{
 								stream << "-";
 							}
 							else
 							{
-								const Service* service(*index.get(false));
+								const Service* service(departureIndex->get(index).service);
 								stream << services[service];
 								stream << "<br /><span class=\"mini\">" << service->getDepartureBeginScheduleToIndex(false, lineStop.getRankInPath()) << "</span>";
 							}
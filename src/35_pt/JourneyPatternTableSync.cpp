@@ -270,4 +270,16 @@ namespace synthese
 			}
 			return LoadFromQuery(query, env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> JourneyPatternTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("35.10.06");
+			result.push_back("35.10.07");
+			result.push_back("35.25.01");
+			result.push_back("35.26");
+			return result;
+		}
 }	}
@@ -90,6 +90,13 @@ namespace synthese
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL,
 				boost::optional<bool> wayback = boost::optional<bool>()
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The journey patterns depend on the use rules, the rolling stocks, the
+			/// lines and the destinations.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
@@ -261,5 +261,15 @@ namespace synthese
 
 			return LoadFromQuery(query, env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> JunctionTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("35.55.01");
+			result.push_back("35.57.01");
+			return result;
+		}
 	}
 }
@@ -83,6 +83,12 @@ namespace synthese
 					util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 				);
 			//@}
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The junctions add edges to the stops after the line stops.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -534,4 +534,15 @@ namespace synthese
 				static_pointer_cast<DesignatedLinePhysicalStop, LineStop>(*result.begin())
 			;
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> LineStopTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("35.30.01");
+			result.push_back("35.40.05");
+			result.push_back("35.55.01");
+			return result;
+		}
 }	}
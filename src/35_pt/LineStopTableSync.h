@@ -168,6 +168,11 @@ namespace synthese
 				util::Env& env
 			);
 
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The line stops link the journey patterns to the stops and the DRT areas.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
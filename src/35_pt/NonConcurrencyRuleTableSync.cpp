@@ -183,5 +183,15 @@ namespace synthese
 
 			return LoadFromQuery(query.str(), env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> NonConcurrencyRuleTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("35.25.01");
+			result.push_back("35.30.01");
+			return result;
+		}
 	}
 }
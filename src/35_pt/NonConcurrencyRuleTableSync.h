@@ -70,6 +70,12 @@ namespace synthese
 				, bool raisingOrder = true,
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The rules are added to the lines after the journey patterns.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -60,6 +60,7 @@
 #include "ImportableTemplate.hpp"
 #include "DataSource.h"
 #include "RemoveObjectAction.hpp"
+#include "SpatialIndex.hpp"
 
 #include <geos/geom/LineString.h>
 
@@ -222,8 +223,8 @@ namespace synthese
 						/* If so, search in database for physical stops which are too close from the current one (less than 0.5 meter) */
 						if(it->getGeometry() && !it->getGeometry()->isEmpty())
 						{
-							StopPointTableSync::SearchResult near(StopPointTableSync::SearchByMaxDistance(*it->getGeometry(),
-								(distance == 0 ? 0.5 : distance),Env::GetOfficialEnv(),UP_LINKS_LOAD_LEVEL));
+							StopPointTableSync::SearchResult near(SpatialIndex<StopPoint>::GetByMaxDistance(*it->getGeometry(),
+								(distance == 0 ? 0.5 : distance)));
 
 							BOOST_FOREACH(const StopPointTableSync::SearchResult::value_type& nr, near)
 							{
@@ -326,4 +326,12 @@ namespace synthese
 			}
 			return stream.str();
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> PTUseRuleTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			return result;
+		}
 }	}
@@ -105,6 +105,12 @@ namespace synthese
 			static std::string SerializeUseRules(
 				const graph::RuleUser::Rules& value
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The use rules depend on the base tables only (fares).
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
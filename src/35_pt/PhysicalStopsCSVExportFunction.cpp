@@ -29,6 +29,7 @@
 #include "StopArea.hpp"
 #include "City.h"
 #include "CoordinatesSystem.hpp"
+#include "SpatialIndex.hpp"
 
 #include <geos/geom/Envelope.h>
 #include <sstream>
@@ -43,6 +44,7 @@ using namespace geos::geom;
 namespace synthese
 {
 	using namespace util;
+	using namespace geography;
 	using namespace server;
 	using namespace security;
 	using namespace pt;
@@ -115,21 +117,29 @@ namespace synthese
 			util::ParametersMap pm;
 
 			stream << fixed;
-			BOOST_FOREACH(Registry<StopPoint>::value_type itps, Env::GetOfficialEnv().getRegistry<StopPoint>())
+
+			// The stops of the bbox are found by the spatial index
+			SpatialIndex<StopPoint>::Objects stopPoints;
+			if(_bbox)
 			{
-				if(!itps.second.get()) continue;
+				stopPoints = SpatialIndex<StopPoint>::GetByEnvelope(*_bbox);
+			}
+			else
+			{
+				BOOST_FOREACH(const Registry<StopPoint>::value_type& itps, Env::GetOfficialEnv().getRegistry<StopPoint>())
+				{
+					stopPoints.push_back(itps.second);
+				}
+			}
 
-				const StopPoint& ps(*itps.second);
+			BOOST_FOREACH(const boost::shared_ptr<StopPoint>& itps, stopPoints)
+			{
+				if(!itps.get()) continue;
 
-				if(	_bbox &&
-					(	!ps.hasGeometry() ||
-						!_bbox->contains(*ps.getGeometry()->getCoordinate())
-				)	){
-					continue;
-				}
+				const StopPoint& ps(*itps);
 
 				boost::shared_ptr<Point> pts(
-					_coordinatesSystem->convertPoint(*ps.getGeometry())
+					ps.getProjectedGeometry(*_coordinatesSystem)
 				);
 
 				stream <<
@@ -112,6 +112,12 @@ namespace synthese
 			/// @author Hugues
 			/// @date 2010
 			virtual std::string getOutputMimeType() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The export is sent while it is written.
+			virtual bool isStreamable() const { return true; }
 		};
 	}
 }
@@ -68,6 +68,12 @@ namespace synthese
 				size_t number = 0,
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The reservation contacts depend on the base tables only.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
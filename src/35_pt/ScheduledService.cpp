@@ -61,6 +61,14 @@ namespace synthese
 
 	namespace pt
 	{
+		namespace
+		{
+			const time_duration::tick_type NIGHT_END_TICKS(hours(3).ticks());
+			const time_duration::tick_type PREVIOUS_DAY_SCHEDULE_BEGIN_TICKS(hours(4).ticks());
+			const time_duration::tick_type DAY_TICKS(hours(24).ticks());
+		}
+
+
 
 		ScheduledService::ScheduledService(
 			RegistryKeyType id,
@@ -95,7 +103,8 @@ namespace synthese
 			bool checkIfTheServiceIsReachable,
 			bool inverted,
 			bool ignoreReservation,
-			bool allowCanceled
+			bool allowCanceled,
+			const SearchTimeContext& timeContext
 		) const {
 
 			// Check of access parameters
@@ -122,40 +131,55 @@ namespace synthese
 			// Force the use of theorical schedule if date is after today
 			//  - RT data is only available today !
 			//  - day finishes at (day+1,03:00)
-			bool forceTheorical(presenceDateTime.date() > day_clock::local_day());
-			forceTheorical &= presenceDateTime.time_of_day().hours() > 3;
-			forceTheorical |= presenceDateTime.date() > day_clock::local_day() + days(1);
+			bool forceTheorical(timeContext.isTheoreticalForced(presenceDateTime));
 
 			// Actual time
-			const time_duration& thSchedule(getDeparture ? getDepartureSchedule(false, edgeIndex) : getArrivalSchedule(false, edgeIndex));
-			const time_duration& rtSchedule(getDeparture ? getDepartureSchedule(true, edgeIndex) : getArrivalSchedule(true, edgeIndex));
-			const time_duration& schedule((RTData && !forceTheorical) ? rtSchedule : thSchedule);
-			const time_duration timeOfDay(GetTimeOfDay(schedule));
-			if(	(getDeparture && ((presenceDateTime.time_of_day().hours() < 3 && schedule.hours() > 3 ? presenceDateTime.time_of_day() + hours(24) : presenceDateTime.time_of_day()) > schedule)) ||
-				(!getDeparture && ((presenceDateTime.time_of_day().hours() < 3 && schedule.hours() > 3 ? presenceDateTime.time_of_day() + hours(24) : presenceDateTime.time_of_day()) < schedule))
-			){
+			const time_duration thSchedule(getDeparture ? getDepartureSchedule(false, edgeIndex) : getArrivalSchedule(false, edgeIndex));
+			const time_duration schedule(
+				(RTData && !forceTheorical) ?
+				(getDeparture ? getDepartureSchedule(true, edgeIndex) : getArrivalSchedule(true, edgeIndex)) :
+				thSchedule
+			);
+
+			// The presence time and the schedule are compared as integers : a presence
+			// time before 03:00 can use a schedule after 04:00 of the previous day
+			const time_duration::tick_type scheduleTicks(schedule.ticks());
+			time_duration::tick_type presenceTicks(presenceDateTime.time_of_day().ticks());
+			const bool presenceAtNight(presenceTicks < NIGHT_END_TICKS);
+			const bool previousDay(presenceAtNight && scheduleTicks >= PREVIOUS_DAY_SCHEDULE_BEGIN_TICKS);
+			if(previousDay)
+			{
+				presenceTicks += DAY_TICKS;
+			}
+			if(getDeparture ? presenceTicks > scheduleTicks : presenceTicks < scheduleTicks)
+			{
 				return ServicePointer();
 			}
 
 			// Initializations
-			const time_duration& departureSchedule(getDepartureSchedule(RTData, 0));
-			ptime actualTime(presenceDateTime.time_of_day().hours() < 3 && schedule.hours() > 3 ? presenceDateTime.date() - days(1) : presenceDateTime.date(), schedule);
+			const time_duration departureSchedule(getDepartureSchedule(RTData, 0));
+			const date presenceDate(presenceDateTime.date());
+			ptime actualTime(previousDay ? presenceDate - days(1) : presenceDate, schedule);
 			ptime originDateTime(actualTime);
 			originDateTime += (departureSchedule - schedule);
 
 			// Check of date
-			ptime calendarDateTime(originDateTime);
-			if(departureSchedule >= hours(24))
+			date calendarDate(originDateTime.date());
+			if(departureSchedule.ticks() >= DAY_TICKS)
 			{
-				calendarDateTime -= days(static_cast<long>(floor(float(departureSchedule.total_seconds()) / float(86400))));
+				calendarDate -= days(static_cast<long>(departureSchedule.ticks() / DAY_TICKS));
 			}
-			if (!isActive(calendarDateTime.date()))
+			if (!isActive(calendarDate))
 			{
 				return ServicePointer();
 			}
 
 			// Saving dates
 			ServicePointer ptr(THData, RTData, accessParameters.getUserClassRank(), *this, originDateTime);
+			ptime theoreticalTime(
+				presenceAtNight && thSchedule.ticks() >= PREVIOUS_DAY_SCHEDULE_BEGIN_TICKS ? presenceDate - days(1) : presenceDate,
+				GetTimeOfDay(thSchedule)
+			);
 
 			if(getDeparture)
 			{
@@ -164,7 +188,7 @@ namespace synthese
 					ptr.setDepartureInformations(
 						edge,
 						actualTime,
-						ptime(presenceDateTime.time_of_day().hours() < 3 && thSchedule.hours() > 3 ? presenceDateTime.date() - days(1) : presenceDateTime.date(), GetTimeOfDay(thSchedule))
+						theoreticalTime
 					);
 				}
 				else
@@ -172,7 +196,7 @@ namespace synthese
 					ptr.setDepartureInformations(
 						edge,
 						actualTime,
-						ptime(presenceDateTime.time_of_day().hours() < 3 && thSchedule.hours() > 3 ? presenceDateTime.date() - days(1) : presenceDateTime.date(), GetTimeOfDay(thSchedule)),
+						theoreticalTime,
 						*((RTData && edgeIndex < _RTVertices.size()) ? _RTVertices[edgeIndex] : edge.getFromVertex())
 					);
 				}
@@ -184,7 +208,7 @@ namespace synthese
 					ptr.setArrivalInformations(
 						edge,
 						actualTime,
-						ptime(presenceDateTime.time_of_day().hours() < 3 && thSchedule.hours() > 3 ? presenceDateTime.date() - days(1) : presenceDateTime.date(), GetTimeOfDay(thSchedule))
+						theoreticalTime
 					);
 				}
 				else
@@ -192,7 +216,7 @@ namespace synthese
 					ptr.setArrivalInformations(
 						edge,
 						actualTime,
-						ptime(presenceDateTime.time_of_day().hours() < 3 && thSchedule.hours() > 3 ? presenceDateTime.date() - days(1) : presenceDateTime.date(), GetTimeOfDay(thSchedule)),
+						theoreticalTime,
 						*((RTData && edgeIndex < _RTVertices.size()) ? _RTVertices[edgeIndex] : edge.getFromVertex())
 					);
 				}
@@ -129,7 +129,8 @@ namespace synthese
 					bool checkIfTheServiceIsReachable,
 					bool inverted,
 					bool ignoreReservation,
-					bool allowCanceled
+					bool allowCanceled,
+					const graph::SearchTimeContext& timeContext = graph::SearchTimeContext()
 				) const;
 
 				virtual void completeServicePointer(
@@ -96,6 +96,13 @@ namespace synthese
 				bool raisingOrder = true,
 				util::LinkLevel linkLevel = util::UP_LINKS_LOAD_LEVEL
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The services are added to the journey patterns and their edges once all
+			/// the edges of the stops are loaded, after the continuous services.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 }	}
 
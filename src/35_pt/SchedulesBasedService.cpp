@@ -121,6 +121,7 @@ namespace synthese
 		{
 			assert(!value || value->getHub() == _path->getEdge(rank)->getHub());
 			_RTVertices[rank] = value;
+			_path->markServicesUpdated();
 		}
 
 
@@ -361,6 +362,7 @@ namespace synthese
 						++i;
 					}
 				}
+				getPath()->markServicesUpdated();
 			}
 			_computeNextRTUpdate();
 		}
@@ -761,6 +763,10 @@ namespace synthese
 		void SchedulesBasedService::setRealTimeVertices( const ServedVertices& value )
 		{
 			_RTVertices = value;
+			if(_path)
+			{
+				_path->markServicesUpdated();
+			}
 
 			// Inter-SYNTHESE sync
 			if(Factory<InterSYNTHESESyncTypeFactory>::size()) // Avoid in unit tests
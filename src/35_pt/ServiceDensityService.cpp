@@ -34,6 +34,7 @@
 #include "Edge.h"
 #include "LineStop.h"
 #include "SchedulesBasedService.h"
+#include "SpatialIndex.hpp"
 #include "JourneyPattern.hpp"
 #include "CommercialLine.h"
 #include "City.h"
@@ -42,6 +43,7 @@
 #ifndef UNIX
 #include <geos/util/math.h>
 #endif
+#include <cmath>
 #include <sstream>
 #include <boost/algorithm/string/split.hpp>
 
@@ -57,6 +59,7 @@ using namespace boost::algorithm;
 namespace synthese
 {
 	using namespace util;
+	using namespace geography;
 	using namespace graph;
 	using namespace server;
 	using namespace security;
@@ -255,17 +258,6 @@ namespace synthese
 			const Request& request
 		) const {
 
-			// Search for stopPoints
-			StopPointSetType stopPointSet;
-
-			BOOST_FOREACH(const Registry<StopPoint>::value_type& stopPoint, Env::GetOfficialEnv().getRegistry<StopPoint>())
-			{
-				if(stopPoint.second->getGeometry())
-				{
-					addStop(stopPointSet, *stopPoint.second, _startDate, _endDate);
-				}
-			}
-
 			// Filling in the result parameters map
 			ParametersMap pm;
 
@@ -274,106 +266,140 @@ namespace synthese
 			size_t maxDistance = 0;
 			bool isServiceNumberReadched = false;
 			set<RegistryKeyType> serviceStored;
-			BOOST_FOREACH(const StopPointSetType::value_type& sp, stopPointSet)
+
+			// Search for stopPoints by the spatial index, in rings of increasing
+			// radius around the center point, until the number of services is
+			// reached : the stops are read in the same order as if all the stops
+			// were sorted by distance
+			Envelope bounds(SpatialIndex<StopPoint>::GetBounds());
+			double boundsDistance(0);
+			if(!bounds.isNull())
+			{
+				double dx(max(fabs(_centerPoint->getX() - bounds.getMinX()), fabs(_centerPoint->getX() - bounds.getMaxX())));
+				double dy(max(fabs(_centerPoint->getY() - bounds.getMinY()), fabs(_centerPoint->getY() - bounds.getMaxY())));
+				boundsDistance = sqrt(dx * dx + dy * dy);
+			}
+			int lastRadius(-1);
+			for(int radius(1000); !isServiceNumberReadched; radius *= 2)
 			{
-				boost::shared_ptr<ParametersMap> stopMap(new ParametersMap);
-				stopMap->insert(DATA_STOP_POINT_ID, sp.getStopPoint()->getKey());
-				stopMap->insert(DATA_STOP_POINT_NAME, sp.getStopPoint()->getName());
-				stopMap->insert(DATA_STOP_DISTANCE, sp.getDistanceToCenter());
-				string dataSourceName;
-				if(!sp.getStopPoint()->getDataSourceName().empty())
+				// The distances to center are truncated to integer meters
+				StopPointSetType stopPointSet;
+				BOOST_FOREACH(const boost::shared_ptr<StopPoint>& stopPoint, SpatialIndex<StopPoint>::GetByMaxDistance(*_centerPoint, radius + 1))
 				{
-					dataSourceName = sp.getStopPoint()->getDataSourceName();
+					int distanceToCenter(CalcDistanceToCenter(*stopPoint));
+					if(distanceToCenter > lastRadius && distanceToCenter <= radius)
+					{
+						addStop(stopPointSet, *stopPoint, _startDate, _endDate);
+					}
 				}
-				stopMap->insert(DATA_STOP_DATASOURCE,dataSourceName);
 
-				size_t nbServiceInStop = 0;
-				BOOST_FOREACH(const Vertex::Edges::value_type& edge, sp.getStopPoint()->getDepartureEdges())
+				BOOST_FOREACH(const StopPointSetType::value_type& sp, stopPointSet)
 				{
-					const LineStop* ls = static_cast<const LineStop*>(edge.second);
+					boost::shared_ptr<ParametersMap> stopMap(new ParametersMap);
+					stopMap->insert(DATA_STOP_POINT_ID, sp.getStopPoint()->getKey());
+					stopMap->insert(DATA_STOP_POINT_NAME, sp.getStopPoint()->getName());
+					stopMap->insert(DATA_STOP_DISTANCE, sp.getDistanceToCenter());
+					string dataSourceName;
+					if(!sp.getStopPoint()->getDataSourceName().empty())
+					{
+						dataSourceName = sp.getStopPoint()->getDataSourceName();
+					}
+					stopMap->insert(DATA_STOP_DATASOURCE,dataSourceName);
 
-					ptime departureDateTime = _startDate;
-					// Loop on services
-					optional<Edge::DepartureServiceIndex::Value> index;
-					while(true)
+					size_t nbServiceInStop = 0;
+					BOOST_FOREACH(const Vertex::Edges::value_type& edge, sp.getStopPoint()->getDepartureEdges())
 					{
-						ServicePointer servicePointer(
-							ls->getNextService(
-								_accessParameters,
-								departureDateTime,
-								_endDate,
-								false,
-								index,
-								false,
-								false
-						));
-						if(!servicePointer.getService())
-							break;
-						const Service * service = servicePointer.getService();
-						++*index;
-						departureDateTime = servicePointer.getDepartureDateTime();
-						if(sp.getStopPoint()->getKey() != servicePointer.getRealTimeDepartureVertex()->getKey())
-							continue;
-
-						const JourneyPattern* journeyPattern = dynamic_cast<const JourneyPattern*>(service->getPath());
-						if(!journeyPattern->isCompatibleWith(_accessParameters) ||
-							!_accessParameters.isAllowedPathClass
-							(
-								journeyPattern->getPathClass() ? journeyPattern->getPathClass()->getIdentifier() : 0,
-								journeyPattern->getPathNetwork() ? journeyPattern->getPathNetwork()->getIdentifier() : 0
-							)
-						){
-							continue;
-						}
-
-						// Check if service already stored in map
-						if(serviceStored.find(service->getKey()) != serviceStored.end())
-							continue;
-						serviceStored.insert(service->getKey());
-
-						nbService++;
-						nbServiceInStop++;
-						maxDistance = sp.getDistanceToCenter();
-						if(_displayServices)
+						const LineStop* ls = static_cast<const LineStop*>(edge.second);
+
+						ptime departureDateTime = _startDate;
+						// Loop on services
+						optional<Edge::DepartureServiceIndex::Value> index;
+						while(true)
 						{
-							boost::shared_ptr<ParametersMap> serviceMap(new ParametersMap);
-							serviceMap->insert(DATA_SERVICE_ID, service->getKey());
+							ServicePointer servicePointer(
+								ls->getNextService(
+									_accessParameters,
+									departureDateTime,
+									_endDate,
+									false,
+									index,
+									false,
+									false
+							));
+							if(!servicePointer.getService())
+								break;
+							const Service * service = servicePointer.getService();
+							++*index;
+							departureDateTime = servicePointer.getDepartureDateTime();
+							if(sp.getStopPoint()->getKey() != servicePointer.getRealTimeDepartureVertex()->getKey())
+								continue;
+
+							const JourneyPattern* journeyPattern = dynamic_cast<const JourneyPattern*>(service->getPath());
+							if(!journeyPattern->isCompatibleWith(_accessParameters) ||
+								!_accessParameters.isAllowedPathClass
+								(
+									journeyPattern->getPathClass() ? journeyPattern->getPathClass()->getIdentifier() : 0,
+									journeyPattern->getPathNetwork() ? journeyPattern->getPathNetwork()->getIdentifier() : 0
+								)
+							){
+								continue;
+							}
 
-							const CommercialLine * commercialLine(journeyPattern->getCommercialLine());
-							serviceMap->insert(DATA_COMMERCIAL_LINE_NAME, commercialLine->getName());
-							serviceMap->insert(DATA_LINE_NAME, journeyPattern->getName());
+							// Check if service already stored in map
+							if(serviceStored.find(service->getKey()) != serviceStored.end())
+								continue;
+							serviceStored.insert(service->getKey());
 
-							// Departure schedule
-							if(dynamic_cast<const SchedulesBasedService*>(service))
+							nbService++;
+							nbServiceInStop++;
+							maxDistance = sp.getDistanceToCenter();
+							if(_displayServices)
 							{
-								const SchedulesBasedService& sservice(
-									dynamic_cast<const SchedulesBasedService&>(*service)
-								);
-								serviceMap->insert(DATA_SERVICE_DEPARTURE_SCHEDULE, to_simple_string(sservice.getDepartureSchedule(false, 0)));
+								boost::shared_ptr<ParametersMap> serviceMap(new ParametersMap);
+								serviceMap->insert(DATA_SERVICE_ID, service->getKey());
+
+								const CommercialLine * commercialLine(journeyPattern->getCommercialLine());
+								serviceMap->insert(DATA_COMMERCIAL_LINE_NAME, commercialLine->getName());
+								serviceMap->insert(DATA_LINE_NAME, journeyPattern->getName());
+
+								// Departure schedule
+								if(dynamic_cast<const SchedulesBasedService*>(service))
+								{
+									const SchedulesBasedService& sservice(
+										dynamic_cast<const SchedulesBasedService&>(*service)
+									);
+									serviceMap->insert(DATA_SERVICE_DEPARTURE_SCHEDULE, to_simple_string(sservice.getDepartureSchedule(false, 0)));
+								}
+								serviceMap->insert(DATA_SERVICE_NETWORK, journeyPattern->getNetwork()->getName());
+								serviceMap->insert(DATA_SERVICE_ROLLING_STOCK, journeyPattern->getRollingStock()->getName());
+								serviceMap->insert(DATA_SERVICE_RANK, nbServiceInStop);
+
+								stopMap->insert(DATA_SERVICE, serviceMap);
+							}
+							if (nbService >= _serviceNumberToReach)
+							{
+								isServiceNumberReadched = true;
+								break;
 							}
-							serviceMap->insert(DATA_SERVICE_NETWORK, journeyPattern->getNetwork()->getName());
-							serviceMap->insert(DATA_SERVICE_ROLLING_STOCK, journeyPattern->getRollingStock()->getName());
-							serviceMap->insert(DATA_SERVICE_RANK, nbServiceInStop);
-
-							stopMap->insert(DATA_SERVICE, serviceMap);
-						}
-						if (nbService >= _serviceNumberToReach)
-						{
-							isServiceNumberReadched = true;
-							break;
-						}
 						
-					} //Service pointer loop
+						} //Service pointer loop
+						if(isServiceNumberReadched)break;
+					} // Edge loop
+					if(nbServiceInStop > 0)
+					{
+						nbStop++;
+						stopMap->insert(DATA_STOP_RANK, nbStop);
+						pm.insert(DATA_STOP, stopMap);
+					}
 					if(isServiceNumberReadched)break;
-				} // Edge loop
-				if(nbServiceInStop > 0)
+				} // Stop point loop
+
+				lastRadius = radius;
+				if(radius >= boundsDistance)
 				{
-					nbStop++;
-					stopMap->insert(DATA_STOP_RANK, nbStop);
-					pm.insert(DATA_STOP, stopMap);
+					break;
 				}
-				if(isServiceNumberReadched)break;
-			} // Stop point loop
+			} // Ring loop
 
 			pm.insert(MAX_DISTANCE_TO_CENTER_POINT, maxDistance);
 			pm.insert(SERVICE_NUMBER_REACHED, nbService);
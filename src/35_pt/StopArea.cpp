@@ -45,6 +45,7 @@
 #include "StopPoint.hpp"
 #include "VertexAccessMap.h"
 
+#include <algorithm>
 #include <boost/foreach.hpp>
 #include <geos/geom/Envelope.h>
 
@@ -108,6 +109,7 @@ namespace synthese
 		){
 			_isoBarycentre.reset();
 			_physicalStops.insert(make_pair(physicalStop.getKey(), &physicalStop));
+			_updateTransferDelaysIndex();
 		}
 
 
@@ -397,6 +399,19 @@ namespace synthese
 
 		boost::posix_time::time_duration StopArea::getTransferDelay( util::RegistryKeyType fromId, util::RegistryKeyType toId ) const
 		{
+			// Transfer between two physical stops of the area : read in the index
+			size_t stopsNumber(_transferDelaysIndexStops.size());
+			size_t fromRank(_getTransferDelaysIndexRank(fromId));
+			if(fromRank < stopsNumber)
+			{
+				size_t toRank(_getTransferDelaysIndexRank(toId));
+				if(toRank < stopsNumber)
+				{
+					return _transferDelaysIndex[fromRank * stopsNumber + toRank];
+				}
+			}
+
+			// Other vertices
 			TransferDelaysMap::const_iterator it(
 				_transferDelays.find(make_pair(fromId, toId))
 			);
@@ -450,6 +465,7 @@ namespace synthese
 
 			_defaultTransferDelay = defaultTransferDelay;
 			_minTransferDelay = posix_time::time_duration(not_a_date_time);
+			_updateTransferDelaysIndex();
 		}
 
 
@@ -458,6 +474,7 @@ namespace synthese
 		{
 			_isoBarycentre.reset();
 			_physicalStops.erase(physicalStop.getKey());
+			_updateTransferDelaysIndex();
 		}
 
 
@@ -1022,5 +1039,44 @@ namespace synthese
 		{
 			_transferDelays = value;
 			_minTransferDelay = posix_time::time_duration(not_a_date_time);
+			_updateTransferDelaysIndex();
+		}
+
+
+
+		void StopArea::_updateTransferDelaysIndex()
+		{
+			_transferDelaysIndexStops.clear();
+			BOOST_FOREACH(const PhysicalStops::value_type& it, _physicalStops)
+			{
+				_transferDelaysIndexStops.push_back(it.first);
+			}
+
+			size_t stopsNumber(_transferDelaysIndexStops.size());
+			_transferDelaysIndex.assign(stopsNumber * stopsNumber, _defaultTransferDelay);
+			BOOST_FOREACH(const TransferDelaysMap::value_type& it, _transferDelays)
+			{
+				size_t fromRank(_getTransferDelaysIndexRank(it.first.first));
+				size_t toRank(_getTransferDelaysIndexRank(it.first.second));
+				if(fromRank < stopsNumber && toRank < stopsNumber)
+				{
+					_transferDelaysIndex[fromRank * stopsNumber + toRank] = it.second;
+				}
+			}
+		}
+
+
+
+		size_t StopArea::_getTransferDelaysIndexRank(
+			RegistryKeyType id
+		) const {
+			vector<RegistryKeyType>::const_iterator it(
+				lower_bound(_transferDelaysIndexStops.begin(), _transferDelaysIndexStops.end(), id)
+			);
+			if(it == _transferDelaysIndexStops.end() || *it != id)
+			{
+				return _transferDelaysIndexStops.size();
+			}
+			return it - _transferDelaysIndexStops.begin();
 		}
 }	}
@@ -34,6 +34,7 @@
 
 #include <map>
 #include <utility>
+#include <vector>
 #include <boost/optional.hpp>
 
 namespace synthese
@@ -210,8 +211,22 @@ namespace synthese
 			//@{
 				mutable boost::optional<graph::HubScore> _score;
 				mutable boost::posix_time::time_duration _minTransferDelay;
+				std::vector<util::RegistryKeyType> _transferDelaysIndexStops;	//!< Ids of the physical stops, sorted (the rank of a stop in the index)
+				std::vector<boost::posix_time::time_duration> _transferDelaysIndex;	//!< Delay from the stop of rank i to the stop of rank j at i * stops number + j
 			//@}
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Builds the dense transfer delays index from the transfer delays map,
+			/// the default delay and the physical stops.
+			/// Must be called after each change of one of them.
+			void _updateTransferDelaysIndex();
+
+			//////////////////////////////////////////////////////////////////////////
+			/// @param id id of a vertex
+			/// @return the rank of the physical stop in the transfer delays index,
+			/// the stops number if the vertex is not a physical stop of the area
+			std::size_t _getTransferDelaysIndexRank(util::RegistryKeyType id) const;
+
 			//! @Location
 			//@{
 				boost::shared_ptr<geos::geom::Point> _location;
@@ -365,5 +365,17 @@ namespace synthese
 
 			return LoadFromQuery(query, env, linkLevel);
 		}
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> StopAreaTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.01");
+			result.push_back("34.40.03");
+			result.push_back("35.10.06");
+			return result;
+		}
 	}
 }
@@ -107,6 +107,14 @@ namespace synthese
 				util::Env& env,
 				util::LinkLevel linkLevel
 			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The stop areas depend on the cities and the use rules, and are
+			/// registered in the places matchers of the cities after the road places
+			/// and the public places.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
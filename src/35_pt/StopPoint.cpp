@@ -33,6 +33,7 @@
 #include "StopPointTableSync.hpp"
 #include "CommercialLineTableSync.h"
 #include "ReverseRoadChunk.hpp"
+#include "SpatialIndex.hpp"
 #include "LineStop.h"
 #include "JourneyPattern.hpp"
 
@@ -384,12 +385,9 @@ namespace synthese
 			// Geometry
 			if(hasGeometry())
 			{
-				boost::shared_ptr<geos::geom::Geometry> projected(getGeometry());
-				if(	CoordinatesSystem::GetStorageCoordinatesSystem().getSRID() !=
-					static_cast<CoordinatesSystem::SRID>(getGeometry()->getSRID())
-				){
-					projected = CoordinatesSystem::GetStorageCoordinatesSystem().convertGeometry(*getGeometry());
-				}
+				boost::shared_ptr<geos::geom::Geometry> projected(
+					getProjectedGeometry(CoordinatesSystem::GetStorageCoordinatesSystem())
+				);
 
 				geos::io::WKTWriter writer;
 				pm.insert(
@@ -407,7 +405,7 @@ namespace synthese
 			pm.insert(prefix + DATA_OPERATOR_CODE, getCodeBySources());
 			if(getGeometry().get())
 			{
-				boost::shared_ptr<Point> gp = coordinatesSystem.convertPoint(*getGeometry());
+				boost::shared_ptr<Point> gp = getProjectedGeometry(coordinatesSystem);
 				if(gp.get())
 				{
 					pm.insert(prefix + DATA_X, gp->getX());
@@ -604,5 +602,12 @@ namespace synthese
 			{
 				getProjectedPoint().getRoadChunk()->getFromCrossing()->addReachableVertex(this);
 			}
+
+			// Spatial index
+			if(	&env == &Env::GetOfficialEnv() &&
+				withAlgorithmOptimizations
+			){
+				geography::SpatialIndex<StopPoint>::Update(*this, getGeometry());
+			}
 		}
 }	}
@@ -32,6 +32,7 @@
 #include "ReplaceQuery.h"
 #include "RoadChunkTableSync.h"
 #include "SelectQuery.hpp"
+#include "SpatialIndex.hpp"
 #include "Session.h"
 #include "StopAreaTableSync.hpp"
 #include "TransportNetworkRight.h"
@@ -135,6 +136,9 @@ namespace synthese
 			{
 				obj->getProjectedPoint().getRoadChunk()->getFromCrossing()->removeReachableVertex(obj);
 			}
+
+			// Spatial index
+			SpatialIndex<StopPoint>::Remove(*obj);
 		}
 
 
@@ -356,4 +360,16 @@ namespace synthese
 				}
 				return result;
 		} ;
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> StopPointTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("32");
+			result.push_back("34.30");
+			result.push_back("35.10.06");
+			result.push_back("35.40.01");
+			return result;
+		}
 }	}
@@ -130,6 +130,12 @@ namespace synthese
 				const boost::optional<std::size_t> limit,
 				const boost::optional<std::string> optionalParameter) const;
 
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The stops are linked to the stop areas and are projected on the road
+			/// chunks, after the road network is loaded.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
@@ -88,7 +88,7 @@ namespace synthese
 			BOOST_FOREACH(const boost::shared_ptr<StopPoint>& ps, stops)
 			{
 				boost::shared_ptr<geos::geom::Point> point(
-					sr.convertPoint(*ps->getGeometry())
+					ps->getProjectedGeometry(sr)
 				);
 
 				stream <<
@@ -36,6 +36,7 @@
 #include "Edge.h"
 #include "LineStop.h"
 #include "SchedulesBasedService.h"
+#include "SpatialIndex.hpp"
 #include "JourneyPattern.hpp"
 #include "City.h"
 #include "Webpage.h"
@@ -57,6 +58,7 @@ using namespace boost::algorithm;
 namespace synthese
 {
 	using namespace util;
+	using namespace geography;
 	using namespace graph;
 	using namespace server;
 	using namespace security;
@@ -335,17 +337,28 @@ namespace synthese
 			}
 			else
 			{
-				BOOST_FOREACH(const Registry<StopPoint>::value_type& stopPoint, Env::GetOfficialEnv().getRegistry<StopPoint>())
+				// The stops of the bbox are found by the spatial index
+				SpatialIndex<StopPoint>::Objects stopPoints;
+				if(_bbox)
 				{
-					if((_bbox &&
-						(!stopPoint.second->getGeometry() ||
-						!_bbox->contains(*stopPoint.second->getGeometry()->getCoordinate()))) ||
-						(_dataSourceFilter && !stopPoint.second->hasLinkWithSource(*_dataSourceFilter))
-					){
+					stopPoints = SpatialIndex<StopPoint>::GetByEnvelope(*_bbox);
+				}
+				else
+				{
+					BOOST_FOREACH(const Registry<StopPoint>::value_type& stopPoint, Env::GetOfficialEnv().getRegistry<StopPoint>())
+					{
+						stopPoints.push_back(stopPoint.second);
+					}
+				}
+
+				BOOST_FOREACH(const boost::shared_ptr<StopPoint>& stopPoint, stopPoints)
+				{
+					if(_dataSourceFilter && !stopPoint->hasLinkWithSource(*_dataSourceFilter))
+					{
 						continue;
 					}
 
-					addStop(stopPointMap, *stopPoint.second, startDateTime, endDateTime);
+					addStop(stopPointMap, *stopPoint, startDateTime, endDateTime);
 				}
 			}
 
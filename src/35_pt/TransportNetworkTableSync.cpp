@@ -229,4 +229,13 @@ namespace synthese
 			}
 			return result;
 		} ;
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> TransportNetworkTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			result.push_back("55.10 Calendar templates");
+			return result;
+		}
 }	}
@@ -93,6 +93,12 @@ namespace synthese
 				const boost::optional<std::string> prefix,
 				const boost::optional<std::size_t> limit,
 				const boost::optional<std::string> optionalParameter) const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The networks depend on the calendar templates.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
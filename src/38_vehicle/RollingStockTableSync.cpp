@@ -277,5 +277,13 @@ namespace synthese
 				}
 				return result;
 		} ;
+
+
+
+		boost::optional<DBTableSync::LoadDependencies> RollingStockTableSync::getLoadDependencies() const
+		{
+			LoadDependencies result(GetBaseLoadDependencies());
+			return result;
+		}
 	}
 }
@@ -126,6 +126,12 @@ namespace synthese
 				const boost::optional<std::string> prefix,
 				const boost::optional<std::size_t> limit,
 				const boost::optional<std::string> optionalParameter) const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// The rolling stocks depend on the base tables only.
+			virtual boost::optional<LoadDependencies> getLoadDependencies() const;
 		};
 	}
 }
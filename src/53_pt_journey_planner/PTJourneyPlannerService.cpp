@@ -145,6 +145,9 @@ namespace synthese
 		const string PTJourneyPlannerService::PARAMETER_ARRIVAL_PLACE_XY = "arrival_place_XY";
 		const string PTJourneyPlannerService::PARAMETER_INVERT_XY = "invert_XY";
 		const string PTJourneyPlannerService::PARAMETER_CONCATENATE_CONTIGUOUS_FOOT_LEGS = "concatenate_contiguous_foot_legs";
+		const string PTJourneyPlannerService::PARAMETER_ALGORITHM = "algorithm";
+		const string PTJourneyPlannerService::VALUE_RAPTOR = "raptor";
+		const string PTJourneyPlannerService::VALUE_RAPTOR_PROFILE = "raptor_profile";
 		const string PTJourneyPlannerService::PARAMETER_BROADCAST_POINT_ID = "broadcast_point";
 
 		const string PTJourneyPlannerService::PARAMETER_OUTPUT_FORMAT = "output_format";
@@ -285,6 +288,7 @@ namespace synthese
 			_endArrivalDate(not_a_date_time),
 			_period(NULL),
 			_logger(new AlgorithmLogger()),
+			_algorithm(PTTimeSlotRoutePlanner::INTEGRAL_SEARCH),
 			_broadcastPoint(NULL),
 			_page(NULL)
 		{}
@@ -313,6 +317,16 @@ namespace synthese
 				map.insert(PARAMETER_MAX_TRANSFER_DURATION, _maxTransferDuration->total_seconds() / 60);
 			}
 
+			// Algorithm
+			if(_algorithm == PTTimeSlotRoutePlanner::RAPTOR)
+			{
+				map.insert(PARAMETER_ALGORITHM, VALUE_RAPTOR);
+			}
+			else if(_algorithm == PTTimeSlotRoutePlanner::RAPTOR_PROFILE)
+			{
+				map.insert(PARAMETER_ALGORITHM, VALUE_RAPTOR_PROFILE);
+			}
+
 			// Min max duration ratio filter
 			if(_minMaxDurationRatioFilter)
 			{
@@ -750,6 +764,21 @@ namespace synthese
 
 			// Param to concatenate contiguous foot legs
 			_concatenateContiguousFootLegs = map.getDefault<bool>(PARAMETER_CONCATENATE_CONTIGUOUS_FOOT_LEGS, false);
+
+			// Search algorithm
+			string algorithm(map.getDefault<string>(PARAMETER_ALGORITHM));
+			if(algorithm == VALUE_RAPTOR)
+			{
+				_algorithm = PTTimeSlotRoutePlanner::RAPTOR;
+			}
+			else if(algorithm == VALUE_RAPTOR_PROFILE)
+			{
+				_algorithm = PTTimeSlotRoutePlanner::RAPTOR_PROFILE;
+			}
+			else
+			{
+				_algorithm = PTTimeSlotRoutePlanner::INTEGRAL_SEARCH;
+			}
 		}
 
 
@@ -880,7 +909,10 @@ namespace synthese
 						false,
 						*_logger,
 						_maxTransferDuration,
-						_minMaxDurationRatioFilter
+						_minMaxDurationRatioFilter,
+						true,
+						true,
+						_algorithm
 					);
 					_result.reset(new PTRoutePlannerResult(r.run()));
 					if (_result->getJourneys().size() > 0)
@@ -903,7 +935,10 @@ namespace synthese
 					false,
 					*_logger,
 					_maxTransferDuration,
-					_minMaxDurationRatioFilter
+					_minMaxDurationRatioFilter,
+					true,
+					true,
+					_algorithm
 				);
 				// Computing
 				_result.reset(new PTRoutePlannerResult(r.run()));
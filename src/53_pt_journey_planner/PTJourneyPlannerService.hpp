@@ -31,6 +31,7 @@
 #include "AccessParameters.h"
 #include "AlgorithmTypes.h"
 #include "PTRoutePlannerResult.h"
+#include "PTTimeSlotRoutePlanner.h"
 #include "RoadModule.h"
 
 #include <boost/optional.hpp>
@@ -137,6 +138,9 @@ namespace synthese
 			static const std::string PARAMETER_ARRIVAL_PLACE_XY;
 			static const std::string PARAMETER_INVERT_XY;
 			static const std::string PARAMETER_CONCATENATE_CONTIGUOUS_FOOT_LEGS;
+			static const std::string PARAMETER_ALGORITHM;
+			static const std::string VALUE_RAPTOR;
+			static const std::string VALUE_RAPTOR_PROFILE;
 			static const std::string PARAMETER_SHOW_COORDINATES;
 			static const std::string PARAMETER_MAX_TRANSFER_DURATION;
 			static const std::string PARAMETER_MIN_MAX_DURATION_RATIO_FILTER;
@@ -331,6 +335,7 @@ namespace synthese
 				std::string									_outputFormat;
 				boost::shared_ptr<const pt_website::PTServiceConfig>	_configuration;
 				bool _concatenateContiguousFootLegs;
+				PTTimeSlotRoutePlanner::SearchAlgorithm _algorithm;
 				vector<string> _vectMad;
 				const messages::CustomBroadcastPoint* _broadcastPoint;
 			//@}
@@ -23,14 +23,17 @@
 #include "PTTimeSlotRoutePlanner.h"
 
 #include "AlgorithmLogger.hpp"
+#include "AlgorithmModule.h"
 #include "FreeDRTArea.hpp"
 #include "Hub.h"
 #include "IntegralSearcher.h"
 #include "JourneysResult.h"
 #include "Log.h"
 #include "NamedPlace.h"
+#include "ParallelSearches.hpp"
 #include "Place.h"
 #include "PTModule.h"
+#include "RaptorTimeSlotRoutePlanner.hpp"
 #include "RoadModule.h"
 #include "StopArea.hpp"
 #include "StopPoint.hpp"
@@ -38,6 +41,7 @@
 #include "VertexAccessMap.h"
 
 #include <sstream>
+#include <boost/bind.hpp>
 
 using namespace std;
 using namespace boost;
@@ -70,7 +74,8 @@ namespace synthese
 			boost::optional<boost::posix_time::time_duration> maxTransferDuration,
 			boost::optional<double> minMaxDurationRatioFilter,
 			bool enableTheoretical,
-			bool enableRealTime
+			bool enableRealTime,
+			SearchAlgorithm algorithm
 		):	TimeSlotRoutePlanner(
 				origin->getVertexAccessMap(
 					accessParameters, PTModule::GRAPH_ID, RoadModule::GRAPH_ID, 0
@@ -95,7 +100,8 @@ namespace synthese
 				enableRealTime
 			),
 			_departurePlace(origin),
-			_arrivalPlace(destination)
+			_arrivalPlace(destination),
+			_algorithm(algorithm)
 		{
 		}
 
@@ -134,16 +140,32 @@ namespace synthese
 					getLowestArrivalTime(),
 					getHighestArrivalTime()
 				);
-				ovam = extenderToPhysicalStops.run(
-					_originVam,
-					_destinationVam,
-					DEPARTURE_TO_ARRIVAL
-				);
-				dvam = extenderToPhysicalStops.run(
-					_destinationVam,
-					_originVam,
-					ARRIVAL_TO_DEPARTURE
+
+				// The extensions of the departure and of the arrival places are
+				// independent : they run in parallel (except when the algorithm
+				// logger is active, as it is not thread safe)
+				ParallelSearches searches(
+					_logger.getActive() ? 1 : AlgorithmModule::GetRoutePlannerThreads()
 				);
+				searches.add(
+					boost::bind(
+						&PTTimeSlotRoutePlanner::_ExtendToPhysicalStops,
+						boost::cref(extenderToPhysicalStops),
+						boost::cref(_originVam),
+						boost::cref(_destinationVam),
+						DEPARTURE_TO_ARRIVAL,
+						boost::ref(ovam)
+				)	);
+				searches.add(
+					boost::bind(
+						&PTTimeSlotRoutePlanner::_ExtendToPhysicalStops,
+						boost::cref(extenderToPhysicalStops),
+						boost::cref(_destinationVam),
+						boost::cref(_originVam),
+						ARRIVAL_TO_DEPARTURE,
+						boost::ref(dvam)
+				)	);
+				searches.run();
 			}
 			else
 			{
@@ -194,7 +216,35 @@ namespace synthese
 			}
 
 
-			if(result.empty())
+			if(result.empty() && (_algorithm == RAPTOR || _algorithm == RAPTOR_PROFILE))
+			{
+				RaptorTimeSlotRoutePlanner r(
+					ovam,
+					dvam,
+					getLowestDepartureTime(),
+					getHighestDepartureTime(),
+					getLowestArrivalTime(),
+					getHighestArrivalTime(),
+					_maxDuration,
+					_maxSolutionsNumber,
+					_accessParameters,
+					_planningOrder,
+					_ignoreReservation,
+					_logger,
+					_maxTransferDuration,
+					_minMaxDurationRatioFilter,
+					_enableTheoretical,
+					_enableRealTime,
+					_algorithm == RAPTOR_PROFILE
+				);
+				return PTRoutePlannerResult(
+					_departurePlace,
+					_arrivalPlace,
+					false,
+					r.run()
+				);
+			}
+			else if(result.empty())
 			{
 				TimeSlotRoutePlanner r(
 					ovam,
@@ -224,6 +274,30 @@ namespace synthese
 					r.run()
 				);
 			}
+			else if(_algorithm == RAPTOR || _algorithm == RAPTOR_PROFILE)
+			{
+				RaptorTimeSlotRoutePlanner r(
+					ovam,
+					dvam,
+					result.front(),
+					_maxDuration,
+					_maxSolutionsNumber,
+					_accessParameters,
+					_planningOrder,
+					_ignoreReservation,
+					_logger,
+					_maxTransferDuration,
+					_minMaxDurationRatioFilter,
+					_enableTheoretical,
+					_enableRealTime
+				);
+				return PTRoutePlannerResult(
+					_departurePlace,
+					_arrivalPlace,
+					false,
+					r.run()
+				);
+			}
 			else
 			{
 				TimeSlotRoutePlanner r(
@@ -255,6 +329,18 @@ namespace synthese
 
 
 
+		void PTTimeSlotRoutePlanner::_ExtendToPhysicalStops(
+			const VAMConverter& converter,
+			const VertexAccessMap& vam,
+			const VertexAccessMap& destinationVam,
+			PlanningPhase direction,
+			VertexAccessMap& result
+		){
+			result = converter.run(vam, destinationVam, direction);
+		}
+
+
+
 		void PTTimeSlotRoutePlanner::_extendByFreeDRT(
 			VertexAccessMap& vam,
 			const VertexAccessMap& destinationVam,
@@ -36,6 +36,7 @@ namespace synthese
 	namespace algorithm
 	{
 		class AlgorithmLogger;
+		class VAMConverter;
 	}
 
 	namespace geography
@@ -82,10 +83,43 @@ namespace synthese
 		class PTTimeSlotRoutePlanner:
 			public algorithm::TimeSlotRoutePlanner
 		{
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Search engine used to compute each journey of the time slot.
+			///  - INTEGRAL_SEARCH : algorithm::RoutePlanner (default)
+			///  - RAPTOR : RaptorRoutePlanner
+			///  - RAPTOR_PROFILE : RaptorRoutePlanner, computing the whole time slot
+			///    in a single profile search
+			typedef enum
+			{
+				INTEGRAL_SEARCH = 0,
+				RAPTOR = 1,
+				RAPTOR_PROFILE = 2
+			} SearchAlgorithm;
+
 		private:
 			const geography::Place* const _departurePlace;
 			const geography::Place* const _arrivalPlace;
 			bool _showFullRoadJourney;
+			SearchAlgorithm _algorithm;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Search of the stops reachable from the departure or the arrival
+			/// place using the road network.
+			/// @param converter the search parameters
+			/// @param vam the points to start the search from
+			/// @param destinationVam the points to reach if possible
+			/// @param direction the search is for departure or arrival places
+			/// @param result the reachable stops (written at the end of the search)
+			static void _ExtendToPhysicalStops(
+				const algorithm::VAMConverter& converter,
+				const graph::VertexAccessMap& vam,
+				const graph::VertexAccessMap& destinationVam,
+				algorithm::PlanningPhase direction,
+				graph::VertexAccessMap& result
+			);
 
 
 
@@ -123,7 +157,8 @@ namespace synthese
 				boost::optional<boost::posix_time::time_duration> maxTransferDuration = boost::optional<boost::posix_time::time_duration>(),
 				boost::optional<double> minMaxDurationRatioFilter = boost::optional<double>(),
 				bool enableTheoretical = true,
-				bool enableRealTime = true
+				bool enableRealTime = true,
+				SearchAlgorithm algorithm = INTEGRAL_SEARCH
 			);
 
 			PTRoutePlannerResult run() const;
@@ -0,0 +1,1155 @@
+/** RaptorRoutePlanner class implementation.
+	@file RaptorRoutePlanner.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "RaptorRoutePlanner.hpp"
+
+#include "Edge.h"
+#include "JourneyPattern.hpp"
+#include "Path.h"
+#include "ScheduledService.h"
+#include "Service.h"
+#include "UseRule.h"
+#include "Vertex.h"
+#include "VertexAccessMap.h"
+
+#include <algorithm>
+#include <set>
+#include <boost/foreach.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace synthese
+{
+	using namespace algorithm;
+	using namespace graph;
+	using namespace util;
+
+	namespace pt_journey_planner
+	{
+		const size_t RaptorRoutePlanner::DEFAULT_MAX_ROUNDS(10);
+
+
+
+		RaptorRoutePlanner::RaptorRoutePlanner(
+			RaptorTimetable& timetable,
+			const VertexAccessMap& originVam,
+			const VertexAccessMap& destinationVam,
+			PlanningOrder planningOrder,
+			optional<time_duration> maxDuration,
+			const ptime& minBeginTime,
+			const ptime& maxBeginTime,
+			const ptime& maxEndTime,
+			bool ignoreReservation,
+			optional<time_duration> maxTransferDuration
+		):	_timetable(timetable),
+			_originVam(originVam),
+			_destinationVam(destinationVam),
+			_planningOrder(planningOrder),
+			_maxDuration(maxDuration),
+			_minBeginTime(minBeginTime),
+			_maxBeginTime(maxBeginTime),
+			_maxEndTime(maxEndTime),
+			_ignoreReservation(ignoreReservation),
+			_maxTransferDuration(maxTransferDuration),
+			_forward(true),
+			_startBound(0),
+			_continuousServicesMet(false),
+			_bestGoal(RaptorTimetable::UNREACHED),
+			_bestGoalRound(RaptorTimetable::NO_STOP),
+			_bestGoalStop(RaptorTimetable::NO_STOP)
+		{}
+
+
+
+		Journey RaptorRoutePlanner::run()
+		{
+			bool departureFirst(_planningOrder == DEPARTURE_FIRST);
+
+			// Look for best time
+			Journey result(
+				_search(
+					departureFirst,
+					departureFirst ? _originVam : _destinationVam,
+					departureFirst ? _destinationVam : _originVam,
+					_minBeginTime,
+					_maxBeginTime,
+					_maxEndTime
+			)	);
+			if(result.empty())
+			{
+				return result;
+			}
+
+			ptime departureTime(
+				result.getFirstDepartureTime() -
+				_originVam.getVertexAccess(result.getOrigin()->getFromVertex()).approachTime
+			);
+			ptime arrivalTime(
+				result.getFirstArrivalTime() +
+				_destinationVam.getVertexAccess(result.getDestination()->getFromVertex()).approachTime
+			);
+
+			// Look for best duration
+			Journey result2(
+				departureFirst ?
+				_search(false, _destinationVam, _originVam, arrivalTime, arrivalTime, departureTime) :
+				_search(true, _originVam, _destinationVam, departureTime, departureTime, arrivalTime)
+			);
+			if(result2.empty())
+			{
+				result2 = result;
+			}
+
+			return _finalizeJourney(result2);
+		}
+
+
+
+		bool RaptorRoutePlanner::runProfile(
+			Journeys& result
+		){
+			result.clear();
+			if(_maxTransferDuration)
+			{
+				return false;
+			}
+
+			bool departureFirst(_planningOrder == DEPARTURE_FIRST);
+			const VertexAccessMap& startVam(departureFirst ? _originVam : _destinationVam);
+			const VertexAccessMap& goalVam(departureFirst ? _destinationVam : _originVam);
+
+			_initSearch(departureFirst, startVam, goalVam);
+			Time firstStart(_toTime(_minBeginTime));
+			Time goalLimit(_toTime(_maxEndTime));
+			_startBound = _toTime(_maxBeginTime);
+			if(_startBound < firstStart || goalLimit < firstStart)
+			{
+				return true;
+			}
+			_bestGoal = goalLimit + 1;
+
+			// Offsets between the start place and the stops reached by round 0
+			vector<size_t> markedStops;
+			_startRound(firstStart, markedStops);
+			if(_bestGoalStop != RaptorTimetable::NO_STOP)
+			{
+				// The goal is reached by junctions only
+				return false;
+			}
+			set<Time> startTimes;
+			if(!_getStartTimes(firstStart, startTimes))
+			{
+				return false;
+			}
+
+			// Scan of the start times from the last one, keeping the labels
+			_initSearch(departureFirst, startVam, goalVam);
+			_startBound = _toTime(_maxBeginTime);
+			_bestGoal = goalLimit + 1;
+			for(set<Time>::const_reverse_iterator it(startTimes.rbegin()); it != startTimes.rend(); ++it)
+			{
+				this_thread::interruption_point();
+
+				Time previousGoal(_bestGoal);
+				markedStops.clear();
+				_startRound(*it, markedStops);
+				_runRounds(markedStops);
+				if(_continuousServicesMet)
+				{
+					result.clear();
+					return false;
+				}
+
+				if(	_bestGoal < previousGoal &&
+					_bestGoalStop != RaptorTimetable::NO_STOP
+				){
+					Journey journey(_finalizeJourney(_buildJourney()));
+					if(!journey.empty())
+					{
+						result.push_back(journey);
+					}
+				}
+			}
+
+			// The start times were scanned in the reverse planning order
+			reverse(result.begin(), result.end());
+			return true;
+		}
+
+
+
+		void RaptorRoutePlanner::runAllStopsProfile(
+			StopArrivals& result
+		){
+			result.clear();
+
+			bool departureFirst(_planningOrder == DEPARTURE_FIRST);
+			const VertexAccessMap& startVam(departureFirst ? _originVam : _destinationVam);
+			VertexAccessMap noGoal;
+
+			_initSearch(departureFirst, startVam, noGoal);
+			Time firstStart(_toTime(_minBeginTime));
+			Time limit(_toTime(_maxEndTime));
+			_startBound = _toTime(_maxBeginTime);
+			if(_startBound < firstStart || limit < firstStart)
+			{
+				return;
+			}
+			_bestGoal = limit + 1;
+
+			// Start times : the services leaving the start stops, or every minute
+			// of the time slot if continuous services leave them
+			vector<size_t> markedStops;
+			_startRound(firstStart, markedStops);
+			set<Time> startTimes;
+			if(!_getStartTimes(firstStart, startTimes))
+			{
+				startTimes.clear();
+				for(Time startTime(firstStart); startTime <= _startBound; startTime += 60)
+				{
+					startTimes.insert(startTime);
+				}
+			}
+
+			// Scan of the start times from the last one. The labels of the later
+			// start times are kept unless the transfers duration is bounded : the
+			// bound depends on the arrival time at each stop, so the labels are
+			// then reset at each start time.
+			vector<Time> recordedArrivals;
+			for(set<Time>::const_reverse_iterator it(startTimes.rbegin()); it != startTimes.rend(); ++it)
+			{
+				this_thread::interruption_point();
+
+				if(it == startTimes.rbegin() || _maxTransferDuration)
+				{
+					_initSearch(departureFirst, startVam, noGoal);
+					_startBound = _toTime(_maxBeginTime);
+					_bestGoal = limit + 1;
+				}
+				_improvedStops.clear();
+				markedStops.clear();
+				_startRound(*it, markedStops);
+				_runRounds(markedStops);
+
+				// A stop is written only if the start time improves its best time
+				recordedArrivals.resize(_bestArrivals.size(), RaptorTimetable::UNREACHED);
+				BOOST_FOREACH(size_t stop, _improvedStops)
+				{
+					if(_bestArrivals[stop] >= recordedArrivals[stop])
+					{
+						continue;
+					}
+					recordedArrivals[stop] = _bestArrivals[stop];
+
+					StopArrival stopArrival;
+					stopArrival.stopPoint = _timetable.getStop(stop).stopPoint;
+					stopArrival.startTime = _toPtime(*it);
+					stopArrival.arrivalTime = _toPtime(_bestArrivals[stop]);
+					result.push_back(stopArrival);
+				}
+			}
+		}
+
+
+
+		bool RaptorRoutePlanner::_getStartTimes(
+			Time firstStart,
+			set<Time>& result
+		){
+			vector<pair<size_t, Time> > offsets;
+			for(size_t stop(0); stop < _rounds[0].readyTimes.size(); ++stop)
+			{
+				if(_rounds[0].readyTimes[stop] != RaptorTimetable::UNREACHED)
+				{
+					offsets.push_back(make_pair(stop, _rounds[0].readyTimes[stop] - firstStart));
+				}
+			}
+
+			// Start times : the services leaving these stops inside the time slot
+			for(vector<pair<size_t, Time> >::const_iterator it(offsets.begin()); it != offsets.end(); ++it)
+			{
+				const RaptorTimetable::Stop& timetableStop(_timetable.getStop(it->first));
+				const RaptorTimetable::PatternStops& patterns(
+					_forward ? timetableStop.departurePatterns : timetableStop.arrivalPatterns
+				);
+				BOOST_FOREACH(const RaptorTimetable::PatternStop& patternStop, patterns)
+				{
+					const RaptorTimetable::Pattern& pattern(_timetable.getPattern(patternStop.pattern));
+					if(!pattern.usable || !pattern.ranksNumber)
+					{
+						continue;
+					}
+					if(!pattern.otherServices.empty())
+					{
+						return false;
+					}
+					if(!(_forward ? pattern.departureAllowed[patternStop.rank] : pattern.arrivalAllowed[patternStop.rank]))
+					{
+						continue;
+					}
+					for(size_t row(0); row < pattern.rowsNumber; ++row)
+					{
+						Time time(
+							_forward ?
+							pattern.departures[row * pattern.ranksNumber + patternStop.rank] :
+							-pattern.arrivals[row * pattern.ranksNumber + patternStop.rank]
+						);
+						Time startTime(time - it->second);
+						if(startTime >= firstStart && startTime <= _startBound)
+						{
+							result.insert(startTime);
+						}
+					}
+				}
+			}
+
+			return true;
+		}
+
+
+
+		Journey RaptorRoutePlanner::_finalizeJourney(
+			const Journey& journey
+		) const {
+			const VertexAccess& originAccess(_originVam.getVertexAccess(journey.getOrigin()->getFromVertex()));
+			const VertexAccess& destinationAccess(_destinationVam.getVertexAccess(journey.getDestination()->getFromVertex()));
+
+			// Duration filter
+			if(	_maxDuration &&
+				journey.getDuration() + originAccess.approachTime + destinationAccess.approachTime > *_maxDuration
+			){
+				return Journey();
+			}
+
+			// Inclusion of approach journeys in the result
+			Journey finalResult;
+			if(originAccess.approachTime.total_seconds())
+			{
+				Journey originApproachJourney(originAccess.approachJourney);
+				if(!originApproachJourney.empty())
+				{
+					originApproachJourney.shift(
+						journey.getFirstDepartureTime() - originAccess.approachTime - originApproachJourney.getFirstDepartureTime()
+					);
+					originApproachJourney.forceContinuousServiceRange(journey.getContinuousServiceRange());
+					finalResult.append(originApproachJourney);
+				}
+			}
+
+			finalResult.append(journey);
+
+			if(destinationAccess.approachTime.total_seconds())
+			{
+				Journey goalApproachJourney(destinationAccess.approachJourney);
+				if(!goalApproachJourney.empty())
+				{
+					goalApproachJourney.shift(
+						journey.getFirstArrivalTime() + destinationAccess.approachTime - goalApproachJourney.getFirstArrivalTime()
+					);
+					goalApproachJourney.forceContinuousServiceRange(journey.getContinuousServiceRange());
+					finalResult.append(goalApproachJourney);
+				}
+			}
+
+			return finalResult;
+		}
+
+
+
+		RaptorRoutePlanner::Time RaptorRoutePlanner::_toTime(
+			const ptime& value
+		) const {
+			Time result(_timetable.toTime(value));
+			return _forward ? result : -result;
+		}
+
+
+
+		ptime RaptorRoutePlanner::_toPtime(
+			Time value
+		) const {
+			return _timetable.toPtime(_forward ? value : -value);
+		}
+
+
+
+		ptime RaptorRoutePlanner::_getTime(
+			const ServicePointer& servicePointer,
+			bool boarding
+		) const {
+			return (_forward == boarding) ?
+				servicePointer.getDepartureDateTime() :
+				servicePointer.getArrivalDateTime()
+			;
+		}
+
+
+
+		void RaptorRoutePlanner::_resize()
+		{
+			size_t stopsNumber(_timetable.getStopsNumber());
+			if(_bestArrivals.size() >= stopsNumber)
+			{
+				return;
+			}
+
+			_bestArrivals.resize(stopsNumber, RaptorTimetable::UNREACHED);
+			_bestReadies.resize(stopsNumber, RaptorTimetable::UNREACHED);
+			_startApproaches.resize(stopsNumber, RaptorTimetable::UNREACHED);
+			_goalApproaches.resize(stopsNumber, RaptorTimetable::UNREACHED);
+			_flags.resize(stopsNumber, false);
+			BOOST_FOREACH(Round& round, _rounds)
+			{
+				round.arrivalTimes.resize(stopsNumber, RaptorTimetable::UNREACHED);
+				round.arrivalLegs.resize(stopsNumber, RaptorTimetable::NO_STOP);
+				round.readyTimes.resize(stopsNumber, RaptorTimetable::UNREACHED);
+				round.readyFromStops.resize(stopsNumber, RaptorTimetable::NO_STOP);
+				round.readyFromRounds.resize(stopsNumber, 0);
+			}
+		}
+
+
+
+		void RaptorRoutePlanner::_newRound()
+		{
+			size_t stopsNumber(_bestArrivals.size());
+			Round round;
+			round.arrivalTimes.resize(stopsNumber, RaptorTimetable::UNREACHED);
+			round.arrivalLegs.resize(stopsNumber, RaptorTimetable::NO_STOP);
+
+			// The ready times of the previous round remain valid
+			if(_rounds.empty())
+			{
+				round.readyTimes.resize(stopsNumber, RaptorTimetable::UNREACHED);
+				round.readyFromStops.resize(stopsNumber, RaptorTimetable::NO_STOP);
+				round.readyFromRounds.resize(stopsNumber, 0);
+			}
+			else
+			{
+				round.readyTimes = _rounds.back().readyTimes;
+				round.readyFromStops = _rounds.back().readyFromStops;
+				round.readyFromRounds = _rounds.back().readyFromRounds;
+			}
+			_rounds.push_back(round);
+		}
+
+
+
+		void RaptorRoutePlanner::_openRound(
+			size_t round,
+			const vector<size_t>& markedStops
+		){
+			if(round == _rounds.size())
+			{
+				_newRound();
+				return;
+			}
+
+			// Round kept from a previous start time : only the ready times improved
+			// by the previous round are carried over
+			const Round& previousRound(_rounds[round - 1]);
+			Round& currentRound(_rounds[round]);
+			BOOST_FOREACH(size_t stop, markedStops)
+			{
+				if(previousRound.readyTimes[stop] < currentRound.readyTimes[stop])
+				{
+					currentRound.readyTimes[stop] = previousRound.readyTimes[stop];
+					currentRound.readyFromStops[stop] = previousRound.readyFromStops[stop];
+					currentRound.readyFromRounds[stop] = previousRound.readyFromRounds[stop];
+				}
+			}
+		}
+
+
+
+		bool RaptorRoutePlanner::_improveArrival(
+			size_t round,
+			size_t stop,
+			Time time,
+			const Leg& leg
+		){
+			if(	time >= _bestArrivals[stop] ||
+				time >= _bestGoal
+			){
+				return false;
+			}
+
+			_bestArrivals[stop] = time;
+			_improvedStops.push_back(stop);
+			Round& currentRound(_rounds[round]);
+			currentRound.arrivalTimes[stop] = time;
+			currentRound.arrivalLegs[stop] = _legs.size();
+			_legs.push_back(leg);
+
+			// Goal check
+			if(_goalApproaches[stop] != RaptorTimetable::UNREACHED)
+			{
+				Time goalTime(time + _goalApproaches[stop]);
+				if(goalTime < _bestGoal)
+				{
+					_bestGoal = goalTime;
+					_bestGoalRound = round;
+					_bestGoalStop = stop;
+				}
+			}
+
+			return true;
+		}
+
+
+
+		bool RaptorRoutePlanner::_findBoarding(
+			const RaptorTimetable::Pattern& pattern,
+			size_t rank,
+			Time readyTime,
+			Time limit,
+			ServicePointer& boarding,
+			size_t& row
+		) const {
+			const AccessParameters& accessParameters(_timetable.getAccessParameters());
+			const Edge& edge(*pattern.edges[rank]);
+			const size_t ranksNumber(pattern.ranksNumber);
+			const size_t rowsNumber(pattern.rowsNumber);
+			bool found(false);
+			Time bestTime(limit);
+
+			// Scheduled services : binary search in the rows sorted at the rank,
+			// then validation of the candidates by the service itself
+			if(rowsNumber)
+			{
+				const vector<RaptorTimetable::Time>& times(_forward ? pattern.departures : pattern.arrivals);
+				const vector<size_t>& order(_forward ? pattern.departureOrder : pattern.arrivalOrder);
+				const size_t offset(rank * rowsNumber);
+				Time absoluteReadyTime(_forward ? readyTime : -readyTime);
+
+				size_t low(0);
+				size_t high(rowsNumber);
+				while(low < high)
+				{
+					size_t middle((low + high) / 2);
+					Time value(times[order[offset + middle] * ranksNumber + rank]);
+					if(_forward ? value < absoluteReadyTime : value <= absoluteReadyTime)
+					{
+						low = middle + 1;
+					}
+					else
+					{
+						high = middle;
+					}
+				}
+
+				for(size_t i(0); i < rowsNumber; ++i)
+				{
+					// Forward : increasing departures from low, backward : decreasing arrivals from low-1
+					if(_forward ? low + i >= rowsNumber : i >= low)
+					{
+						break;
+					}
+					size_t candidateRow(order[offset + (_forward ? low + i : low - 1 - i)]);
+					Time time(times[candidateRow * ranksNumber + rank]);
+					if(!_forward)
+					{
+						time = -time;
+					}
+					if(time > bestTime)
+					{
+						break;
+					}
+
+					ServicePointer servicePointer(
+						pattern.rowServices[candidateRow]->getFromPresenceTime(
+							accessParameters,
+							_timetable.getTHData(),
+							_timetable.getRTData(),
+							_forward,
+							edge,
+							_toPtime(time),
+							true,
+							false,
+							_ignoreReservation,
+							false,
+							_timetable.getTimeContext()
+					)	);
+					if(	!servicePointer.getService() ||
+						_getTime(servicePointer, true) != _toPtime(time)
+					){
+						continue;
+					}
+
+					boarding = servicePointer;
+					row = candidateRow;
+					bestTime = time;
+					found = true;
+					break;
+				}
+			}
+
+			// Other services are read directly
+			BOOST_FOREACH(const Service* service, pattern.otherServices)
+			{
+				ServicePointer servicePointer(
+					service->getFromPresenceTime(
+						accessParameters,
+						_timetable.getTHData(),
+						_timetable.getRTData(),
+						_forward,
+						edge,
+						_toPtime(readyTime),
+						true,
+						false,
+						_ignoreReservation,
+						false,
+						_timetable.getTimeContext()
+				)	);
+				if(!servicePointer.getService())
+				{
+					continue;
+				}
+				Time time(_toTime(_getTime(servicePointer, true)));
+				if(	time < readyTime ||
+					(found ? time >= bestTime : time > bestTime)
+				){
+					continue;
+				}
+
+				boarding = servicePointer;
+				row = RaptorTimetable::NO_STOP;
+				bestTime = time;
+				found = true;
+			}
+
+			return found;
+		}
+
+
+
+		void RaptorRoutePlanner::_scanPattern(
+			size_t round,
+			size_t patternIndex,
+			size_t firstRank,
+			vector<size_t>& arrivedStops
+		){
+			const RaptorTimetable::Pattern& pattern(_timetable.getPattern(patternIndex));
+			_resize();
+			if(!pattern.usable || !pattern.ranksNumber)
+			{
+				return;
+			}
+			if(!pattern.otherServices.empty())
+			{
+				_continuousServicesMet = true;
+			}
+
+			const AccessParameters& accessParameters(_timetable.getAccessParameters());
+			const size_t ranksNumber(pattern.ranksNumber);
+			const Round& previousRound(_rounds[round - 1]);
+
+			bool boarded(false);
+			ServicePointer boarding;
+			size_t boardingRow(RaptorTimetable::NO_STOP);
+			size_t boardingStop(RaptorTimetable::NO_STOP);
+
+			for(size_t i(0); _forward ? firstRank + i < ranksNumber : i <= firstRank; ++i)
+			{
+				size_t rank(_forward ? firstRank + i : firstRank - i);
+				size_t stop(pattern.stops[rank]);
+				if(	stop == RaptorTimetable::NO_STOP ||
+					!_timetable.isUsableStop(stop)
+				){
+					continue;
+				}
+				const Edge& edge(*pattern.edges[rank]);
+
+				// Alighting
+				if(	boarded &&
+					(_forward ? pattern.arrivalAllowed[rank] : pattern.departureAllowed[rank])
+				){
+					bool useful(true);
+					if(boardingRow != RaptorTimetable::NO_STOP)
+					{
+						Time tableTime(
+							_forward ?
+							pattern.arrivals[boardingRow * ranksNumber + rank] :
+							-pattern.departures[boardingRow * ranksNumber + rank]
+						);
+						useful = tableTime < _bestArrivals[stop] && tableTime < _bestGoal;
+					}
+					if(useful)
+					{
+						ServicePointer serviceUse(boarding, edge, accessParameters);
+						Time time(_toTime(_getTime(serviceUse, false)));
+						if(	time < _bestArrivals[stop] &&
+							time < _bestGoal &&
+							serviceUse.isUseRuleCompliant(_ignoreReservation) != UseRule::RUN_NOT_POSSIBLE
+						){
+							Leg leg;
+							leg.boarding = boarding;
+							leg.alightingEdge = &edge;
+							leg.boardingStop = boardingStop;
+							leg.previousRound = round - 1;
+							leg.previousIsArrival = false;
+							if(_improveArrival(round, stop, time, leg))
+							{
+								arrivedStops.push_back(stop);
+							}
+						}
+					}
+				}
+
+				// Boarding
+				Time readyTime(previousRound.readyTimes[stop]);
+				if(	readyTime == RaptorTimetable::UNREACHED ||
+					!(_forward ? pattern.departureAllowed[rank] : pattern.arrivalAllowed[rank])
+				){
+					continue;
+				}
+
+				// A new service is boarded only if it leaves before the current one
+				Time limit(_bestGoal == RaptorTimetable::UNREACHED ? _bestGoal : _bestGoal - 1);
+				if(boarded)
+				{
+					Time currentTime(
+						boardingRow != RaptorTimetable::NO_STOP ?
+						(	_forward ?
+							pattern.departures[boardingRow * ranksNumber + rank] :
+							-pattern.arrivals[boardingRow * ranksNumber + rank]
+						):
+						_toTime(_getTime(ServicePointer(boarding, edge, accessParameters), false))
+					);
+					limit = min(limit, currentTime - 1);
+				}
+
+				size_t fromStop(previousRound.readyFromStops[stop]);
+				if(fromStop == RaptorTimetable::NO_STOP)
+				{
+					// The start place can not be left after the start bound
+					limit = min(limit, _startBound + _startApproaches[stop]);
+				}
+				else if(_maxTransferDuration)
+				{
+					Time arrivalTime(_rounds[previousRound.readyFromRounds[stop]].arrivalTimes[fromStop]);
+					limit = min(limit, arrivalTime + static_cast<Time>(_maxTransferDuration->total_seconds()));
+				}
+				if(limit < readyTime)
+				{
+					continue;
+				}
+
+				ServicePointer candidate;
+				size_t candidateRow(RaptorTimetable::NO_STOP);
+				if(_findBoarding(pattern, rank, readyTime, limit, candidate, candidateRow))
+				{
+					boarded = true;
+					boarding = candidate;
+					boardingRow = candidateRow;
+					boardingStop = stop;
+				}
+			}
+		}
+
+
+
+		void RaptorRoutePlanner::_relaxJunctions(
+			size_t round,
+			const vector<size_t>& stops,
+			bool fromArrivals,
+			vector<size_t>& arrivedStops
+		){
+			const AccessParameters& accessParameters(_timetable.getAccessParameters());
+
+			// A junction can not follow another junction : the labels of the
+			// source stops must not be replaced during the loop
+			BOOST_FOREACH(size_t stop, stops)
+			{
+				_flags[stop] = true;
+			}
+
+			BOOST_FOREACH(size_t stop, stops)
+			{
+				Time time(
+					fromArrivals ?
+					_rounds[round].arrivalTimes[stop] :
+					_rounds[round].readyTimes[stop]
+				);
+				if(time == RaptorTimetable::UNREACHED)
+				{
+					continue;
+				}
+
+				const RaptorTimetable::Stop& timetableStop(_timetable.getStop(stop));
+				_resize();
+				const RaptorTimetable::Junctions& junctions(
+					_forward ? timetableStop.departureJunctions : timetableStop.arrivalJunctions
+				);
+				BOOST_FOREACH(const Edge* edge, junctions)
+				{
+					const Edge* otherEdge(
+						_forward ?
+						edge->getFollowingArrivalForFineSteppingOnly() :
+						edge->getPreviousDepartureForFineSteppingOnly()
+					);
+					size_t otherStop(_timetable.getStopIndex(*otherEdge->getFromVertex()));
+					_resize();
+					if(	otherStop == RaptorTimetable::NO_STOP ||
+						_flags[otherStop] ||
+						!_timetable.isUsableStop(otherStop)
+					){
+						continue;
+					}
+
+					const Path& path(*edge->getParentPath());
+					ServicePointer servicePointer;
+					{
+						boost::shared_lock<shared_recursive_mutex> sharedServicesLock(
+							*path.sharedServicesMutex
+						);
+						BOOST_FOREACH(const Service* service, path.getServices())
+						{
+							servicePointer = service->getFromPresenceTime(
+								accessParameters,
+								_timetable.getTHData(),
+								_timetable.getRTData(),
+								_forward,
+								*edge,
+								_toPtime(time),
+								true,
+								false,
+								_ignoreReservation,
+								false,
+								_timetable.getTimeContext()
+							);
+							if(servicePointer.getService())
+							{
+								break;
+							}
+						}
+					}
+					if(!servicePointer.getService())
+					{
+						continue;
+					}
+
+					ServicePointer serviceUse(servicePointer, *otherEdge, accessParameters);
+					if(serviceUse.isUseRuleCompliant(_ignoreReservation) == UseRule::RUN_NOT_POSSIBLE)
+					{
+						continue;
+					}
+
+					Leg leg;
+					leg.boarding = servicePointer;
+					leg.alightingEdge = otherEdge;
+					leg.boardingStop = stop;
+					leg.previousRound = round;
+					leg.previousIsArrival = fromArrivals;
+					if(_improveArrival(round, otherStop, _toTime(_getTime(serviceUse, false)), leg))
+					{
+						arrivedStops.push_back(otherStop);
+					}
+				}
+			}
+
+			BOOST_FOREACH(size_t stop, stops)
+			{
+				_flags[stop] = false;
+			}
+		}
+
+
+
+		void RaptorRoutePlanner::_relaxTransfers(
+			size_t round,
+			const vector<size_t>& arrivedStops,
+			vector<size_t>& markedStops
+		){
+			BOOST_FOREACH(size_t stop, arrivedStops)
+			{
+				const RaptorTimetable::Stop& timetableStop(_timetable.getStopWithTransfers(stop));
+				_resize();
+
+				Round& currentRound(_rounds[round]);
+				Time arrivalTime(currentRound.arrivalTimes[stop]);
+				const RaptorTimetable::Transfers& transfers(
+					_forward ? timetableStop.outgoingTransfers : timetableStop.incomingTransfers
+				);
+				BOOST_FOREACH(const RaptorTimetable::Transfer& transfer, transfers)
+				{
+					Time time(arrivalTime + transfer.duration);
+					if(	time >= _bestReadies[transfer.stop] ||
+						time >= _bestGoal
+					){
+						continue;
+					}
+
+					_bestReadies[transfer.stop] = time;
+					currentRound.readyTimes[transfer.stop] = time;
+					currentRound.readyFromStops[transfer.stop] = stop;
+					currentRound.readyFromRounds[transfer.stop] = round;
+					if(!_flags[transfer.stop])
+					{
+						_flags[transfer.stop] = true;
+						markedStops.push_back(transfer.stop);
+					}
+				}
+			}
+
+			BOOST_FOREACH(size_t stop, markedStops)
+			{
+				_flags[stop] = false;
+			}
+		}
+
+
+
+		Journey RaptorRoutePlanner::_buildJourney() const
+		{
+			// Walk back from the goal to the start
+			vector<const Leg*> legs;
+			size_t round(_bestGoalRound);
+			size_t stop(_bestGoalStop);
+			while(legs.size() <= _legs.size())
+			{
+				const Leg& leg(_legs[_rounds[round].arrivalLegs[stop]]);
+				legs.push_back(&leg);
+
+				if(leg.previousIsArrival)
+				{
+					round = leg.previousRound;
+					stop = leg.boardingStop;
+					continue;
+				}
+
+				const Round& previousRound(_rounds[leg.previousRound]);
+				size_t fromStop(previousRound.readyFromStops[leg.boardingStop]);
+				if(fromStop == RaptorTimetable::NO_STOP)
+				{
+					break;
+				}
+				round = previousRound.readyFromRounds[leg.boardingStop];
+				stop = fromStop;
+			}
+
+			// The legs are written in the chronological order
+			const AccessParameters& accessParameters(_timetable.getAccessParameters());
+			Journey result;
+			if(_forward)
+			{
+				for(vector<const Leg*>::const_reverse_iterator it(legs.rbegin()); it != legs.rend(); ++it)
+				{
+					result.append(ServicePointer((*it)->boarding, *(*it)->alightingEdge, accessParameters));
+				}
+			}
+			else
+			{
+				BOOST_FOREACH(const Leg* leg, legs)
+				{
+					result.append(ServicePointer(leg->boarding, *leg->alightingEdge, accessParameters));
+				}
+			}
+			return result;
+		}
+
+
+
+		void RaptorRoutePlanner::_initSearch(
+			bool forward,
+			const VertexAccessMap& startVam,
+			const VertexAccessMap& goalVam
+		){
+			_forward = forward;
+			_rounds.clear();
+			_legs.clear();
+			_bestArrivals.clear();
+			_improvedStops.clear();
+			_bestReadies.clear();
+			_startApproaches.clear();
+			_startStops.clear();
+			_goalApproaches.clear();
+			_flags.clear();
+			_bestGoal = RaptorTimetable::UNREACHED;
+			_bestGoalRound = RaptorTimetable::NO_STOP;
+			_bestGoalStop = RaptorTimetable::NO_STOP;
+			_continuousServicesMet = false;
+
+			// Start stops
+			BOOST_FOREACH(const VertexAccessMap::VamMap::value_type& it, startVam.getMap())
+			{
+				size_t stop(_timetable.getStopIndex(*it.first));
+				if(	stop == RaptorTimetable::NO_STOP ||
+					!_timetable.isUsableStop(stop)
+				){
+					continue;
+				}
+				_resize();
+				Time approachTime(static_cast<Time>(it.second.approachTime.total_seconds()));
+				if(_startApproaches[stop] == RaptorTimetable::UNREACHED)
+				{
+					_startStops.push_back(stop);
+				}
+				if(approachTime < _startApproaches[stop])
+				{
+					_startApproaches[stop] = approachTime;
+				}
+			}
+
+			// Goal stops
+			BOOST_FOREACH(const VertexAccessMap::VamMap::value_type& it, goalVam.getMap())
+			{
+				size_t stop(_timetable.getStopIndex(*it.first));
+				if(stop == RaptorTimetable::NO_STOP)
+				{
+					continue;
+				}
+				_resize();
+				Time approachTime(static_cast<Time>(it.second.approachTime.total_seconds()));
+				if(approachTime < _goalApproaches[stop])
+				{
+					_goalApproaches[stop] = approachTime;
+				}
+			}
+			_resize();
+		}
+
+
+
+		void RaptorRoutePlanner::_startRound(
+			Time start,
+			vector<size_t>& markedStops
+		){
+			if(_rounds.empty())
+			{
+				_newRound();
+			}
+
+			BOOST_FOREACH(size_t stop, _startStops)
+			{
+				Time time(start + _startApproaches[stop]);
+				if(time >= _bestReadies[stop])
+				{
+					continue;
+				}
+				Round& firstRound(_rounds[0]);
+				firstRound.readyTimes[stop] = time;
+				firstRound.readyFromStops[stop] = RaptorTimetable::NO_STOP;
+				_bestReadies[stop] = time;
+				markedStops.push_back(stop);
+			}
+
+			vector<size_t> arrivedStops;
+			_relaxJunctions(0, markedStops, false, arrivedStops);
+			_relaxTransfers(0, arrivedStops, markedStops);
+		}
+
+
+
+		void RaptorRoutePlanner::_runRounds(
+			vector<size_t>& markedStops
+		){
+			const optional<size_t>& maxTransportConnections(
+				_timetable.getAccessParameters().getMaxtransportConnectionsCount()
+			);
+			size_t maxRounds(maxTransportConnections ? *maxTransportConnections + 1 : DEFAULT_MAX_ROUNDS);
+			vector<size_t> patternFirstRanks;
+			vector<size_t> queuedPatterns;
+			for(size_t round(1); round <= maxRounds && !markedStops.empty(); ++round)
+			{
+				this_thread::interruption_point();
+
+				_openRound(round, markedStops);
+
+				// Patterns serving the stops marked by the previous round
+				queuedPatterns.clear();
+				BOOST_FOREACH(size_t stop, markedStops)
+				{
+					const RaptorTimetable::Stop& timetableStop(_timetable.getStop(stop));
+					patternFirstRanks.resize(_timetable.getPatternsNumber(), RaptorTimetable::NO_STOP);
+					const RaptorTimetable::PatternStops& patterns(
+						_forward ? timetableStop.departurePatterns : timetableStop.arrivalPatterns
+					);
+					BOOST_FOREACH(const RaptorTimetable::PatternStop& patternStop, patterns)
+					{
+						size_t& firstRank(patternFirstRanks[patternStop.pattern]);
+						if(firstRank == RaptorTimetable::NO_STOP)
+						{
+							queuedPatterns.push_back(patternStop.pattern);
+							firstRank = patternStop.rank;
+						}
+						else if(_forward ? patternStop.rank < firstRank : patternStop.rank > firstRank)
+						{
+							firstRank = patternStop.rank;
+						}
+					}
+				}
+				_resize();
+
+				// Patterns scan
+				vector<size_t> arrivedStops;
+				BOOST_FOREACH(size_t pattern, queuedPatterns)
+				{
+					this_thread::interruption_point();
+					_scanPattern(round, pattern, patternFirstRanks[pattern], arrivedStops);
+					patternFirstRanks[pattern] = RaptorTimetable::NO_STOP;
+				}
+
+				// Junctions and transfers
+				vector<size_t> junctionStops;
+				_relaxJunctions(round, arrivedStops, true, junctionStops);
+				arrivedStops.insert(arrivedStops.end(), junctionStops.begin(), junctionStops.end());
+				markedStops.clear();
+				_relaxTransfers(round, arrivedStops, markedStops);
+			}
+		}
+
+
+
+		Journey RaptorRoutePlanner::_search(
+			bool forward,
+			const VertexAccessMap& startVam,
+			const VertexAccessMap& goalVam,
+			const ptime& startTime,
+			const ptime& startBound,
+			const ptime& goalBound
+		){
+			_initSearch(forward, startVam, goalVam);
+
+			Time start(_toTime(startTime));
+			Time goalLimit(_toTime(goalBound));
+			_startBound = _toTime(startBound);
+			if(_startBound < start || goalLimit < start)
+			{
+				return Journey();
+			}
+			_bestGoal = goalLimit + 1;
+
+			vector<size_t> markedStops;
+			_startRound(start, markedStops);
+			_runRounds(markedStops);
+
+			if(_bestGoalStop == RaptorTimetable::NO_STOP)
+			{
+				return Journey();
+			}
+			return _buildJourney();
+		}
+}	}
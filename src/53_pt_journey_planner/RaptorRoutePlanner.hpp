@@ -0,0 +1,348 @@
+/** RaptorRoutePlanner class header.
+	@file RaptorRoutePlanner.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_pt_journey_planner_RaptorRoutePlanner_hpp__
+#define SYNTHESE_pt_journey_planner_RaptorRoutePlanner_hpp__
+
+#include "RaptorTimetable.hpp"
+
+#include "AlgorithmTypes.h"
+#include "Journey.h"
+#include "ServicePointer.h"
+
+#include <set>
+#include <vector>
+#include <boost/optional.hpp>
+#include <boost/date_time/posix_time/ptime.hpp>
+
+namespace synthese
+{
+	namespace graph
+	{
+		class VertexAccessMap;
+	}
+
+	namespace pt_journey_planner
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Round based public transportation route planner.
+		///	@ingroup m53
+		//////////////////////////////////////////////////////////////////////////
+		/// This route planner is an alternative to algorithm::RoutePlanner for
+		/// the public transportation graph. It returns the same kind of result :
+		/// the journey reaching the destination as soon as possible, leaving the
+		/// origin as late as possible.
+		///
+		/// The search is made by rounds (RAPTOR algorithm) :
+		/// <ul>
+		///		<li>the round k computes the best times to reach each stop with k
+		///		services</li>
+		///		<li>each round scans the patterns serving the stops improved by the
+		///		previous round, from the first improved stop to the end of the
+		///		pattern, boarding the first usable row at each stop</li>
+		///		<li>the arrivals of the round are then extended by the junctions and
+		///		by the transfers inside each stop area, using the transfer delays
+		///		of the stop area</li>
+		///	</ul>
+		///
+		/// The same code handles the two directions : in the arrival to departure
+		/// direction, the times are negated and the patterns are read backwards.
+		///
+		/// The services found in the timetable are always validated by
+		/// Service::getFromPresenceTime and ServicePointer::isUseRuleCompliant, so
+		/// the access parameters, the use rules, the reservation rules and the
+		/// real time cancellations are handled exactly as by the integral search.
+		///
+		/// Limitations compared to algorithm::RoutePlanner :
+		/// <ul>
+		///		<li>only the stop points are considered : the journey patterns
+		///		serving areas (free DRT) are ignored</li>
+		///		<li>the maximal duration is a filter on the result</li>
+		///		<li>the maximal transfer duration is checked against the best arrival
+		///		at each stop</li>
+		///	</ul>
+		class RaptorRoutePlanner
+		{
+		public:
+			static const std::size_t DEFAULT_MAX_ROUNDS;
+
+			typedef std::vector<graph::Journey> Journeys;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Best time at a stop for a start time (one to all profile).
+			struct StopArrival
+			{
+				const pt::StopPoint* stopPoint;
+				boost::posix_time::ptime startTime;
+				boost::posix_time::ptime arrivalTime;
+			};
+			typedef std::vector<StopArrival> StopArrivals;
+
+		private:
+			typedef RaptorTimetable::Time Time;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Use of a service from a stop to another one.
+			struct Leg
+			{
+				graph::ServicePointer boarding;
+				const graph::Edge* alightingEdge;
+				std::size_t boardingStop;
+				std::size_t previousRound;
+				bool previousIsArrival;	//!< the leg follows an arrival at boardingStop (junction) instead of a transfer
+			};
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Labels of the stops at the end of a round.
+			struct Round
+			{
+				std::vector<Time> arrivalTimes;
+				std::vector<std::size_t> arrivalLegs;
+				std::vector<Time> readyTimes;
+				std::vector<std::size_t> readyFromStops;
+				std::vector<std::size_t> readyFromRounds;
+			};
+
+			//! @name Parameters
+			//@{
+				RaptorTimetable& _timetable;
+				const graph::VertexAccessMap& _originVam;
+				const graph::VertexAccessMap& _destinationVam;
+				const algorithm::PlanningOrder _planningOrder;
+				const boost::optional<boost::posix_time::time_duration> _maxDuration;
+				const boost::posix_time::ptime _minBeginTime;
+				const boost::posix_time::ptime _maxBeginTime;
+				const boost::posix_time::ptime _maxEndTime;
+				const bool _ignoreReservation;
+				const boost::optional<boost::posix_time::time_duration> _maxTransferDuration;
+			//@}
+
+			//! @name Search state
+			//@{
+				bool _forward;
+				std::vector<Round> _rounds;
+				std::vector<Leg> _legs;
+				std::vector<Time> _bestArrivals;
+				std::vector<std::size_t> _improvedStops;	//!< stops whose best arrival was improved since the last start round
+				std::vector<Time> _bestReadies;
+				std::vector<Time> _startApproaches;
+				std::vector<std::size_t> _startStops;
+				std::vector<Time> _goalApproaches;
+				std::vector<bool> _flags;
+				Time _startBound;
+				bool _continuousServicesMet;
+				Time _bestGoal;
+				std::size_t _bestGoalRound;
+				std::size_t _bestGoalStop;
+			//@}
+
+			Time _toTime(const boost::posix_time::ptime& value) const;
+			boost::posix_time::ptime _toPtime(Time value) const;
+			boost::posix_time::ptime _getTime(const graph::ServicePointer& servicePointer, bool boarding) const;
+
+			void _resize();
+			void _newRound();
+			void _openRound(
+				std::size_t round,
+				const std::vector<std::size_t>& markedStops
+			);
+
+			bool _improveArrival(
+				std::size_t round,
+				std::size_t stop,
+				Time time,
+				const Leg& leg
+			);
+
+			bool _findBoarding(
+				const RaptorTimetable::Pattern& pattern,
+				std::size_t rank,
+				Time readyTime,
+				Time limit,
+				graph::ServicePointer& boarding,
+				std::size_t& row
+			) const;
+
+			void _scanPattern(
+				std::size_t round,
+				std::size_t patternIndex,
+				std::size_t firstRank,
+				std::vector<std::size_t>& arrivedStops
+			);
+
+			void _relaxJunctions(
+				std::size_t round,
+				const std::vector<std::size_t>& stops,
+				bool fromArrivals,
+				std::vector<std::size_t>& arrivedStops
+			);
+
+			void _relaxTransfers(
+				std::size_t round,
+				const std::vector<std::size_t>& arrivedStops,
+				std::vector<std::size_t>& markedStops
+			);
+
+			graph::Journey _buildJourney() const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Start times of a profile search : the departures (or arrivals) of the
+			/// services reachable from the stops labelled by the round 0.
+			/// @param firstStart the start time used by the round 0
+			/// @param result the start times between firstStart and the start bound
+			/// @return false if continuous services are reachable from the start
+			/// stops : the start times can not be listed
+			bool _getStartTimes(
+				Time firstStart,
+				std::set<Time>& result
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Adds the approach journeys to a public transportation journey and
+			/// checks its maximal duration.
+			/// @return the complete journey, empty if it is too long
+			graph::Journey _finalizeJourney(const graph::Journey& journey) const;
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Resets the search state and registers the start and goal stops.
+			void _initSearch(
+				bool forward,
+				const graph::VertexAccessMap& startVam,
+				const graph::VertexAccessMap& goalVam
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Round 0 : labels of the start stops and of the stops reached from
+			/// them by junctions and transfers.
+			/// The labels are only improved : the labels of a previous start time
+			/// are kept if they are better.
+			/// @param start the time at the start place
+			/// @param markedStops the stops improved by the round
+			void _startRound(
+				Time start,
+				std::vector<std::size_t>& markedStops
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Rounds 1 to n.
+			/// @param markedStops the stops improved by the round 0
+			void _runRounds(std::vector<std::size_t>& markedStops);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Runs a search in one direction.
+			/// @param forward true for a departure to arrival search
+			/// @param startVam the stops to start from
+			/// @param goalVam the stops to reach
+			/// @param startTime the time at the start place
+			/// @param startBound the last (forward) or first (backward) time at which
+			/// the start place can be left
+			/// @param goalBound the last (forward) or first (backward) time at which
+			/// the goal place can be reached
+			/// @return the public transportation part of the best journey (empty if
+			/// no journey was found)
+			graph::Journey _search(
+				bool forward,
+				const graph::VertexAccessMap& startVam,
+				const graph::VertexAccessMap& goalVam,
+				const boost::posix_time::ptime& startTime,
+				const boost::posix_time::ptime& startBound,
+				const boost::posix_time::ptime& goalBound
+			);
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor.
+			/// The parameters have the same meaning as in algorithm::RoutePlanner.
+			/// @param timetable the timetable of the request, shared by the
+			/// successive runs of a time slot
+			RaptorRoutePlanner(
+				RaptorTimetable& timetable,
+				const graph::VertexAccessMap& originVam,
+				const graph::VertexAccessMap& destinationVam,
+				algorithm::PlanningOrder planningOrder,
+				boost::optional<boost::posix_time::time_duration> maxDuration,
+				const boost::posix_time::ptime& minBeginTime,
+				const boost::posix_time::ptime& maxBeginTime,
+				const boost::posix_time::ptime& maxEndTime,
+				bool ignoreReservation,
+				boost::optional<boost::posix_time::time_duration> maxTransferDuration = boost::optional<boost::posix_time::time_duration>()
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Launches the computing and returns the result.
+			/// @return the best journey, including the approach journeys, empty if
+			/// no solution has been found
+			graph::Journey run();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Computes in a single pass the best journeys for all the start times
+			/// between minBeginTime and maxBeginTime (profile search).
+			/// The start times are the departures (or arrivals) of the services
+			/// reachable from the start place. They are scanned from the last one to
+			/// the first one, keeping the labels of the previous start times, which
+			/// remain valid bounds : a start time produces a journey only if it
+			/// improves the best time at the goal.
+			/// @param result the journeys, sorted in the planning order, including
+			/// the approach journeys
+			/// @return false if the profile can not be computed exactly because of
+			/// continuous services or of a maximal transfer duration : the caller
+			/// must then run a search for each start time
+			bool runProfile(Journeys& result);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Computes in a single pass the best times at all the stops for all the
+			/// start times between minBeginTime and maxBeginTime (one to all profile
+			/// search). The destination is ignored.
+			/// The start times are scanned as in runProfile. If continuous services
+			/// leave the start place, a start time is used at each minute of the
+			/// time slot.
+			/// In the departure to arrival order, the start time is the departure
+			/// time from the origin place and the stop time is the arrival time at
+			/// the stop. In the arrival to departure order, the start time is the
+			/// arrival time at the origin place and the stop time is the departure
+			/// time from the stop.
+			/// @param result for each start time, from the last one to the first
+			/// one, the stops whose best time is improved by the start time : the
+			/// best time at a stop for any start time is given by the record of the
+			/// stop with the nearest start time not preceding it
+			void runAllStopsProfile(StopArrivals& result);
+		};
+}	}
+
+#endif // SYNTHESE_pt_journey_planner_RaptorRoutePlanner_hpp__
@@ -0,0 +1,199 @@
+/** RaptorTimeSlotRoutePlanner class implementation.
+	@file RaptorTimeSlotRoutePlanner.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "RaptorTimeSlotRoutePlanner.hpp"
+
+#include "AlgorithmLogger.hpp"
+#include "PTModule.h"
+#include "RaptorRoutePlanner.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace synthese
+{
+	using namespace algorithm;
+	using namespace graph;
+	using namespace pt;
+
+	namespace pt_journey_planner
+	{
+		RaptorTimeSlotRoutePlanner::RaptorTimeSlotRoutePlanner(
+			const graph::VertexAccessMap& originVam,
+			const graph::VertexAccessMap& destinationVam,
+			const ptime& lowestDepartureTime,
+			const ptime& highestDepartureTime,
+			const ptime& lowestArrivalTime,
+			const ptime& highestArrivalTime,
+			optional<time_duration> maxDuration,
+			optional<size_t> maxSolutionsNumber,
+			AccessParameters accessParameters,
+			PlanningOrder planningOrder,
+			bool ignoreReservation,
+			const AlgorithmLogger& logger,
+			optional<time_duration> maxTransferDuration,
+			optional<double> minMaxDurationRatioFilter,
+			bool enableTheoretical,
+			bool enableRealTime,
+			bool profile
+		):	TimeSlotRoutePlanner(
+				originVam,
+				destinationVam,
+				lowestDepartureTime,
+				highestDepartureTime,
+				lowestArrivalTime,
+				highestArrivalTime,
+				PTModule::GRAPH_ID,
+				PTModule::GRAPH_ID,
+				maxDuration,
+				maxSolutionsNumber,
+				accessParameters,
+				planningOrder,
+				100,
+				ignoreReservation,
+				logger,
+				maxTransferDuration,
+				minMaxDurationRatioFilter,
+				enableTheoretical,
+				enableRealTime
+			),
+			// Same real time rule as Edge::getNextService, evaluated once for the time slot
+			_timetable(
+				accessParameters,
+				enableTheoretical,
+				enableRealTime && _timeContext.isRealTimeUsable(lowestDepartureTime),
+				lowestDepartureTime.date(),
+				highestArrivalTime.date(),
+				_timeContext
+			),
+			_profile(profile),
+			_profileComputed(false),
+			_profileAvailable(false)
+		{}
+
+
+
+		RaptorTimeSlotRoutePlanner::RaptorTimeSlotRoutePlanner(
+			const graph::VertexAccessMap& originVam,
+			const graph::VertexAccessMap& destinationVam,
+			const Result::value_type& continuousService,
+			optional<time_duration> maxDuration,
+			optional<size_t> maxSolutionsNumber,
+			AccessParameters accessParameters,
+			PlanningOrder planningOrder,
+			bool ignoreReservation,
+			const AlgorithmLogger& logger,
+			optional<time_duration> maxTransferDuration,
+			optional<double> minMaxDurationRatioFilter,
+			bool enableTheoretical,
+			bool enableRealTime
+		):	TimeSlotRoutePlanner(
+				originVam,
+				destinationVam,
+				continuousService,
+				PTModule::GRAPH_ID,
+				PTModule::GRAPH_ID,
+				maxDuration,
+				maxSolutionsNumber,
+				accessParameters,
+				planningOrder,
+				100,
+				ignoreReservation,
+				logger,
+				maxTransferDuration,
+				minMaxDurationRatioFilter,
+				enableTheoretical,
+				enableRealTime
+			),
+			_timetable(
+				accessParameters,
+				enableTheoretical,
+				enableRealTime && _timeContext.isRealTimeUsable(continuousService.getFirstDepartureTime()),
+				continuousService.getFirstDepartureTime().date(),
+				continuousService.getLastArrivalTime().date(),
+				_timeContext
+			),
+			_profile(false),
+			_profileComputed(false),
+			_profileAvailable(false)
+		{}
+
+
+
+		Journey RaptorTimeSlotRoutePlanner::_findJourney(
+			const ptime& originDateTime
+		){
+			if(_profile)
+			{
+				// The whole time slot is computed at the first step
+				if(!_profileComputed)
+				{
+					RaptorRoutePlanner r(
+						_timetable,
+						_originVam,
+						_destinationVam,
+						_planningOrder,
+						_maxDuration,
+						_planningOrder == DEPARTURE_FIRST ? _lowestDepartureTime : _highestArrivalTime,
+						_planningOrder == DEPARTURE_FIRST ? _highestDepartureTime : _lowestArrivalTime,
+						_planningOrder == DEPARTURE_FIRST ? _highestArrivalTime : _lowestDepartureTime,
+						_ignoreReservation,
+						_maxTransferDuration
+					);
+					_profileAvailable = r.runProfile(_profileJourneys);
+					_profileComputed = true;
+				}
+
+				// The journeys are sorted in the planning order
+				if(_profileAvailable)
+				{
+					BOOST_FOREACH(const Journey& journey, _profileJourneys)
+					{
+						if(	_planningOrder == DEPARTURE_FIRST ?
+							journey.getFirstDepartureTime() >= originDateTime :
+							journey.getFirstArrivalTime() <= originDateTime
+						){
+							return journey;
+						}
+					}
+					return Journey();
+				}
+			}
+
+			RaptorRoutePlanner r(
+				_timetable,
+				_originVam,
+				_destinationVam,
+				_planningOrder,
+				_maxDuration,
+				originDateTime,
+				_planningOrder == DEPARTURE_FIRST ? _highestDepartureTime : _lowestArrivalTime,
+				_planningOrder == DEPARTURE_FIRST ? _highestArrivalTime : _lowestDepartureTime,
+				_ignoreReservation,
+				_maxTransferDuration
+			);
+			return r.run();
+		}
+}	}
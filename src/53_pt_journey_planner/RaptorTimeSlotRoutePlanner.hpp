@@ -0,0 +1,112 @@
+/** RaptorTimeSlotRoutePlanner class header.
+	@file RaptorTimeSlotRoutePlanner.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_pt_journey_planner_RaptorTimeSlotRoutePlanner_hpp__
+#define SYNTHESE_pt_journey_planner_RaptorTimeSlotRoutePlanner_hpp__
+
+#include "TimeSlotRoutePlanner.h"
+
+#include "RaptorRoutePlanner.hpp"
+#include "RaptorTimetable.hpp"
+
+namespace synthese
+{
+	namespace pt_journey_planner
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Time slot route planner using the round based route planner.
+		///	@ingroup m53
+		//////////////////////////////////////////////////////////////////////////
+		/// The time slot loop of algorithm::TimeSlotRoutePlanner is kept : only the
+		/// search of each journey is replaced by a RaptorRoutePlanner run.
+		/// The timetable is built once for the whole time slot and shared by all
+		/// the runs.
+		///
+		/// In profile mode, the journeys of the whole time slot are computed by a
+		/// single RaptorRoutePlanner::runProfile call at the first step of the
+		/// loop, and each step only picks the first journey starting after the
+		/// origin date time. The loop itself (filters, maximal solutions number,
+		/// continuous services merging) is unchanged. If the profile can not be
+		/// computed exactly, each step runs a search as in the default mode.
+		class RaptorTimeSlotRoutePlanner:
+			public algorithm::TimeSlotRoutePlanner
+		{
+		private:
+			const graph::SearchTimeContext _timeContext;	//!< current time of the whole search
+			RaptorTimetable _timetable;
+
+			//! @name Profile mode
+			//@{
+				const bool _profile;
+				bool _profileComputed;
+				bool _profileAvailable;
+				RaptorRoutePlanner::Journeys _profileJourneys;
+			//@}
+
+		protected:
+			virtual graph::Journey _findJourney(
+				const boost::posix_time::ptime& originDateTime
+			);
+
+		public:
+			RaptorTimeSlotRoutePlanner(
+				const graph::VertexAccessMap& originVam,
+				const graph::VertexAccessMap& destinationVam,
+				const boost::posix_time::ptime& lowestDepartureTime,
+				const boost::posix_time::ptime& highestDepartureTime,
+				const boost::posix_time::ptime& lowestArrivalTime,
+				const boost::posix_time::ptime& highestArrivalTime,
+				boost::optional<boost::posix_time::time_duration> maxDuration,
+				boost::optional<std::size_t> maxSolutionsNumber,
+				graph::AccessParameters accessParameters,
+				algorithm::PlanningOrder planningOrder,
+				bool ignoreReservation,
+				const algorithm::AlgorithmLogger& logger,
+				boost::optional<boost::posix_time::time_duration> maxTransferDuration = boost::optional<boost::posix_time::time_duration>(),
+				boost::optional<double> minMaxDurationRatioFilter = boost::optional<double>(),
+				bool enableTheoretical = true,
+				bool enableRealTime = true,
+				bool profile = false
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor for attempting to optimize a continuous service slot.
+			RaptorTimeSlotRoutePlanner(
+				const graph::VertexAccessMap& originVam,
+				const graph::VertexAccessMap& destinationVam,
+				const Result::value_type& continuousService,
+				boost::optional<boost::posix_time::time_duration> maxDuration,
+				boost::optional<std::size_t> maxSolutionsNumber,
+				graph::AccessParameters accessParameters,
+				algorithm::PlanningOrder planningOrder,
+				bool ignoreReservation,
+				const algorithm::AlgorithmLogger& logger,
+				boost::optional<boost::posix_time::time_duration> maxTransferDuration = boost::optional<boost::posix_time::time_duration>(),
+				boost::optional<double> minMaxDurationRatioFilter = boost::optional<double>(),
+				bool enableTheoretical = true,
+				bool enableRealTime = true
+			);
+		};
+}	}
+
+#endif // SYNTHESE_pt_journey_planner_RaptorTimeSlotRoutePlanner_hpp__
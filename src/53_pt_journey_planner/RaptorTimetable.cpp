@@ -0,0 +1,439 @@
+/** RaptorTimetable class implementation.
+	@file RaptorTimetable.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "RaptorTimetable.hpp"
+
+#include "Edge.h"
+#include "Hub.h"
+#include "JourneyPattern.hpp"
+#include "Junction.hpp"
+#include "Path.h"
+#include "PTModule.h"
+#include "PTUseRule.h"
+#include "ScheduledService.h"
+#include "StopPoint.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <boost/foreach.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace boost::gregorian;
+
+namespace synthese
+{
+	using namespace graph;
+	using namespace pt;
+	using namespace util;
+
+	namespace pt_journey_planner
+	{
+		const RaptorTimetable::Time RaptorTimetable::UNREACHED(numeric_limits<RaptorTimetable::Time>::max());
+		const size_t RaptorTimetable::NO_STOP(numeric_limits<size_t>::max());
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Orders the rows of a pattern by their time at a given rank.
+		class RaptorRowComparator
+		{
+			const vector<RaptorTimetable::Time>& _times;
+			const size_t _ranksNumber;
+			const size_t _rank;
+
+		public:
+			RaptorRowComparator(
+				const vector<RaptorTimetable::Time>& times,
+				size_t ranksNumber,
+				size_t rank
+			):	_times(times),
+				_ranksNumber(ranksNumber),
+				_rank(rank)
+			{}
+
+			bool operator()(size_t left, size_t right) const
+			{
+				return _times[left * _ranksNumber + _rank] < _times[right * _ranksNumber + _rank];
+			}
+		};
+
+
+
+		RaptorTimetable::RaptorTimetable(
+			const graph::AccessParameters& accessParameters,
+			bool THData,
+			bool RTData,
+			const date& firstDay,
+			const date& lastDay,
+			const SearchTimeContext& timeContext
+		):	_accessParameters(accessParameters),
+			_THData(THData),
+			_RTData(RTData),
+			_firstDay(firstDay - days(1)),
+			_lastDay(lastDay),
+			_epoch(firstDay - days(1)),
+			_timeContext(timeContext)
+		{}
+
+
+
+		size_t RaptorTimetable::getStopIndex(
+			const Vertex& vertex
+		){
+			map<const Vertex*, size_t>::const_iterator it(_stopIndexes.find(&vertex));
+			if(it != _stopIndexes.end())
+			{
+				return it->second;
+			}
+
+			const StopPoint* stopPoint(dynamic_cast<const StopPoint*>(&vertex));
+			if(!stopPoint)
+			{
+				return NO_STOP;
+			}
+
+			Stop stop;
+			stop.stopPoint = stopPoint;
+			stop.usable = stopPoint->getUseRule(_accessParameters.getUserClassRank()).isCompatibleWith(_accessParameters);
+			stop.linksBuilt = false;
+			stop.transfersBuilt = false;
+
+			size_t index(_stops.size());
+			_stops.push_back(stop);
+			_stopIndexes.insert(make_pair(&vertex, index));
+			return index;
+		}
+
+
+
+		const RaptorTimetable::Stop& RaptorTimetable::getStop(
+			size_t stopIndex
+		){
+			Stop& stop(_stops[stopIndex]);
+			if(!stop.linksBuilt)
+			{
+				_buildLinks(stopIndex);
+			}
+			return stop;
+		}
+
+
+
+		const RaptorTimetable::Stop& RaptorTimetable::getStopWithTransfers(
+			size_t stopIndex
+		){
+			Stop& stop(_stops[stopIndex]);
+			if(!stop.linksBuilt)
+			{
+				_buildLinks(stopIndex);
+			}
+			if(!stop.transfersBuilt)
+			{
+				_buildTransfers(stopIndex);
+			}
+			return stop;
+		}
+
+
+
+		const RaptorTimetable::Pattern& RaptorTimetable::getPattern(
+			size_t patternIndex
+		){
+			Pattern& pattern(_patterns[patternIndex]);
+			if(!pattern.built)
+			{
+				_buildPattern(pattern);
+			}
+			return pattern;
+		}
+
+
+
+		bool RaptorTimetable::isUsablePath(
+			const Path& path
+		) const {
+			if(	!path.isCompatibleWith(_accessParameters) ||
+				!_accessParameters.isAllowedPathClass(
+					path.getPathClass() ? path.getPathClass()->getIdentifier() : 0,
+					path.getPathNetwork() ? path.getPathNetwork()->getIdentifier() : 0
+			)	){
+				return false;
+			}
+
+			const UseRule& useRule(path.getUseRule(_accessParameters.getUserClassRank()));
+			if(	dynamic_cast<const PTUseRule*>(&useRule) &&
+				static_cast<const PTUseRule&>(useRule).getForbiddenInJourneyPlanning()
+			){
+				return false;
+			}
+
+			return true;
+		}
+
+
+
+		RaptorTimetable::Time RaptorTimetable::toTime(
+			const ptime& value
+		) const {
+			return static_cast<Time>((value - _epoch).total_seconds());
+		}
+
+
+
+		ptime RaptorTimetable::toPtime(
+			Time value
+		) const {
+			return _epoch + seconds(value);
+		}
+
+
+
+		void RaptorTimetable::_buildLinks(
+			size_t stopIndex
+		){
+			Stop& stop(_stops[stopIndex]);
+			stop.linksBuilt = true;
+
+			for(size_t i(0); i<2; ++i)
+			{
+				const Vertex::Edges& edges(i ? stop.stopPoint->getArrivalEdges() : stop.stopPoint->getDepartureEdges());
+				BOOST_FOREACH(const Vertex::Edges::value_type& itEdge, edges)
+				{
+					const Path& path(*itEdge.first);
+					const Edge& edge(*itEdge.second);
+
+					if(dynamic_cast<const JourneyPattern*>(&path))
+					{
+						map<const Path*, size_t>::const_iterator it(_patternIndexes.find(&path));
+						size_t patternIndex;
+						if(it == _patternIndexes.end())
+						{
+							Pattern pattern;
+							pattern.journeyPattern = static_cast<const JourneyPattern*>(&path);
+							pattern.built = false;
+							pattern.usable = false;
+							pattern.ranksNumber = 0;
+							pattern.rowsNumber = 0;
+							patternIndex = _patterns.size();
+							_patterns.push_back(pattern);
+							_patternIndexes.insert(make_pair(&path, patternIndex));
+						}
+						else
+						{
+							patternIndex = it->second;
+						}
+
+						PatternStop patternStop;
+						patternStop.pattern = patternIndex;
+						patternStop.rank = edge.getRankInPath();
+						(i ? stop.arrivalPatterns : stop.departurePatterns).push_back(patternStop);
+					}
+					else if(dynamic_cast<const Junction*>(&path))
+					{
+						if(!isUsablePath(path))
+						{
+							continue;
+						}
+						if(i)
+						{
+							if(edge.getPreviousDepartureForFineSteppingOnly())
+							{
+								stop.arrivalJunctions.push_back(&edge);
+							}
+						}
+						else
+						{
+							if(edge.getFollowingArrivalForFineSteppingOnly())
+							{
+								stop.departureJunctions.push_back(&edge);
+							}
+						}
+					}
+				}
+			}
+		}
+
+
+
+		void RaptorTimetable::_buildTransfers(
+			size_t stopIndex
+		){
+			_stops[stopIndex].transfersBuilt = true;
+
+			const StopPoint& stopPoint(*_stops[stopIndex].stopPoint);
+			const Hub* hub(stopPoint.getHub());
+			if(!hub || !hub->isUsefulTransfer(PTModule::GRAPH_ID))
+			{
+				return;
+			}
+
+			Hub::Vertices vertices(hub->getVertices(PTModule::GRAPH_ID));
+			BOOST_FOREACH(const Vertex* vertex, vertices)
+			{
+				size_t otherIndex(getStopIndex(*vertex));
+				if(otherIndex == NO_STOP)
+				{
+					continue;
+				}
+
+				if(hub->isConnectionAllowed(stopPoint, *vertex))
+				{
+					Transfer transfer;
+					transfer.stop = otherIndex;
+					transfer.duration = static_cast<Time>(hub->getTransferDelay(stopPoint, *vertex).total_seconds());
+					_stops[stopIndex].outgoingTransfers.push_back(transfer);
+				}
+				if(hub->isConnectionAllowed(*vertex, stopPoint))
+				{
+					Transfer transfer;
+					transfer.stop = otherIndex;
+					transfer.duration = static_cast<Time>(hub->getTransferDelay(*vertex, stopPoint).total_seconds());
+					_stops[stopIndex].incomingTransfers.push_back(transfer);
+				}
+			}
+		}
+
+
+
+		void RaptorTimetable::_buildPattern(
+			Pattern& pattern
+		){
+			pattern.built = true;
+
+			const JourneyPattern& journeyPattern(*pattern.journeyPattern);
+			if(!isUsablePath(journeyPattern))
+			{
+				return;
+			}
+
+			// Ranks
+			const Path::Edges& edges(journeyPattern.getEdges());
+			size_t ranksNumber(edges.size());
+			pattern.edges.resize(ranksNumber, NULL);
+			pattern.stops.resize(ranksNumber, NO_STOP);
+			pattern.departureAllowed.resize(ranksNumber, false);
+			pattern.arrivalAllowed.resize(ranksNumber, false);
+			BOOST_FOREACH(const Edge* edge, edges)
+			{
+				size_t rank(edge->getRankInPath());
+				if(rank >= ranksNumber)
+				{
+					return;
+				}
+				pattern.edges[rank] = edge;
+				pattern.stops[rank] = getStopIndex(*edge->getFromVertex());
+				pattern.departureAllowed[rank] = edge->isDepartureAllowed();
+				pattern.arrivalAllowed[rank] = edge->isArrivalAllowed();
+			}
+			BOOST_FOREACH(const Edge* edge, pattern.edges)
+			{
+				if(!edge)
+				{
+					return;
+				}
+			}
+			pattern.ranksNumber = ranksNumber;
+			pattern.usable = true;
+
+			// Rows
+			const date& today(_timeContext.getToday());
+			{
+				boost::shared_lock<shared_recursive_mutex> sharedServicesLock(
+					*journeyPattern.sharedServicesMutex
+				);
+				BOOST_FOREACH(const Service* service, journeyPattern.getServices())
+				{
+					if(!service->isCompatibleWith(_accessParameters))
+					{
+						continue;
+					}
+
+					const ScheduledService* scheduledService(dynamic_cast<const ScheduledService*>(service));
+					if(!scheduledService)
+					{
+						pattern.otherServices.push_back(service);
+						continue;
+					}
+
+					for(date day(_firstDay); day <= _lastDay; day += days(1))
+					{
+						if(!scheduledService->isActive(day))
+						{
+							continue;
+						}
+
+						// Real time schedules are only available for the services of the current day
+						bool RTData(_RTData && day <= today);
+						const SchedulesBasedService::Schedules& departureSchedules(
+							scheduledService->getDepartureSchedules(_THData, RTData)
+						);
+						const SchedulesBasedService::Schedules& arrivalSchedules(
+							scheduledService->getArrivalSchedules(_THData, RTData)
+						);
+						if(	departureSchedules.size() < ranksNumber ||
+							arrivalSchedules.size() < ranksNumber
+						){
+							continue;
+						}
+
+						Time dayOffset(static_cast<Time>((day - _epoch.date()).days()) * 86400);
+						for(size_t rank(0); rank<ranksNumber; ++rank)
+						{
+							pattern.departures.push_back(dayOffset + static_cast<Time>(departureSchedules[rank].total_seconds()));
+							pattern.arrivals.push_back(dayOffset + static_cast<Time>(arrivalSchedules[rank].total_seconds()));
+						}
+						pattern.rowServices.push_back(scheduledService);
+						pattern.rowDates.push_back(day);
+					}
+				}
+			}
+			pattern.rowsNumber = pattern.rowServices.size();
+
+			// Indexes
+			size_t rowsNumber(pattern.rowsNumber);
+			pattern.departureOrder.resize(ranksNumber * rowsNumber);
+			pattern.arrivalOrder.resize(ranksNumber * rowsNumber);
+			for(size_t rank(0); rank<ranksNumber; ++rank)
+			{
+				vector<size_t>::iterator departureBegin(pattern.departureOrder.begin() + rank * rowsNumber);
+				vector<size_t>::iterator arrivalBegin(pattern.arrivalOrder.begin() + rank * rowsNumber);
+				for(size_t row(0); row<rowsNumber; ++row)
+				{
+					*(departureBegin + row) = row;
+					*(arrivalBegin + row) = row;
+				}
+				stable_sort(
+					departureBegin,
+					departureBegin + rowsNumber,
+					RaptorRowComparator(pattern.departures, ranksNumber, rank)
+				);
+				stable_sort(
+					arrivalBegin,
+					arrivalBegin + rowsNumber,
+					RaptorRowComparator(pattern.arrivals, ranksNumber, rank)
+				);
+			}
+		}
+}	}
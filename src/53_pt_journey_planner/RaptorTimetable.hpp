@@ -0,0 +1,262 @@
+/** RaptorTimetable class header.
+	@file RaptorTimetable.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_pt_journey_planner_RaptorTimetable_hpp__
+#define SYNTHESE_pt_journey_planner_RaptorTimetable_hpp__
+
+#include "AccessParameters.h"
+#include "SearchTimeContext.hpp"
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <boost/date_time/gregorian/greg_date.hpp>
+#include <boost/date_time/posix_time/ptime.hpp>
+
+namespace synthese
+{
+	namespace graph
+	{
+		class Edge;
+		class Path;
+		class Service;
+		class Vertex;
+	}
+
+	namespace pt
+	{
+		class JourneyPattern;
+		class ScheduledService;
+		class StopPoint;
+	}
+
+	namespace pt_journey_planner
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Flat timetable used by the round based route planner.
+		///	@ingroup m53
+		//////////////////////////////////////////////////////////////////////////
+		/// The timetable is built for a single journey planning request : it
+		/// depends on the access parameters, on the real time settings and on the
+		/// dates covered by the request. It must not be shared between threads.
+		///
+		/// Stops and journey patterns are numbered densely when they are met for
+		/// the first time, so the searches only handle integer indices and
+		/// contiguous arrays :
+		/// <ul>
+		///		<li>each stop knows the patterns which serve it, its transfers
+		///		towards the other stops of its stop area and the junctions starting
+		///		or ending at it</li>
+		///		<li>each pattern stores one row per (scheduled service, day) couple
+		///		running in the period, with the absolute departure and arrival times
+		///		at each rank, and for each rank the rows sorted by departure and by
+		///		arrival time</li>
+		/// </ul>
+		///
+		/// Times are stored as a number of seconds since midnight of the first
+		/// day of the period.
+		///
+		/// Patterns are built lazily the first time a search reaches them, so a
+		/// request never reads the services of the lines it does not use.
+		///
+		/// Services which are not scheduled services (continuous services) are
+		/// not tabulated : they are kept in a separate list and read through
+		/// Service::getFromPresenceTime at search time.
+		///
+		/// Stops and patterns are stored in deques : the references returned by
+		/// the getters remain valid when other stops or patterns are registered.
+		class RaptorTimetable
+		{
+		public:
+			typedef int Time;
+
+			static const Time UNREACHED;
+			static const std::size_t NO_STOP;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Link between a stop and another one, with the duration of the link.
+			struct Transfer
+			{
+				std::size_t stop;
+				Time duration;
+			};
+			typedef std::vector<Transfer> Transfers;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Passage of a pattern at a stop.
+			struct PatternStop
+			{
+				std::size_t pattern;
+				std::size_t rank;
+			};
+			typedef std::vector<PatternStop> PatternStops;
+
+			typedef std::vector<const graph::Edge*> Junctions;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Stop of the timetable.
+			struct Stop
+			{
+				const pt::StopPoint* stopPoint;
+				bool usable;	//!< the use rules of the stop are compatible with the access parameters
+
+				bool linksBuilt;
+				PatternStops departurePatterns;	//!< patterns departing from the stop
+				PatternStops arrivalPatterns;	//!< patterns arriving at the stop
+				Junctions departureJunctions;	//!< first edges of junctions starting at the stop
+				Junctions arrivalJunctions;	//!< last edges of junctions ending at the stop
+
+				bool transfersBuilt;
+				Transfers outgoingTransfers;	//!< transfers from the stop to the stops of the same stop area
+				Transfers incomingTransfers;	//!< transfers to the stop from the stops of the same stop area
+			};
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Journey pattern of the timetable.
+			/// The times of a row are stored contiguously : the departure time of
+			/// the row <i>t</i> at the rank <i>r</i> is departures[t * ranksNumber + r].
+			/// The sorted indexes are stored rank by rank : the <i>k</i>th departure
+			/// at the rank <i>r</i> is departureOrder[r * rowsNumber + k].
+			struct Pattern
+			{
+				const pt::JourneyPattern* journeyPattern;
+				bool built;
+				bool usable;	//!< the pattern is compatible with the access parameters
+				std::size_t ranksNumber;
+				std::size_t rowsNumber;
+
+				std::vector<const graph::Edge*> edges;
+				std::vector<std::size_t> stops;
+				std::vector<bool> departureAllowed;
+				std::vector<bool> arrivalAllowed;
+
+				std::vector<const pt::ScheduledService*> rowServices;
+				std::vector<boost::gregorian::date> rowDates;
+				std::vector<Time> departures;
+				std::vector<Time> arrivals;
+				std::vector<std::size_t> departureOrder;
+				std::vector<std::size_t> arrivalOrder;
+
+				std::vector<const graph::Service*> otherServices;
+			};
+
+		private:
+			//! @name Parameters
+			//@{
+				const graph::AccessParameters _accessParameters;
+				const bool _THData;
+				const bool _RTData;
+				const boost::gregorian::date _firstDay;
+				const boost::gregorian::date _lastDay;
+				const boost::posix_time::ptime _epoch;
+				const graph::SearchTimeContext _timeContext;	//!< current time of the searches in the timetable
+			//@}
+
+			//! @name Content
+			//@{
+				std::deque<Stop> _stops;
+				std::deque<Pattern> _patterns;
+				std::map<const graph::Vertex*, std::size_t> _stopIndexes;
+				std::map<const graph::Path*, std::size_t> _patternIndexes;
+			//@}
+
+			void _buildPattern(Pattern& pattern);
+			void _buildLinks(std::size_t stopIndex);
+			void _buildTransfers(std::size_t stopIndex);
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor.
+			/// @param accessParameters the access parameters of the request
+			/// @param THData use the theoretical schedules
+			/// @param RTData use the real time schedules
+			/// @param firstDay first day of the period covered by the request
+			/// @param lastDay last day of the period covered by the request
+			/// @param timeContext current time of the search
+			/// The day preceding firstDay is added to the period to handle the
+			/// services running after midnight.
+			RaptorTimetable(
+				const graph::AccessParameters& accessParameters,
+				bool THData,
+				bool RTData,
+				const boost::gregorian::date& firstDay,
+				const boost::gregorian::date& lastDay,
+				const graph::SearchTimeContext& timeContext
+			);
+
+			//! @name Getters
+			//@{
+				const graph::AccessParameters& getAccessParameters() const { return _accessParameters; }
+				bool getTHData() const { return _THData; }
+				bool getRTData() const { return _RTData; }
+				const graph::SearchTimeContext& getTimeContext() const { return _timeContext; }
+				std::size_t getStopsNumber() const { return _stops.size(); }
+				std::size_t getPatternsNumber() const { return _patterns.size(); }
+			//@}
+
+			//! @name Queries
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// Gets the index of a stop, registering it if necessary.
+				/// @param vertex the stop
+				/// @return the index of the stop, NO_STOP if the vertex is not a stop point
+				std::size_t getStopIndex(const graph::Vertex& vertex);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Gets a stop with its patterns and junctions.
+				const Stop& getStop(std::size_t stopIndex);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Checks if the use rules of a stop are compatible with the access
+				/// parameters, without building its links.
+				bool isUsableStop(std::size_t stopIndex) const { return _stops[stopIndex].usable; }
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Gets a stop with its patterns, junctions and transfers.
+				const Stop& getStopWithTransfers(std::size_t stopIndex);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Gets a pattern, reading its services if necessary.
+				const Pattern& getPattern(std::size_t patternIndex);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Checks if a path can be used according to the access parameters.
+				bool isUsablePath(const graph::Path& path) const;
+
+
+
+				Time toTime(const boost::posix_time::ptime& value) const;
+				boost::posix_time::ptime toPtime(Time value) const;
+			//@}
+		};
+}	}
+
+#endif // SYNTHESE_pt_journey_planner_RaptorTimetable_hpp__
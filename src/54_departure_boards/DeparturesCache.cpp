@@ -0,0 +1,294 @@
+/** DeparturesCache class implementation.
+	@file DeparturesCache.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "DeparturesCache.hpp"
+
+#include "AccessParameters.h"
+#include "GraphConstants.h"
+#include "Path.h"
+#include "Service.h"
+#include "StopPointTableSync.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace synthese
+{
+	using namespace db;
+	using namespace graph;
+	using namespace pt;
+	using namespace util;
+
+	namespace departure_boards
+	{
+		const time_duration DeparturesCache::MAX_AGE(minutes(5));
+		DeparturesCache::StopsDepartures DeparturesCache::_stopsDepartures;
+		boost::mutex DeparturesCache::_mutex;
+		boost::detail::atomic_count DeparturesCache::_hits(0);
+		boost::detail::atomic_count DeparturesCache::_misses(0);
+
+		namespace
+		{
+			bool _HasContinuousServices(const Path& path)
+			{
+				boost::shared_lock<shared_recursive_mutex> sharedServicesLock(
+					*path.sharedServicesMutex
+				);
+				BOOST_FOREACH(const Service* service, path.getServices())
+				{
+					if(service->isContinuous())
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+		}
+
+
+
+		DeparturesCache::EdgeDepartures::EdgeDepartures(
+			const Edge& edge_,
+			const ptime& startDateTime_,
+			bool allowCanceled_,
+			const ptime& now
+		):	edge(edge_),
+			pathMutex(edge_.getParentPath()->sharedServicesMutex),
+			servicesVersion(edge_.getParentPath()->getServicesVersion()),
+			creationTime(now),
+			startDateTime(startDateTime_),
+			allowCanceled(allowCanceled_),
+			continuous(_HasContinuousServices(*edge_.getParentPath())),
+			nextDepartureDateTime(startDateTime_),
+			searchedUntil(neg_infin)
+		{}
+
+
+
+		bool DeparturesCache::EdgeDepartures::isExpired() const
+		{
+			return pathMutex.expired();
+		}
+
+
+
+		bool DeparturesCache::EdgeDepartures::isValidFor(
+			const ptime& startDateTime_,
+			const ptime& now
+		) const	{
+			return
+				!isExpired() &&
+				servicesVersion == edge.getParentPath()->getServicesVersion() &&
+				startDateTime <= startDateTime_ &&
+				now - creationTime <= MAX_AGE
+			;
+		}
+
+
+
+		bool DeparturesCache::EdgeDepartures::computeNext(
+			const ptime& endDateTime
+		){
+			// Same access parameters as the generators. The reachability of the
+			// services is not checked, so the reservation rules are never read :
+			// the result does not depend on the time of the computing.
+			AccessParameters ap(USER_PEDESTRIAN);
+			ServicePointer servicePointer(
+				edge.getNextService(
+					ap,
+					nextDepartureDateTime,
+					endDateTime,
+					false,
+					nextIndex,
+					false,
+					true,
+					allowCanceled
+			)	);
+			if(!servicePointer.getService())
+			{
+				searchedUntil = max(searchedUntil, endDateTime);
+				return false;
+			}
+
+			++*nextIndex;
+			nextDepartureDateTime = servicePointer.getDepartureDateTime();
+			departures.push_back(servicePointer);
+			return true;
+		}
+
+
+
+		DeparturesCache::Cursor::Cursor(
+			const Edge& edge,
+			const ptime& startDateTime,
+			const ptime& endDateTime,
+			bool allowCanceled
+		):	_edge(edge),
+			_startDateTime(startDateTime),
+			_endDateTime(endDateTime),
+			_allowCanceled(allowCanceled),
+			_rank(0),
+			_departureDateTime(startDateTime)
+		{
+			ptime now(second_clock::local_time());
+
+			boost::mutex::scoped_lock lock(_mutex);
+			EdgesDepartures& edgesDepartures(_stopsDepartures[edge.getFromVertex()->getKey()]);
+
+			// Cleaning of the departures of the deleted paths
+			for(EdgesDepartures::iterator it(edgesDepartures.begin()); it != edgesDepartures.end(); )
+			{
+				if(it->second->isExpired())
+				{
+					edgesDepartures.erase(it++);
+				}
+				else
+				{
+					++it;
+				}
+			}
+
+			// The entry is replaced, the cursors still reading the previous one
+			// keep it until their end
+			boost::shared_ptr<EdgeDepartures>& departures(
+				edgesDepartures[make_pair(&edge, allowCanceled)]
+			);
+			if(	!departures ||
+				&departures->edge != &edge ||
+				departures->pathMutex.lock() != edge.getParentPath()->sharedServicesMutex ||
+				!departures->isValidFor(startDateTime, now)
+			){
+				departures.reset(new EdgeDepartures(edge, startDateTime, allowCanceled, now));
+			}
+			_departures = departures;
+		}
+
+
+
+		ServicePointer DeparturesCache::Cursor::next()
+		{
+			// Direct computing
+			if(_departures->continuous)
+			{
+				AccessParameters ap(USER_PEDESTRIAN);
+				ServicePointer servicePointer(
+					_edge.getNextService(
+						ap,
+						_departureDateTime,
+						_endDateTime,
+						false,
+						_index,
+						false,
+						true,
+						_allowCanceled
+				)	);
+				if(servicePointer.getService())
+				{
+					++*_index;
+					_departureDateTime = servicePointer.getDepartureDateTime();
+					++_misses;
+				}
+				return servicePointer;
+			}
+
+			// Read of the stored departures
+			boost::mutex::scoped_lock lock(_departures->mutex);
+			while(true)
+			{
+				bool computed(false);
+				if(_rank == _departures->departures.size())
+				{
+					if(	_departures->searchedUntil >= _endDateTime ||
+						!_departures->computeNext(_endDateTime)
+					){
+						return ServicePointer();
+					}
+					computed = true;
+				}
+
+				const ServicePointer& servicePointer(_departures->departures[_rank]);
+				++_rank;
+
+				// Departures stored for a board with an earlier start time
+				if(servicePointer.getDepartureDateTime() < _startDateTime)
+				{
+					continue;
+				}
+
+				// Departures stored for a board with a later end time
+				if(servicePointer.getDepartureDateTime() > _endDateTime)
+				{
+					--_rank;
+					return ServicePointer();
+				}
+
+				if(computed)
+				{
+					++_misses;
+				}
+				else
+				{
+					++_hits;
+				}
+				return servicePointer;
+			}
+		}
+
+
+
+		size_t DeparturesCache::GetEntriesNumber()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			size_t result(0);
+			BOOST_FOREACH(const StopsDepartures::value_type& it, _stopsDepartures)
+			{
+				result += it.second.size();
+			}
+			return result;
+		}
+
+
+
+		void DeparturesCache::Clear()
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			_stopsDepartures.clear();
+		}
+
+
+
+		void DeparturesCache::Invalidate(
+			const DB::DBModifEvent& modifEvent
+		){
+			if(	modifEvent.type != DB::MODIF_DELETE ||
+				decodeTableId(modifEvent.id) != StopPointTableSync::TABLE.ID
+			){
+				return;
+			}
+
+			boost::mutex::scoped_lock lock(_mutex);
+			_stopsDepartures.erase(modifEvent.id);
+		}
+}	}
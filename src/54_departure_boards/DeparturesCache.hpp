@@ -0,0 +1,199 @@
+/** DeparturesCache class header.
+	@file DeparturesCache.hpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef SYNTHESE_departure_boards_DeparturesCache_hpp__
+#define SYNTHESE_departure_boards_DeparturesCache_hpp__
+
+#include "DB.hpp"
+#include "Edge.h"
+#include "ServicePointer.h"
+#include "UtilTypes.h"
+
+#include <map>
+#include <vector>
+#include <boost/detail/atomic_count.hpp>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace util
+	{
+		class shared_recursive_mutex;
+	}
+
+	namespace departure_boards
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Departures of the stops, shared by all the departure boards.
+		///	@ingroup m54
+		//////////////////////////////////////////////////////////////////////////
+		/// The departures of each edge leaving a stop are computed once, from the
+		/// start time of the first departure board which reads them, and are
+		/// extended lazily as the boards ask for later departures. The other
+		/// boards displaying the same stop read the stored departures.
+		///
+		/// The departures of an edge are computed again :
+		/// <ul>
+		///		<li>when the services of its path have changed (see
+		///		graph::Path::getServicesVersion) : schedules, real time schedules
+		///		or vertices, services added or removed by the table sync</li>
+		///		<li>when a board asks for departures before the stored ones</li>
+		///		<li>after MAX_AGE, to follow the passing of the time (real time
+		///		horizon, canceled services)</li>
+		/// </ul>
+		///
+		/// The paths with continuous services are never stored, because the
+		/// departure time of a continuous service depends on the presence time.
+		///
+		/// The boards do not check if the services are reachable, so the stored
+		/// departures do not depend on the reservation deadlines.
+		///
+		/// The departures of a stop point are removed when it is deleted (see
+		/// Invalidate).
+		class DeparturesCache
+		{
+		public:
+			static const boost::posix_time::time_duration MAX_AGE;
+
+		private:
+			//////////////////////////////////////////////////////////////////////////
+			/// Stored departures of an edge.
+			struct EdgeDepartures
+			{
+				const graph::Edge& edge;
+				const boost::weak_ptr<util::shared_recursive_mutex> pathMutex;	//!< expires with the path
+				const long servicesVersion;
+				const boost::posix_time::ptime creationTime;
+				const boost::posix_time::ptime startDateTime;
+				const bool allowCanceled;
+				const bool continuous;
+
+				boost::mutex mutex;	//!< protects the following attributes
+				std::vector<graph::ServicePointer> departures;
+				boost::posix_time::ptime nextDepartureDateTime;
+				boost::optional<graph::Edge::DepartureServiceIndex::Value> nextIndex;
+				boost::posix_time::ptime searchedUntil;	//!< no other departure before this time
+
+				EdgeDepartures(
+					const graph::Edge& edge,
+					const boost::posix_time::ptime& startDateTime,
+					bool allowCanceled,
+					const boost::posix_time::ptime& now
+				);
+
+				bool isValidFor(
+					const boost::posix_time::ptime& startDateTime,
+					const boost::posix_time::ptime& now
+				) const;
+
+				bool isExpired() const;
+
+				bool computeNext(const boost::posix_time::ptime& endDateTime);
+			};
+
+			typedef std::map<
+				std::pair<const graph::Edge*, bool>,
+				boost::shared_ptr<EdgeDepartures>
+			> EdgesDepartures;
+			typedef std::map<util::RegistryKeyType, EdgesDepartures> StopsDepartures;
+
+			static StopsDepartures _stopsDepartures;
+			static boost::mutex _mutex;
+			static boost::detail::atomic_count _hits;
+			static boost::detail::atomic_count _misses;
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Reads the departures of an edge in a time window, from the cache.
+			/// The departures are returned in the same order as successive calls
+			/// to graph::Edge::getNextService.
+			class Cursor
+			{
+			private:
+				const graph::Edge& _edge;
+				const boost::posix_time::ptime _startDateTime;
+				const boost::posix_time::ptime _endDateTime;
+				const bool _allowCanceled;
+				boost::shared_ptr<EdgeDepartures> _departures;
+				std::size_t _rank;
+
+				//! @name Direct computing (continuous services)
+				//@{
+					boost::posix_time::ptime _departureDateTime;
+					boost::optional<graph::Edge::DepartureServiceIndex::Value> _index;
+				//@}
+
+			public:
+				//////////////////////////////////////////////////////////////////////////
+				/// Constructor.
+				/// @param edge the edge to read
+				/// @param startDateTime first departure time
+				/// @param endDateTime last departure time
+				/// @param allowCanceled return the canceled services too
+				Cursor(
+					const graph::Edge& edge,
+					const boost::posix_time::ptime& startDateTime,
+					const boost::posix_time::ptime& endDateTime,
+					bool allowCanceled
+				);
+
+
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Next departure.
+				/// @return the next departure, an empty service pointer if no other
+				/// departure is in the time window
+				graph::ServicePointer next();
+			};
+
+			//! @name Statistics
+			//@{
+				//////////////////////////////////////////////////////////////////////////
+				/// Number of departures read from the cache since the server start.
+				static long GetHits() { return _hits; }
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Number of departures computed since the server start.
+				static long GetMisses() { return _misses; }
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Number of edges whose departures are stored.
+				static std::size_t GetEntriesNumber();
+			//@}
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Removes all the stored departures.
+			static void Clear();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Removes the departures of the deleted stop points.
+			/// Registered by db::DB::AddModificationCallback.
+			static void Invalidate(const db::DB::DBModifEvent& modifEvent);
+		};
+}	}
+
+#endif // SYNTHESE_departure_boards_DeparturesCache_hpp__
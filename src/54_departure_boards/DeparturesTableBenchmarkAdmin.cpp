@@ -28,6 +28,7 @@
 #include "ModuleAdmin.h"
 #include "DeparturesTableBenchmarkAdmin.h"
 #include "DeparturesTableModule.h"
+#include "DeparturesCache.hpp"
 #include "DisplayScreen.h"
 #include "DisplayScreenCPU.h"
 #include "DisplayAdmin.h"
@@ -240,6 +241,30 @@ namespace synthese
 				stream << f.close();
 			}
 
+			// Departures cache statistics
+			stream << "<h1>Cache des départs</h1>";
+			{
+				long hits(DeparturesCache::GetHits());
+				long misses(DeparturesCache::GetMisses());
+
+				HTMLTable::ColsVector h;
+				h.push_back("Départs lus en cache");
+				h.push_back("Départs calculés");
+				h.push_back("Taux de succès");
+				h.push_back("Parcours en cache");
+				HTMLTable t(h, ResultHTMLTable::CSS_CLASS);
+				stream << t.open();
+				stream << t.row();
+				stream << t.col() << hits;
+				stream << t.col() << misses;
+				stream << t.col();
+				if(hits + misses > 0)
+				{
+					stream << setprecision(1) << fixed << (100.0 * hits / (hits + misses)) << " %";
+				}
+				stream << t.col() << DeparturesCache::GetEntriesNumber();
+				stream << t.close();
+			}
 		}
 
 		bool DeparturesTableBenchmarkAdmin::isAuthorized(
@@ -25,6 +25,8 @@
 
 #include "DeparturesTableModule.h"
 #include "AdvancedSelectTableSync.h"
+#include "DB.hpp"
+#include "DeparturesCache.hpp"
 #include "DisplayType.h"
 #include "DisplayTypeTableSync.h"
 #include "DisplayScreen.h"
@@ -73,6 +75,9 @@ namespace synthese
 			RegisterParameter(DeparturesTableModule::PARAMETER_INEO_SERVER_DB_LOGIN, "", &DeparturesTableModule::ParameterCallback);
 			RegisterParameter(DeparturesTableModule::PARAMETER_INEO_SERVER_DB_PASSWORD, "", &DeparturesTableModule::ParameterCallback);
 			RegisterParameter(DeparturesTableModule::PARAMETER_INEO_SERVER_DB_NAME, "", &DeparturesTableModule::ParameterCallback);
+
+			// Removal of the departures of the deleted stops
+			db::DB::AddModificationCallback(&DeparturesCache::Invalidate);
 		}
 
 		template<> void ModuleClassTemplate<DeparturesTableModule>::Init()
@@ -865,6 +865,25 @@ namespace synthese
 
 
 
+		//////////////////////////////////////////////////////////////////////////
+		/// Without customized rule, the message must be linked to the screen or to
+		/// all the screens.
+		bool DisplayScreen::getRecipientKeys(
+			RecipientKeys& result
+		) const	{
+			if(	_displayType &&
+				_displayType->getMessageIsDisplayedPage()
+			){
+				return false;
+			}
+			result.insert(getKey());
+			result.insert(DisplayScreenTableSync::TABLE.ID);
+			result.insert(0);
+			return true;
+		}
+
+
+
 		bool DisplayScreen::displaysMessage(
 			const Alarm::LinkedObjects& linkedObjects,
 			const util::ParametersMap& parameters
@@ -29,6 +29,7 @@
 #include "GraphConstants.h"
 #include "Service.h"
 #include "AccessParameters.h"
+#include "DeparturesCache.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -127,10 +128,9 @@ namespace synthese
 					// Max time for forced destination
 					ptime maxTimeForForcedDestination(_startDateTime);
 					maxTimeForForcedDestination += _persistanceDuration;
-					ptime minTimeForForcedDestination(_startDateTime);
 					ServicePointer serviceInstance;
 
-					optional<Edge::DepartureServiceIndex::Value> minIndex;
+					DeparturesCache::Cursor departures(ls, _startDateTime, maxTimeForForcedDestination, _allowCanceled);
 
 					// Loop on services while all arrival stops are not reached
 					set<const Edge*> nonServedEdges;
@@ -138,17 +138,7 @@ namespace synthese
 					while(true)
 					{
 						// Next service
-						AccessParameters ap(USER_PEDESTRIAN);
-						serviceInstance = ls.getNextService(
-							ap,
-							minTimeForForcedDestination,
-							maxTimeForForcedDestination,
-							false,
-							minIndex,
-							false,
-							false,
-							_allowCanceled
-						);
+						serviceInstance = departures.next();
 
 						// If no next service was found, quits the current journey pattern
 						if(	serviceInstance.getService() == NULL)
@@ -156,9 +146,6 @@ namespace synthese
 							break;
 						}
 
-						++*minIndex;
-						minTimeForForcedDestination = serviceInstance.getDepartureDateTime();
-
 						// If real time departure stop is forbidden, go to next service
 						if(	_physicalStops.find(serviceInstance.getRealTimeDepartureVertex()->getKey()) == _physicalStops.end()
 						){
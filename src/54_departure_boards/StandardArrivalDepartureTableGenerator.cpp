@@ -22,7 +22,7 @@
 
 #include "StandardArrivalDepartureTableGenerator.h"
 
-#include "AccessParameters.h"
+#include "DeparturesCache.hpp"
 #include "LinePhysicalStop.hpp"
 #include "StopArea.hpp"
 #include "StopPoint.hpp"
@@ -70,8 +70,6 @@ namespace synthese
 				return _result;
 			}
 
-			AccessParameters ap;
-
 			// Loop on the stops
 			BOOST_FOREACH(PhysicalStops::value_type it, _physicalStops)
 			{
@@ -91,23 +89,12 @@ namespace synthese
 					}
 
 					// Loop on services
-					ptime departureDateTime = _startDateTime;
-					optional<Edge::DepartureServiceIndex::Value> index;
+					DeparturesCache::Cursor departures(ls, _startDateTime, _endDateTime, _allowCanceled);
 					size_t insertedServices(0);
 					while(true)
 					{
-						// Tells to the journey pattern for a next service
-						ServicePointer servicePointer(
-							ls.getNextService(
-								ap,
-								departureDateTime,
-								_endDateTime,
-								false,
-								index,
-								false,
-								false,
-								_allowCanceled
-						)	);
+						// Reads the next service of the journey pattern
+						ServicePointer servicePointer(departures.next());
 
 						// If no next service was found, then abort the search in the current journey pattern
 						if(	!servicePointer.getService())
@@ -115,10 +102,6 @@ namespace synthese
 							break;
 						}
 
-						// Saves local variables
-						++*index;
-						departureDateTime = servicePointer.getDepartureDateTime();
-
 						// Checks if the stop area is really served and if the served stop is allowed
 						if(	_physicalStops.find(servicePointer.getRealTimeDepartureVertex()->getKey()) == _physicalStops.end()
 						){
@@ -38,6 +38,7 @@
 #include "PTServiceConfigTableSync.hpp"
 #include "Webpage.h"
 #include "RoadChunkTableSync.h"
+#include "SpatialIndex.hpp"
 #include <geos/geom/LineString.h>
 
 #ifndef UNIX
@@ -341,11 +342,9 @@ namespace synthese
 			{
 				//Best place, which is near the originPoint
 				boost::shared_ptr<Point> originPoint = CoordinatesSystem::GetInstanceCoordinatesSystem().convertPoint(*_originPoint);
-				RoadChunkTableSync::SearchResult  roadChunks = RoadChunkTableSync::SearchByMaxDistance(
+				RoadChunkTableSync::SearchResult  roadChunks = SpatialIndex<MainRoadChunk>::GetByMaxDistance(
 					*originPoint.get(),
-					_maxDistance,//distance  to originPoint
-					Env::GetOfficialEnv(),
-					UP_LINKS_LOAD_LEVEL
+					_maxDistance//distance  to originPoint
 				);
 
 				BOOST_FOREACH(const RoadChunkTableSync::SearchResult::value_type& roadChunk, roadChunks)
@@ -0,0 +1,231 @@
+/** IsochronProfile class implementation.
+	@file IsochronProfile.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "IsochronProfile.hpp"
+
+#include "ParallelSearches.hpp"
+#include "RaptorTimetable.hpp"
+#include "StopArea.hpp"
+#include "StopPoint.hpp"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/ref.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace synthese
+{
+	using namespace algorithm;
+	using namespace graph;
+	using namespace pt;
+	using namespace pt_journey_planner;
+
+	namespace analysis
+	{
+		IsochronProfile::IsochronProfile(
+			const VertexAccessMap& originVam,
+			const AccessParameters& accessParameters,
+			const ptime& beginTime,
+			const ptime& endTime,
+			const time_duration& maxDuration,
+			size_t threadsNumber
+		):	_originVam(originVam),
+			_accessParameters(accessParameters),
+			_beginTime(beginTime),
+			_endTime(endTime),
+			_maxDuration(maxDuration),
+			_threadsNumber(threadsNumber)
+		{}
+
+
+
+		void IsochronProfile::_runPart(
+			const ptime& beginTime,
+			const ptime& endTime,
+			RaptorRoutePlanner::StopArrivals& result
+		) const {
+			RaptorTimetable timetable(
+				_accessParameters,
+				true,
+				true,
+				beginTime.date(),
+				(_endTime + _maxDuration).date()
+			);
+			RaptorRoutePlanner routePlanner(
+				timetable,
+				_originVam,
+				_destinationVam,
+				DEPARTURE_FIRST,
+				optional<time_duration>(),
+				beginTime,
+				endTime,
+				_endTime + _maxDuration,
+				false
+			);
+			routePlanner.runAllStopsProfile(result);
+		}
+
+
+
+		void IsochronProfile::run()
+		{
+			_result.clear();
+			if(_endTime < _beginTime)
+			{
+				return;
+			}
+
+			// Split of the time slot : one part per thread
+			size_t partsNumber(max<size_t>(_threadsNumber, 1));
+			long slotMinutes((_endTime - _beginTime).total_seconds() / 60 + 1);
+			if(partsNumber > static_cast<size_t>(slotMinutes))
+			{
+				partsNumber = static_cast<size_t>(slotMinutes);
+			}
+			vector<RaptorRoutePlanner::StopArrivals> partsResults(partsNumber);
+			ParallelSearches searches(partsNumber);
+			for(size_t part(0); part < partsNumber; ++part)
+			{
+				ptime partBegin(_beginTime + minutes(slotMinutes * part / partsNumber));
+				ptime partEnd(
+					part + 1 == partsNumber ?
+					_endTime :
+					_beginTime + minutes(slotMinutes * (part + 1) / partsNumber) - seconds(1)
+				);
+				searches.add(
+					boost::bind(
+						&IsochronProfile::_runPart,
+						this,
+						partBegin,
+						partEnd,
+						boost::ref(partsResults[part])
+				)	);
+			}
+			searches.run();
+
+			// Merge of the parts by stop area
+			BOOST_FOREACH(const RaptorRoutePlanner::StopArrivals& partResult, partsResults)
+			{
+				BOOST_FOREACH(const RaptorRoutePlanner::StopArrival& stopArrival, partResult)
+				{
+					const StopArea* stopArea(stopArrival.stopPoint->getConnectionPlace());
+					if(!stopArea)
+					{
+						continue;
+					}
+					StopAreaResult& stopAreaResult(_result[stopArea->getKey()]);
+					stopAreaResult.stopArea = stopArea;
+					stopAreaResult.departures.push_back(
+						make_pair(stopArrival.startTime, stopArrival.arrivalTime)
+					);
+				}
+			}
+
+			// Durations
+			for(Result::iterator it(_result.begin()); it != _result.end(); )
+			{
+				_computeDurations(it->second);
+				if(it->second.minutesNumber)
+				{
+					++it;
+				}
+				else
+				{
+					_result.erase(it++);
+				}
+			}
+		}
+
+
+
+		void IsochronProfile::_computeDurations(
+			StopAreaResult& stopAreaResult
+		) const {
+			// Departures useful for the stop area : from the last one to the first
+			// one, the departures which arrive before all the later ones
+			Departures& departures(stopAreaResult.departures);
+			sort(departures.begin(), departures.end());
+			Departures usefulDepartures;
+			for(Departures::const_reverse_iterator it(departures.rbegin()); it != departures.rend(); ++it)
+			{
+				if(	usefulDepartures.empty() ||
+					(	it->second < usefulDepartures.back().second &&
+						it->first < usefulDepartures.back().first
+				)	){
+					usefulDepartures.push_back(*it);
+				}
+				else if(it->first == usefulDepartures.back().first)
+				{
+					// Same departure with a better arrival (sorted by arrival)
+					usefulDepartures.back() = *it;
+				}
+			}
+			reverse(usefulDepartures.begin(), usefulDepartures.end());
+			departures = usefulDepartures;
+
+			// Travel time from each minute of the time slot
+			vector<int> durations;
+			stopAreaResult.firstDuration = optional<int>();
+			Departures::const_iterator next(departures.begin());
+			for(ptime departureTime(_beginTime); departureTime <= _endTime; departureTime += minutes(1))
+			{
+				while(next != departures.end() && next->first < departureTime)
+				{
+					++next;
+				}
+				if(next == departures.end())
+				{
+					break;
+				}
+				time_duration duration(next->second - departureTime);
+				if(duration > _maxDuration)
+				{
+					continue;
+				}
+				int durationMinutes(static_cast<int>(duration.total_seconds() / 60));
+				if(departureTime == _beginTime)
+				{
+					stopAreaResult.firstDuration = durationMinutes;
+				}
+				durations.push_back(durationMinutes);
+			}
+
+			stopAreaResult.minutesNumber = durations.size();
+			if(durations.empty())
+			{
+				return;
+			}
+			int total(0);
+			BOOST_FOREACH(int duration, durations)
+			{
+				total += duration;
+			}
+			stopAreaResult.averageDuration = (total + static_cast<int>(durations.size()) / 2) / static_cast<int>(durations.size());
+			stopAreaResult.minDuration = *min_element(durations.begin(), durations.end());
+			stopAreaResult.maxDuration = *max_element(durations.begin(), durations.end());
+			nth_element(durations.begin(), durations.begin() + durations.size() / 2, durations.end());
+			stopAreaResult.medianDuration = durations[durations.size() / 2];
+		}
+}	}
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+/// IsochronProfile class header.
+///	@file IsochronProfile.hpp
+///
+///	This file belongs to the SYNTHESE project (public transportation specialized
+///	software)
+///	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+///
+///	This program is free software; you can redistribute it and/or
+///	modify it under the terms of the GNU General Public License
+///	as published by the Free Software Foundation; either version 2
+///	of the License, or (at your option) any later version.
+///
+///	This program is distributed in the hope that it will be useful,
+///	but WITHOUT ANY WARRANTY; without even the implied warranty of
+///	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+///	GNU General Public License for more details.
+///
+///	You should have received a copy of the GNU General Public License
+///	along with this program; if not, write to the Free Software Foundation,
+///	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#ifndef SYNTHESE_analysis_IsochronProfile_hpp__
+#define SYNTHESE_analysis_IsochronProfile_hpp__
+
+#include "AccessParameters.h"
+#include "RaptorRoutePlanner.hpp"
+#include "UtilTypes.h"
+#include "VertexAccessMap.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <boost/optional.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace synthese
+{
+	namespace pt
+	{
+		class StopArea;
+	}
+
+	namespace analysis
+	{
+		//////////////////////////////////////////////////////////////////////////
+		/// Travel times from a place to all the stop areas of the network over a
+		/// time slot.
+		///	@ingroup m60
+		//////////////////////////////////////////////////////////////////////////
+		/// The best arrival at each stop as a function of the departure time from
+		/// the place is computed by a single one to all profile search
+		/// (pt_journey_planner::RaptorRoutePlanner::runAllStopsProfile) instead of
+		/// a search per departure time.
+		///
+		/// In parallel mode, the time slot is split into as many parts as threads,
+		/// each part being computed by its own search with its own timetable. The
+		/// profiles of the parts are then merged : the result does not depend on
+		/// the number of threads.
+		///
+		/// The travel times are measured from each minute of the time slot : a
+		/// traveller leaving the place at this minute waits for the next useful
+		/// departure.
+		class IsochronProfile
+		{
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Departure from the place with the arrival at the stop area.
+			typedef std::pair<boost::posix_time::ptime, boost::posix_time::ptime> Departure;
+			typedef std::vector<Departure> Departures;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Travel times to a stop area, in minutes.
+			struct StopAreaResult
+			{
+				const pt::StopArea* stopArea;
+				Departures departures;	//!< useful departures sorted by departure time (the arrival times are sorted too)
+				std::size_t minutesNumber;	//!< number of departure minutes from which the stop area is reached within the maximal duration
+				int minDuration;
+				int averageDuration;
+				int medianDuration;
+				int maxDuration;
+				boost::optional<int> firstDuration;	//!< travel time from the beginning of the time slot
+			};
+			typedef std::map<util::RegistryKeyType, StopAreaResult> Result;
+
+		private:
+			//! @name Parameters
+			//@{
+				const graph::VertexAccessMap _originVam;
+				const graph::VertexAccessMap _destinationVam;
+				const graph::AccessParameters _accessParameters;
+				const boost::posix_time::ptime _beginTime;
+				const boost::posix_time::ptime _endTime;
+				const boost::posix_time::time_duration _maxDuration;
+				const std::size_t _threadsNumber;
+			//@}
+
+			Result _result;
+
+			void _runPart(
+				const boost::posix_time::ptime& beginTime,
+				const boost::posix_time::ptime& endTime,
+				pt_journey_planner::RaptorRoutePlanner::StopArrivals& result
+			) const;
+
+			void _computeDurations(StopAreaResult& stopAreaResult) const;
+
+		public:
+			//////////////////////////////////////////////////////////////////////////
+			/// Constructor.
+			/// @param originVam the stops reachable from the place, with the
+			/// approach durations
+			/// @param accessParameters the access parameters
+			/// @param beginTime first departure time from the place
+			/// @param endTime last departure time from the place
+			/// @param maxDuration maximal travel time
+			/// @param threadsNumber number of threads computing the profile
+			IsochronProfile(
+				const graph::VertexAccessMap& originVam,
+				const graph::AccessParameters& accessParameters,
+				const boost::posix_time::ptime& beginTime,
+				const boost::posix_time::ptime& endTime,
+				const boost::posix_time::time_duration& maxDuration,
+				std::size_t threadsNumber
+			);
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Launches the computing.
+			/// @throws synthese::Exception if the search of a part of the time slot
+			/// has failed
+			void run();
+
+
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Stop areas reached within the maximal duration, by key.
+			const Result& getResult() const { return _result; }
+		};
+}	}
+
+#endif // SYNTHESE_analysis_IsochronProfile_hpp__
@@ -29,10 +29,12 @@
 #include "AdminFunctionRequest.hpp"
 #include "AccessParameters.h"
 #include "AlgorithmLogger.hpp"
+#include "AlgorithmModule.h"
 #include "AnalysisModule.hpp"
 #include "CoordinatesSystem.hpp"
 #include "Edge.h"
 #include "IntegralSearcher.h"
+#include "IsochronProfile.hpp"
 #include "GlobalRight.h"
 #include "ParametersMap.h"
 #include "Place.h"
@@ -43,6 +45,8 @@
 #include "RoadModule.h"
 #include "Vertex.h"
 
+#include <cmath>
+
 using namespace std;
 using namespace boost;
 using namespace boost::posix_time;
@@ -85,6 +89,7 @@ namespace synthese
 		const std::string IsochronService::PARAMETER_FREQUENCY_TYPE("frequency_type");
 		const std::string IsochronService::PARAMETER_SPEED("speed");
 		const std::string IsochronService::PARAMETER_ONLY_WKT("only_wkt");
+		const std::string IsochronService::PARAMETER_GRID_CELL_SIZE("grid_cell_size");
 
 		const std::string IsochronService::PARAMETER_PAGE("page");
 		const std::string IsochronService::PARAMETER_BOARD_PAGE("board_page");
@@ -106,7 +111,8 @@ namespace synthese
 			_speed(4),
 			_durationType(DURATION_TYPE_MEDIAN),
 			_frequencyType(FREQUENCY_TYPE_NO),
-			_onlyWKT(false)
+			_onlyWKT(false),
+			_gridCellSize(0)
 		{
 		}
 
@@ -138,6 +144,7 @@ namespace synthese
 			map.insert(PARAMETER_FREQUENCY_TYPE, lexical_cast<string>(_frequencyType));
 
 			map.insert(PARAMETER_ONLY_WKT, (_onlyWKT ? 1 : 0));
+			map.insert(PARAMETER_GRID_CELL_SIZE, _gridCellSize);
 
 			if(_page.get())
 			{
@@ -245,6 +252,11 @@ namespace synthese
 			_frequencyType = map.getDefault<int>(PARAMETER_FREQUENCY_TYPE, FREQUENCY_TYPE_NO);
 			_speed = map.getDefault<int>(PARAMETER_SPEED, 4);
 			_onlyWKT = map.getDefault<bool>(PARAMETER_ONLY_WKT, false);
+			_gridCellSize = map.getDefault<int>(PARAMETER_GRID_CELL_SIZE, 0);
+			if(_gridCellSize && _gridCellSize < 10)
+			{
+				throw RequestException("The grid cells must be at least 10 meters wide");
+			}
 
 			AccessParameters::AllowedPathClasses allowedPathClasses;
 			string rsStr(map.getDefault<string>(PARAMETER_ROLLING_STOCK_LIST));
@@ -329,134 +341,82 @@ namespace synthese
 					logger
 				);
 
-				GraphIdType graphId = PTModule::GRAPH_ID;
+				// Travel times from each minute of the slot [_beginTimeSlot;_endTimeSlot]
+				IsochronProfile profile(
+					ovam,
+					_accessParameters,
+					ptime(_date, time_duration(hours(_beginTimeSlot))),
+					ptime(_date, time_duration(hours(_endTimeSlot))),
+					minutes(_maxDuration),
+					AlgorithmModule::GetRoutePlannerThreads()
+				);
+				profile.run();
 
 				ResultsMap resultsMap;
-				ResultsMapAccess resultsMapAccess;
-				int nbMinutes = (_endTimeSlot - _beginTimeSlot) * 60;
-
-				// Launch IntergralSearcher for each minute of the slot [_beginTimeSlot;_endTimeSlot]
-				for(int minute=0; minute <= nbMinutes; ++minute)
+				BOOST_FOREACH(const IsochronProfile::Result::value_type& it, profile.getResult())
 				{
-					BestVertexReachesMap bestVertexReachesMap(DEPARTURE_TO_ARRIVAL, ovam, dvam, Vertex::GetMaxIndex());
-					const ptime minMaxDateTimeAtOrigin = ptime(_date, time_duration(hours(_beginTimeSlot) + minutes(minute)));
-					ptime minMaxDateTimeAtDestination = ptime(_date, time_duration(hours(_endTimeSlot)));
-					JourneysResult result(minMaxDateTimeAtOrigin, DEPARTURE_TO_ARRIVAL);
-
-					// Initialization of the IntegralSearcher
-					IntegralSearcher is(
-						DEPARTURE_TO_ARRIVAL,
-						_accessParameters,
-						graphId,
-						false,
-						graphId,
-						result,
-						bestVertexReachesMap,
-						ovam,
-						minMaxDateTimeAtOrigin,
-						minMaxDateTimeAtDestination,
-						minMaxDateTimeAtDestination,
-						false,
-						false,
-						boost::optional<boost::posix_time::time_duration>(),
-						70.0,
-						false,
-						logger,
-						0,
-						boost::optional<const JourneyTemplates&>()
-					);
+					const IsochronProfile::StopAreaResult& stopAreaResult(it.second);
+					const StopArea* reachedPlace(stopAreaResult.stopArea);
 
-					// Launch IntegralSearcher
-					is.integralSearch(
-						ovam,
-						optional<size_t>(_maxConnections),
-						optional<posix_time::time_duration>()
-					);
-
-					// Fill bestResultsMap (results of this iteration)
-					BestResultsMap bestResultsMap;
-					for(JourneysResult::ResultSet::const_iterator it(result.getJourneys().begin()) ;	it != result.getJourneys().end() ; it++)
+					// Ignore StopArea without geometry
+					if(!reachedPlace->getPoint())
 					{
-						const RoutePlanningIntermediateJourney& journey(*it->first);
-						const Vertex* reachedVertex(journey.getEndEdge().getFromVertex());
-						if(!reachedVertex || !dynamic_cast<const StopArea*>(reachedVertex->getHub()))
-						{
-							continue;
-						}
-						const StopArea* reachedPlace = dynamic_cast<const StopArea*>(reachedVertex->getHub());
-
-						if(bestResultsMap.count(reachedPlace->getKey()) == 1)
-						{
-							if(journey.getEffectiveDuration() < (*bestResultsMap[reachedPlace->getKey()]).first->getEffectiveDuration())
-							{
-								bestResultsMap.erase(reachedPlace->getKey());
-								bestResultsMap.insert(pair<RegistryKeyType,JourneysResult::ResultSet::const_iterator>(reachedPlace->getKey(), it));
-							}
-						}
-						else
-						{
-							bestResultsMap.insert(pair<RegistryKeyType,JourneysResult::ResultSet::const_iterator>(reachedPlace->getKey(), it));
-						}
+						continue;
 					}
 
-					// Fill resultsMap (results of all iterations)
-					BOOST_FOREACH(BestResultsMap::value_type it, bestResultsMap)
+					int distance = (int) (_startPlace->getPoint()->distance(reachedPlace->getPoint().get()) / 1000);
+
+					// Tests length constraint
+					if(distance > _maxDistance)
 					{
-						const RoutePlanningIntermediateJourney& journey(*(*it.second).first);
-						const Vertex* reachedVertex(journey.getEndEdge().getFromVertex());
-						if(!reachedVertex || !dynamic_cast<const StopArea*>(reachedVertex->getHub()))
-						{
-							continue;
-						}
-						const StopArea* reachedPlace = dynamic_cast<const StopArea*>(reachedVertex->getHub());
+						continue;
+					}
 
-						// Ignore StopArea without geometry
-						if(!reachedPlace->getPoint())
+					int duration;
+					switch(_durationType)
+					{
+					case DURATION_TYPE_FIXED_DATETIME:
+						if(!stopAreaResult.firstDuration)
 						{
 							continue;
 						}
+						duration = *stopAreaResult.firstDuration;
+						break;
 
-						int distance = (int) (_startPlace->getPoint()->distance(reachedPlace->getPoint().get()) / 1000);
-						int duration = journey.getEffectiveDuration().hours() * 60 + journey.getEffectiveDuration().minutes();
+					case DURATION_TYPE_BEST:
+						duration = stopAreaResult.minDuration;
+						break;
 
-						// Tests time and length constraints
-						if((distance > _maxDistance) || (duration > _maxDuration))
-						{
-							continue;
-						}
+					case DURATION_TYPE_AVERAGE:
+						duration = stopAreaResult.averageDuration;
+						break;
 
-						if(resultsMapAccess.count(reachedPlace->getKey()) == 1) // Update a result in ResultsMap
-						{
-							ResultsMap::iterator itMap = resultsMapAccess[reachedPlace->getKey()];
+					case DURATION_TYPE_WORST:
+						duration = stopAreaResult.maxDuration;
+						break;
 
-							if((minMaxDateTimeAtOrigin.time_of_day() > journey.getFirstDepartureTime(false).time_of_day()) ||
-								(journey.getFirstDepartureTime(false).time_of_day() == (*itMap).second.lastDepartureTime.time_of_day())
-							)
-							{
-								continue;
-							}
+					default:
+						duration = stopAreaResult.medianDuration;
+					}
 
-							(*itMap).second.nbSolutions++;
-							(*itMap).second.lastDepartureTime = journey.getFirstDepartureTime(false);
-							(*itMap).second.timeDepartureList.push_back(journey.getFirstDepartureTime(false));
-							if((*itMap).second.duration > duration)
-							{
-								(*itMap).second.duration = duration;
-							}
-						}
-						else // Add new a result in ResultsMap
+					StopStruct stop;
+					stop.stop = reachedPlace;
+					stop.nbSolutions = 0;
+					stop.duration = duration;
+					stop.minDuration = stopAreaResult.minDuration;
+					stop.averageDuration = stopAreaResult.averageDuration;
+					stop.maxDuration = stopAreaResult.maxDuration;
+					stop.distance = distance;
+					BOOST_FOREACH(const IsochronProfile::Departure& departure, stopAreaResult.departures)
+					{
+						if(departure.second - departure.first > minutes(_maxDuration))
 						{
-							StopStruct stop;
-							stop.stop = reachedPlace;
-							stop.nbSolutions = 1;
-							stop.duration = duration;
-							stop.distance = distance;
-							stop.lastDepartureTime = journey.getFirstDepartureTime();
-							stop.timeDepartureList.push_back(journey.getFirstDepartureTime(false));
-							ResultsMap::iterator itMap = resultsMap.insert(pair<int, StopStruct>(duration, stop));
-							resultsMapAccess.insert(pair<RegistryKeyType,ResultsMap::iterator>(reachedPlace->getKey(), itMap));
+							continue;
 						}
+						++stop.nbSolutions;
+						stop.timeDepartureList.push_back(departure.first);
 					}
+					resultsMap.insert(make_pair(duration, stop));
 				}
 
 				// // CMS output
@@ -502,6 +462,9 @@ namespace synthese
 							pmStop.insert("stop_name", (*it).second.stop->getName());
 							pmStop.insert("nb_solutions", (*it).second.nbSolutions);
 							pmStop.insert("duration", (*it).second.duration);
+							pmStop.insert("min_duration", (*it).second.minDuration);
+							pmStop.insert("average_duration", (*it).second.averageDuration);
+							pmStop.insert("max_duration", (*it).second.maxDuration);
 							pmStop.insert("distance", (*it).second.distance);
 							pmStop.insert("speed", ((*it).second.distance / ((float)(*it).second.duration / 60)));
 
@@ -557,6 +520,41 @@ namespace synthese
 					pm.insert("boards", boardsStream.str());
 					pm.insert("wktPoints", wktPointsStream.str());
 
+					// Rasterised output
+					if(_gridCellSize)
+					{
+						Grid grid(_getGrid(resultsMap));
+						stringstream gridPointsStream;
+						gridPointsStream << "[";
+						bool firstCell(true);
+						BOOST_FOREACH(const Grid::value_type& cell, grid)
+						{
+							boost::shared_ptr<geos::geom::Point> center(
+								CoordinatesSystem::GetInstanceCoordinatesSystem().createPoint(
+									(cell.first.first + 0.5) * _gridCellSize,
+									(cell.first.second + 0.5) * _gridCellSize
+							)	);
+							boost::shared_ptr<geos::geom::Point> wgs84Point(
+								CoordinatesSystem::GetCoordinatesSystem(4326).convertPoint(*center)
+							);
+
+							if(!firstCell)
+								gridPointsStream << ",";
+							else
+								firstCell = false;
+							gridPointsStream << "[ ";
+							gridPointsStream << wgs84Point->getY();
+							gridPointsStream << ", ";
+							gridPointsStream << wgs84Point->getX();
+							gridPointsStream << ", ";
+							gridPointsStream << cell.second; // duration
+							gridPointsStream << " ]";
+						}
+						gridPointsStream << "]";
+						pm.insert("grid_cell_size", _gridCellSize);
+						pm.insert("gridPoints", gridPointsStream.str());
+					}
+
 					_page->display(stream, request, pm);
 				}
 			}
@@ -716,6 +714,76 @@ namespace synthese
 
 
 
+		IsochronService::Grid IsochronService::_getGrid(
+			const ResultsMap& resultsMap
+		) const {
+			Grid result;
+			double speed(_accessParameters.getApproachSpeed());
+			if(speed <= 0)
+			{
+				return result;
+			}
+
+			// Walk sources : the start place and the reached stop areas
+			vector<pair<const geos::geom::Point*, int> > sources;
+			if(_startPlace->getPoint())
+			{
+				sources.push_back(make_pair(_startPlace->getPoint().get(), 0));
+			}
+			for(ResultsMap::const_iterator it(resultsMap.begin()); it != resultsMap.end(); it++)
+			{
+				sources.push_back(make_pair((*it).second.stop->getPoint().get(), (*it).second.duration));
+			}
+
+			for(vector<pair<const geos::geom::Point*, int> >::const_iterator it(sources.begin()); it != sources.end(); ++it)
+			{
+				double x(it->first->getX());
+				double y(it->first->getY());
+				double radius(
+					min(
+						_accessParameters.getMaxApproachDistance(),
+						(_maxDuration - it->second) * 60 * speed
+				)	);
+				if(radius < 0)
+				{
+					continue;
+				}
+
+				for(long column(static_cast<long>(floor((x - radius) / _gridCellSize)));
+					column <= static_cast<long>(floor((x + radius) / _gridCellSize));
+					++column
+				){
+					for(long row(static_cast<long>(floor((y - radius) / _gridCellSize)));
+						row <= static_cast<long>(floor((y + radius) / _gridCellSize));
+						++row
+					){
+						double dx((column + 0.5) * _gridCellSize - x);
+						double dy((row + 0.5) * _gridCellSize - y);
+						double distance(sqrt(dx * dx + dy * dy));
+						if(distance > radius)
+						{
+							continue;
+						}
+
+						int duration(it->second + static_cast<int>(ceil(distance / speed / 60)));
+						Grid::iterator itCell(result.find(make_pair(column, row)));
+						if(itCell == result.end())
+						{
+							result.insert(make_pair(make_pair(column, row), duration));
+						}
+						else if(duration < itCell->second)
+						{
+							itCell->second = duration;
+						}
+					}
+				}
+			}
+
+			return result;
+		}
+
+
+
 		bool IsochronService::isAuthorized(
 			const Session* session
 		) const {
@@ -79,6 +79,7 @@ namespace synthese
 			static const std::string PARAMETER_FREQUENCY_TYPE;
 			static const std::string PARAMETER_SPEED;
 			static const std::string PARAMETER_ONLY_WKT;
+			static const std::string PARAMETER_GRID_CELL_SIZE;
 
 			static const std::string PARAMETER_PAGE;
 			static const std::string PARAMETER_BOARD_PAGE;
@@ -113,14 +114,13 @@ namespace synthese
 				const pt::StopArea* stop;
 				int nbSolutions;
 				int duration;
+				int minDuration;
+				int averageDuration;
+				int maxDuration;
 				int distance;
-				boost::posix_time::ptime lastDepartureTime;
 				std::list<boost::posix_time::ptime> timeDepartureList;
 			} StopStruct;
 
-			// Best result for each StopArea and on one IntegralSearcher iteration
-			typedef std::map<util::RegistryKeyType, algorithm::JourneysResult::ResultSet::const_iterator> BestResultsMap;
-
 			typedef std::pair<int, StopStruct> stopPair;
 			class SortableStop
 			{
@@ -134,8 +134,8 @@ namespace synthese
 			// Results by duration
 			typedef std::multimap<int, StopStruct> ResultsMap;
 
-			// ResultsMap access by StopArea
-			typedef std::map<util::RegistryKeyType, ResultsMap::iterator> ResultsMapAccess;
+			// Rasterised travel times : duration by cell (column, row)
+			typedef std::map<std::pair<long, long>, int> Grid;
 
 			int _maxDistance;
 
@@ -149,6 +149,7 @@ namespace synthese
 			int _durationType;
 			int _frequencyType;
 			bool _onlyWKT;
+			int _gridCellSize;
 
 			std::string	_startPlaceNameText;
 			const CoordinatesSystem* _coordinatesSystem;
@@ -159,6 +160,12 @@ namespace synthese
 			boost::shared_ptr<const cms::Webpage> _stopPage;
 			boost::shared_ptr<const cms::Webpage> _timePage;
 
+			//////////////////////////////////////////////////////////////////////////
+			/// Rasterises the travel times : the value of a cell is the shortest
+			/// travel time to its center, walking from the start place or from a
+			/// reached stop area within the maximal approach distance.
+			Grid _getGrid(const ResultsMap& resultsMap) const;
+
 		public:
 			IsochronService();
 
@@ -39,15 +39,21 @@
 #include "JunctionTableSync.hpp"
 #include "DesignatedLinePhysicalStop.hpp"
 #include "PTUseRuleTableSync.h"
-#include "IConv.hpp"
 #include "ContinuousService.h"
+#include "CoordinatesSystem.hpp"
+#include "CSVReader.hpp"
+#include "ParallelSearches.hpp"
 #include "ZipWriter.hpp"
 #include "Path.h"
 
+#include <algorithm>
 #include <fstream>
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
 #include <boost/date_time/gregorian/greg_date.hpp>
-#include <boost/tokenizer.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 
 #include <geos/geom/LineString.h>
 #include <geos/geom/Geometry.h>
@@ -60,8 +66,6 @@ using namespace boost::algorithm;
 using namespace boost::gregorian;
 using namespace boost::posix_time;
 using namespace geos::geom;
-using boost::tokenizer;
-using boost::escaped_list_separator;
 
 namespace synthese
 {
@@ -75,6 +79,7 @@ namespace synthese
 	using namespace server;
 	using namespace geography;
 	using namespace vehicle;
+	using namespace algorithm;
 
 	namespace util
 	{
@@ -172,182 +177,159 @@ namespace synthese
 
 
 
-		bool GTFSFileFormat::Importer_::_parse(
-			const boost::filesystem::path& filePath,
-			const std::string& key
-		) const {
-			ifstream inFile;
-			inFile.open(filePath.file_string().c_str());
-			if(!inFile)
-			{
-				throw Exception("Could no open the file " + filePath.file_string());
-			}
-			string line;
-			if(!getline(inFile, line))
-			{
-				return false;
-			}
-			_loadFieldsMap(line);
-
-			_logInfo("Loading file "+ filePath.file_string() +" as "+ key);
-
-			DataSource& dataSource(*_import.get<DataSource>());
+		bool GTFSFileFormat::Importer_::parseFiles() const
+		{
+			_clearRows();
+			const size_t threadsNumber(max<size_t>(boost::thread::hardware_concurrency(), 1));
 
-			// 1 : Routes
-			// Stops
-			if(key == FILE_STOPS)
+			// 1 : Parsing of the files
 			{
-				ImportableTableSync::ObjectBySource<StopAreaTableSync> stopAreas(dataSource, _env);
-
-				// 2.1 : stop areas
-				if(_importStopArea)
+				Phase phase(*this, "parsing");
+				map<FileKey, bool> results;
+				ParallelSearches parsing(threadsNumber);
+				BOOST_FOREACH(const FileKey& key, FILES.getFiles())
 				{
-					PTFileFormat::ImportableStopAreas linkedStopAreas;
-					PTFileFormat::ImportableStopAreas nonLinkedStopAreas;
-
-					// Loop
-					while(getline(inFile, line))
+					FilePathsMap::const_iterator it(_pathsMap.find(key));
+					if(it == _pathsMap.end() || it->second.file_string().empty())
 					{
-						_loadLine(line);
-						if(_getValue("location_type") != "1")
-						{
-							continue;
-						}
-
-						string id(_getValue("stop_id"));
-						string name(_getValue("stop_name"));
-
-						PTFileFormat::ImportableStopArea isa;
-						isa.operatorCode = id;
-						isa.name = name;
-						isa.linkedStopAreas = stopAreas.get(id);
-
-						if(isa.linkedStopAreas.empty())
-						{
-							nonLinkedStopAreas.push_back(isa);
-						}
-						else if(_displayLinkedStops)
-						{
-							linkedStopAreas.push_back(isa);
-						}
-						_createOrUpdateStopAreas(
-							stopAreas,
-							id,
-							name,
-							_defaultCity.get(),
-							false,
-							_stopAreaDefaultTransferDuration,
-							dataSource
-						);
+						continue;
 					}
-
-					_exportStopAreas(
-						nonLinkedStopAreas
+					_logInfo("Loading file "+ it->second.file_string() +" as "+ key);
+					parsing.add(
+						boost::bind(&Importer_::_readFile, this, it->second, key, boost::ref(results[key]))
 					);
-					if(_displayLinkedStops)
+				}
+				try
+				{
+					parsing.run();
+				}
+				catch(synthese::Exception& e)
+				{
+					_logError("Error while parsing the GTFS files : "+ e.getMessage());
+					return false;
+				}
+				BOOST_FOREACH(const FileKey& key, FILES.getFiles())
+				{
+					map<FileKey, bool>::const_iterator it(results.find(key));
+					if(it != results.end() && !it->second)
 					{
-						_exportStopAreas(
-							linkedStopAreas
-						);
+						return false;
 					}
 				}
+			}
 
-				// 2.2 : stops
-				PTFileFormat::ImportableStopPoints linkedStopPoints;
-				PTFileFormat::ImportableStopPoints nonLinkedStopPoints;
-
-				// Loop
-				inFile.clear();
-				inFile.seekg(0, ios::beg);
-				getline(inFile, line);
-				while(getline(inFile, line))
+			// 2 : Calendars and stops geometries (the trips signatures are computed
+			// while parsing the stop times file)
+			{
+				Phase phase(*this, "preparation");
+				ParallelSearches preparation(threadsNumber);
+				preparation.add(boost::bind(&Importer_::_buildCalendars, this));
+				for(size_t i(0); i < threadsNumber; ++i)
 				{
-					_loadLine(line);
-					if(_getValue("location_type") != "0")
-					{
-						continue;
-					}
+					preparation.add(
+						boost::bind(
+							&Importer_::_projectStops,
+							this,
+							_stopRows.size() * i / threadsNumber,
+							_stopRows.size() * (i + 1) / threadsNumber
+					)	);
+				}
+				try
+				{
+					preparation.run();
+				}
+				catch(synthese::Exception& e)
+				{
+					_logError("Error while preparing the GTFS data : "+ e.getMessage());
+					return false;
+				}
+				BOOST_FOREACH(const string& warning, _calendarsWarnings)
+				{
+					_logWarning(warning);
+				}
+			}
 
-					string id(_getValue("stop_id"));
-					string name(_getValue("stop_name"));
+			// 3 : Objects creation, in the order of the files
+			{
+				Phase phase(*this, "stops");
+				if(!_createStops())
+				{
+					return false;
+				}
+			}
+			{
+				Phase phase(*this, "networks");
+				_createNetworks();
+			}
+			{
+				Phase phase(*this, "lines");
+				_createLines();
+			}
+			{
+				Phase phase(*this, "trips");
+				_createTrips();
+			}
+			{
+				Phase phase(*this, "services");
+				if(!_createServices())
+				{
+					return false;
+				}
+			}
 
-					string stopAreaId;
+			_clearRows();
+			return true;
+		}
 
-					// Stop area
-					if(_fieldsMap.find("parent_station") != _fieldsMap.end())
-						stopAreaId = _getValue("parent_station");
 
-					const StopArea* stopArea(NULL);
-					if(stopAreas.contains(stopAreaId))
-					{
-						stopArea = *stopAreas.get(stopAreaId).begin();
-					}
-					else if(_stopPoints.contains(id))
-					{
-						stopArea = (*_stopPoints.get(id).begin())->getConnectionPlace();
-					}
-					else
-					{
-						_logWarning(
-							"inconsistent stop area id "+ stopAreaId +" in the stop point "+ id
-						);
-						continue;
-					}
 
-					// Point
-					boost::shared_ptr<geos::geom::Point> point(
-						dataSource.getActualCoordinateSystem().createPoint(
-							lexical_cast<double>(_getValue("stop_lon")),
-							lexical_cast<double>(_getValue("stop_lat"))
-					)	);
-					if(point->isEmpty())
-					{
-						point.reset();
-					}
+		void GTFSFileFormat::Importer_::_readFile(
+			const boost::filesystem::path& filePath,
+			const std::string& key,
+			bool& result
+		) const {
+			result = _parse(filePath, key);
+		}
 
-					PTFileFormat::ImportableStopPoint isp;
-					isp.name = name;
-					isp.linkedStopPoints = _stopPoints.get(id);
-					isp.stopArea = stopArea;
-					isp.coords = point;
 
-					if(isp.linkedStopPoints.empty())
-					{
-						nonLinkedStopPoints.insert(
-							make_pair(id, isp)
-						);
-					}
-					else if(_displayLinkedStops)
-					{
-						linkedStopPoints.insert(
-							make_pair(id, isp)
-						);
-					}
-					// Creation or update
-					_createOrUpdateStop(
-						_stopPoints,
-						id,
-						name,
-						optional<const RuleUser::Rules&>(),
-						stopArea,
-						point.get(),
-						dataSource
-					);
-				}
 
-				_exportStopPoints(
-					nonLinkedStopPoints
-				);
-				if(_displayLinkedStops)
-				{
-					_exportStopPoints(
-						linkedStopPoints
-					);
-				}
+		bool GTFSFileFormat::Importer_::_parse(
+			const boost::filesystem::path& filePath,
+			const std::string& key
+		) const {
+			CSVReader reader(
+				filePath,
+				',',
+				'"',
+				'\\',
+				_import.get<DataSource>()->get<Charset>()
+			);
+			if(!reader.readHeader())
+			{
+				return false;
+			}
 
-				if(!nonLinkedStopPoints.empty())
+			// Stops
+			if(key == FILE_STOPS)
+			{
+				const size_t locationTypeColumn(reader.getColumn("location_type"));
+				const size_t stopIdColumn(reader.getColumn("stop_id"));
+				const size_t stopNameColumn(reader.getColumn("stop_name"));
+				const size_t parentStationColumn(reader.getColumn("parent_station"));
+				const size_t stopLonColumn(reader.getColumn("stop_lon"));
+				const size_t stopLatColumn(reader.getColumn("stop_lat"));
+				while(reader.next())
 				{
-					return false;
+					StopRow row;
+					row.id = reader.getString(stopIdColumn);
+					row.name = reader.getString(stopNameColumn);
+					row.parentStation = reader.getString(parentStationColumn);
+					row.locationType = reader.getString(locationTypeColumn);
+					row.withCoordinates =
+						reader.getDouble(stopLonColumn, row.lon) &&
+						reader.getDouble(stopLatColumn, row.lat)
+					;
+					_stopRows.push_back(row);
 				}
 			}
 			else if(key == FILE_TRANSFERS)
@@ -356,69 +338,34 @@ namespace synthese
 			}
 			else if(key == FILE_AGENCY)
 			{
-				while(getline(inFile, line))
+				const size_t agencyIdColumn(reader.getColumn("agency_id"));
+				const size_t agencyNameColumn(reader.getColumn("agency_name"));
+				while(reader.next())
 				{
-					_loadLine(line);
-
-					_createOrUpdateNetwork(
-						_networks,
-						_getValue("agency_id"),
-						_getValue("agency_name"),
-						dataSource
-					);
+					AgencyRow row;
+					row.id = reader.getString(agencyIdColumn);
+					row.name = reader.getString(agencyNameColumn);
+					_agencyRows.push_back(row);
 				}
 			}
-			// 3 : Lines
 			else if(key == FILE_ROUTES)
 			{
-				while(getline(inFile, line))
+				const size_t agencyIdColumn(reader.getColumn("agency_id"));
+				const size_t routeIdColumn(reader.getColumn("route_id"));
+				const size_t routeColorColumn(reader.getColumn("route_color"));
+				const size_t routeLongNameColumn(reader.getColumn("route_long_name"));
+				const size_t routeShortNameColumn(reader.getColumn("route_short_name"));
+				while(reader.next())
 				{
-					_loadLine(line);
-
-					// Network
-					string networkId(_getValue("agency_id"));
-					string id(_getValue("route_id"));
-					TransportNetwork* network(NULL);
-					if(_networks.contains(networkId))
-					{
-						network = *_networks.get(networkId).begin();
-					}
-					else if(_lines.contains(id))
-					{
-						network = (*_lines.get(id).begin())->getNetwork();
-					}
-					else
-					{
-						_logWarning(
-							"Inconsistent network id "+ networkId +" in the line "+ id
-						);
-						continue;
-					}
-
-					// Color
-					optional<RGBColor> color;
-					string colorStr(_getValue("route_color"));
-					if(colorStr.size() == 6)
-					{
-						color = RGBColor::FromXMLColor("#"+ colorStr);
-					}
-					else if(colorStr.size() == 7 && colorStr[0] == '#')
-					{
-						color = RGBColor::FromXMLColor(colorStr);
-					}
-
-					_createOrUpdateLine(
-						_lines,
-						id,
-						_getValue("route_long_name"),
-						_getValue("route_short_name"),
-						color,
-						*network,
-						dataSource
-					);
+					RouteRow row;
+					row.agencyId = reader.getString(agencyIdColumn);
+					row.id = reader.getString(routeIdColumn);
+					row.color = reader.getString(routeColorColumn);
+					row.longName = reader.getString(routeLongNameColumn);
+					row.shortName = reader.getString(routeShortNameColumn);
+					_routeRows.push_back(row);
 				}
 			}
-			// 4 : Calendars
 			else if(key == FILE_CALENDAR)
 			{
 				vector<string> week_days;
@@ -429,293 +376,690 @@ namespace synthese
 				week_days.push_back("thursday");
 				week_days.push_back("friday");
 				week_days.push_back("saturday");
+				vector<size_t> weekDaysColumns;
+				BOOST_FOREACH(const string& weekDay, week_days)
+				{
+					weekDaysColumns.push_back(reader.getColumn(weekDay));
+				}
+				const size_t serviceIdColumn(reader.getColumn("service_id"));
+				const size_t startDateColumn(reader.getColumn("start_date"));
+				const size_t endDateColumn(reader.getColumn("end_date"));
 
-				while(getline(inFile, line))
+				while(reader.next())
 				{
-					_loadLine(line);
+					CalendarRow row;
+					row.rowNumber = reader.getRowNumber();
+					row.serviceId = reader.getString(serviceIdColumn);
+					row.startDate = reader.getString(startDateColumn);
+					row.endDate = reader.getString(endDateColumn);
+					for(size_t i(0); i < 7; ++i)
+					{
+						row.weekDays[i] = reader.equals(weekDaysColumns[i], "1");
+					}
+					_calendarRows.push_back(row);
+				}
+			}
+			else if(key == FILE_CALENDAR_DATES)
+			{
+				const size_t serviceIdColumn(reader.getColumn("service_id"));
+				const size_t dateColumn(reader.getColumn("date"));
+				const size_t exceptionTypeColumn(reader.getColumn("exception_type"));
+				while(reader.next())
+				{
+					CalendarDateRow row;
+					row.rowNumber = reader.getRowNumber();
+					row.serviceId = reader.getString(serviceIdColumn);
+					row.date = reader.getString(dateColumn);
+					row.active = reader.equals(exceptionTypeColumn, "1");
+					row.inactive = reader.equals(exceptionTypeColumn, "2");
+					_calendarDateRows.push_back(row);
+				}
+			}
+			else if(key == FILE_TRIPS)
+			{
+				const size_t tripIdColumn(reader.getColumn("trip_id"));
+				const size_t routeIdColumn(reader.getColumn("route_id"));
+				const size_t blockIdColumn(reader.getColumn("block_id"));
+				const size_t serviceIdColumn(reader.getColumn("service_id"));
+				const size_t tripHeadsignColumn(reader.getColumn("trip_headsign"));
+				const size_t directionIdColumn(reader.getColumn("direction_id"));
+				while(reader.next())
+				{
+					TripRow row;
+					row.id = reader.getString(tripIdColumn);
+					row.routeId = reader.getString(routeIdColumn);
+					row.blockId = reader.getString(blockIdColumn);
+					row.serviceId = reader.getString(serviceIdColumn);
+					row.headsign = reader.getString(tripHeadsignColumn);
+					long direction(0);
+					reader.getInt(directionIdColumn, direction);
+					row.direction = (direction != 0);
+					_tripRows.push_back(row);
+				}
+			}
+			else if(key == FILE_STOP_TIMES)
+			{
+				_readStopTimes(
+					reader,
+					boost::bind(&Importer_::_addTripSignature, this, _1, _2)
+				);
+			}
+			else if(key == FILE_FARE_ATTRIBUTES)
+			{
+				// TODO
+			}
+			else if(key == FILE_FARE_RULES)
+			{
+				// TODO
+			}
+			else if(key == FILE_SHAPES)
+			{
+				// TODO
+			}
+			else if(key == FILE_FREQUENCIES)
+			{
+				// TODO
+			}
+			return true;
+		}
+
 
-					Calendar c;
 
-					string startDateStr(_getValue("start_date"));
-					string endDateStr(_getValue("end_date"));
-					if(startDateStr.size() != 8 || endDateStr.size() != 8)
+		void GTFSFileFormat::Importer_::_readStopTimes(
+			CSVReader& reader,
+			TripStopTimesHandler handler
+		) const {
+			string tripCode;
+			StopTimeRows stopTimes;
+			time_duration previousArrivalTime, previousDepartureTime;
+			const size_t tripIdColumn(reader.getColumn("trip_id"));
+			const size_t shapeDistTraveledColumn(reader.getColumn("shape_dist_traveled"));
+			const size_t arrivalTimeColumn(reader.getColumn("arrival_time"));
+			const size_t departureTimeColumn(reader.getColumn("departure_time"));
+			const size_t stopIdColumn(reader.getColumn("stop_id"));
+
+			while(reader.next())
+			{
+				// The stop times of a trip are consecutive
+				string rowTripCode(reader.getString(tripIdColumn));
+				if(rowTripCode != tripCode)
+				{
+					if(!stopTimes.empty())
 					{
-						_logWarning(
-							"Inconsistent dates in "+ line +" ("+ startDateStr +" and "+ endDateStr +")"
-						);
-						continue;
+						handler(tripCode, stopTimes);
+						stopTimes.clear();
 					}
-					date startDate(
-						lexical_cast<int>(startDateStr.substr(0,4)),
-						lexical_cast<int>(startDateStr.substr(4,2)),
-						lexical_cast<int>(startDateStr.substr(6,2))
-					);
-					date endDate(
-						lexical_cast<int>(endDateStr.substr(0,4)),
-						lexical_cast<int>(endDateStr.substr(4,2)),
-						lexical_cast<int>(endDateStr.substr(6,2))
-					);
+					tripCode = rowTripCode;
+				}
 
-					for(date curDate(startDate); curDate<=endDate; curDate += days(1))
+				StopTimeRow stopTime;
+				double offset(0);
+				reader.getDouble(shapeDistTraveledColumn, offset);
+				stopTime.offsetFromLast = offset;
+				if(reader.getTime(arrivalTimeColumn, stopTime.arrivalTime))
+				{
+					if(stopTime.arrivalTime.seconds())
 					{
-						if(_getValue(week_days[curDate.day_of_week()]) == "1")
-						{
-							c.setActive(curDate);
-						}
+						stopTime.arrivalTime += seconds(60 - stopTime.arrivalTime.seconds());
 					}
+					previousArrivalTime = stopTime.arrivalTime;
+				}
+				else  // Invalid time duration
+				{
+					stopTime.arrivalTime = previousArrivalTime; // Copy previous regulation stop
+				}
 
-					_calendars[_getValue("service_id")] = c;
+				if(reader.getTime(departureTimeColumn, stopTime.departureTime))
+				{
+					if(stopTime.departureTime.seconds())
+					{
+						stopTime.departureTime -= seconds(stopTime.departureTime.seconds());
+					}
+					previousDepartureTime = stopTime.departureTime;
+				}
+				else // Invalid time duration
+				{
+					stopTime.departureTime = previousDepartureTime; // Copy previous regulation stop
 				}
+
+				stopTime.stopCode = reader.getString(stopIdColumn);
+				stopTimes.push_back(stopTime);
 			}
-			else if(key == FILE_CALENDAR_DATES) // 5
+			if(!stopTimes.empty())
 			{
-				while(getline(inFile, line))
+				handler(tripCode, stopTimes);
+			}
+		}
+
+
+
+		void GTFSFileFormat::Importer_::_buildCalendars() const
+		{
+			BOOST_FOREACH(const CalendarRow& row, _calendarRows)
+			{
+				if(row.startDate.size() != 8 || row.endDate.size() != 8)
 				{
-					_loadLine(line);
+					_calendarsWarnings.push_back(
+						"Inconsistent dates at row "+ lexical_cast<string>(row.rowNumber) +" ("+ row.startDate +" and "+ row.endDate +")"
+					);
+					continue;
+				}
+				date startDate(
+					lexical_cast<int>(row.startDate.substr(0,4)),
+					lexical_cast<int>(row.startDate.substr(4,2)),
+					lexical_cast<int>(row.startDate.substr(6,2))
+				);
+				date endDate(
+					lexical_cast<int>(row.endDate.substr(0,4)),
+					lexical_cast<int>(row.endDate.substr(4,2)),
+					lexical_cast<int>(row.endDate.substr(6,2))
+				);
 
-					std::map<std::string, calendar::Calendar>::iterator it(_calendars.find(_getValue("service_id")));
-					if(it == _calendars.end())
+				Calendar c;
+				for(date curDate(startDate); curDate<=endDate; curDate += days(1))
+				{
+					if(row.weekDays[curDate.day_of_week()])
 					{
-						it = _calendars.insert(make_pair(_getValue("service_id"), Calendar())).first;
+						c.setActive(curDate);
 					}
+				}
 
-					string dateStr(_getValue("date"));
-					if(dateStr.size() != 8)
-					{
-						_logWarning(
-							"Inconsistent date in "+ line
-						);
-						continue;
-					}
-					date d(
-						lexical_cast<int>(dateStr.substr(0,4)),
-						lexical_cast<int>(dateStr.substr(4,2)),
-						lexical_cast<int>(dateStr.substr(6,2))
+				_calendars[row.serviceId] = c;
+			}
+
+			BOOST_FOREACH(const CalendarDateRow& row, _calendarDateRows)
+			{
+				Calendars::iterator it(_calendars.find(row.serviceId));
+				if(it == _calendars.end())
+				{
+					it = _calendars.insert(make_pair(row.serviceId, Calendar())).first;
+				}
+
+				if(row.date.size() != 8)
+				{
+					_calendarsWarnings.push_back(
+						"Inconsistent date at row "+ lexical_cast<string>(row.rowNumber)
 					);
+					continue;
+				}
+				date d(
+					lexical_cast<int>(row.date.substr(0,4)),
+					lexical_cast<int>(row.date.substr(4,2)),
+					lexical_cast<int>(row.date.substr(6,2))
+				);
 
-					if(_getValue("exception_type") == "1")
-					{
-						it->second.setActive(d);
-					}
-					else if(_getValue("exception_type") == "2")
-					{
-						it->second.setInactive(d);
-					}
+				if(row.active)
+				{
+					it->second.setActive(d);
+				}
+				else if(row.inactive)
+				{
+					it->second.setInactive(d);
 				}
 			}
-			// 6 : Routes / Services
-			else if(key == FILE_TRIPS)
+		}
+
+
+
+		void GTFSFileFormat::Importer_::_projectStops(
+			size_t begin,
+			size_t end
+		) const {
+			const CoordinatesSystem& sourceSystem(_import.get<DataSource>()->getActualCoordinateSystem());
+			const CoordinatesSystem& instanceSystem(CoordinatesSystem::GetInstanceCoordinatesSystem());
+			for(size_t i(begin); i < end; ++i)
 			{
-				while(getline(inFile, line))
+				StopRow& row(_stopRows[i]);
+				if(row.locationType != "0" || !row.withCoordinates)
 				{
-					_loadLine(line);
+					continue;
+				}
+				row.point = sourceSystem.createPoint(row.lon, row.lat);
+				if(row.point->isEmpty())
+				{
+					row.point.reset();
+					continue;
+				}
+				row.projectedPoint = instanceSystem.convertPoint(*row.point);
+			}
+		}
+
+
 
-					Trip trip;
+		void GTFSFileFormat::Importer_::_addTripSignature(
+			const string& tripCode,
+			const StopTimeRows& stopTimes
+		) const {
+			string signature;
+			BOOST_FOREACH(const StopTimeRow& stopTime, stopTimes)
+			{
+				signature += stopTime.stopCode;
+				signature.push_back('\0');
+				signature += lexical_cast<string>(stopTime.offsetFromLast);
+				signature.push_back('\0');
+			}
+			_tripsSignatures[tripCode] = &*_signatures.insert(signature).first;
+		}
 
-					// Line
-					string id(_getValue("trip_id"));
-					string lineCode(_getValue("route_id"));
-					if(!_lines.contains(lineCode))
+
+
+		bool GTFSFileFormat::Importer_::_createStops() const
+		{
+			DataSource& dataSource(*_import.get<DataSource>());
+			ImportableTableSync::ObjectBySource<StopAreaTableSync> stopAreas(dataSource, _env);
+
+			// Stop areas
+			if(_importStopArea)
+			{
+				PTFileFormat::ImportableStopAreas linkedStopAreas;
+				PTFileFormat::ImportableStopAreas nonLinkedStopAreas;
+
+				// Loop
+				BOOST_FOREACH(const StopRow& row, _stopRows)
+				{
+					if(row.locationType != "1")
 					{
-						_logWarning(
-							"Inconsistent line id "+ lineCode +" in the trip "+ id
-						);
 						continue;
 					}
-					trip.line = *_lines.get(lineCode).begin();
 
-					// Use rule
-					trip.useRule = NULL;
-					string blockId(_getValue("block_id"));
-					BOOST_FOREACH(const PTUseRuleBlockMasks::value_type& rule, _ptUseRuleBlockMasks)
+					PTFileFormat::ImportableStopArea isa;
+					isa.operatorCode = row.id;
+					isa.name = row.name;
+					isa.linkedStopAreas = stopAreas.get(row.id);
+
+					if(isa.linkedStopAreas.empty())
 					{
-						if(blockId.size() >= rule.first.size() && blockId.substr(0, rule.first.size()) == rule.first)
-						{
-							trip.useRule = rule.second;
-							break;
-						}
+						nonLinkedStopAreas.push_back(isa);
 					}
-
-					// Calendar
-					string calendarCode(_getValue("service_id"));
-					Calendars::const_iterator it(_calendars.find(calendarCode));
-					if(it == _calendars.end())
+					else if(_displayLinkedStops)
 					{
-						_logWarning(
-							"Inconsistent service id "+ calendarCode +" in the trip "+ id
-						);
-						continue;
+						linkedStopAreas.push_back(isa);
 					}
-					trip.calendar = it->second;
+					_createOrUpdateStopAreas(
+						stopAreas,
+						row.id,
+						row.name,
+						_defaultCity.get(),
+						false,
+						_stopAreaDefaultTransferDuration,
+						dataSource
+					);
+				}
+
+				_exportStopAreas(
+					nonLinkedStopAreas
+				);
+				if(_displayLinkedStops)
+				{
+					_exportStopAreas(
+						linkedStopAreas
+					);
+				}
+			}
 
-					// Destination
-					trip.destination = _getValue("trip_headsign");
+			// Stops
+			PTFileFormat::ImportableStopPoints linkedStopPoints;
+			PTFileFormat::ImportableStopPoints nonLinkedStopPoints;
 
-					// Direction
-					trip.direction = lexical_cast<bool>(_getValue("direction_id"));
+			// Loop
+			BOOST_FOREACH(const StopRow& row, _stopRows)
+			{
+				if(row.locationType != "0")
+				{
+					continue;
+				}
 
-					_trips.insert(make_pair(id, trip));
+				// Stop area
+				const StopArea* stopArea(NULL);
+				if(stopAreas.contains(row.parentStation))
+				{
+					stopArea = *stopAreas.get(row.parentStation).begin();
+				}
+				else if(_stopPoints.contains(row.id))
+				{
+					stopArea = (*_stopPoints.get(row.id).begin())->getConnectionPlace();
+				}
+				else
+				{
+					_logWarning(
+						"inconsistent stop area id "+ row.parentStation +" in the stop point "+ row.id
+					);
+					continue;
+				}
+
+				// Point (projected by _projectStops) : the stop is created without
+				// geometry if the coordinates are empty or invalid
+				if(!row.projectedPoint.get())
+				{
+					_logWarning(
+						"inconsistent coordinates in the stop point "+ row.id +" : no geometry"
+					);
+				}
+
+				PTFileFormat::ImportableStopPoint isp;
+				isp.name = row.name;
+				isp.linkedStopPoints = _stopPoints.get(row.id);
+				isp.stopArea = stopArea;
+				isp.coords = row.point;
+
+				if(isp.linkedStopPoints.empty())
+				{
+					nonLinkedStopPoints.insert(
+						make_pair(row.id, isp)
+					);
 				}
+				else if(_displayLinkedStops)
+				{
+					linkedStopPoints.insert(
+						make_pair(row.id, isp)
+					);
+				}
+				// Creation or update
+				_createOrUpdateStop(
+					_stopPoints,
+					row.id,
+					row.name,
+					optional<const RuleUser::Rules&>(),
+					stopArea,
+					row.projectedPoint.get(),
+					dataSource
+				);
 			}
-			else if(key == FILE_STOP_TIMES)
+
+			_exportStopPoints(
+				nonLinkedStopPoints
+			);
+			if(_displayLinkedStops)
 			{
-				string lastTripCode;
-				time_duration previousArrivalTime, previousDepartureTime;
-				TripDetailVector tripDetailVector;
+				_exportStopPoints(
+					linkedStopPoints
+				);
+			}
+
+			return nonLinkedStopPoints.empty();
+		}
 
-				while(getline(inFile, line))
+
+
+		void GTFSFileFormat::Importer_::_createNetworks() const
+		{
+			DataSource& dataSource(*_import.get<DataSource>());
+			BOOST_FOREACH(const AgencyRow& row, _agencyRows)
+			{
+				_createOrUpdateNetwork(
+					_networks,
+					row.id,
+					row.name,
+					dataSource
+				);
+			}
+		}
+
+
+
+		void GTFSFileFormat::Importer_::_createLines() const
+		{
+			DataSource& dataSource(*_import.get<DataSource>());
+			BOOST_FOREACH(const RouteRow& row, _routeRows)
+			{
+				// Network
+				TransportNetwork* network(NULL);
+				if(_networks.contains(row.agencyId))
+				{
+					network = *_networks.get(row.agencyId).begin();
+				}
+				else if(_lines.contains(row.id))
+				{
+					network = (*_lines.get(row.id).begin())->getNetwork();
+				}
+				else
 				{
-					_loadLine(line);
+					_logWarning(
+						"Inconsistent network id "+ row.agencyId +" in the line "+ row.id
+					);
+					continue;
+				}
 
-					string tripCode(_getValue("trip_id"));
-					if(tripCode != lastTripCode && !lastTripCode.empty() && !tripDetailVector.empty())
-					{
-						// Trip
-						TripsMap::const_iterator it(_trips.find(lastTripCode));
-						if(it == _trips.end())
-						{
-							_logWarning(
-								"Inconsistent trip id "+ lastTripCode +" in the trip stops file"
-							);
-							continue;
-						}
-						Trip trip(it->second);
+				// Color
+				optional<RGBColor> color;
+				if(row.color.size() == 6)
+				{
+					color = RGBColor::FromXMLColor("#"+ row.color);
+				}
+				else if(row.color.size() == 7 && row.color[0] == '#')
+				{
+					color = RGBColor::FromXMLColor(row.color);
+				}
 
-						// Route
-						JourneyPattern::StopsWithDepartureArrivalAuthorization stops;
-						MetricOffset offsetSum(0);
-						BOOST_FOREACH(const TripDetail& tripStop, tripDetailVector)
-						{
-							offsetSum += tripStop.offsetFromLast;
-							JourneyPattern::StopWithDepartureArrivalAuthorization stop(
-								tripStop.stop,
-								offsetSum
-							);
-							stops.push_back(stop);
-						}
+				_createOrUpdateLine(
+					_lines,
+					row.id,
+					row.longName,
+					row.shortName,
+					color,
+					*network,
+					dataSource
+				);
+			}
+		}
 
-						// Use rules
-						RuleUser::Rules rules(RuleUser::GetEmptyRules());
-						rules[USER_PEDESTRIAN - USER_CLASS_CODE_OFFSET] = trip.useRule;
-
-						JourneyPattern* route(
-							_createOrUpdateRoute(
-								*trip.line,
-								optional<const string&>(),
-								optional<const string&>(),
-								optional<const string&>(trip.destination),
-								optional<Destination*>(),
-								rules,
-								trip.direction,
-								NULL,
-								stops,
-								dataSource,
-								true,
-								true,
-								true,
-								true
-						)	);
 
-						// Service
-						ScheduledService::Schedules departures;
-						BOOST_FOREACH(const TripDetail& tripStop, tripDetailVector)
-						{
-							departures.push_back(tripStop.departureTime);
-						}
-						ScheduledService::Schedules arrivals;
-						BOOST_FOREACH(const TripDetail& tripStop, tripDetailVector)
-						{
-							arrivals.push_back(tripStop.arrivalTime);
-						}
 
-						ScheduledService* service(
-							_createOrUpdateService(
-								*route,
-								departures,
-								arrivals,
-								lastTripCode,
-								dataSource,
-								optional<const string&>(),
-								optional<const RuleUser::Rules&>(),
-								optional<const JourneyPattern::StopsWithDepartureArrivalAuthorization&>(stops),
-								lastTripCode
-						)	);
-						if(service)
-						{
-							*service |= trip.calendar;
-						}
+		void GTFSFileFormat::Importer_::_createTrips() const
+		{
+			BOOST_FOREACH(const TripRow& row, _tripRows)
+			{
+				Trip trip;
 
-						tripDetailVector.clear();
-					}
+				// Line
+				if(!_lines.contains(row.routeId))
+				{
+					_logWarning(
+						"Inconsistent line id "+ row.routeId +" in the trip "+ row.id
+					);
+					continue;
+				}
+				trip.line = *_lines.get(row.routeId).begin();
 
-					TripDetail tripDetail;
-					if(_getValue("shape_dist_traveled") != "")
-					{
-						tripDetail.offsetFromLast = lexical_cast<MetricOffset>(_getValue("shape_dist_traveled"));
-					}
-					else
-					{
-						tripDetail.offsetFromLast = 0;
-					}
-					stringstream arr_stream(_getValue("arrival_time"));
-					if(arr_stream.str() != "" && arr_stream >> tripDetail.arrivalTime) // Invalid time duration
-					{
-						if(tripDetail.arrivalTime.seconds())
-						{
-							tripDetail.arrivalTime += seconds(60 - tripDetail.arrivalTime.seconds());
-						}
-						previousArrivalTime = tripDetail.arrivalTime;
-					}
-					else  // Invalid time duration
+				// Use rule
+				trip.useRule = NULL;
+				BOOST_FOREACH(const PTUseRuleBlockMasks::value_type& rule, _ptUseRuleBlockMasks)
+				{
+					if(row.blockId.size() >= rule.first.size() && row.blockId.substr(0, rule.first.size()) == rule.first)
 					{
-						tripDetail.arrivalTime = previousArrivalTime; // Copy previous regulation stop
+						trip.useRule = rule.second;
+						break;
 					}
+				}
 
-					stringstream dep_stream(_getValue("departure_time"));
-					if(dep_stream.str() != "" && dep_stream >> tripDetail.departureTime)
-					{
-						if(tripDetail.departureTime.seconds())
-						{
-							tripDetail.departureTime -= seconds(tripDetail.departureTime.seconds());
-						}
-						previousDepartureTime = tripDetail.departureTime;
-					}
-					else // Invalid time duration
-					{
-						tripDetail.departureTime = previousDepartureTime; // Copy previous regulation stop
-					}
+				// Calendar
+				Calendars::const_iterator it(_calendars.find(row.serviceId));
+				if(it == _calendars.end())
+				{
+					_logWarning(
+						"Inconsistent service id "+ row.serviceId +" in the trip "+ row.id
+					);
+					continue;
+				}
+				trip.calendar = it->second;
 
-					string stopCode(_getValue("stop_id"));
-					if(!_stopPoints.contains(stopCode))
-					{
-						_logWarning(
-							"inconsistent stop id "+ stopCode +" in the trip "+ tripCode
-						);
-						continue;
-					}
-					tripDetail.stop = _stopPoints.get(stopCode);
+				// Destination
+				trip.destination = row.headsign;
+
+				// Direction
+				trip.direction = row.direction;
+
+				_trips.insert(make_pair(row.id, trip));
+			}
+		}
+
+
+
+		bool GTFSFileFormat::Importer_::_createServices() const
+		{
+			FilePathsMap::const_iterator it(_pathsMap.find(FILE_STOP_TIMES));
+			CSVReader reader(
+				it->second,
+				',',
+				'"',
+				'\\',
+				_import.get<DataSource>()->get<Charset>()
+			);
+			if(!reader.readHeader())
+			{
+				_logError("The stop times file "+ it->second.file_string() +" cannot be read again");
+				return false;
+			}
+
+			Routes routes;
+			_readStopTimes(
+				reader,
+				boost::bind(&Importer_::_createService, this, _1, _2, boost::ref(routes))
+			);
+			return true;
+		}
+
+
+
+		void GTFSFileFormat::Importer_::_createService(
+			const string& tripCode,
+			const StopTimeRows& stopTimes,
+			Routes& routes
+		) const {
+			DataSource& dataSource(*_import.get<DataSource>());
+
+			// Trip
+			TripsMap::const_iterator it(_trips.find(tripCode));
+			if(it == _trips.end())
+			{
+				_logWarning(
+					"Inconsistent trip id "+ tripCode +" in the trip stops file"
+				);
+				return;
+			}
+			const Trip& trip(it->second);
+
+			// Signature
+			TripsSignatures::const_iterator itSignature(_tripsSignatures.find(tripCode));
+			if(itSignature == _tripsSignatures.end())
+			{
+				_logWarning(
+					"Inconsistent trip id "+ tripCode +" : the trip stops file has changed during the import"
+				);
+				return;
+			}
 
-					tripDetailVector.push_back(tripDetail);
-					lastTripCode = tripCode;
+			// Stops
+			TripDetailVector tripDetailVector;
+			BOOST_FOREACH(const StopTimeRow& stopTime, stopTimes)
+			{
+				if(!_stopPoints.contains(stopTime.stopCode))
+				{
+					_logWarning(
+						"inconsistent stop id "+ stopTime.stopCode +" in the trip "+ tripCode
+					);
+					continue;
 				}
+				TripDetail tripDetail;
+				tripDetail.arrivalTime = stopTime.arrivalTime;
+				tripDetail.departureTime = stopTime.departureTime;
+				tripDetail.offsetFromLast = stopTime.offsetFromLast;
+				tripDetail.stop = _stopPoints.get(stopTime.stopCode);
+				tripDetailVector.push_back(tripDetail);
 			}
-			else if(key == FILE_FARE_ATTRIBUTES)
+			if(tripDetailVector.empty())
 			{
-				// TODO
+				return;
 			}
-			else if(key == FILE_FARE_RULES)
+
+			// Route
+			JourneyPattern::StopsWithDepartureArrivalAuthorization stops;
+			MetricOffset offsetSum(0);
+			BOOST_FOREACH(const TripDetail& tripStop, tripDetailVector)
 			{
-				// TODO
+				offsetSum += tripStop.offsetFromLast;
+				JourneyPattern::StopWithDepartureArrivalAuthorization stop(
+					tripStop.stop,
+					offsetSum
+				);
+				stops.push_back(stop);
 			}
-			else if(key == FILE_SHAPES)
+
+			RouteKey routeKey(itSignature->second, trip.line, trip.useRule, trip.destination, trip.direction);
+			Routes::const_iterator itRoute(routes.find(routeKey));
+			JourneyPattern* route(NULL);
+			if(itRoute == routes.end())
 			{
-				// TODO
+				// Use rules
+				RuleUser::Rules rules(RuleUser::GetEmptyRules());
+				rules[USER_PEDESTRIAN - USER_CLASS_CODE_OFFSET] = trip.useRule;
+
+				route = _createOrUpdateRoute(
+					*trip.line,
+					optional<const string&>(),
+					optional<const string&>(),
+					optional<const string&>(trip.destination),
+					optional<Destination*>(),
+					rules,
+					trip.direction,
+					NULL,
+					stops,
+					dataSource,
+					true,
+					true,
+					true,
+					true
+				);
+				routes.insert(make_pair(routeKey, route));
 			}
-			else if(key == FILE_FREQUENCIES)
+			else
 			{
-				// TODO
+				route = itRoute->second;
+			}
+
+			// Service
+			ScheduledService::Schedules departures;
+			BOOST_FOREACH(const TripDetail& tripStop, tripDetailVector)
+			{
+				departures.push_back(tripStop.departureTime);
+			}
+			ScheduledService::Schedules arrivals;
+			BOOST_FOREACH(const TripDetail& tripStop, tripDetailVector)
+			{
+				arrivals.push_back(tripStop.arrivalTime);
+			}
+
+			ScheduledService* service(
+				_createOrUpdateService(
+					*route,
+					departures,
+					arrivals,
+					tripCode,
+					dataSource,
+					optional<const string&>(),
+					optional<const RuleUser::Rules&>(),
+					optional<const JourneyPattern::StopsWithDepartureArrivalAuthorization&>(stops),
+					tripCode
+			)	);
+			if(service)
+			{
+				*service |= trip.calendar;
 			}
-			return true;
+		}
+
+
+
+		void GTFSFileFormat::Importer_::_clearRows() const
+		{
+			vector<StopRow>().swap(_stopRows);
+			vector<AgencyRow>().swap(_agencyRows);
+			vector<RouteRow>().swap(_routeRows);
+			vector<CalendarRow>().swap(_calendarRows);
+			vector<CalendarDateRow>().swap(_calendarDateRows);
+			vector<TripRow>().swap(_tripRows);
+			_tripsSignatures.clear();
+			_signatures.clear();
+			_calendarsWarnings.clear();
 		}
 
 
@@ -768,54 +1112,6 @@ namespace synthese
 
 
 
-		void GTFSFileFormat::Importer_::_loadFieldsMap( const std::string& line ) const
-		{
-			vector<string> cols;
-			split(
-				cols,
-				line[line.size() - 1] == '\r' ? line.substr(0, line.size() - 1) : line,
-				is_any_of(SEP)
-			);
-			_fieldsMap.clear();
-			size_t rank(0);
-			BOOST_FOREACH(const string& col, cols)
-			{
-				_fieldsMap[col] = rank;
-				++rank;
-			}
-		}
-
-
-
-		std::string GTFSFileFormat::Importer_::_getValue( const std::string& field ) const
-		{
-			return trim_copy(_line[_fieldsMap[field]]);
-		}
-
-
-
-		void GTFSFileFormat::Importer_::_loadLine( const std::string& line ) const
-		{
-			_line.clear();
-			if(!line.empty())
-			{
-				string utfline(
-					line[line.size() - 1] == '\r' ?
-					line.substr(0, line.size() - 1) :
-					line
-				);
-				utfline = IConv(_import.get<DataSource>()->get<Charset>(), "UTF-8").convert(line);
-
-				tokenizer<escaped_list_separator<char> > tok(utfline, escaped_list_separator<char>('\\', ',', '\"'));
-				for(tokenizer<escaped_list_separator<char> >::iterator beg=tok.begin(); beg!=tok.end(); ++beg)
-				{
-					_line.push_back(*beg);
-				}
-			}
-		}
-
-
-
 		util::ParametersMap GTFSFileFormat::Importer_::_getParametersMap() const
 		{
 			ParametersMap map(PTDataCleanerFileFormat::_getParametersMap());
@@ -1178,7 +1474,7 @@ namespace synthese
 
 				if(stopPoint->hasGeometry())
 				{
-					gp = CoordinatesSystem::GetCoordinatesSystem(WGS84_SRID).convertPoint(*stopPoint->getGeometry());
+					gp = stopPoint->getProjectedGeometry(CoordinatesSystem::GetCoordinatesSystem(WGS84_SRID));
 				}
 
 				if(gp.get())
@@ -1401,7 +1697,7 @@ namespace synthese
 				boost::shared_ptr<geos::geom::Point> gp;
 				if(stopPoint.hasGeometry())
 				{
-					gp = CoordinatesSystem::GetCoordinatesSystem(WGS84_SRID).convertPoint(*stopPoint.getGeometry());
+					gp = stopPoint.getProjectedGeometry(CoordinatesSystem::GetCoordinatesSystem(WGS84_SRID));
 				}
 
 				if(gp.get())
@@ -1439,7 +1735,7 @@ namespace synthese
 					{
 						if(stops.begin()->second->hasGeometry())
 						{
-							gp = CoordinatesSystem::GetCoordinatesSystem(WGS84_SRID).convertPoint(*stops.begin()->second->getGeometry());
+							gp = stops.begin()->second->getProjectedGeometry(CoordinatesSystem::GetCoordinatesSystem(WGS84_SRID));
 						}
 					}
 				}
@@ -43,7 +43,10 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <set>
 #include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/function.hpp>
+#include <boost/tuple/tuple.hpp>
 
 namespace synthese
 {
@@ -57,6 +60,11 @@ namespace synthese
 		class City;
 	}
 
+	namespace impex
+	{
+		class CSVReader;
+	}
+
 	namespace pt
 	{
 		class JourneyPattern;
@@ -113,19 +121,10 @@ namespace synthese
 				boost::shared_ptr<const geography::City> _defaultCity;
 				boost::posix_time::time_duration _stopAreaDefaultTransferDuration;
 
-				typedef std::map<std::string, std::size_t> FieldsMap;
-				mutable FieldsMap _fieldsMap;
-
 				typedef std::map<std::string, const pt::PTUseRule*> PTUseRuleBlockMasks;
 				PTUseRuleBlockMasks _ptUseRuleBlockMasks;
 				static std::string _serializePTUseRuleBlockMasks(const PTUseRuleBlockMasks& object);
 
-				mutable std::vector<std::string> _line;
-
-				void _loadFieldsMap(const std::string& line) const;
-				std::string _getValue(const std::string& field) const;
-				void _loadLine(const std::string& line) const;
-
 				typedef std::map<std::string, calendar::Calendar> Calendars;
 				mutable Calendars _calendars;
 
@@ -153,6 +152,141 @@ namespace synthese
 				};
 				typedef std::vector<TripDetail> TripDetailVector;
 
+				//! @name Rows read by _parse
+				//@{
+					struct StopRow
+					{
+						std::string id;
+						std::string name;
+						std::string parentStation;
+						std::string locationType;
+						bool withCoordinates;
+						double lon;
+						double lat;
+						boost::shared_ptr<geos::geom::Point> point;				//!< In the coordinates system of the data source
+						boost::shared_ptr<geos::geom::Point> projectedPoint;	//!< In the coordinates system of the instance
+					};
+					mutable std::vector<StopRow> _stopRows;
+
+					struct AgencyRow
+					{
+						std::string id;
+						std::string name;
+					};
+					mutable std::vector<AgencyRow> _agencyRows;
+
+					struct RouteRow
+					{
+						std::string id;
+						std::string agencyId;
+						std::string color;
+						std::string longName;
+						std::string shortName;
+					};
+					mutable std::vector<RouteRow> _routeRows;
+
+					struct CalendarRow
+					{
+						std::size_t rowNumber;
+						std::string serviceId;
+						std::string startDate;
+						std::string endDate;
+						bool weekDays[7];	//!< From sunday to saturday
+					};
+					mutable std::vector<CalendarRow> _calendarRows;
+
+					struct CalendarDateRow
+					{
+						std::size_t rowNumber;
+						std::string serviceId;
+						std::string date;
+						bool active;
+						bool inactive;
+					};
+					mutable std::vector<CalendarDateRow> _calendarDateRows;
+
+					struct TripRow
+					{
+						std::string id;
+						std::string routeId;
+						std::string blockId;
+						std::string serviceId;
+						std::string headsign;
+						bool direction;
+					};
+					mutable std::vector<TripRow> _tripRows;
+
+					struct StopTimeRow
+					{
+						std::string stopCode;
+						boost::posix_time::time_duration arrivalTime;
+						boost::posix_time::time_duration departureTime;
+						graph::MetricOffset offsetFromLast;
+					};
+					typedef std::vector<StopTimeRow> StopTimeRows;
+
+					/// Stops and offsets of the trips, shared by the trips of a same route.
+					/// The stop times themselves are not kept : the stop times file is read
+					/// again trip by trip when the services are created.
+					typedef std::set<std::string> Signatures;
+					mutable Signatures _signatures;
+					typedef std::map<std::string, const std::string*> TripsSignatures;
+					mutable TripsSignatures _tripsSignatures;
+
+					mutable std::vector<std::string> _calendarsWarnings;
+				//@}
+
+				void _readFile(
+					const boost::filesystem::path& filePath,
+					const std::string& key,
+					bool& result
+				) const;
+
+				typedef boost::function<void (const std::string&, const StopTimeRows&)> TripStopTimesHandler;
+
+				//////////////////////////////////////////////////////////////////////////
+				/// Reads the stop times file and sends the stop times of each trip to
+				/// the handler (the stop times of a trip are consecutive).
+				void _readStopTimes(
+					impex::CSVReader& reader,
+					TripStopTimesHandler handler
+				) const;
+
+				//! @name Preparation of the rows (run in parallel)
+				//@{
+					void _buildCalendars() const;
+					void _projectStops(std::size_t begin, std::size_t end) const;
+					void _addTripSignature(const std::string& tripCode, const StopTimeRows& stopTimes) const;
+				//@}
+
+				//! @name Objects creation (run in the order of the files)
+				//@{
+					bool _createStops() const;
+					void _createNetworks() const;
+					void _createLines() const;
+					void _createTrips() const;
+					bool _createServices() const;
+
+					/// Routes already found for a stops signature, a line, a use rule, a
+					/// destination and a direction
+					typedef boost::tuple<
+						const std::string*,
+						const pt::CommercialLine*,
+						const pt::PTUseRule*,
+						std::string,
+						bool
+					> RouteKey;
+					typedef std::map<RouteKey, pt::JourneyPattern*> Routes;
+
+					void _createService(
+						const std::string& tripCode,
+						const StopTimeRows& stopTimes,
+						Routes& routes
+					) const;
+				//@}
+
+				void _clearRows() const;
+
 
 			protected:
 
@@ -196,6 +330,23 @@ namespace synthese
 
 
 
+				//////////////////////////////////////////////////////////////////////////
+				/// Reads the files and creates the objects.
+				/// <ol>
+				///		<li>the files are parsed in parallel, each one in its rows</li>
+				///		<li>the calendars are built, the coordinates of the stops are
+				///		projected and the signatures of the trips are computed in
+				///		parallel</li>
+				///		<li>the objects are created in the order of the files, so the
+				///		ids are allocated in the same order at each import</li>
+				/// </ol>
+				/// The duration of each stage is reported in the import log.
+				/// @return false if a file could not be read or if a stop is not
+				/// linked
+				virtual bool parseFiles() const;
+
+
+
 				virtual db::DBTransaction _save() const;
 			};
 
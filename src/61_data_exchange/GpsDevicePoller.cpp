@@ -41,6 +41,7 @@
 #include "Vehicle.hpp"
 #include "VehicleModule.hpp"
 #include "StopPointTableSync.hpp"
+#include "SpatialIndex.hpp"
 
 #include <boost/thread.hpp>
 #include <boost/format.hpp>
@@ -151,27 +152,13 @@ DEBUG(JD)*/
 							);
 
 							// Nearest stop point
-							StopPoint* nearestStopPoint(NULL);
 							double maxdistance(3000.0);
-							double lastDistance(0.0);
-							pt::StopPointTableSync::SearchResult  sr = pt::StopPointTableSync::SearchByMaxDistance(
-								*projectedPoint.get(),
-								maxdistance, //distance  to originPoint
-								Env::GetOfficialEnv(),
-								UP_LINKS_LOAD_LEVEL
-							);
-
-							BOOST_FOREACH(boost::shared_ptr<StopPoint> sp, sr)
-							{
-								double dst(sp->getGeometry()->distance(projectedPoint.get()));
-
-								if(!nearestStopPoint || dst < lastDistance)
-								{
-									lastDistance = dst;
-									nearestStopPoint = sp.get();
-								}
-							}
-							VehicleModule::GetCurrentVehiclePosition().setStopPoint(nearestStopPoint);
+							boost::shared_ptr<StopPoint> nearestStopPoint(
+								geography::SpatialIndex<StopPoint>::GetNearest(
+									*projectedPoint.get(),
+									maxdistance //distance  to originPoint
+							)	);
+							VehicleModule::GetCurrentVehiclePosition().setStopPoint(nearestStopPoint.get());
 							
 
 							// update Vehicle position.
@@ -37,7 +37,7 @@
 #include "JunctionTableSync.hpp"
 #include "DesignatedLinePhysicalStop.hpp"
 #include "PTUseRuleTableSync.h"
-#include "IConv.hpp"
+#include "CSVReader.hpp"
 #include "CommercialLineTableSync.h"
 #include "RollingStockTableSync.hpp"
 
@@ -162,13 +162,13 @@ namespace synthese
 			const boost::filesystem::path& filePath,
 			const std::string& key
 		) const {
-			ifstream inFile;
-			inFile.open(filePath.file_string().c_str());
-			if(!inFile)
-			{
-				throw Exception("Could no open the file " + filePath.file_string());
-			}
-			string line;
+			CSVReader reader(
+				filePath,
+				SEP[0],
+				0,
+				0,
+				_import.get<DataSource>()->get<Charset>()
+			);
 			_logDebug(
 				"Loading file "+ filePath.file_string() +" as "+ key
 			);
@@ -179,16 +179,15 @@ namespace synthese
 			if(key == FILE_ARRETS)
 			{
 				// Loop
-				while(getline(inFile, line))
+				while(reader.next())
 				{
 					// Strings
-					_loadLine(line);
-					string code(_getValue(0));
-					string name(_getValue(1));
-					string x(_getValue(2));
-					string y(_getValue(3));
-					string cityCode(_getValue(6));
-					bool handicapped(_getValue(7) == "1");
+					string code(reader.getString(0));
+					string name(reader.getString(1));
+					string x(reader.getString(2));
+					string y(reader.getString(3));
+					string cityCode(reader.getString(6));
+					bool handicapped(reader.equals(7, "1"));
 
 					// City
 					City* cityForStopAreaAutoGeneration(NULL);
@@ -209,24 +208,17 @@ namespace synthese
 
 					// Point
 					boost::shared_ptr<geos::geom::Point> point;
-					if(!x.empty() && !y.empty())
+					double xValue;
+					double yValue;
+					if(reader.getDouble(2, xValue) && reader.getDouble(3, yValue))
 					{
-						try
-						{
-							point = dataSource.getActualCoordinateSystem().createPoint(
-								lexical_cast<double>(x),
-								lexical_cast<double>(y)
-							);
-							if(point->isEmpty())
-							{
-								point.reset();
-							}
-						}
-						catch(boost::bad_lexical_cast&)
+						point = dataSource.getActualCoordinateSystem().createPoint(
+							xValue,
+							yValue
+						);
+						if(point->isEmpty())
 						{
-							_logWarning(
-								"Stop "+ code +" has invalid coordinate"
-							);
+							point.reset();
 						}
 					}
 					else
@@ -271,20 +263,18 @@ namespace synthese
 			// Services
 			else if(key == FILE_VOYAGES)
 			{
-				while(getline(inFile, line))
+				while(reader.next())
 				{
 					// Strings
-					_loadLine(line);
-
 					date day(
-						from_string(_getValue(0))
+						from_string(reader.getString(0))
 					);
 					TripIndex trip;
-					trip.lineCode = _getValue(1);
-					trip.routeCode = _getValue(4);
-					trip.code = _getValue(5);
-					trip.team = _getValue(6);
-					trip.handicapped = (_getValue(13) == "X");
+					trip.lineCode = reader.getString(1);
+					trip.routeCode = reader.getString(4);
+					trip.code = reader.getString(5);
+					trip.team = reader.getString(6);
+					trip.handicapped = reader.equals(13, "X");
 
 					size_t pos = trip.team.rfind('-');
 					if(pos != string::npos && pos + 1 < trip.team.length())
@@ -303,9 +293,10 @@ namespace synthese
 						).first;
 					}
 					itTrip->second.calendar.setActive(day);
-					itTrip->second.routeName = _getValue(10);
-					itTrip->second.wayBack = (_getValue(12) == "Retour");
-					itTrip->second.rollingStock = (_rollingStocks.find(_getValue(3)) == _rollingStocks.end()) ? _defaultRollingStock.get() : _rollingStocks.find(_getValue(3))->second.get();
+					itTrip->second.routeName = reader.getString(10);
+					itTrip->second.wayBack = reader.equals(12, "Retour");
+					RollingStockMap::const_iterator itRollingStock(_rollingStocks.find(reader.getString(3)));
+					itTrip->second.rollingStock = (itRollingStock == _rollingStocks.end()) ? _defaultRollingStock.get() : itRollingStock->second.get();
 					_tripsByCode[trip.code].insert(trip);
 				}
 			}
@@ -315,21 +306,22 @@ namespace synthese
 				string lastCode;
 				MetricOffset distance(0);
 
-				while(getline(inFile, line))
+				while(reader.next())
 				{
 					// Strings
-					_loadLine(line);
-					string stopCode(_getValue(0));
-					MetricOffset delta(
-						lexical_cast<MetricOffset>(
-							_getValue(2)
-					)	);
-					time_duration schedule(
-						duration_from_string(
-							_getValue(3)
-					)	);
-					string code(_getValue(4));
-					bool withSchedules(_getValue(5) == "REGUL");
+					string stopCode(reader.getString(0));
+					MetricOffset delta;
+					if(!reader.getDouble(2, delta))
+					{
+						delta = lexical_cast<MetricOffset>(reader.getString(2));
+					}
+					time_duration schedule;
+					if(!reader.getTime(3, schedule))
+					{
+						schedule = duration_from_string(reader.getString(3));
+					}
+					string code(reader.getString(4));
+					bool withSchedules(reader.equals(5, "REGUL"));
 
 					// Object change
 					if(lastCode != code)
@@ -488,30 +480,6 @@ namespace synthese
 
 
 
-		std::string HastusCSVFileFormat::Importer_::_getValue( std::size_t rank ) const
-		{
-			return trim_copy(_line[rank]);
-		}
-
-
-
-		void HastusCSVFileFormat::Importer_::_loadLine( const std::string& line ) const
-		{
-			_line.clear();
-			if(!line.empty())
-			{
-				string utfline(
-					line[line.size() - 1] == '\r' ?
-					line.substr(0, line.size() - 1) :
-					line
-				);
-				utfline = IConv(_import.get<DataSource>()->get<Charset>(), "UTF-8").convert(line);
-				split(_line, utfline, is_any_of(SEP));
-			}
-		}
-
-
-
 		util::ParametersMap HastusCSVFileFormat::Importer_::_getParametersMap() const
 		{
 			ParametersMap map(PTDataCleanerFileFormat::_getParametersMap());
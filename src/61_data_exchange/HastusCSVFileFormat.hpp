@@ -103,9 +103,6 @@ namespace synthese
 				boost::shared_ptr<pt::PTUseRule> _handicappedAllowedUseRule;
 				boost::shared_ptr<pt::PTUseRule> _handicappedForbiddenUseRule;
 
-				mutable std::vector<std::string> _line;
-				std::string _getValue(std::size_t rank) const;
-				void _loadLine(const std::string& line) const;
 
 				//////////////////////////////////////////////////////////////////////////
 				/// Temporary storage of a trip.
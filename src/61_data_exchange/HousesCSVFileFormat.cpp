@@ -30,10 +30,12 @@
 #include "RoadPlaceTableSync.h"
 #include "RoadModule.h"
 #include "CityTableSync.h"
+#include "CSVReader.hpp"
 #include "DataSource.h"
 #include "Crossing.h"
 #include "CoordinatesSystem.hpp"
 #include "DBTransaction.hpp"
+#include "Exception.h"
 #include "VirtualShapeVirtualTable.hpp"
 #include "AdminFunctionRequest.hpp"
 #include "FrenchPhoneticString.h"
@@ -157,12 +159,20 @@ namespace synthese
 				size_t badGeometry(0);
 
 				{
-					ifstream inFile;
-					string line;
-
 					_logDebug("Loading file "+ filePath.file_string());
-					inFile.open(filePath.file_string().c_str());
-					if(!inFile)
+					boost::shared_ptr<CSVReader> reader;
+					try
+					{
+						reader.reset(
+							new CSVReader(
+								filePath,
+								SEP[0],
+								0,
+								0,
+								dataSource.get<Charset>()
+						)	);
+					}
+					catch(synthese::Exception&)
 					{
 						_logError("Could not open the file "+ filePath.file_string());
 						return false;
@@ -170,9 +180,7 @@ namespace synthese
 					// Ignore header lines
 					for(int i = 0; i < _numberOfLinesToIgnore; i++)
 					{
-						if(getline(inFile, line))
-							_loadLine(line);
-						else
+						if(!reader->next())
 						{
 							_logError(
 								"Error with the number of lines to ignore : "+ lexical_cast<string>(_numberOfLinesToIgnore)
@@ -207,10 +215,9 @@ namespace synthese
 						return false;
 					}
 
-					while(getline(inFile, line))
+					while(reader->next())
 					{
-						_loadLine(line);
-
+						const size_t fieldsNumber(reader->getFieldsNumber());
 						string cityCode;
 						string cityName;
 						string roadName;
@@ -218,34 +225,53 @@ namespace synthese
 						double x;
 						double y;
 
-						if(_line.size() > *_cityCodeField)
-							cityCode = _getValue(*_cityCodeField);
+						if(fieldsNumber > *_cityCodeField)
+							cityCode = reader->getString(*_cityCodeField);
 						else
 							continue;
 
-						if(_line.size() > *_cityNameField)
-							cityName = _getValue(*_cityNameField);
+						if(fieldsNumber > *_cityNameField)
+							cityName = reader->getString(*_cityNameField);
 						else
 							continue;
 
-						if(_line.size() > *_roadNameField)
-							roadName = _getValue(*_roadNameField);
+						if(fieldsNumber > *_roadNameField)
+							roadName = reader->getString(*_roadNameField);
 						else
 							continue;
 						boost::algorithm::trim(roadName);
 
-						if(_line.size() > *_numberField)
-							number = lexical_cast<int>(_getValue(*_numberField));
+						long value;
+						if(fieldsNumber > *_numberField)
+						{
+							if(!reader->getInt(*_numberField, value))
+							{
+								value = lexical_cast<int>(reader->getString(*_numberField));
+							}
+							number = value;
+						}
 						else
 							continue;
 						
-						if(_line.size() > *_geometryXField)
-							x = lexical_cast<int>(_getValue(*_geometryXField));
+						if(fieldsNumber > *_geometryXField)
+						{
+							if(!reader->getInt(*_geometryXField, value))
+							{
+								value = lexical_cast<int>(reader->getString(*_geometryXField));
+							}
+							x = value;
+						}
 						else
 							continue;
 
-						if(_line.size() > *_geometryYField)
-							y = lexical_cast<int>(_getValue(*_geometryYField));
+						if(fieldsNumber > *_geometryYField)
+						{
+							if(!reader->getInt(*_geometryYField, value))
+							{
+								value = lexical_cast<int>(reader->getString(*_geometryYField));
+							}
+							y = value;
+						}
 						else
 							continue;					
 						boost::shared_ptr<Point> geometry(CoordinatesSystem::GetInstanceCoordinatesSystem().convertPoint(
@@ -421,28 +447,4 @@ namespace synthese
 			_geometryXField = map.getOptional<size_t>(PARAMETER_FIELD_GEOMETRY_X);
 			_geometryYField = map.getOptional<size_t>(PARAMETER_FIELD_GEOMETRY_Y);
 		}
-
-
-
-		std::string HousesCSVFileFormat::Importer_::_getValue( const std::size_t field ) const
-		{
-			return trim_copy(_line[field]);
-		}
-
-
-
-		void HousesCSVFileFormat::Importer_::_loadLine( const std::string& line ) const
-		{
-			_line.clear();
-			if(!line.empty())
-			{
-				string utfline(
-					line[line.size() - 1] == '\r' ?
-					line.substr(0, line.size() - 1) :
-				line
-					);
-				utfline = IConv(_import.get<DataSource>()->get<Charset>(), "UTF-8").convert(line);
-				split(_line, utfline, is_any_of(SEP));
-			}
-		}
 }	}
@@ -105,8 +105,6 @@ namespace synthese
 				boost::optional<std::size_t> _geometryXField;
 				boost::optional<std::size_t> _geometryYField;
 
-				mutable std::vector<std::string> _line;
-
 				//////////////////////////////////////////////////////////////////////////
 				/// Checks that all necessary input files are available.
 				/// @result true if all necessary files are present
@@ -126,11 +124,6 @@ namespace synthese
 					const std::string& key
 				) const;
 
-
-
-				std::string _getValue(const std::size_t field) const;
-				void _loadLine(const std::string& line) const;
-
 			public:
 				Importer_(
 					util::Env& env,
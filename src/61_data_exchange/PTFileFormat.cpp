@@ -39,6 +39,7 @@
 #include "LineStopTableSync.h"
 #include "RollingStockTableSync.hpp"
 
+#include <boost/functional/hash.hpp>
 #include <geos/operation/distance/DistanceOp.h>
 
 using namespace boost;
@@ -87,6 +88,147 @@ namespace synthese
 
 
 
+		//////////////////////////////////////////////////////////////////////////
+		/// Signature of the stop areas served by a route.
+		std::size_t PTFileFormat::_GetRouteSignature(
+			const JourneyPattern& route
+		){
+			size_t result(0);
+			BOOST_FOREACH(const Edge* edge, route.getEdges())
+			{
+				boost::hash_combine(result, edge->getFromVertex()->getHub());
+			}
+			return result;
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Signature of the stop areas of stops to serve.
+		/// @return the signature, or nothing if a stop can be served by stops of
+		/// several stop areas (the routes cannot be found by the index)
+		boost::optional<std::size_t> PTFileFormat::_GetRouteSignature(
+			const JourneyPattern::StopsWithDepartureArrivalAuthorization& servedStops
+		){
+			size_t result(0);
+			BOOST_FOREACH(const JourneyPattern::StopWithDepartureArrivalAuthorization& stop, servedStops)
+			{
+				const Hub* hub(NULL);
+				BOOST_FOREACH(const JourneyPattern::StopWithDepartureArrivalAuthorization::StopsSet::value_type& stopPoint, stop._stop)
+				{
+					if(hub && stopPoint->getHub() != hub)
+					{
+						return boost::optional<size_t>();
+					}
+					hub = stopPoint->getHub();
+				}
+				boost::hash_combine(result, hub);
+			}
+			return result;
+		}
+
+
+
+		std::size_t PTFileFormat::_GetServiceSignature(
+			const std::string& number,
+			const SchedulesBasedService::Schedules& departureSchedules,
+			const SchedulesBasedService::Schedules& arrivalSchedules
+		){
+			size_t result(0);
+			boost::hash_combine(result, number);
+			BOOST_FOREACH(const time_duration& td, departureSchedules)
+			{
+				boost::hash_combine(result, td.ticks());
+			}
+			BOOST_FOREACH(const time_duration& ta, arrivalSchedules)
+			{
+				boost::hash_combine(result, ta.ticks());
+			}
+			return result;
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Gets the index of the routes of a line, built at the first call.
+		/// The index is rebuilt if paths were added to or removed from the line
+		/// outside of _createOrUpdateRoute.
+		PTFileFormat::RoutesIndex& PTFileFormat::_getRoutesIndex(
+			CommercialLine& line
+		) const {
+			RoutesIndexes::iterator it(_routesIndexes.find(&line));
+			if(	it != _routesIndexes.end() &&
+				it->second.pathsNumber == line.getPaths().size()
+			){
+				return it->second;
+			}
+
+			RoutesIndex& index(_routesIndexes[&line]);
+			index.routes.clear();
+			BOOST_FOREACH(Path* path, line.getPaths())
+			{
+				// Avoid junctions
+				JourneyPattern* route(dynamic_cast<JourneyPattern*>(path));
+				if(!route)
+				{
+					continue;
+				}
+				index.routes[_GetRouteSignature(*route)].insert(route);
+			}
+			index.pathsNumber = line.getPaths().size();
+			return index;
+		}
+
+
+
+		//////////////////////////////////////////////////////////////////////////
+		/// Gets the index of the scheduled services of a route, built at the first
+		/// call.
+		/// The index is rebuilt if services were added to or removed from the
+		/// route outside of _createOrUpdateService.
+		/// @pre the services of the route are locked
+		PTFileFormat::ServicesIndex& PTFileFormat::_getServicesIndex(
+			JourneyPattern& route
+		) const {
+			ServicesIndexes::iterator it(_servicesIndexes.find(&route));
+			if(	it != _servicesIndexes.end() &&
+				it->second.servicesNumber == route.getServices().size()
+			){
+				return it->second;
+			}
+
+			ServicesIndex& index(_servicesIndexes[&route]);
+			index.services.clear();
+			BOOST_FOREACH(Service* service, route.getServices())
+			{
+				ScheduledService* scheduledService(dynamic_cast<ScheduledService*>(service));
+				if(!scheduledService)
+				{
+					continue;
+				}
+				index.services[
+					_GetServiceSignature(
+						scheduledService->getServiceNumber(),
+						scheduledService->getDataDepartureSchedules(),
+						scheduledService->getDataArrivalSchedules()
+					)
+				].insert(scheduledService);
+			}
+			index.servicesNumber = route.getServices().size();
+			return index;
+		}
+
+
+
+		void PTFileFormat::resetSession() const
+		{
+			Importer::resetSession();
+			_routesIndexes.clear();
+			_servicesIndexes.clear();
+		}
+
+
+
 		//////////////////////////////////////////////////////////////////////////
 		/// The created object is owned by the environment (it is not required to
 		/// maintain the returned shared pointer)
@@ -687,18 +829,35 @@ namespace synthese
 			// Declaration
 			bool creation(false);
 
-			// Attempting to find an existing route by value comparison
-			JourneyPattern* result(NULL);
-			BOOST_FOREACH(Path* route, line.getPaths())
+			// Candidate routes : the routes serving the same stop areas, found by the
+			// index if possible
+			RoutesIndex& index(_getRoutesIndex(line));
+			set<JourneyPattern*> candidates;
+			optional<size_t> signature(_GetRouteSignature(servedStops));
+			if(signature)
 			{
-				// Avoid junctions
-				if(!dynamic_cast<JourneyPattern*>(route))
+				boost::unordered_map<size_t, set<JourneyPattern*> >::const_iterator it(index.routes.find(*signature));
+				if(it != index.routes.end())
 				{
-					continue;
+					candidates = it->second;
 				}
+			}
+			else
+			{
+				BOOST_FOREACH(Path* route, line.getPaths())
+				{
+					// Avoid junctions
+					if(dynamic_cast<JourneyPattern*>(route))
+					{
+						candidates.insert(static_cast<JourneyPattern*>(route));
+					}
+				}
+			}
 
-				JourneyPattern* jp(static_cast<JourneyPattern*>(route));
-
+			// Attempting to find an existing route by value comparison
+			JourneyPattern* result(NULL);
+			BOOST_FOREACH(JourneyPattern* jp, candidates)
+			{
 				if(!jp->hasLinkWithSource(source))
 				{
 					continue;
@@ -826,6 +985,10 @@ namespace synthese
 							(*itEdge)->setGeometry(templateObject->getGeometry());
 						}
 				}	}
+
+				// Index update
+				index.routes[_GetRouteSignature(*result)].insert(result);
+				index.pathsNumber = line.getPaths().size();
 			}
 
 
@@ -958,26 +1121,31 @@ namespace synthese
 				}
 			}
 
-			// Search for a corresponding service
+			// Search for a corresponding service among the services with the same
+			// number and schedules
 			ScheduledService* result(NULL);
+			size_t signature(_GetServiceSignature(number, departureSchedules, arrivalSchedules));
 			{
 				boost::shared_lock<util::shared_recursive_mutex> sharedServicesLock(
 					*route.sharedServicesMutex
 				);
-				BOOST_FOREACH(Service* tservice, route.getServices())
+				const ServicesIndex& index(_getServicesIndex(route));
+				boost::unordered_map<size_t, ServiceSet>::const_iterator it(index.services.find(signature));
+				if(it != index.services.end())
 				{
-					ScheduledService* curService(dynamic_cast<ScheduledService*>(tservice));
-
-					if(!curService) continue;
-
-					if(	curService->getServiceNumber() == number &&
-						curService->comparePlannedSchedules(departureSchedules, arrivalSchedules) &&
-						(!servedVertices || curService->comparePlannedStops(*servedVertices)) &&
-						(team ? curService->getTeam() == *team : true) &&
-						(rules ? curService->getRules() == *rules : true)
-					){
-						result = curService;
-						break;
+					BOOST_FOREACH(Service* tservice, it->second)
+					{
+						ScheduledService* curService(static_cast<ScheduledService*>(tservice));
+
+						if(	curService->getServiceNumber() == number &&
+							curService->comparePlannedSchedules(departureSchedules, arrivalSchedules) &&
+							(!servedVertices || curService->comparePlannedStops(*servedVertices)) &&
+							(team ? curService->getTeam() == *team : true) &&
+							(rules ? curService->getRules() == *rules : true)
+						){
+							result = curService;
+							break;
+						}
 					}
 				}
 			}
@@ -1030,6 +1198,11 @@ namespace synthese
 
 				route.addService(*result, false);
 
+				// Index update (the index of the route was built by the search)
+				ServicesIndex& index(_servicesIndexes[&route]);
+				index.services[signature].insert(result);
+				index.servicesNumber = route.getServices().size();
+
 				// Source links
 				Importable::DataSourceLinks links;
 				if(id)
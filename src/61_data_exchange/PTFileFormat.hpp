@@ -31,6 +31,10 @@
 #include "SchedulesBasedService.h"
 #include "StopPoint.hpp"
 
+#include <map>
+#include <set>
+#include <boost/unordered_map.hpp>
+
 namespace synthese
 {
 	namespace util
@@ -88,8 +92,56 @@ namespace synthese
 			static const std::string TAG_STOP_AREA;
 			static const std::string TAG_SOURCE_LINE;
 
+		private:
+			//////////////////////////////////////////////////////////////////////////
+			/// Routes of a line by served stop areas signature.
+			/// Each bucket is ordered like the paths of the line, so the first
+			/// matching route is the same as with a scan of the line.
+			struct RoutesIndex
+			{
+				std::size_t pathsNumber;	//!< number of paths of the line when indexed
+				boost::unordered_map<std::size_t, std::set<pt::JourneyPattern*> > routes;
+			};
+			typedef std::map<const pt::CommercialLine*, RoutesIndex> RoutesIndexes;
+
+			//////////////////////////////////////////////////////////////////////////
+			/// Scheduled services of a route by number and schedules signature.
+			struct ServicesIndex
+			{
+				std::size_t servicesNumber;	//!< number of services of the route when indexed
+				boost::unordered_map<std::size_t, graph::ServiceSet> services;
+			};
+			typedef std::map<const pt::JourneyPattern*, ServicesIndex> ServicesIndexes;
 
+			//! @name Indexes of the import session
+			//@{
+				mutable RoutesIndexes _routesIndexes;
+				mutable ServicesIndexes _servicesIndexes;
+			//@}
 
+			static std::size_t _GetRouteSignature(
+				const pt::JourneyPattern& route
+			);
+
+			static boost::optional<std::size_t> _GetRouteSignature(
+				const pt::JourneyPattern::StopsWithDepartureArrivalAuthorization& servedStops
+			);
+
+			static std::size_t _GetServiceSignature(
+				const std::string& number,
+				const pt::SchedulesBasedService::Schedules& departureSchedules,
+				const pt::SchedulesBasedService::Schedules& arrivalSchedules
+			);
+
+			RoutesIndex& _getRoutesIndex(
+				pt::CommercialLine& line
+			) const;
+
+			ServicesIndex& _getServicesIndex(
+				pt::JourneyPattern& route
+			) const;
+
+		protected:
 			PTFileFormat(
 				util::Env& env,
 				const impex::Import& import,
@@ -321,6 +373,10 @@ namespace synthese
 				const boost::posix_time::time_duration& waitingTime,
 				const impex::DataSource& source
 			) const;
+
+
+		public:
+			virtual void resetSession() const;
 		};
 }	}
 
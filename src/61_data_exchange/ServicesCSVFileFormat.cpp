@@ -27,7 +27,8 @@
 #include "Import.hpp"
 #include "Importer.hpp"
 #include "ImpExModule.h"
-#include "IConv.hpp"
+#include "CSVReader.hpp"
+#include "Exception.h"
 #include "DataSource.h"
 #include "DesignatedLinePhysicalStop.hpp"
 #include "TransportNetwork.h"
@@ -131,9 +132,6 @@ namespace synthese
 			const boost::filesystem::path& filePath,
 			const std::string& key
 		) const {
-			ifstream inFile;
-			string line;
-
 			DataSource& dataSource(*_import.get<DataSource>());
 
 			if(key == PATH_SERVICES)
@@ -183,13 +181,23 @@ namespace synthese
 
 				BOOST_FOREACH(const string& file, schedulesFiles)
 				{
-					ifstream inFile;
 					string fileWithPath = filePath.file_string() + file;
 					_logDebug(
 						"Loading file "+ fileWithPath
 					);
-					inFile.open(fileWithPath.c_str());
-					if(!inFile)
+					boost::shared_ptr<CSVReader> reader;
+					try
+					{
+						reader.reset(
+							new CSVReader(
+								fileWithPath,
+								SEP[0],
+								0,
+								0,
+								dataSource.get<Charset>()
+						)	);
+					}
+					catch(synthese::Exception&)
 					{
 						_logError(
 							"Could no open the file "+ fileWithPath
@@ -199,9 +207,7 @@ namespace synthese
 					// Ignore header lines
 					for(int i = 0; i < _numberOfLinesToIgnore; i++)
 					{
-						if(getline(inFile, line))
-							_loadLine(line);
-						else
+						if(!reader->next())
 						{
 							_logError(
 								"Error with the number of lines to ignore : "+ lexical_cast<string>(_numberOfLinesToIgnore)
@@ -297,29 +303,29 @@ namespace synthese
 					time_duration lastTd(minutes(0));
 					serviceDetail.serviceNumber = "-1";
 
-					while(getline(inFile, line))
+					while(reader->next())
 					{
-						_loadLine(line);
+						const size_t fieldsNumber(reader->getFieldsNumber());
 						string serviceNumberStr;
 						string stopNameStr;
 						string stopCodeStr;
 						string timeStr;
 
 						// Test if this line is correct
-						if(_line.size() > *_serviceNumberField)
-							serviceNumberStr = _getValue(*_serviceNumberField);
+						if(fieldsNumber > *_serviceNumberField)
+							serviceNumberStr = reader->getString(*_serviceNumberField);
 						else
 							continue;
-						if(_stopCodeField && _line.size() > *_stopCodeField)
-							stopCodeStr = _getValue(*_stopCodeField);
-						if(_stopNameField && _line.size() > *_stopNameField)
-							stopNameStr = _getValue(*_stopNameField);
+						if(_stopCodeField && fieldsNumber > *_stopCodeField)
+							stopCodeStr = reader->getString(*_stopCodeField);
+						if(_stopNameField && fieldsNumber > *_stopNameField)
+							stopNameStr = reader->getString(*_stopNameField);
 
-						if((_stopCodeField && _line.size() <= *_stopCodeField) && (_stopNameField && _line.size() <= *_stopNameField))
+						if((_stopCodeField && fieldsNumber <= *_stopCodeField) && (_stopNameField && fieldsNumber <= *_stopNameField))
 							continue;
 
-						if(_line.size() > *_timeField)
-							timeStr = _getValue(*_timeField);
+						if(fieldsNumber > *_timeField)
+							timeStr = reader->getString(*_timeField);
 						else
 							continue;
 
@@ -538,30 +544,6 @@ namespace synthese
 
 
 
-		std::string ServicesCSVFileFormat::Importer_::_getValue( const std::size_t field ) const
-		{
-			return trim_copy(_line[field]);
-		}
-
-
-
-		void ServicesCSVFileFormat::Importer_::_loadLine( const std::string& line ) const
-		{
-			_line.clear();
-			if(!line.empty())
-			{
-				string utfline(
-					line[line.size() - 1] == '\r' ?
-					line.substr(0, line.size() - 1) :
-					line
-				);
-				utfline = IConv(_import.get<DataSource>()->get<Charset>(), "UTF-8").convert(line);
-				split(_line, utfline, is_any_of(SEP));
-			}
-		}
-
-
-
 		std::string ServicesCSVFileFormat::Importer_::_replaceAllSubStrings(
 			const std::string source,
 			const std::string& replaceWhat,
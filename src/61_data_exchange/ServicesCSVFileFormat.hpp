@@ -110,11 +110,6 @@ namespace synthese
 
 				bool _interactive;
 
-				typedef std::map<std::string, std::size_t> FieldsMap;
-				mutable FieldsMap _fieldsMap;
-
-				mutable std::vector<std::string> _line;
-
 				struct ServiceDetail
 				{
 					std::string serviceNumber;
@@ -128,8 +123,6 @@ namespace synthese
 				PTUseRuleBlockMasks _ptUseRuleBlockMasks;
 				static std::string _serializePTUseRuleBlockMasks(const PTUseRuleBlockMasks& object);
 
-				std::string _getValue(const std::size_t field) const;
-				void _loadLine(const std::string& line) const;
 				std::string _replaceAllSubStrings(std::string result, const std::string& replaceWhat, const std::string& replaceWithWhat) const;
 
 				mutable impex::ImportableTableSync::ObjectBySource<pt::CommercialLineTableSync> _lines;
@@ -0,0 +1,127 @@
+/** LexicalMatcher benchmark.
+	@file LexicalMatcherBenchmark.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "07_lexical_matcher/LexicalMatcher.h"
+
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace synthese::lexical_matcher;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace
+{
+	/// Synthetic street names built from syllables, like a national street base
+	vector<string> getSyntheticBase(size_t size)
+	{
+		const char* types[] = { "rue", "avenue", "allée", "chemin", "place", "boulevard", "impasse", "route" };
+		const char* firstNames[] = { "", "", "", "Jean", "Louis", "Marie", "Pierre", "Georges", "Victor", "Anne" };
+		const char* syllables[] = {
+			"ba", "ber", "bou", "ca", "char", "co", "da", "de", "fon", "ga", "gre", "jou",
+			"la", "le", "lou", "ma", "mar", "mon", "na", "ni", "pa", "pe", "pi", "ra",
+			"ri", "ro", "sa", "se", "ta", "ti", "tou", "va", "ve", "vil"
+		};
+
+		vector<string> result;
+		unsigned long seed(12345);
+		for(size_t i(0); i < size; ++i)
+		{
+			string name;
+			for(size_t s(0); s < 2 + (seed >> 7) % 3; ++s)
+			{
+				seed = seed * 1103515245 + 12345;
+				name += syllables[(seed >> 16) % (sizeof(syllables) / sizeof(const char*))];
+			}
+			seed = seed * 1103515245 + 12345;
+			string firstName(firstNames[(seed >> 16) % (sizeof(firstNames) / sizeof(const char*))]);
+			seed = seed * 1103515245 + 12345;
+			result.push_back(
+				string(types[(seed >> 16) % (sizeof(types) / sizeof(const char*))]) + " " +
+				(firstName.empty() ? string() : firstName + " ") +
+				name
+			);
+		}
+		return result;
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (testIndexedBestMatches)
+{
+	vector<string> base(getSyntheticBase(20000));
+
+	ptime t0(microsec_clock::local_time());
+	LexicalMatcher<size_t> matcher;
+	for(size_t i(0); i < base.size(); ++i)
+	{
+		matcher.add(base[i], i);
+	}
+	ptime t1(microsec_clock::local_time());
+	cout << "Load of " << matcher.size() << " entries : " << (t1 - t0).total_milliseconds() << " ms" << endl;
+
+	// Keystrokes of some entries, with typos
+	vector<string> queries;
+	for(size_t i(0); i < 10; ++i)
+	{
+		const string& name(base[i * 997]);
+		string lastWord(name.substr(name.rfind(' ') + 1));
+		for(size_t l(1); l <= lastWord.size(); l += 2)
+		{
+			queries.push_back(lastWord.substr(0, l));
+		}
+		queries.push_back(name);
+		queries.push_back(string(name.begin(), name.end() - 1) + "x");
+	}
+	queries.push_back("rue du general de gaulle");
+
+	const size_t nbMatches(10);
+	time_duration indexedDuration;
+	time_duration fullDuration;
+	BOOST_FOREACH(const string& query, queries)
+	{
+		ptime t2(microsec_clock::local_time());
+		LexicalMatcher<size_t>::MatchResult indexed(matcher.bestMatches(query, nbMatches));
+		ptime t3(microsec_clock::local_time());
+		LexicalMatcher<size_t>::MatchResult full(matcher.match(query, 0, 0));
+		if(full.size() > nbMatches)
+		{
+			full.resize(nbMatches);
+		}
+		ptime t4(microsec_clock::local_time());
+		indexedDuration += t3 - t2;
+		fullDuration += t4 - t3;
+
+		// Same scores at each rank (the order of the entries with equal
+		// scores is not defined)
+		BOOST_REQUIRE_EQUAL(indexed.size(), full.size());
+		for(size_t i(0); i < indexed.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL(indexed[i].score.phoneticScore, full[i].score.phoneticScore);
+			BOOST_CHECK_EQUAL(indexed[i].score.levenshtein, full[i].score.levenshtein);
+		}
+	}
+	cout << queries.size() << " queries : indexed " << indexedDuration.total_milliseconds() <<
+		" ms, full scan " << fullDuration.total_milliseconds() << " ms" << endl;
+}
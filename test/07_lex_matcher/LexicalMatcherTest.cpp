@@ -296,3 +296,100 @@ BOOST_AUTO_TEST_CASE(comparison)
 	BOOST_CHECK_EQUAL(result2.value, 0);
 }
 
+
+
+namespace
+{
+	/// Synthetic street names built from syllables, like a national street base
+	vector<string> getSyntheticBase(size_t size)
+	{
+		const char* types[] = { "rue", "avenue", "allée", "chemin", "place", "boulevard", "impasse", "route" };
+		const char* firstNames[] = { "", "", "", "Jean", "Louis", "Marie", "Pierre", "Georges", "Victor", "Anne" };
+		const char* syllables[] = {
+			"ba", "ber", "bou", "ca", "char", "co", "da", "de", "fon", "ga", "gre", "jou",
+			"la", "le", "lou", "ma", "mar", "mon", "na", "ni", "pa", "pe", "pi", "ra",
+			"ri", "ro", "sa", "se", "ta", "ti", "tou", "va", "ve", "vil"
+		};
+
+		vector<string> result;
+		unsigned long seed(12345);
+		for(size_t i(0); i < size; ++i)
+		{
+			string name;
+			for(size_t s(0); s < 2 + (seed >> 7) % 3; ++s)
+			{
+				seed = seed * 1103515245 + 12345;
+				name += syllables[(seed >> 16) % (sizeof(syllables) / sizeof(const char*))];
+			}
+			seed = seed * 1103515245 + 12345;
+			string firstName(firstNames[(seed >> 16) % (sizeof(firstNames) / sizeof(const char*))]);
+			seed = seed * 1103515245 + 12345;
+			result.push_back(
+				string(types[(seed >> 16) % (sizeof(types) / sizeof(const char*))]) + " " +
+				(firstName.empty() ? string() : firstName + " ") +
+				name
+			);
+		}
+		return result;
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (testIndexedBestMatches)
+{
+	vector<string> base(getSyntheticBase(2000));
+
+	LexicalMatcher<size_t> matcher;
+	for(size_t i(0); i < base.size(); ++i)
+	{
+		matcher.add(base[i], i);
+	}
+
+	// Keystrokes of some entries, with typos : the indexed search must give
+	// the same result as the scoring of all the entries
+	vector<string> queries;
+	for(size_t i(0); i < 10; ++i)
+	{
+		const string& name(base[i * 199]);
+		string lastWord(name.substr(name.rfind(' ') + 1));
+		for(size_t l(1); l <= lastWord.size(); l += 2)
+		{
+			queries.push_back(lastWord.substr(0, l));
+		}
+		queries.push_back(name);
+		queries.push_back(string(name.begin(), name.end() - 1) + "x");
+	}
+	queries.push_back("rue du general de gaulle");
+
+	const size_t nbMatches(10);
+	BOOST_FOREACH(const string& query, queries)
+	{
+		LexicalMatcher<size_t>::MatchResult indexed(matcher.bestMatches(query, nbMatches));
+		LexicalMatcher<size_t>::MatchResult full(matcher.match(query, 0, 0));
+		if(full.size() > nbMatches)
+		{
+			full.resize(nbMatches);
+		}
+
+		// Same scores at each rank (the order of the entries with equal
+		// scores is not defined)
+		BOOST_REQUIRE_EQUAL(indexed.size(), full.size());
+		for(size_t i(0); i < indexed.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL(indexed[i].score.phoneticScore, full[i].score.phoneticScore);
+			BOOST_CHECK_EQUAL(indexed[i].score.levenshtein, full[i].score.levenshtein);
+		}
+	}
+
+	// Removal keeps the index consistent
+	matcher.remove(base[0]);
+	LexicalMatcher<size_t>::MatchResult result(matcher.bestMatches(base[0], 1));
+	BOOST_REQUIRE_EQUAL(result.size(), 1);
+	BOOST_CHECK_NE(result.front().key.getSource(), base[0]);
+
+	// Copies have their own index
+	LexicalMatcher<size_t> copy(matcher);
+	matcher.clear();
+	BOOST_CHECK_EQUAL(copy.bestMatches(base[1], 1).front().value, 1);
+}
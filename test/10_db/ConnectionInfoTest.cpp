@@ -67,6 +67,7 @@ BOOST_AUTO_TEST_CASE(ValidNoParams)
 	BOOST_CHECK_EQUAL(0, ci.port);
 	BOOST_CHECK_EQUAL(false, ci.debug);
 	BOOST_CHECK_EQUAL(true, ci.triggerCheck);
+	BOOST_CHECK_EQUAL(0, ci.loadThreads);
 }
 
 BOOST_AUTO_TEST_CASE(ValidParams0)
@@ -86,7 +87,7 @@ BOOST_AUTO_TEST_CASE(ValidParams0)
 
 BOOST_AUTO_TEST_CASE(ValidParams1)
 {
-	ConnectionInfo ci("sqlite://path=test.db,host=localhost,user=joe,passwd=secret,db=myDb,triggerHost=foo.org,port=9999,debug=1,triggerCheck=0");
+	ConnectionInfo ci("sqlite://path=test.db,host=localhost,user=joe,passwd=secret,db=myDb,triggerHost=foo.org,port=9999,debug=1,triggerCheck=0,loadThreads=4");
 	BOOST_CHECK_EQUAL("sqlite", ci.backend);
 	BOOST_CHECK_EQUAL("test.db", ci.path);
 	BOOST_CHECK_EQUAL("localhost", ci.host);
@@ -97,4 +98,5 @@ BOOST_AUTO_TEST_CASE(ValidParams1)
 	BOOST_CHECK_EQUAL(9999, ci.port);
 	BOOST_CHECK_EQUAL(true, ci.debug);
 	BOOST_CHECK_EQUAL(false, ci.triggerCheck);
+	BOOST_CHECK_EQUAL(4, ci.loadThreads);
 }
@@ -0,0 +1,86 @@
+/** DBTablesLoader unit test.
+	@file DBTablesLoaderTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "10_db/DBTablesLoader.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace synthese::db;
+using namespace boost;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE(DefaultDependencies)
+{
+	vector<string> keys;
+	keys.push_back("12.01 Users");
+	keys.push_back("32.00 Cities");
+	keys.push_back("35.40.01 Connection places");
+	vector<optional<DBTableSync::LoadDependencies> > declared(keys.size());
+
+	DBTablesLoader::Dependencies dependencies(DBTablesLoader::GetDependencies(keys, declared));
+	BOOST_REQUIRE_EQUAL(dependencies.size(), 3);
+	BOOST_CHECK(dependencies[0].empty());
+	BOOST_REQUIRE_EQUAL(dependencies[1].size(), 1);
+	BOOST_CHECK_EQUAL(dependencies[1][0], 0);
+	BOOST_REQUIRE_EQUAL(dependencies[2].size(), 2);
+	BOOST_CHECK_EQUAL(dependencies[2][0], 0);
+	BOOST_CHECK_EQUAL(dependencies[2][1], 1);
+}
+
+BOOST_AUTO_TEST_CASE(DeclaredDependencies)
+{
+	vector<string> keys;
+	keys.push_back("32.00 Cities");
+	keys.push_back("35.40.01 Connection places");
+	keys.push_back("35.40.02 DRT areas");
+	keys.push_back("36.01 Websites");
+	keys.push_back("36.10 Web pages");
+	vector<optional<DBTableSync::LoadDependencies> > declared(keys.size());
+
+	// Depends on a module and on a group of tables, but not on itself
+	declared[2] = DBTableSync::LoadDependencies();
+	declared[2]->push_back("32");
+	declared[2]->push_back("35.40");
+
+	// No dependencies
+	declared[3] = DBTableSync::LoadDependencies();
+
+	// Depends on a following table
+	declared[0] = DBTableSync::LoadDependencies();
+	declared[0]->push_back("36.01 Websites");
+
+	DBTablesLoader::Dependencies dependencies(DBTablesLoader::GetDependencies(keys, declared));
+	BOOST_REQUIRE_EQUAL(dependencies.size(), 5);
+
+	BOOST_REQUIRE_EQUAL(dependencies[0].size(), 1);
+	BOOST_CHECK_EQUAL(dependencies[0][0], 3);
+
+	BOOST_REQUIRE_EQUAL(dependencies[1].size(), 1);
+	BOOST_CHECK_EQUAL(dependencies[1][0], 0);
+
+	BOOST_REQUIRE_EQUAL(dependencies[2].size(), 2);
+	BOOST_CHECK_EQUAL(dependencies[2][0], 0);
+	BOOST_CHECK_EQUAL(dependencies[2][1], 1);
+
+	BOOST_CHECK(dependencies[3].empty());
+
+	BOOST_CHECK_EQUAL(dependencies[4].size(), 4);
+}
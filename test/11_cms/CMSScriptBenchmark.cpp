@@ -0,0 +1,120 @@
+/** CMSScript benchmark.
+	@file CMSScriptBenchmark.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "CMSScript.hpp"
+#include "IfFunction.hpp"
+#include "ParametersMap.h"
+#include "StaticFunctionRequest.h"
+#include "StrLenFunction.hpp"
+#include "Webpage.h"
+#include "WebPageDisplayFunction.h"
+#include "Website.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+using namespace synthese::util;
+using namespace synthese::cms;
+using namespace synthese::server;
+using namespace synthese;
+
+namespace
+{
+	/// Code of the pages of the packages
+	vector<string> getPackagesTemplates()
+	{
+		vector<string> result;
+		boost::filesystem::path packages(PACKAGES_DIR);
+		for(boost::filesystem::recursive_directory_iterator it(packages);
+			it != boost::filesystem::recursive_directory_iterator();
+			++it
+		){
+			string path(it->path().string());
+			if(	path.find("/pages") == string::npos ||
+				path.size() < 5 ||
+				path.substr(path.size() - 5) != ".html"
+			){
+				continue;
+			}
+			ifstream file(path.c_str());
+			stringstream code;
+			code << file.rdbuf();
+			result.push_back(code.str());
+		}
+		return result;
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (CMSScriptBenchmark)
+{
+	IfFunction::integrate();
+	StrLenFunction::integrate();
+
+	StaticFunctionRequest<WebPageDisplayFunction> request;
+	ParametersMap additionalParametersMap;
+	additionalParametersMap.insert("title", string("Benchmark"));
+	Website site;
+	Webpage page;
+	page.setRoot(&site);
+
+	vector<string> templates(getPackagesTemplates());
+	BOOST_REQUIRE(!templates.empty());
+
+	const size_t iterations(1000);
+	time_duration programDuration;
+	time_duration interpreterDuration;
+	BOOST_FOREACH(const string& code, templates)
+	{
+		CMSScript script(code);
+
+		ptime t0(microsec_clock::local_time());
+		for(size_t i(0); i < iterations; ++i)
+		{
+			ParametersMap variables;
+			stringstream s;
+			script.display(s, request, additionalParametersMap, page, variables);
+		}
+		ptime t1(microsec_clock::local_time());
+		for(size_t i(0); i < iterations; ++i)
+		{
+			ParametersMap variables;
+			stringstream s;
+			script.interpret(s, request, additionalParametersMap, page, variables);
+		}
+		ptime t2(microsec_clock::local_time());
+		programDuration += t1 - t0;
+		interpreterDuration += t2 - t1;
+	}
+	cout << templates.size() << " templates displayed " << iterations << " times : program " <<
+		programDuration.total_milliseconds() << " ms, tree interpreter " <<
+		interpreterDuration.total_milliseconds() << " ms" << endl;
+}
@@ -0,0 +1,161 @@
+/** CMSScript unit test.
+	@file CMSScriptTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "CMSScript.hpp"
+#include "IfFunction.hpp"
+#include "ParametersMap.h"
+#include "StaticFunctionRequest.h"
+#include "StrLenFunction.hpp"
+#include "Webpage.h"
+#include "WebPageDisplayFunction.h"
+#include "Website.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace boost;
+using namespace std;
+using namespace synthese::util;
+using namespace synthese::cms;
+using namespace synthese::server;
+using namespace synthese;
+
+namespace
+{
+	/// Code of the pages of the packages
+	vector<string> getPackagesTemplates()
+	{
+		vector<string> result;
+		boost::filesystem::path packages(PACKAGES_DIR);
+		for(boost::filesystem::recursive_directory_iterator it(packages);
+			it != boost::filesystem::recursive_directory_iterator();
+			++it
+		){
+			string path(it->path().string());
+			if(	path.find("/pages") == string::npos ||
+				path.size() < 5 ||
+				path.substr(path.size() - 5) != ".html"
+			){
+				continue;
+			}
+			ifstream file(path.c_str());
+			stringstream code;
+			code << file.rdbuf();
+			result.push_back(code.str());
+		}
+		return result;
+	}
+
+
+
+	/// Output of the program and of the tree interpreter, with the same
+	/// variables
+	pair<string, string> run(
+		const CMSScript& script,
+		const Request& request,
+		const ParametersMap& additionalParametersMap,
+		const Webpage& page
+	){
+		ParametersMap variables1;
+		stringstream s1;
+		script.display(s1, request, additionalParametersMap, page, variables1);
+		ParametersMap variables2;
+		stringstream s2;
+		script.interpret(s2, request, additionalParametersMap, page, variables2);
+		return make_pair(s1.str(), s2.str());
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (CMSScriptProgramTest)
+{
+	IfFunction::integrate();
+	StrLenFunction::integrate();
+
+	StaticFunctionRequest<WebPageDisplayFunction> request;
+	ParametersMap additionalParametersMap;
+	additionalParametersMap.insert("label", string("b"));
+	Website site;
+	Webpage page;
+	page.setRoot(&site);
+
+	{ // Folded expressions are concatenated to the text
+		CMSScript script("a<@1+2@>b<@\"c\"+\"d\"@><@!0@><@(2*3==6) ? \"y\" : \"n\"@>");
+		BOOST_REQUIRE(script.getConstantText());
+		BOOST_CHECK_EQUAL(*script.getConstantText(), "a3bcd1y");
+		pair<string, string> result(run(script, request, additionalParametersMap, page));
+		BOOST_CHECK_EQUAL(result.first, "a3bcd1y");
+		BOOST_CHECK_EQUAL(result.second, result.first);
+	}
+
+	{ // Expressions reading the context are not folded
+		CMSScript script("a<@label@><@label+1@>");
+		BOOST_CHECK(!script.getConstantText());
+		pair<string, string> result(run(script, request, additionalParametersMap, page));
+		BOOST_CHECK_EQUAL(result.first, "abb1");
+		BOOST_CHECK_EQUAL(result.second, result.first);
+	}
+
+	{ // Jumps to constant labels, forward and backward
+		CMSScript script("<@i=0@><<loop>>x<@i=<@i+1@>@><%<@(i<3) ? \"loop\" : \"\"@>%><%end%>y<<end>>z");
+		pair<string, string> result(run(script, request, additionalParametersMap, page));
+		BOOST_CHECK_EQUAL(result.first, "xxxz");
+		BOOST_CHECK_EQUAL(result.second, result.first);
+	}
+
+	{ // Jumps to labels read in the context, and to unknown labels
+		CMSScript script("<%<@label@>%>a<<a>>b<<b>>c<%unknown%>d");
+		pair<string, string> result(run(script, request, additionalParametersMap, page));
+		BOOST_CHECK_EQUAL(result.first, "cd");
+		BOOST_CHECK_EQUAL(result.second, result.first);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (CMSScriptPackagesTest)
+{
+	IfFunction::integrate();
+	StrLenFunction::integrate();
+
+	StaticFunctionRequest<WebPageDisplayFunction> request;
+	ParametersMap additionalParametersMap;
+	additionalParametersMap.insert("title", string("Packages"));
+	Website site;
+	Webpage page;
+	page.setRoot(&site);
+
+	// The program gives the same output as the tree interpreter on the pages
+	// of the packages
+	vector<string> templates(getPackagesTemplates());
+	BOOST_REQUIRE(!templates.empty());
+	BOOST_FOREACH(const string& code, templates)
+	{
+		CMSScript script(code);
+		pair<string, string> result(run(script, request, additionalParametersMap, page));
+		BOOST_CHECK_EQUAL(result.first, result.second);
+	}
+}
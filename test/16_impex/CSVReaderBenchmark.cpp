@@ -0,0 +1,136 @@
+/** CSVReader benchmark.
+	@file CSVReaderBenchmark.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "CSVReader.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/tokenizer.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+using namespace synthese::impex;
+
+
+
+BOOST_AUTO_TEST_CASE (testCSVReaderBenchmark)
+{
+	const size_t rowsNumber(100000);
+
+	// Synthetic GTFS stop_times.txt
+	filesystem::path path("CSVReaderBenchmark_stop_times.txt");
+	{
+		ofstream file(path.string().c_str(), ios::binary);
+		file << "trip_id,arrival_time,departure_time,stop_id,stop_sequence,stop_headsign,pickup_type,drop_off_type,shape_dist_traveled\r\n";
+		for(size_t i(0); i < rowsNumber; ++i)
+		{
+			size_t minutes(300 + (i % 40) * 3 + (i / 40) % 1200);
+			file <<
+				"T" << (i / 40) << "," <<
+				(minutes / 60) << ":" << (minutes % 60 < 10 ? "0" : "") << (minutes % 60) << ":00," <<
+				(minutes / 60) << ":" << (minutes % 60 < 10 ? "0" : "") << (minutes % 60) << ":30," <<
+				"StopPoint:" << (i * 7919) % 20000 << "," <<
+				(i % 40) << ",\"Gare Matabiau\",0,0," <<
+				(i % 40) * 412.5 << "\r\n";
+		}
+	}
+
+	// Previous implementation : line by line, tokenizer, and stream conversions
+	ptime t0(microsec_clock::local_time());
+	double checkSumStreams(0);
+	{
+		ifstream file(path.string().c_str());
+		string line;
+		getline(file, line);
+		typedef tokenizer<escaped_list_separator<char> > Tokenizer;
+		vector<string> fields;
+		while(getline(file, line))
+		{
+			if(!line.empty() && line[line.size() - 1] == '\r')
+			{
+				line.resize(line.size() - 1);
+			}
+			fields.clear();
+			Tokenizer values(line, escaped_list_separator<char>('\\', ',', '"'));
+			for(Tokenizer::iterator it(values.begin()); it != values.end(); ++it)
+			{
+				fields.push_back(algorithm::trim_copy(*it));
+			}
+			string tripId(fields[0]);
+			string stopId(fields[3]);
+			time_duration arrival;
+			stringstream arrivalStream(fields[1]);
+			arrivalStream >> arrival;
+			time_duration departure;
+			stringstream departureStream(fields[2]);
+			departureStream >> departure;
+			double distance(lexical_cast<double>(fields[8]));
+			checkSumStreams += distance + arrival.total_seconds() + departure.total_seconds();
+		}
+	}
+
+	// CSVReader
+	ptime t1(microsec_clock::local_time());
+	double checkSumReader(0);
+	size_t readRows(0);
+	{
+		CSVReader reader(path, ',', '"', '\\');
+		BOOST_REQUIRE(reader.readHeader());
+		size_t tripIdColumn(reader.getColumn("trip_id"));
+		size_t arrivalTimeColumn(reader.getColumn("arrival_time"));
+		size_t departureTimeColumn(reader.getColumn("departure_time"));
+		size_t stopIdColumn(reader.getColumn("stop_id"));
+		size_t shapeDistTraveledColumn(reader.getColumn("shape_dist_traveled"));
+		while(reader.next())
+		{
+			string tripId(reader.getString(tripIdColumn));
+			string stopId(reader.getString(stopIdColumn));
+			time_duration arrival;
+			reader.getTime(arrivalTimeColumn, arrival);
+			time_duration departure;
+			reader.getTime(departureTimeColumn, departure);
+			double distance(0);
+			reader.getDouble(shapeDistTraveledColumn, distance);
+			checkSumReader += distance + arrival.total_seconds() + departure.total_seconds();
+			++readRows;
+		}
+	}
+	ptime t2(microsec_clock::local_time());
+
+	BOOST_CHECK_EQUAL(readRows, rowsNumber);
+	BOOST_CHECK_EQUAL(checkSumReader, checkSumStreams);
+
+	long streamsMs((t1 - t0).total_milliseconds());
+	long readerMs((t2 - t1).total_milliseconds());
+	cout << rowsNumber << " stop times : getline/tokenizer " <<
+		streamsMs << " ms (" << (streamsMs ? rowsNumber * 1000 / streamsMs : 0) << " rows/s), CSVReader " <<
+		readerMs << " ms (" << (readerMs ? rowsNumber * 1000 / readerMs : 0) << " rows/s)" << endl;
+
+	filesystem::remove(path);
+}
@@ -0,0 +1,151 @@
+/** CSVReader Test implementation.
+	@file CSVReaderTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "CSVReader.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+using namespace synthese::impex;
+
+namespace
+{
+	bool parseDouble(const char* text, double& value)
+	{
+		return CSVReader::ParseDouble(text, text + strlen(text), value);
+	}
+
+	bool parseTime(const char* text, time_duration& value)
+	{
+		return CSVReader::ParseTime(text, text + strlen(text), value);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (testCSVReader)
+{
+	filesystem::path path("CSVReaderTest.txt");
+	{
+		ofstream file(path.string().c_str(), ios::binary);
+		file <<
+			"\xEF\xBB\xBF" "stop_id,stop_name,stop_lat,arrival_time\r\n" <<
+			"S1, Gare ,43.6045,25:10:00\r\n" <<
+			"\r\n" <<
+			"S2,\"Place, \"\"du\"\" Capitole\",-1.5e2,8:05\n" <<
+			"S3,Rue\\\"Alsace\n" <<
+			"S4,\"Two\nlines\",abc,8h05";
+	}
+
+	CSVReader reader(path, ',', '"', '\\');
+	BOOST_REQUIRE(reader.readHeader());
+	size_t stopIdColumn(reader.getColumn("stop_id"));
+	size_t stopNameColumn(reader.getColumn("stop_name"));
+	size_t stopLatColumn(reader.getColumn("stop_lat"));
+	size_t arrivalTimeColumn(reader.getColumn("arrival_time"));
+	BOOST_CHECK_EQUAL(stopIdColumn, 0);
+	BOOST_CHECK_EQUAL(arrivalTimeColumn, 3);
+	BOOST_CHECK_EQUAL(reader.getColumn("parent_station"), CSVReader::NO_COLUMN);
+
+	double lat;
+	time_duration arrival;
+
+	BOOST_REQUIRE(reader.next());
+	BOOST_CHECK_EQUAL(reader.getString(stopIdColumn), "S1");
+	BOOST_CHECK_EQUAL(reader.getString(stopNameColumn), "Gare");
+	BOOST_CHECK(reader.equals(stopNameColumn, "Gare"));
+	BOOST_CHECK(reader.getDouble(stopLatColumn, lat));
+	BOOST_CHECK_EQUAL(lat, 43.6045);
+	BOOST_CHECK(reader.getTime(arrivalTimeColumn, arrival));
+	BOOST_CHECK_EQUAL(arrival, time_duration(25, 10, 0));
+	BOOST_CHECK(reader.isEmpty(reader.getColumn("parent_station")));
+
+	BOOST_REQUIRE(reader.next());
+	BOOST_CHECK_EQUAL(reader.getRowNumber(), 3);
+	BOOST_CHECK_EQUAL(reader.getString(stopNameColumn), "Place, \"du\" Capitole");
+	BOOST_CHECK(reader.getDouble(stopLatColumn, lat));
+	BOOST_CHECK_EQUAL(lat, -150);
+	BOOST_CHECK(reader.getTime(arrivalTimeColumn, arrival));
+	BOOST_CHECK_EQUAL(arrival, time_duration(8, 5, 0));
+
+	BOOST_REQUIRE(reader.next());
+	BOOST_CHECK_EQUAL(reader.getFieldsNumber(), 2);
+	BOOST_CHECK_EQUAL(reader.getString(stopNameColumn), "Rue\"Alsace");
+	BOOST_CHECK(reader.isEmpty(arrivalTimeColumn));
+	BOOST_CHECK(!reader.getTime(arrivalTimeColumn, arrival));
+
+	BOOST_REQUIRE(reader.next());
+	BOOST_CHECK_EQUAL(reader.getString(stopNameColumn), "Two\nlines");
+	BOOST_CHECK(!reader.getDouble(stopLatColumn, lat));
+	BOOST_CHECK(!reader.getTime(arrivalTimeColumn, arrival));
+
+	BOOST_CHECK(!reader.next());
+
+	reader.rewind();
+	BOOST_REQUIRE(reader.next());
+	BOOST_REQUIRE(reader.next());
+	BOOST_CHECK_EQUAL(reader.getString(stopIdColumn), "S1");
+
+	filesystem::remove(path);
+}
+
+
+
+BOOST_AUTO_TEST_CASE (testCSVReaderParsers)
+{
+	double value;
+	BOOST_CHECK(parseDouble("1.4376", value));
+	BOOST_CHECK_EQUAL(value, lexical_cast<double>("1.4376"));
+	BOOST_CHECK(parseDouble("-0.000123456789", value));
+	BOOST_CHECK_EQUAL(value, lexical_cast<double>("-0.000123456789"));
+	BOOST_CHECK(parseDouble("6.02e23", value));
+	BOOST_CHECK_EQUAL(value, 6.02e23);
+	BOOST_CHECK(parseDouble("42", value));
+	BOOST_CHECK_EQUAL(value, 42);
+	BOOST_CHECK(!parseDouble("", value));
+	BOOST_CHECK(!parseDouble(".", value));
+	BOOST_CHECK(!parseDouble("1.2.3", value));
+	BOOST_CHECK(!parseDouble("12a", value));
+
+	long integer;
+	const char* text("-315");
+	BOOST_CHECK(CSVReader::ParseInt(text, text + 4, integer));
+	BOOST_CHECK_EQUAL(integer, -315);
+	BOOST_CHECK(!CSVReader::ParseInt(text, text + 1, integer));
+
+	time_duration time;
+	BOOST_CHECK(parseTime("07:00:30", time));
+	BOOST_CHECK_EQUAL(time, time_duration(7, 0, 30));
+	BOOST_CHECK(parseTime("26:59", time));
+	BOOST_CHECK_EQUAL(time, time_duration(26, 59, 0));
+	BOOST_CHECK(!parseTime("07", time));
+	BOOST_CHECK(!parseTime("07:00:", time));
+	BOOST_CHECK(!parseTime("07:00:30:00", time));
+}
+
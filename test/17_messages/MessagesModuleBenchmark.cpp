@@ -0,0 +1,147 @@
+/** MessagesModule benchmark.
+	@file MessagesModuleBenchmark.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "AlarmObjectLink.h"
+#include "BroadcastPointAlarmRecipient.hpp"
+#include "Env.h"
+#include "MailingList.hpp"
+#include "MessagesModule.h"
+#include "ParametersMap.h"
+#include "SentAlarm.h"
+#include "SentScenario.h"
+
+#include <iostream>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/foreach.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace std;
+using namespace synthese::util;
+using namespace synthese::messages;
+using namespace synthese;
+
+namespace
+{
+	/// Mailing list checking all the activated messages
+	class NotIndexedMailingList:
+		public MailingList
+	{
+	public:
+		NotIndexedMailingList(RegistryKeyType id):
+			MailingList(id)
+		{}
+
+		virtual bool getRecipientKeys(RecipientKeys& result) const { return false; }
+	};
+}
+
+
+
+BOOST_AUTO_TEST_CASE (ActivatedMessagesIndexBenchmark)
+{
+	BroadcastPointAlarmRecipient::integrate();
+
+	const size_t messagesNumber(5000);
+	const size_t pointsNumber(2000);
+	const RegistryKeyType firstPointId(1000000);
+
+	SentScenario scenario(1);
+	scenario.setIsEnabled(true);
+
+	// Each message is linked to two broadcast points
+	vector<boost::shared_ptr<AlarmObjectLink> > links;
+	for(size_t i(0); i < messagesNumber; ++i)
+	{
+		boost::shared_ptr<SentAlarm> message(new SentAlarm(i + 1, &scenario));
+		Env::GetOfficialEnv().getEditableRegistry<Alarm>().add(message);
+		for(size_t j(0); j < 2; ++j)
+		{
+			boost::shared_ptr<AlarmObjectLink> link(new AlarmObjectLink(messagesNumber * j + i + 1));
+			link->setRecipient(BroadcastPointAlarmRecipient::FACTORY_KEY);
+			link->setObjectId(firstPointId + (i * 7 + j * 13) % pointsNumber);
+			link->setAlarm(message.get());
+			message->addLinkedObject(*link);
+			links.push_back(link);
+		}
+	}
+
+	MessagesModule::UpdateActivatedMessages();
+
+	vector<boost::shared_ptr<MailingList> > indexedPoints;
+	vector<boost::shared_ptr<MailingList> > notIndexedPoints;
+	for(size_t i(0); i < pointsNumber; ++i)
+	{
+		indexedPoints.push_back(boost::shared_ptr<MailingList>(new MailingList(firstPointId + i)));
+		notIndexedPoints.push_back(boost::shared_ptr<MailingList>(new NotIndexedMailingList(firstPointId + i)));
+	}
+
+	// Same messages with and without the index
+	ParametersMap parameters;
+	size_t displayedMessagesNumber(0);
+	for(size_t i(0); i < pointsNumber; ++i)
+	{
+		MessagesModule::ActivatedMessages indexedResult(
+			MessagesModule::GetActivatedMessages(*indexedPoints[i], parameters)
+		);
+		MessagesModule::ActivatedMessages notIndexedResult(
+			MessagesModule::GetActivatedMessages(*notIndexedPoints[i], parameters)
+		);
+		BOOST_CHECK(indexedResult == notIndexedResult);
+		displayedMessagesNumber += indexedResult.size();
+	}
+	BOOST_CHECK_EQUAL(displayedMessagesNumber, messagesNumber * 2);
+
+	// Benchmark (the broadcast points caches of the messages are already populated)
+	const size_t iterations(5);
+	ptime t0(microsec_clock::local_time());
+	for(size_t n(0); n < iterations; ++n)
+	{
+		BOOST_FOREACH(const boost::shared_ptr<MailingList>& point, indexedPoints)
+		{
+			MessagesModule::GetActivatedMessages(*point, parameters);
+		}
+	}
+	ptime t1(microsec_clock::local_time());
+	for(size_t n(0); n < iterations; ++n)
+	{
+		BOOST_FOREACH(const boost::shared_ptr<MailingList>& point, notIndexedPoints)
+		{
+			MessagesModule::GetActivatedMessages(*point, parameters);
+		}
+	}
+	ptime t2(microsec_clock::local_time());
+	cout << messagesNumber << " messages on " << pointsNumber << " broadcast points, " << iterations << " times : index " <<
+		(t1 - t0).total_milliseconds() << " ms, scan " <<
+		(t2 - t1).total_milliseconds() << " ms" << endl;
+
+	// Cleaning of the official environment
+	BOOST_FOREACH(const boost::shared_ptr<AlarmObjectLink>& link, links)
+	{
+		link->getAlarm()->removeLinkedObject(*link);
+	}
+	scenario.setIsEnabled(false);
+	MessagesModule::UpdateActivatedMessages();
+	Env::GetOfficialEnv().getEditableRegistry<Alarm>().clear();
+}
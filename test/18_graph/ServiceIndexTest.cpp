@@ -0,0 +1,135 @@
+/** ServiceIndex unit test.
+	@file ServiceIndexTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "FakeGraphImplementation.hpp"
+#include "ServiceIndex.hpp"
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace synthese::util;
+using namespace synthese::graph;
+using namespace synthese;
+using namespace boost::posix_time;
+
+namespace
+{
+	/// Service passing at the edge at a single schedule (departure at rank 0)
+	class FakeScheduledService:
+		public FakeService
+	{
+		time_duration _departure;
+		time_duration _arrival;
+		bool _continuous;
+
+	public:
+		FakeScheduledService(
+			const time_duration& departure,
+			const time_duration& arrival,
+			bool continuous = false
+		):	synthese::util::Registrable(0),
+			_departure(departure),
+			_arrival(arrival),
+			_continuous(continuous)
+		{}
+
+		virtual bool isContinuous () const { return _continuous; }
+		virtual time_duration getDepartureBeginScheduleToIndex(bool RTData,std::size_t rankInPath) const { return _departure; }
+		virtual time_duration getDepartureEndScheduleToIndex(bool RTData,std::size_t rankInPath) const { return _departure; }
+		virtual time_duration getArrivalBeginScheduleToIndex(bool RTData,std::size_t rankInPath) const { return _arrival; }
+		virtual time_duration getArrivalEndScheduleToIndex(bool RTData,std::size_t rankInPath) const { return _arrival; }
+		virtual time_duration getDepartureSchedule(bool RTData,size_t rank) const { return _departure; }
+	};
+}
+
+BOOST_AUTO_TEST_CASE (testDepartureIndex)
+{
+	// The second service overtakes the first one before the edge
+	FakeScheduledService s1(hours(8), hours(9));
+	FakeScheduledService s2(hours(8) + minutes(30), hours(8) + minutes(45));
+	FakeScheduledService s3(hours(12), hours(13));
+	FakeScheduledService s4(hours(25), hours(26));
+
+	ServiceSet services;
+	services.insert(&s1);
+	services.insert(&s2);
+	services.insert(&s3);
+	services.insert(&s4);
+
+	{	// Departures
+		ServiceIndex index(services, 0, true, false);
+		BOOST_REQUIRE_EQUAL(index.end(), 4);
+		BOOST_CHECK_EQUAL(index.get(0).service, &s1);
+		BOOST_CHECK_EQUAL(index.get(3).service, &s4);
+
+		BOOST_CHECK_EQUAL(index.getFirst(hours(5)), 0);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(8)), 0);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(8) + minutes(1)), 1);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(13)), 3);
+
+		// The services after midnight are read at the presence times of the night
+		BOOST_CHECK_EQUAL(index.getFirst(minutes(30)), 0);
+		BOOST_CHECK(!index.isCandidate(0, minutes(30)));
+		BOOST_CHECK(!index.isCandidate(2, minutes(30)));
+		BOOST_CHECK(index.isCandidate(3, minutes(30)));
+		BOOST_CHECK(!index.isCandidate(3, hours(1) + minutes(30)));
+		BOOST_CHECK(index.isCandidate(3, hours(23)));
+	}
+
+	{	// Arrivals : latest first
+		ServiceIndex index(services, 0, false, false);
+		BOOST_REQUIRE_EQUAL(index.end(), 4);
+		BOOST_CHECK_EQUAL(index.get(0).service, &s4);
+		BOOST_CHECK_EQUAL(index.get(1).service, &s3);
+		BOOST_CHECK_EQUAL(index.get(2).service, &s1);
+		BOOST_CHECK_EQUAL(index.get(3).service, &s2);
+
+		BOOST_CHECK_EQUAL(index.getFirst(hours(8)), 4);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(8) + minutes(50)), 3);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(10)), 2);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(20)), 1);
+		BOOST_CHECK_EQUAL(index.getFirst(hours(2)), 0);
+		BOOST_CHECK(!index.isCandidate(0, hours(1)));
+		BOOST_CHECK(index.isCandidate(0, hours(2)));
+		BOOST_CHECK(index.isCandidate(1, hours(2)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE (testContinuousServiceIndex)
+{
+	FakeScheduledService s1(hours(8), hours(9));
+	FakeScheduledService s2(hours(10), hours(11), true);
+	FakeScheduledService s3(hours(12), hours(13));
+
+	ServiceSet services;
+	services.insert(&s1);
+	services.insert(&s2);
+	services.insert(&s3);
+
+	ServiceIndex index(services, 0, true, false);
+	BOOST_REQUIRE_EQUAL(index.end(), 3);
+
+	// The continuous service is never skipped
+	BOOST_CHECK_EQUAL(index.getFirst(hours(7)), 0);
+	BOOST_CHECK_EQUAL(index.getFirst(hours(9)), 1);
+	BOOST_CHECK_EQUAL(index.getFirst(hours(23)), 1);
+	BOOST_CHECK(index.isCandidate(1, hours(23)));
+	BOOST_CHECK(index.isCandidate(1, hours(1)));
+}
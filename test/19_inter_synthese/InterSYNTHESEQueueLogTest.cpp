@@ -0,0 +1,143 @@
+/** InterSYNTHESEQueueLog unit test.
+	@file InterSYNTHESEQueueLogTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "19_inter_synthese/InterSYNTHESEQueueLog.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace synthese::inter_synthese;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace
+{
+	const string PATH("InterSYNTHESEQueueLogTest.log");
+
+	void RemoveLog()
+	{
+		remove(PATH.c_str());
+		remove((PATH + ".ack").c_str());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(QueueLogResumesAfterTheAcknowledgedOffset)
+{
+	RemoveLog();
+	ptime now(second_clock::local_time());
+
+	InterSYNTHESEQueueLog::Offset first(0);
+	InterSYNTHESEQueueLog::Offset second(0);
+	InterSYNTHESEQueueLog::Offset third(0);
+	{
+		InterSYNTHESEQueueLog log(PATH);
+		InterSYNTHESEQueueLog::Records records;
+		BOOST_CHECK(!log.open(records));
+		BOOST_CHECK(records.empty());
+
+		first = log.append(now, "DB", "first");
+		second = log.append(now, "DB", string("sec\0ond", 7));
+		third = log.append(ptime(not_a_date_time), "RealTime", "");
+		BOOST_CHECK(first < second);
+		BOOST_CHECK(second < third);
+		BOOST_CHECK(third < log.getEndOffset());
+
+		log.acknowledge(second);
+	}
+
+	{	// The acknowledged record is not read again
+		InterSYNTHESEQueueLog log(PATH);
+		InterSYNTHESEQueueLog::Records records;
+		BOOST_CHECK(log.open(records));
+		BOOST_REQUIRE_EQUAL(records.size(), 2ULL);
+		BOOST_CHECK_EQUAL(records[0].offset, second);
+		BOOST_CHECK(records[0].requestTime == now);
+		BOOST_CHECK_EQUAL(records[0].syncType, "DB");
+		BOOST_CHECK_EQUAL(records[0].content, string("sec\0ond", 7));
+		BOOST_CHECK_EQUAL(records[1].offset, third);
+		BOOST_CHECK(records[1].requestTime.is_not_a_date_time());
+		BOOST_CHECK_EQUAL(records[1].syncType, "RealTime");
+		BOOST_CHECK_EQUAL(records[1].content, "");
+
+		// The offsets continue after the reopening
+		BOOST_CHECK(log.append(now, "DB", "fourth") >= log.getAcknowledgedOffset());
+	}
+
+	RemoveLog();
+}
+
+BOOST_AUTO_TEST_CASE(QueueLogDropsTruncatedRecord)
+{
+	RemoveLog();
+	ptime now(second_clock::local_time());
+
+	InterSYNTHESEQueueLog::Offset end(0);
+	{
+		InterSYNTHESEQueueLog log(PATH);
+		InterSYNTHESEQueueLog::Records records;
+		log.open(records);
+		log.append(now, "DB", "complete");
+		end = log.getEndOffset();
+	}
+
+	// Record interrupted by a crash
+	{
+		ofstream file(PATH.c_str(), ios::out | ios::binary | ios::app);
+		file.write("\x40\x00", 2);
+	}
+
+	InterSYNTHESEQueueLog log(PATH);
+	InterSYNTHESEQueueLog::Records records;
+	BOOST_CHECK(log.open(records));
+	BOOST_REQUIRE_EQUAL(records.size(), 1ULL);
+	BOOST_CHECK_EQUAL(records[0].content, "complete");
+	BOOST_CHECK_EQUAL(log.getEndOffset(), end);
+	BOOST_CHECK_EQUAL(log.append(now, "DB", "next"), end);
+
+	RemoveLog();
+}
+
+BOOST_AUTO_TEST_CASE(QueueLogClearKeepsOffsetsIncreasing)
+{
+	RemoveLog();
+	ptime now(second_clock::local_time());
+
+	InterSYNTHESEQueueLog::Offset last(0);
+	{
+		InterSYNTHESEQueueLog log(PATH);
+		InterSYNTHESEQueueLog::Records records;
+		log.open(records);
+		log.append(now, "DB", "first");
+		last = log.append(now, "DB", "second");
+		log.clear();
+		BOOST_CHECK_EQUAL(log.getAcknowledgedOffset(), log.getEndOffset());
+	}
+
+	InterSYNTHESEQueueLog log(PATH);
+	InterSYNTHESEQueueLog::Records records;
+	BOOST_CHECK(log.open(records));
+	BOOST_CHECK(records.empty());
+	BOOST_CHECK(log.append(now, "DB", "after") > last);
+
+	RemoveLog();
+}
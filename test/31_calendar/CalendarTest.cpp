@@ -27,6 +27,8 @@
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/foreach.hpp>
 
+#include <sstream>
+
 using namespace synthese::calendar;
 using namespace boost::gregorian;
 using namespace boost;
@@ -70,6 +72,53 @@ BOOST_AUTO_TEST_CASE(CalendarTest)
 	BOOST_CHECK(!(c != c));
 }
 
+BOOST_AUTO_TEST_CASE(CalendarOperationsTest)
+{
+	Calendar c1(date(2010, Jan, 1), date(2010, Jun, 30));
+	Calendar c2(date(2010, Apr, 1), date(2011, Feb, 28));
+
+	Calendar i(c1 & c2);
+	BOOST_CHECK_EQUAL(to_simple_string(i.getFirstActiveDate()), to_simple_string(date(2010, Apr, 1)));
+	BOOST_CHECK_EQUAL(to_simple_string(i.getLastActiveDate()), to_simple_string(date(2010, Jun, 30)));
+
+	Calendar u(c1 | c2);
+	BOOST_CHECK_EQUAL(u.size(), 365 + 31 + 28);
+	BOOST_CHECK(u.includesDates(c1));
+	BOOST_CHECK(!c1.includesDates(u));
+
+	Calendar m(c1);
+	m -= c2;
+	BOOST_CHECK_EQUAL(to_simple_string(m.getLastActiveDate()), to_simple_string(date(2010, Mar, 31)));
+	BOOST_CHECK(!m.hasAtLeastOneCommonDateWith(c2));
+	BOOST_CHECK(c1.hasAtLeastOneCommonDateWith(c2));
+
+	// The shift crosses the end of the year
+	Calendar s(date(2010, Dec, 30), date(2010, Dec, 31));
+	s <<= 2;
+	BOOST_CHECK_EQUAL(s.size(), 2);
+	BOOST_CHECK(s.isActive(date(2011, Jan, 1)));
+	BOOST_CHECK(s.isActive(date(2011, Jan, 2)));
+	BOOST_CHECK(!s.isActive(date(2010, Dec, 31)));
+
+	// Serialization round trip
+	std::stringstream stream;
+	u.serialize(stream);
+	BOOST_CHECK_EQUAL(stream.str().size(), 2 * 370);
+	Calendar r(stream.str());
+	BOOST_CHECK(r == u);
+
+	// Registered calendars with the same dates
+	Calendar k1(1), k2(2);
+	k1.copyDates(c1);
+	k2.copyDates(c1);
+	BOOST_CHECK(k1 == k2);
+	k2.setInactive(date(2010, Jan, 1));
+	BOOST_CHECK(k1 != k2);
+	BOOST_CHECK(k1.isActive(date(2010, Jan, 1)));
+}
+
+
+
 BOOST_AUTO_TEST_CASE(CalendarTemplateTest)
 {
 	date d1(2009, Jan, 1);
@@ -22,10 +22,17 @@
 
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/LineString.h>
 #include <geos/geom/Point.h>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <cmath>
 
 #include "GeographyModule.h"
 #include "CoordinatesSystem.hpp"
+#include "WithGeometry.hpp"
 #include "DBModule.h"
 #include "101_sqlite/SQLiteDB.h"
 
@@ -85,6 +92,99 @@ BOOST_AUTO_TEST_CASE (testFromLambertIIe)
 	BOOST_CHECK_CLOSE(48.5836, gp3wgs->getY(), 0.00001);
 }
 
+namespace
+{
+	void convertLineString(
+		const LineString& source,
+		size_t iterations,
+		bool& ok
+	){
+		ok = true;
+		for(size_t i(0); i < iterations; ++i)
+		{
+			boost::shared_ptr<Geometry> result(
+				CoordinatesSystem::GetCoordinatesSystem(4326).convertGeometry(source)
+			);
+			const LineString& lineString(static_cast<const LineString&>(*result));
+			ok = ok &&
+				result->getSRID() == 4326 &&
+				lineString.getNumPoints() == 3 &&
+				fabs(lineString.getCoordinateN(0).x - 1.44199101) < 0.00001 &&
+				fabs(lineString.getCoordinateN(1).y - 48.38984464) < 0.00001 &&
+				fabs(lineString.getCoordinateN(2).x - 7.74806) < 0.00001
+			;
+		}
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (testConcurrentConversions)
+{
+	// Toulouse, Brest, Strasbourg in a single sequence
+	const CoordinatesSystem& lambertIIe(CoordinatesSystem::GetCoordinatesSystem(27572));
+	const GeometryFactory& factory(lambertIIe.getGeometryFactory());
+	CoordinateSequence* coordinates(factory.getCoordinateSequenceFactory()->create(0, 2));
+	coordinates->add(Coordinate(527674.0, 1845128.0));
+	coordinates->add(Coordinate(95151.0, 2398703.0));
+	coordinates->add(Coordinate(999096.6, 2412064.0));
+	boost::shared_ptr<LineString> lineString(factory.createLineString(coordinates));
+
+	// Bulk conversion of a sequence
+	boost::shared_ptr<CoordinateSequence> sequence(lineString->getCoordinates());
+	CoordinatesSystem::GetCoordinatesSystem(4326).convertCoordinates(lambertIIe, *sequence);
+	BOOST_CHECK_CLOSE(1.44199101, sequence->getX(0), 0.00001);
+	BOOST_CHECK_CLOSE(48.38984464, sequence->getY(1), 0.00001);
+
+	// Conversions in several threads
+	const size_t threadsNumber(4);
+	bool ok[threadsNumber];
+	boost::thread_group threads;
+	for(size_t i(0); i < threadsNumber; ++i)
+	{
+		threads.create_thread(
+			boost::bind(&convertLineString, boost::cref(*lineString), 200, boost::ref(ok[i]))
+		);
+	}
+	threads.join_all();
+	for(size_t i(0); i < threadsNumber; ++i)
+	{
+		BOOST_CHECK(ok[i]);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (testProjectedGeometryCache)
+{
+	const CoordinatesSystem& lambertIIe(CoordinatesSystem::GetCoordinatesSystem(27572));
+	const CoordinatesSystem& wgs84(CoordinatesSystem::GetCoordinatesSystem(4326));
+
+	// Toulouse
+	WithGeometry<Point> object(
+		boost::shared_ptr<Point>(lambertIIe.createPoint(527674.0, 1845128.0))
+	);
+	boost::shared_ptr<Point> projected(object.getProjectedGeometry(wgs84));
+	BOOST_REQUIRE(projected.get());
+	BOOST_CHECK_CLOSE(1.44199101, projected->getX(), 0.00001);
+	BOOST_CHECK_EQUAL(object.getProjectedGeometry(wgs84).get(), projected.get());
+	BOOST_CHECK_EQUAL(object.getProjectedGeometry(lambertIIe).get(), object.getGeometry().get());
+
+	// Brest : the conversion of the previous geometry is not read anymore
+	object.setGeometry(
+		boost::shared_ptr<Point>(lambertIIe.createPoint(95151.0, 2398703.0))
+	);
+	boost::shared_ptr<Point> projected2(object.getProjectedGeometry(wgs84));
+	BOOST_REQUIRE(projected2.get());
+	BOOST_CHECK_CLOSE(-4.48683053, projected2->getX(), 0.00001);
+	BOOST_CHECK_EQUAL(object.getProjectedGeometry(wgs84).get(), projected2.get());
+
+	object.resetGeometry();
+	BOOST_CHECK(!object.getProjectedGeometry(wgs84).get());
+}
+
+
+
 BOOST_AUTO_TEST_CASE (testToLambertIIe)
 {
 	GeographyModule::PreInit();
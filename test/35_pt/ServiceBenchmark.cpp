@@ -0,0 +1,131 @@
+/** Service benchmark.
+	@file ServiceBenchmark.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "AccessParameters.h"
+#include "AllowedUseRule.h"
+#include "CommercialLine.h"
+#include "DesignatedLinePhysicalStop.hpp"
+#include "Env.h"
+#include "GeographyModule.h"
+#include "ScheduledService.h"
+#include "SearchTimeContext.hpp"
+#include "StopArea.hpp"
+#include "StopPoint.hpp"
+
+#include <iostream>
+#include <vector>
+#include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace synthese::util;
+using namespace synthese::pt;
+using namespace synthese::geography;
+using namespace synthese;
+using namespace boost::posix_time;
+using namespace boost::gregorian;
+using namespace synthese::graph;
+
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Cost of the time context in Edge::getNextService.
+/// The lookup reading the clock inside ScheduledService::getFromPresenceTime
+/// does not exist anymore : the closest path is the default argument, which
+/// builds a context (and reads the clock) at each lookup, as the callers
+/// without a search do. It is compared with one context shared by all the
+/// lookups, as a route planning search does.
+BOOST_AUTO_TEST_CASE (GetNextServiceBenchmark)
+{
+	Env env;
+	GeographyModule::PreInit();
+
+	date today(day_clock::local_day());
+
+	RuleUser::Rules r;
+	r.push_back(AllowedUseRule::INSTANCE.get());
+	r.push_back(AllowedUseRule::INSTANCE.get());
+	r.push_back(AllowedUseRule::INSTANCE.get());
+	CommercialLine line;
+	JourneyPattern l(5678);
+	l.setCommercialLine(&line);
+	l.setRules(r);
+
+	StopArea p1(0, true);
+	StopArea p2(0, false);
+	StopPoint s1(0, "s1", &p1);
+	s1.link(env, true);
+	StopPoint s2(0, "s2", &p2);
+	s2.link(env, true);
+
+	DesignatedLinePhysicalStop l1D(0, &l, 0, true, false,0,&s1, true);
+	l1D.link(env, true);
+	DesignatedLinePhysicalStop l2A(0, &l, 1, false, true,500,&s2, true);
+	l2A.link(env, true);
+
+	// A service every 5 minutes from 05:00 to 23:55
+	std::vector<boost::shared_ptr<ScheduledService> > services;
+	for(int i(0); i < 228; ++i)
+	{
+		SchedulesBasedService::Schedules d;
+		SchedulesBasedService::Schedules a;
+		d.push_back(hours(5) + minutes(5 * i));
+		a.push_back(hours(5) + minutes(5 * i));
+		d.push_back(hours(5) + minutes(5 * i + 20));
+		a.push_back(hours(5) + minutes(5 * i + 20));
+
+		boost::shared_ptr<ScheduledService> s(new ScheduledService(1000 + i, "S", &l));
+		s->setDataSchedules(d, a);
+		s->setActive(today);
+		s->setActive(today + days(1));
+		s->link(env, true);
+		services.push_back(s);
+	}
+
+	AccessParameters ap;
+	const size_t lookupsNumber(100000);
+	SearchTimeContext timeContext;
+
+	ptime t0(microsec_clock::local_time());
+	for(size_t n(0); n < lookupsNumber; ++n)
+	{
+		ptime presence(today, minutes(n % (24 * 60)));
+		boost::optional<Edge::DepartureServiceIndex::Value> index;
+		l1D.getNextService(ap, presence, presence + hours(24), true, index);
+	}
+	ptime t1(microsec_clock::local_time());
+	for(size_t n(0); n < lookupsNumber; ++n)
+	{
+		ptime presence(today, minutes(n % (24 * 60)));
+		boost::optional<Edge::DepartureServiceIndex::Value> index;
+		l1D.getNextService(ap, presence, presence + hours(24), true, index, false, false, false, true, true, timeContext);
+	}
+	ptime t2(microsec_clock::local_time());
+	std::cout << lookupsNumber << " getNextService : context built at each lookup " <<
+		(t1 - t0).total_milliseconds() << " ms, context shared by the lookups " <<
+		(t2 - t1).total_milliseconds() << " ms" << std::endl;
+
+	BOOST_FOREACH(const boost::shared_ptr<ScheduledService>& s, services)
+	{
+		s->unlink();
+	}
+}
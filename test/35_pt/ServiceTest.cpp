@@ -33,9 +33,13 @@
 #include "StopPoint.hpp"
 #include "DesignatedLinePhysicalStop.hpp"
 #include "PermanentService.h"
+#include "SearchTimeContext.hpp"
 #include "ServicePointer.h"
 
 #include <iostream>
+#include <vector>
+#include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <boost/test/auto_unit_test.hpp>
 
@@ -470,19 +474,19 @@ BOOST_AUTO_TEST_CASE (testScheduledServiceRealTime)
 			true,
 			true
 	)	);
-	// From departure, before the departure time but today + 2 days (so scheduled time should be received)
-	ptime time2(today + days(2), time_duration(1,50,0));
-	ServicePointer sp2(
-		s.getFromPresenceTime(
-			ap,
-			true,
-			true,
-			true,
-			l3AD,
-			time2,
-			false,
-			false,
-			true,
+	// From departure, before the departure time but today + 2 days (so scheduled time should be received)
+	ptime time2(today + days(2), time_duration(1,50,0));
+	ServicePointer sp2(
+		s.getFromPresenceTime(
+			ap,
+			true,
+			true,
+			true,
+			l3AD,
+			time2,
+			false,
+			false,
+			true,
 			true
 	)	);
 	BOOST_CHECK_EQUAL(sp1.getDepartureEdge(), &l3AD);
@@ -1551,3 +1555,73 @@ BOOST_AUTO_TEST_CASE (testSubline)
 	}
 
 }
+
+
+
+BOOST_AUTO_TEST_CASE (testGetNextServiceSearchTimeContext)
+{
+	Env env;
+	GeographyModule::PreInit();
+
+	date today(day_clock::local_day());
+
+	RuleUser::Rules r;
+	r.push_back(AllowedUseRule::INSTANCE.get());
+	r.push_back(AllowedUseRule::INSTANCE.get());
+	r.push_back(AllowedUseRule::INSTANCE.get());
+	CommercialLine line;
+	JourneyPattern l(5678);
+	l.setCommercialLine(&line);
+	l.setRules(r);
+
+	StopArea p1(0, true);
+	StopArea p2(0, false);
+	StopPoint s1(0, "s1", &p1);
+	s1.link(env, true);
+	StopPoint s2(0, "s2", &p2);
+	s2.link(env, true);
+
+	DesignatedLinePhysicalStop l1D(0, &l, 0, true, false,0,&s1, true);
+	l1D.link(env, true);
+	DesignatedLinePhysicalStop l2A(0, &l, 1, false, true,500,&s2, true);
+	l2A.link(env, true);
+
+	// A service every 5 minutes from 05:00 to 23:55
+	std::vector<boost::shared_ptr<ScheduledService> > services;
+	for(int i(0); i < 228; ++i)
+	{
+		SchedulesBasedService::Schedules d;
+		SchedulesBasedService::Schedules a;
+		d.push_back(hours(5) + minutes(5 * i));
+		a.push_back(hours(5) + minutes(5 * i));
+		d.push_back(hours(5) + minutes(5 * i + 20));
+		a.push_back(hours(5) + minutes(5 * i + 20));
+
+		boost::shared_ptr<ScheduledService> s(new ScheduledService(1000 + i, "S", &l));
+		s->setDataSchedules(d, a);
+		s->setActive(today);
+		s->setActive(today + days(1));
+		s->link(env, true);
+		services.push_back(s);
+	}
+
+	AccessParameters ap;
+	SearchTimeContext timeContext;
+
+	// Same services with a context per lookup and a context per search
+	for(int minute(0); minute < 48 * 60; minute += 7)
+	{
+		ptime presence(today, minutes(minute));
+		boost::optional<Edge::DepartureServiceIndex::Value> index1;
+		boost::optional<Edge::DepartureServiceIndex::Value> index2;
+		ServicePointer sp1(l1D.getNextService(ap, presence, presence + hours(24), true, index1));
+		ServicePointer sp2(l1D.getNextService(ap, presence, presence + hours(24), true, index2, false, false, false, true, true, timeContext));
+		BOOST_CHECK_EQUAL(sp1.getService(), sp2.getService());
+		BOOST_CHECK_EQUAL(sp1.getDepartureDateTime(), sp2.getDepartureDateTime());
+	}
+
+	BOOST_FOREACH(const boost::shared_ptr<ScheduledService>& s, services)
+	{
+		s->unlink();
+	}
+}
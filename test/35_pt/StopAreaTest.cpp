@@ -0,0 +1,77 @@
+/** StopAreaTest class implementation.
+	@file StopAreaTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "GeographyModule.h"
+#include "StopArea.hpp"
+#include "StopPoint.hpp"
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace synthese::pt;
+using namespace synthese::geography;
+using namespace synthese;
+using namespace boost::posix_time;
+
+BOOST_AUTO_TEST_CASE (testTransferDelays)
+{
+	GeographyModule::PreInit();
+
+	StopArea p(1, true, minutes(5));
+	StopPoint s1(11, "s1", &p);
+	StopPoint s2(12, "s2", &p);
+	StopPoint s3(13, "s3", &p);
+	p.addPhysicalStop(s1);
+	p.addPhysicalStop(s2);
+
+	StopArea::TransferDelaysMap delays;
+	StopArea::_addTransferDelay(delays, 11, 12, minutes(2));
+	StopArea::_addForbiddenTransferDelay(delays, 12, 11);
+	StopArea::_addTransferDelay(delays, 11, 13, minutes(8));
+	StopArea::_addTransferDelay(delays, 11, 99, minutes(1));
+	p.setTransferDelaysMatrix(delays);
+
+	// Stops of the area
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s1, s2), minutes(2));
+	BOOST_CHECK(p.isConnectionAllowed(s1, s2));
+	BOOST_CHECK(p.getTransferDelay(s2, s1).is_not_a_date_time());
+	BOOST_CHECK(!p.isConnectionAllowed(s2, s1));
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s1, s1), minutes(5));
+
+	// Vertices which are not stops of the area
+	BOOST_CHECK_EQUAL(p.getTransferDelay(11, 99), minutes(1));
+	BOOST_CHECK_EQUAL(p.getTransferDelay(99, 11), minutes(5));
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s1, s3), minutes(8));
+
+	// Stops added after the matrix
+	p.addPhysicalStop(s3);
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s1, s3), minutes(8));
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s3, s2), minutes(5));
+
+	// Default delay change
+	p.setDefaultTransferDelay(minutes(3));
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s3, s2), minutes(3));
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s1, s2), minutes(2));
+
+	// Removed stop
+	p.removePhysicalStop(s1);
+	BOOST_CHECK(p.getTransferDelay(s2, s1).is_not_a_date_time());
+	BOOST_CHECK_EQUAL(p.getTransferDelay(s2, s3), minutes(3));
+}
@@ -0,0 +1,135 @@
+/** RaptorRoutePlanner test.
+	@file RaptorRoutePlannerTest.cpp
+
+	This file belongs to the SYNTHESE project (public transportation specialized software)
+	Copyright (C) 2002 Hugues Romain - RCSmobility <contact@rcsmobility.com>
+
+	This program is free software; you can redistribute it and/or
+	modify it under the terms of the GNU General Public License
+	as published by the Free Software Foundation; either version 2
+	of the License, or (at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "RoutePlannerTestData.inc.hpp"
+
+#include "AlgorithmLogger.hpp"
+#include "PTTimeSlotRoutePlanner.h"
+#include "FreeDRTArea.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace synthese::pt_journey_planner;
+using namespace synthese::algorithm;
+using namespace synthese::graph;
+using namespace synthese::geography;
+using namespace synthese::road;
+using namespace synthese::util;
+using namespace synthese::pt;
+using namespace synthese::vehicle;
+
+using namespace std;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace
+{
+	//////////////////////////////////////////////////////////////////////////
+	/// Checks that a round based search returns the same journeys than the
+	/// integral search between two places.
+	void compareAlgorithms(
+		PTTimeSlotRoutePlanner::SearchAlgorithm algorithm,
+		const Place& origin,
+		const Place& destination,
+		const ptime& startTime,
+		const ptime& endTime,
+		const AccessParameters& accessParameters,
+		PlanningOrder planningOrder,
+		const AlgorithmLogger& logger
+	){
+		PTTimeSlotRoutePlanner integral(
+			&origin,
+			&destination,
+			startTime,
+			endTime,
+			startTime,
+			endTime,
+			boost::optional<std::size_t>(),
+			accessParameters,
+			planningOrder,
+			false,
+			logger
+		);
+		PTRoutePlannerResult integralResult(integral.run());
+
+		PTTimeSlotRoutePlanner raptor(
+			&origin,
+			&destination,
+			startTime,
+			endTime,
+			startTime,
+			endTime,
+			boost::optional<std::size_t>(),
+			accessParameters,
+			planningOrder,
+			false,
+			logger,
+			boost::optional<time_duration>(),
+			boost::optional<double>(),
+			true,
+			true,
+			algorithm
+		);
+		PTRoutePlannerResult raptorResult(raptor.run());
+
+		BOOST_REQUIRE_EQUAL(raptorResult.getJourneys().size(), integralResult.getJourneys().size());
+		for(size_t i(0); i<integralResult.getJourneys().size(); ++i)
+		{
+			const Journey& expected(integralResult.getJourneys().at(i));
+			const Journey& journey(raptorResult.getJourneys().at(i));
+			BOOST_CHECK_EQUAL(journey.getFirstDepartureTime(), expected.getFirstDepartureTime());
+			BOOST_CHECK_EQUAL(journey.getFirstArrivalTime(), expected.getFirstArrivalTime());
+			BOOST_CHECK_EQUAL(journey.getContinuousServiceRange(), expected.getContinuousServiceRange());
+		}
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE (RaptorRoutePlannerTest)
+{
+	ScopedCoordinatesSystemUser scopedCoordinatesSystemUser;
+	ScopedRegistrable<FreeDRTArea> scopedFreeDRTAreaRegistrable;
+
+	#include "RoutePlannerTestData.hpp"
+
+	AlgorithmLogger logger;
+	AccessParameters::AllowedPathClasses pc;
+	AccessParameters a(
+		USER_PEDESTRIAN, false, false, 1000, boost::posix_time::minutes(23), 1.11, 10, pc
+	);
+	ptime tomorrow(day_clock::local_day(), minutes(0));
+	tomorrow += days(1);
+	ptime next_day(tomorrow);
+	next_day += days(1);
+
+	PTTimeSlotRoutePlanner::SearchAlgorithm algorithms[] = { PTTimeSlotRoutePlanner::RAPTOR, PTTimeSlotRoutePlanner::RAPTOR_PROFILE };
+	BOOST_FOREACH(PTTimeSlotRoutePlanner::SearchAlgorithm algorithm, algorithms)
+	{
+		compareAlgorithms(algorithm, place94, place99, tomorrow, next_day, a, DEPARTURE_FIRST, logger);
+		compareAlgorithms(algorithm, place93, place07, tomorrow, next_day, a, DEPARTURE_FIRST, logger);
+		compareAlgorithms(algorithm, place06, place07, tomorrow, next_day, a, DEPARTURE_FIRST, logger);
+		compareAlgorithms(algorithm, place05, place99, tomorrow, next_day, a, DEPARTURE_FIRST, logger);
+		compareAlgorithms(algorithm, place93, place07, tomorrow, next_day, a, ARRIVAL_FIRST, logger);
+		compareAlgorithms(algorithm, place94, place99, tomorrow + hours(12), next_day, a, ARRIVAL_FIRST, logger);
+	}
+}
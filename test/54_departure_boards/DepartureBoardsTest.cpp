@@ -29,9 +29,12 @@
 #include "DesignatedLinePhysicalStop.hpp"
 #include "ScheduledService.h"
 #include "DeparturesTableTypes.h"
+#include "DeparturesCache.hpp"
+#include "StopPointTableSync.hpp"
 
 #include <boost/test/auto_unit_test.hpp>
 
+using namespace synthese::db;
 using namespace synthese::departure_boards;
 using namespace synthese::graph;
 using namespace synthese::util;
@@ -704,3 +707,50 @@ BOOST_AUTO_TEST_CASE(DepartureBoardsTest)
 	// Back to initial situation
 	jp1ser1.setRealTimeVertex(2, jp1.getEdge(2)->getFromVertex());
 }
+
+
+
+BOOST_AUTO_TEST_CASE(DeparturesCacheInvalidateTest)
+{
+	DeparturesCache::Clear();
+
+	StopArea a1(1);
+	StopPoint s1(encodeUId(StopPointTableSync::TABLE.ID, 0, 1), "S1", &a1);
+	a1.addPhysicalStop(s1);
+	StopArea a2(2);
+	StopPoint s2(encodeUId(StopPointTableSync::TABLE.ID, 0, 2), "S2", &a2);
+	a2.addPhysicalStop(s2);
+
+	date today(day_clock::local_day());
+
+	CommercialLine l;
+	JourneyPattern jp(1, "JP");
+	jp.setCommercialLine(&l);
+	DesignatedLinePhysicalStop jps1(0, &jp, 0, true, true, 0, &s1);
+	jp.addEdge(jps1);
+	DesignatedLinePhysicalStop jps2(0, &jp, 1, true, true, 0, &s2);
+	jp.addEdge(jps2);
+
+	ScheduledService ser(0, "Ser", &jp);
+	ScheduledService::Schedules serD;
+	serD.push_back(time_duration(8,0,0));
+	serD.push_back(time_duration(8,10,0));
+	ser.setDataSchedules(serD, serD);
+	ser.setActive(today);
+	jp.addService(ser, true);
+
+	{
+		DeparturesCache::Cursor departures(jps1, ptime(today, hours(7)), ptime(today, hours(9)), false);
+		BOOST_CHECK_EQUAL(departures.next().getService(), &ser);
+	}
+	BOOST_CHECK_EQUAL(DeparturesCache::GetEntriesNumber(), 1);
+
+	// The update of a stop and the deletion of an other object keep the departures
+	DeparturesCache::Invalidate(DB::DBModifEvent(StopPointTableSync::TABLE.NAME, DB::MODIF_UPDATE, s1.getKey()));
+	DeparturesCache::Invalidate(DB::DBModifEvent(StopPointTableSync::TABLE.NAME, DB::MODIF_DELETE, s2.getKey()));
+	BOOST_CHECK_EQUAL(DeparturesCache::GetEntriesNumber(), 1);
+
+	// The deletion of the stop removes its departures
+	DeparturesCache::Invalidate(DB::DBModifEvent(StopPointTableSync::TABLE.NAME, DB::MODIF_DELETE, s1.getKey()));
+	BOOST_CHECK_EQUAL(DeparturesCache::GetEntriesNumber(), 0);
+}